@@ -56,6 +56,7 @@
 #include <boost/asio/handler_invoke_hook.hpp>
 #include <boost/asio/handler_type.hpp>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/io_service_statistics.hpp>
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/address_v4.hpp>
 #include <boost/asio/ip/address_v6.hpp>
@@ -101,6 +102,7 @@
 #include <boost/asio/stream_socket_service.hpp>
 #include <boost/asio/streambuf.hpp>
 #include <boost/asio/time_traits.hpp>
+#include <boost/asio/timer_wheel_traits.hpp>
 #include <boost/asio/version.hpp>
 #include <boost/asio/wait_traits.hpp>
 #include <boost/asio/waitable_timer_service.hpp>
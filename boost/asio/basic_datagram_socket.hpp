@@ -942,6 +942,235 @@ public:
         this->get_implementation(), buffers, sender_endpoint, flags,
         BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
   }
+
+#if (!defined(BOOST_ASIO_WINDOWS_RUNTIME) && !defined(BOOST_ASIO_HAS_IOCP)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send a number of datagrams, one
+   * from each buffer in the sequence, using as few system calls as possible.
+   * On Linux the datagrams are sent using @c sendmmsg. On other platforms
+   * they are sent one at a time. The function call always returns
+   * immediately.
+   *
+   * @param buffers A sequence of buffers, each of which contains the data for
+   * one datagram. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller,
+   * which must guarantee that they remain valid until the handler is called.
+   *
+   * @param destinations A pointer to an array of endpoints, one for each
+   * buffer, to which the datagrams are to be sent. May be null if the socket
+   * is connected. Ownership of the array is retained by the caller, which
+   * must guarantee that it is valid until the handler is called.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_sent              // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   *
+   * @note The send operation completes once at least one datagram has been
+   * sent, and so may not send all of the datagrams. At most 64 datagrams are
+   * sent by each operation. The remaining datagrams may be sent by starting
+   * another operation for the rest of the sequence.
+   *
+   * @par Example
+   * @code boost::array<boost::asio::const_buffer, 2> buffers = {{
+   *     boost::asio::buffer(data1, size1),
+   *     boost::asio::buffer(data2, size2) }};
+   * boost::array<udp::endpoint, 2> destinations = {{ ep1, ep2 }};
+   * socket.async_send_batch(buffers, destinations.data(), handler);
+   * @endcode
+   */
+  template <typename ConstBufferSequence, typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    return this->get_service().async_send_batch(
+        this->get_implementation(), buffers, destinations, 0,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send a number of datagrams, one
+   * from each buffer in the sequence, using as few system calls as possible.
+   * The function call always returns immediately.
+   *
+   * @param buffers A sequence of buffers, each of which contains the data for
+   * one datagram. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller,
+   * which must guarantee that they remain valid until the handler is called.
+   *
+   * @param destinations A pointer to an array of endpoints, one for each
+   * buffer, to which the datagrams are to be sent. May be null if the socket
+   * is connected. Ownership of the array is retained by the caller, which
+   * must guarantee that it is valid until the handler is called.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_sent              // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename ConstBufferSequence, typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations, socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    return this->get_service().async_send_batch(
+        this->get_implementation(), buffers, destinations, flags,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive a number of datagrams,
+   * one into each buffer in the sequence, using as few system calls as
+   * possible. On Linux the datagrams are received using @c recvmmsg. On other
+   * platforms they are received one at a time. The function call always
+   * returns immediately.
+   *
+   * @param buffers A sequence of buffers, each of which receives one
+   * datagram. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller,
+   * which must guarantee that they remain valid until the handler is called.
+   *
+   * @param sender_endpoints A pointer to an array of endpoints, one for each
+   * buffer, that receive the endpoints of the remote senders. May be null if
+   * the senders are not required. Ownership of the array is retained by the
+   * caller, which must guarantee that it is valid until the handler is
+   * called.
+   *
+   * @param sizes A pointer to an array, one element for each buffer, that
+   * receives the size of each datagram. Ownership of the array is retained by
+   * the caller, which must guarantee that it is valid until the handler is
+   * called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_received          // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   *
+   * @note The receive operation completes once at least one datagram has been
+   * received, and fills the buffers in order with the datagrams that are
+   * available at that time. At most 64 datagrams are received by each
+   * operation.
+   *
+   * @par Example
+   * @code std::vector<boost::asio::mutable_buffer> buffers;
+   * for (int i = 0; i < 32; ++i)
+   *   buffers.push_back(boost::asio::buffer(data[i], max_length));
+   * udp::endpoint senders[32];
+   * std::size_t sizes[32];
+   * socket.async_receive_batch(buffers, senders, sizes, handler);
+   * @endcode
+   */
+  template <typename MutableBufferSequence, typename ReadHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))
+  async_receive_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    return this->get_service().async_receive_batch(
+        this->get_implementation(), buffers, sender_endpoints, sizes, 0,
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive a number of datagrams,
+   * one into each buffer in the sequence, using as few system calls as
+   * possible. The function call always returns immediately.
+   *
+   * @param buffers A sequence of buffers, each of which receives one
+   * datagram. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller,
+   * which must guarantee that they remain valid until the handler is called.
+   *
+   * @param sender_endpoints A pointer to an array of endpoints, one for each
+   * buffer, that receive the endpoints of the remote senders. May be null if
+   * the senders are not required. Ownership of the array is retained by the
+   * caller, which must guarantee that it is valid until the handler is
+   * called.
+   *
+   * @param sizes A pointer to an array, one element for each buffer, that
+   * receives the size of each datagram. Ownership of the array is retained by
+   * the caller, which must guarantee that it is valid until the handler is
+   * called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_received          // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename MutableBufferSequence, typename ReadHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))
+  async_receive_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    return this->get_service().async_receive_batch(
+        this->get_implementation(), buffers, sender_endpoints, sizes, flags,
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+#endif // (!defined(BOOST_ASIO_WINDOWS_RUNTIME)
+       //     && !defined(BOOST_ASIO_HAS_IOCP))
+       //   || defined(GENERATING_DOCUMENTATION)
 };
 
 } // namespace asio
@@ -19,9 +19,11 @@
 #include <cstddef>
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/basic_socket.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/throw_error.hpp>
 #include <boost/asio/error.hpp>
+#include <boost/asio/posix/basic_stream_descriptor.hpp>
 #include <boost/asio/stream_socket_service.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -413,6 +415,126 @@ public:
         BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
   }
 
+#if (!defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a range of a file.
+  /**
+   * This function is used to asynchronously send data from a file to the
+   * peer, without copying it through a user buffer. On Linux the data is
+   * transferred by the kernel using @c sendfile, or using @c splice if the
+   * file is a pipe. On other platforms the data is read into an internal
+   * buffer and then sent. The function call always returns immediately.
+   *
+   * The operation continues until all of the requested data has been sent,
+   * the end of the file is reached, or an error occurs. If the end of the file
+   * is reached first, the handler is passed boost::asio::error::eof.
+   *
+   * @param file The native descriptor of the file from which the data is to be
+   * sent. The caller must keep the descriptor open until the handler is
+   * called. The file position of the descriptor is not changed.
+   *
+   * @param offset The position in the file at which to start sending. Ignored
+   * if @c file is a pipe.
+   *
+   * @param length The number of bytes to send.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   *
+   * @note On Linux, sending to a socket whose connection has been closed by
+   * the peer raises @c SIGPIPE. Programs that use this function should ignore
+   * that signal.
+   *
+   * @note If @c file is a pipe, the operation waits for data to be written to
+   * the pipe whenever it is empty. Closing or cancelling the socket ends the
+   * wait, and the handler is passed boost::asio::error::operation_aborted.
+   *
+   * @note Only one send_file operation may be in progress on a socket at a
+   * time. Starting another fails with boost::asio::error::already_started.
+   *
+   * @par Example
+   * @code
+   * int fd = ::open("index.html", O_RDONLY);
+   * socket.async_send_file(fd, 0, file_size, handler);
+   * @endcode
+   */
+  template <typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_file(int file, uint64_t offset, std::size_t length,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    return this->get_service().async_send_file(
+        this->get_implementation(), file, offset, length,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+#if defined(BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a range of a file.
+  /**
+   * This function is used to asynchronously send data from a file to the
+   * peer, without copying it through a user buffer. The function call always
+   * returns immediately.
+   *
+   * The operation continues until all of the requested data has been sent,
+   * the end of the file is reached, or an error occurs. If the end of the file
+   * is reached first, the handler is passed boost::asio::error::eof.
+   *
+   * @param descriptor The descriptor from which the data is to be sent. The
+   * caller must keep the descriptor open until the handler is called.
+   *
+   * @param offset The position in the file at which to start sending. Ignored
+   * if @c descriptor is a pipe.
+   *
+   * @param length The number of bytes to send.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename StreamDescriptorService, typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_file(
+      posix::basic_stream_descriptor<StreamDescriptorService>& descriptor,
+      uint64_t offset, std::size_t length,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    return this->get_service().async_send_file(
+        this->get_implementation(), descriptor.native_handle(), offset,
+        length, BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+#endif // defined(BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+       //   || defined(GENERATING_DOCUMENTATION)
+#endif // (!defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__))
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data on the socket.
   /**
    * This function is used to receive data on the stream socket. The function
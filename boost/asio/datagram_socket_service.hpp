@@ -415,6 +415,49 @@ public:
     return init.result.get();
   }
 
+#if (!defined(BOOST_ASIO_WINDOWS_RUNTIME) && !defined(BOOST_ASIO_HAS_IOCP)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a batch of datagrams.
+  template <typename ConstBufferSequence, typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_batch(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type* destinations,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    detail::async_result_init<
+      WriteHandler, void (boost::system::error_code, std::size_t)> init(
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+
+    service_impl_.async_send_batch(impl, buffers,
+        destinations, flags, init.handler);
+
+    return init.result.get();
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  template <typename MutableBufferSequence, typename ReadHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))
+  async_receive_batch(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoints,
+      std::size_t* sizes, socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    detail::async_result_init<
+      ReadHandler, void (boost::system::error_code, std::size_t)> init(
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+
+    service_impl_.async_receive_batch(impl, buffers,
+        sender_endpoints, sizes, flags, init.handler);
+
+    return init.result.get();
+  }
+#endif // (!defined(BOOST_ASIO_WINDOWS_RUNTIME)
+       //     && !defined(BOOST_ASIO_HAS_IOCP))
+       //   || defined(GENERATING_DOCUMENTATION)
+
 private:
   // Destroy all user-defined handler objects owned by the service.
   void shutdown_service()
@@ -104,14 +104,23 @@ public:
   explicit buffer_sequence_adapter(const Buffers& buffer_sequence)
     : count_(0), total_buffer_size_(0)
   {
+    // Empty buffers are skipped so that they do not take up any of the
+    // native buffers, which would otherwise hide the data that follows them.
     typename Buffers::const_iterator iter = buffer_sequence.begin();
     typename Buffers::const_iterator end = buffer_sequence.end();
-    for (; iter != end && count_ < max_buffers; ++iter, ++count_)
+    for (; iter != end && count_ < max_buffers; ++iter)
     {
       Buffer buffer(*iter);
-      init_native_buffer(buffers_[count_], buffer);
-      total_buffer_size_ += boost::asio::buffer_size(buffer);
+      if (std::size_t size = boost::asio::buffer_size(buffer))
+      {
+        init_native_buffer(buffers_[count_++], buffer);
+        total_buffer_size_ += size;
+      }
     }
+
+    // A sequence of empty buffers is still passed as one empty buffer.
+    if (count_ == 0 && buffer_sequence.begin() != end)
+      init_native_buffer(buffers_[count_++], Buffer(*buffer_sequence.begin()));
   }
 
   native_buffer_type* buffers()
@@ -133,8 +142,7 @@ public:
   {
     typename Buffers::const_iterator iter = buffer_sequence.begin();
     typename Buffers::const_iterator end = buffer_sequence.end();
-    std::size_t i = 0;
-    for (; iter != end && i < max_buffers; ++iter, ++i)
+    for (; iter != end; ++iter)
       if (boost::asio::buffer_size(Buffer(*iter)) > 0)
         return false;
     return true;
@@ -170,6 +178,38 @@ private:
   std::size_t total_buffer_size_;
 };
 
+// Helper class to translate each buffer of a sequence into a native buffer,
+// including empty ones. Used where a buffer's position in the sequence is
+// significant, such as when each buffer holds a separate datagram.
+template <typename Buffer, typename Buffers>
+class buffer_sequence_batch_adapter
+  : buffer_sequence_adapter_base
+{
+public:
+  explicit buffer_sequence_batch_adapter(const Buffers& buffer_sequence)
+    : count_(0)
+  {
+    typename Buffers::const_iterator iter = buffer_sequence.begin();
+    typename Buffers::const_iterator end = buffer_sequence.end();
+    for (; iter != end && count_ < max_buffers; ++iter, ++count_)
+      init_native_buffer(buffers_[count_], Buffer(*iter));
+  }
+
+  native_buffer_type* buffers()
+  {
+    return buffers_;
+  }
+
+  std::size_t count() const
+  {
+    return count_;
+  }
+
+private:
+  native_buffer_type buffers_[max_buffers];
+  std::size_t count_;
+};
+
 template <typename Buffer>
 class buffer_sequence_adapter<Buffer, boost::asio::mutable_buffers_1>
   : buffer_sequence_adapter_base
@@ -545,7 +545,8 @@
 # endif // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
-// Linux: epoll, eventfd and timerfd.
+// Linux: epoll, eventfd, timerfd, recvmmsg/sendmmsg, sendfile/splice and
+// io_uring.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(BOOST_ASIO_HAS_EPOLL)
@@ -569,6 +570,31 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(BOOST_ASIO_HAS_EPOLL)
 # endif // !defined(BOOST_ASIO_HAS_TIMERFD)
+# if !defined(BOOST_ASIO_HAS_MMSG)
+#  if !defined(BOOST_ASIO_DISABLE_MMSG)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#    if LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0)
+#     define BOOST_ASIO_HAS_MMSG 1
+#    endif // LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0)
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#  endif // !defined(BOOST_ASIO_DISABLE_MMSG)
+# endif // !defined(BOOST_ASIO_HAS_MMSG)
+# if !defined(BOOST_ASIO_HAS_SENDFILE)
+#  if !defined(BOOST_ASIO_DISABLE_SENDFILE)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,17)
+#    define BOOST_ASIO_HAS_SENDFILE 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,17)
+#  endif // !defined(BOOST_ASIO_DISABLE_SENDFILE)
+# endif // !defined(BOOST_ASIO_HAS_SENDFILE)
+# if !defined(BOOST_ASIO_HAS_IO_URING)
+#  if defined(BOOST_ASIO_ENABLE_IO_URING)
+#   if defined(BOOST_ASIO_HAS_TIMERFD) && defined(BOOST_ASIO_HAS_EVENTFD)
+#    if LINUX_VERSION_CODE >= KERNEL_VERSION(5,6,0)
+#     define BOOST_ASIO_HAS_IO_URING 1
+#    endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,6,0)
+#   endif // defined(BOOST_ASIO_HAS_TIMERFD) && defined(BOOST_ASIO_HAS_EVENTFD)
+#  endif // defined(BOOST_ASIO_ENABLE_IO_URING)
+# endif // !defined(BOOST_ASIO_HAS_IO_URING)
 #endif // defined(__linux__)
 
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
@@ -767,6 +793,55 @@
 # endif // defined(BOOST_ASIO_HAS_THREADS)
 #endif // !defined(BOOST_ASIO_HAS_PTHREADS)
 
+// Work stealing between threads running a task_io_service.
+#if !defined(BOOST_ASIO_HAS_WORK_STEALING)
+# if defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+#  if defined(BOOST_ASIO_HAS_THREADS)
+#   define BOOST_ASIO_HAS_WORK_STEALING 1
+#  endif // defined(BOOST_ASIO_HAS_THREADS)
+# endif // defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+#endif // !defined(BOOST_ASIO_HAS_WORK_STEALING)
+
+// An io_service that runs a separate epoll reactor on each of its threads.
+#if !defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+# if !defined(BOOST_ASIO_DISABLE_MULTIPLE_REACTORS)
+#  if defined(BOOST_ASIO_HAS_EPOLL) && !defined(BOOST_ASIO_HAS_IO_URING)
+#   if defined(BOOST_ASIO_HAS_THREADS) && !defined(BOOST_ASIO_HAS_IOCP)
+#    define BOOST_ASIO_HAS_MULTIPLE_REACTORS 1
+#   endif // defined(BOOST_ASIO_HAS_THREADS) && !defined(BOOST_ASIO_HAS_IOCP)
+#  endif // defined(BOOST_ASIO_HAS_EPOLL) && !defined(BOOST_ASIO_HAS_IO_URING)
+# endif // !defined(BOOST_ASIO_DISABLE_MULTIPLE_REACTORS)
+#endif // !defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
+// Strands that each have their own lock-free queue of waiting handlers.
+#if !defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+# if !defined(BOOST_ASIO_DISABLE_LOCK_FREE_STRANDS)
+#  if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#   define BOOST_ASIO_HAS_LOCK_FREE_STRANDS 1
+#  endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+# endif // !defined(BOOST_ASIO_DISABLE_LOCK_FREE_STRANDS)
+#endif // !defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+
+// Counters and timings for the handlers run by an io_service.
+#if !defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+# if defined(BOOST_ASIO_ENABLE_HANDLER_STATISTICS) \
+  || defined(BOOST_ASIO_ENABLE_HANDLER_TYPE_STATISTICS)
+#  if defined(BOOST_ASIO_HAS_STD_ATOMIC) || defined(__GNUC__)
+#   define BOOST_ASIO_HAS_HANDLER_STATISTICS 1
+#  endif // defined(BOOST_ASIO_HAS_STD_ATOMIC) || defined(__GNUC__)
+# endif // defined(BOOST_ASIO_ENABLE_HANDLER_STATISTICS)
+      //   || defined(BOOST_ASIO_ENABLE_HANDLER_TYPE_STATISTICS)
+#endif // !defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+
+// Handler statistics broken down by the type of operation.
+#if !defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+# if defined(BOOST_ASIO_ENABLE_HANDLER_TYPE_STATISTICS)
+#  if defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+#   define BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS 1
+#  endif // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+# endif // defined(BOOST_ASIO_ENABLE_HANDLER_TYPE_STATISTICS)
+#endif // !defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
 // Helper to prevent macro expansion.
 #define BOOST_ASIO_PREVENT_MACRO_SUBSTITUTION
 
@@ -151,6 +151,73 @@ private:
   std::size_t max_size_;
 };
 
+// A list of up to MaxBuffers buffers, stored inline so that copying it costs
+// the same however long the sequence it was taken from.
+template <typename Buffer, std::size_t MaxBuffers>
+class prepared_buffers
+{
+public:
+  // The type for each element in the list of buffers.
+  typedef Buffer value_type;
+
+  // A random-access iterator type that may be used to read elements.
+  typedef const Buffer* const_iterator;
+
+  // The maximum number of buffers in the list.
+  enum { max_buffers = MaxBuffers };
+
+  // Construct an empty list.
+  prepared_buffers()
+    : count_(0)
+  {
+  }
+
+  // Copy constructor.
+  prepared_buffers(const prepared_buffers& other)
+    : count_(other.count_)
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+      elems_[i] = other.elems_[i];
+  }
+
+  // Assignment operator.
+  prepared_buffers& operator=(const prepared_buffers& other)
+  {
+    count_ = other.count_;
+    for (std::size_t i = 0; i < count_; ++i)
+      elems_[i] = other.elems_[i];
+    return *this;
+  }
+
+  // Add a buffer to the end of the list.
+  void push_back(const Buffer& buffer)
+  {
+    elems_[count_++] = buffer;
+  }
+
+  // Determine whether the list is full.
+  bool full() const
+  {
+    return count_ == max_buffers;
+  }
+
+  // Get a random-access iterator to the first element.
+  const_iterator begin() const
+  {
+    return elems_;
+  }
+
+  // Get a random-access iterator for one past the last element.
+  const_iterator end() const
+  {
+    return elems_ + count_;
+  }
+
+private:
+  Buffer elems_[max_buffers];
+  std::size_t count_;
+};
+
 // A proxy for a sub-range in a list of buffers.
 template <typename Buffer, typename Buffers>
 class consuming_buffers
@@ -163,17 +230,23 @@ public:
   typedef consuming_buffers_iterator<Buffer, typename Buffers::const_iterator>
     const_iterator;
 
+  // The buffers to be used in a single transfer. No more are needed than can
+  // be passed to a single system call.
+  typedef prepared_buffers<Buffer, 64> prepared_buffers_type;
+
   // Construct to represent the entire list of buffers.
   consuming_buffers(const Buffers& buffers)
     : buffers_(buffers),
       at_end_(buffers_.begin() == buffers_.end()),
       begin_remainder_(buffers_.begin()),
+      remainder_offset_(0),
       max_size_((std::numeric_limits<std::size_t>::max)())
   {
     if (!at_end_)
     {
       first_ = *buffers_.begin();
       ++begin_remainder_;
+      ++remainder_offset_;
     }
   }
 
@@ -183,12 +256,25 @@ public:
       at_end_(other.at_end_),
       first_(other.first_),
       begin_remainder_(buffers_.begin()),
+      remainder_offset_(other.remainder_offset_),
+      max_size_(other.max_size_)
+  {
+    std::advance(begin_remainder_, remainder_offset_);
+  }
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+  // Move constructor.
+  consuming_buffers(consuming_buffers&& other)
+    : buffers_(BOOST_ASIO_MOVE_CAST(Buffers)(other.buffers_)),
+      at_end_(other.at_end_),
+      first_(other.first_),
+      begin_remainder_(buffers_.begin()),
+      remainder_offset_(other.remainder_offset_),
       max_size_(other.max_size_)
   {
-    typename Buffers::const_iterator first = other.buffers_.begin();
-    typename Buffers::const_iterator second = other.begin_remainder_;
-    std::advance(begin_remainder_, std::distance(first, second));
+    std::advance(begin_remainder_, remainder_offset_);
   }
+#endif // defined(BOOST_ASIO_HAS_MOVE)
 
   // Assignment operator.
   consuming_buffers& operator=(const consuming_buffers& other)
@@ -197,9 +283,8 @@ public:
     at_end_ = other.at_end_;
     first_ = other.first_;
     begin_remainder_ = buffers_.begin();
-    typename Buffers::const_iterator first = other.buffers_.begin();
-    typename Buffers::const_iterator second = other.begin_remainder_;
-    std::advance(begin_remainder_, std::distance(first, second));
+    remainder_offset_ = other.remainder_offset_;
+    std::advance(begin_remainder_, remainder_offset_);
     max_size_ = other.max_size_;
     return *this;
   }
@@ -223,6 +308,35 @@ public:
     max_size_ = max_size;
   }
 
+  // Get the buffers for the next transfer, limited to the maximum size. Empty
+  // buffers are skipped. Only as many buffers are visited as are returned, so
+  // the cost does not depend on how much of the sequence remains.
+  prepared_buffers_type prepared() const
+  {
+    prepared_buffers_type result;
+    if (at_end_ || max_size_ == 0)
+      return result;
+
+    std::size_t remaining = max_size_;
+    Buffer next = first_;
+    typename Buffers::const_iterator iter = begin_remainder_;
+    typename Buffers::const_iterator end = buffers_.end();
+    for (;;)
+    {
+      if (buffer_size(next) > 0)
+      {
+        Buffer b = buffer(next, remaining);
+        result.push_back(b);
+        remaining -= buffer_size(b);
+      }
+      if (remaining == 0 || result.full() || iter == end)
+        break;
+      next = *iter++;
+    }
+
+    return result;
+  }
+
   // Consume the specified number of bytes from the buffers.
   void consume(std::size_t size)
   {
@@ -235,7 +349,10 @@ public:
         if (begin_remainder_ == buffers_.end())
           at_end_ = true;
         else
+        {
           first_ = *begin_remainder_++;
+          ++remainder_offset_;
+        }
       }
       else
       {
@@ -250,7 +367,10 @@ public:
       if (begin_remainder_ == buffers_.end())
         at_end_ = true;
       else
+      {
         first_ = *begin_remainder_++;
+        ++remainder_offset_;
+      }
     }
   }
 
@@ -259,6 +379,7 @@ private:
   bool at_end_;
   Buffer first_;
   typename Buffers::const_iterator begin_remainder_;
+  std::size_t remainder_offset_;
   std::size_t max_size_;
 };
 
@@ -279,6 +400,11 @@ public:
     // No-op.
   }
 
+  boost::asio::null_buffers prepared() const
+  {
+    return boost::asio::null_buffers();
+  }
+
   void consume(std::size_t)
   {
     // No-op.
@@ -65,6 +65,8 @@ BOOST_ASIO_DECL int open(const char* path, int flags,
 BOOST_ASIO_DECL int close(int d, state_type& state,
     boost::system::error_code& ec);
 
+BOOST_ASIO_DECL int dup(int d, boost::system::error_code& ec);
+
 BOOST_ASIO_DECL bool set_user_non_blocking(int d,
     state_type& state, bool value, boost::system::error_code& ec);
 
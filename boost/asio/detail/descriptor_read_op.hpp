@@ -24,6 +24,7 @@
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
 #include <boost/asio/detail/descriptor_ops.hpp>
 #include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/io_uring_ops.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -42,6 +43,10 @@ public:
       descriptor_(descriptor),
       buffers_(buffers)
   {
+#if defined(BOOST_ASIO_HAS_IO_URING)
+    this->set_submission_funcs(&descriptor_read_op_base::do_prepare,
+        &descriptor_read_op_base::do_complete_submission);
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
   }
 
   static bool do_perform(reactor_op* base)
@@ -55,6 +60,37 @@ public:
         bufs.buffers(), bufs.count(), o->ec_, o->bytes_transferred_);
   }
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  static bool do_prepare(reactor_op* base, io_uring_sqe& sqe)
+  {
+    descriptor_read_op_base* o(static_cast<descriptor_read_op_base*>(base));
+
+    // Only single buffers are submitted directly, as a scatter-gather list
+    // would have to outlive this call.
+    buffer_sequence_adapter<boost::asio::mutable_buffer,
+        MutableBufferSequence> bufs(o->buffers_);
+    if (bufs.count() != 1)
+      return false;
+
+    io_uring_ops::prep_read(sqe, o->descriptor_,
+        bufs.buffers()[0].iov_base, bufs.buffers()[0].iov_len);
+    return true;
+  }
+
+  static bool do_complete_submission(reactor_op* base, int result)
+  {
+    descriptor_read_op_base* o(static_cast<descriptor_read_op_base*>(base));
+
+    if (io_uring_ops::would_block(result))
+      return false;
+
+    o->bytes_transferred_ = io_uring_ops::translate_result(result, o->ec_);
+    if (result == 0)
+      o->ec_ = boost::asio::error::eof;
+    return true;
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 private:
   int descriptor_;
   MutableBufferSequence buffers_;
@@ -31,6 +31,7 @@
 #include <boost/asio/detail/timer_queue_base.hpp>
 #include <boost/asio/detail/timer_queue_set.hpp>
 #include <boost/asio/detail/wait_op.hpp>
+#include <vector>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -57,6 +58,7 @@ public:
     mutex mutex_;
     epoll_reactor* reactor_;
     int descriptor_;
+    std::size_t shard_;
     uint32_t registered_events_;
     op_queue<reactor_op> op_queue_[max_ops];
     bool shutdown_;
@@ -154,10 +156,40 @@ public:
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
   // Run epoll once until interrupted or events are ready to be dispatched.
-  BOOST_ASIO_DECL void run(bool block, op_queue<operation>& ops);
+  void run(bool block, op_queue<operation>& ops)
+  {
+    run(0, block, ops);
+  }
 
   // Interrupt the select loop.
-  BOOST_ASIO_DECL void interrupt();
+  void interrupt()
+  {
+    interrupt(0);
+  }
+
+  // Get the number of epoll instances. There is more than one only when the
+  // io_service has been constructed with multiple reactors, in which case
+  // each thread running the io_service waits on its own instance.
+  std::size_t num_shards() const
+  {
+    return epoll_fds_.size();
+  }
+
+  // Run the given epoll instance once until interrupted or events are ready to
+  // be dispatched.
+  BOOST_ASIO_DECL void run(std::size_t shard,
+      bool block, op_queue<operation>& ops);
+
+  // Interrupt a blocking wait on the given epoll instance.
+  BOOST_ASIO_DECL void interrupt(std::size_t shard);
+
+  // Add one epoll instance to another, so that waiting on the outer instance
+  // also returns when the inner instance has events ready. The inner instance
+  // must then be run separately to dispatch those events.
+  BOOST_ASIO_DECL void nest_shard(std::size_t outer, std::size_t inner);
+
+  // Remove an epoll instance previously added to another using nest_shard.
+  BOOST_ASIO_DECL void unnest_shard(std::size_t outer, std::size_t inner);
 
 private:
   // The hint to pass to epoll_create to size its data structures.
@@ -167,6 +199,11 @@ private:
   // cannot be created.
   BOOST_ASIO_DECL static int do_epoll_create();
 
+  // Create the epoll file descriptors and add the interrupter and timer
+  // descriptors to them. Throws an exception if a descriptor cannot be
+  // created.
+  BOOST_ASIO_DECL void create_epoll_fds();
+
   // Create the timerfd file descriptor. Does not throw.
   BOOST_ASIO_DECL static int do_timerfd_create();
 
@@ -205,8 +242,9 @@ private:
   // The interrupter is used to break a blocking epoll_wait call.
   select_interrupter interrupter_;
 
-  // The epoll file descriptor.
-  int epoll_fd_;
+  // The epoll file descriptors, one for each reactor. The first is also used
+  // for the timer and for internal descriptors.
+  std::vector<int> epoll_fds_;
 
   // The timer file descriptor.
   int timer_fd_;
@@ -0,0 +1,379 @@
+//
+// detail/handler_statistics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_HANDLER_STATISTICS_HPP
+#define BOOST_ASIO_DETAIL_HANDLER_STATISTICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/detail/cstdint.hpp>
+
+#if defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+# include <boost/asio/detail/noncopyable.hpp>
+# include <boost/asio/detail/op_queue.hpp>
+# if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#  include <atomic>
+# endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#endif // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The values read from an io_service's statistics.
+struct handler_statistics_values
+{
+  enum
+  {
+    // The number of buckets in a handler execution time histogram. Bucket n
+    // counts handlers that ran for less than 2^n microseconds, and at least
+    // 2^(n-1) microseconds if n is non-zero. The last bucket is unbounded.
+    histogram_buckets = 24,
+
+    // The number of operation types that are counted separately.
+    operation_types = 9
+  };
+
+  uint64_t handlers_queued;
+  uint64_t handlers_executed;
+  uint64_t handler_usec;
+  uint64_t max_handler_usec;
+  uint64_t reactor_waits;
+  uint64_t reactor_wait_usec;
+  uint64_t histogram[histogram_buckets];
+  uint64_t operations_completed[operation_types];
+  uint64_t operation_usec[operation_types];
+  uint64_t operation_histogram[operation_types][histogram_buckets];
+};
+
+#if defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+
+// Counters kept by an io_service for the handlers that it runs. Updates are
+// spread over several cache lines to limit contention between threads, and
+// may be read from any thread without locking.
+class handler_statistics
+  : private noncopyable
+{
+public:
+  // The types of operation that are counted separately. Must be kept in step
+  // with io_service_statistics::operation_type.
+  enum operation_type
+  {
+    posted_handler = 0,
+    strand_handler,
+    timer_operation,
+    socket_receive_operation,
+    socket_send_operation,
+    socket_accept_operation,
+    socket_connect_operation,
+    descriptor_operation,
+    other_operation,
+    untyped_operation = 0xFF
+  };
+
+  // Record that a number of handlers have been queued for execution.
+  void handlers_queued(std::size_t n)
+  {
+    this_slot().queued.add(n);
+  }
+
+  // Record that all of the operations in a queue have been queued for
+  // execution.
+  template <typename Operation>
+  void handlers_queued(op_queue<Operation>& ops)
+  {
+    std::size_t n = 0;
+    for (Operation* o = ops.front(); o; o = op_queue_access::next(o))
+      ++n;
+    if (n)
+      handlers_queued(n);
+  }
+
+  // Times the execution of a handler by the io_service.
+  class handler_timer
+    : private noncopyable
+  {
+  public:
+    explicit handler_timer(handler_statistics& s)
+      : statistics_(s),
+        start_(now_usec())
+    {
+    }
+
+    ~handler_timer()
+    {
+      statistics_.handler_executed(now_usec() - start_);
+    }
+
+  private:
+    handler_statistics& statistics_;
+    uint64_t start_;
+  };
+
+  // Times a call into the reactor.
+  class wait_timer
+    : private noncopyable
+  {
+  public:
+    explicit wait_timer(handler_statistics& s)
+      : statistics_(s),
+        start_(now_usec())
+    {
+    }
+
+    ~wait_timer()
+    {
+      statistics_.reactor_waited(now_usec() - start_);
+    }
+
+  private:
+    handler_statistics& statistics_;
+    uint64_t start_;
+  };
+
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+  // Record the type of a newly created operation.
+  template <typename Operation>
+  static void creation(Operation* o, const char* object_type,
+      void* /*object*/, const char* op_name)
+  {
+    o->statistics_type_ = static_cast<unsigned char>(
+        operation_type_of(object_type, op_name));
+  }
+
+  // Times the completion of an operation that has a type.
+  class operation_timer
+    : private noncopyable
+  {
+  public:
+    operation_timer(handler_statistics& s, unsigned char type)
+      : statistics_(type == untyped_operation ? 0 : &s),
+        type_(type),
+        start_(statistics_ ? now_usec() : 0)
+    {
+    }
+
+    ~operation_timer()
+    {
+      if (statistics_)
+        statistics_->operation_completed(type_, now_usec() - start_);
+    }
+
+  private:
+    handler_statistics* statistics_;
+    unsigned char type_;
+    uint64_t start_;
+  };
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
+  // Read the current values of all counters.
+  BOOST_ASIO_DECL void read(handler_statistics_values& values) const;
+
+  // Get the current time in microseconds from a monotonic clock.
+  BOOST_ASIO_DECL static uint64_t now_usec();
+
+private:
+  // A counter that is updated and read without locking.
+  class counter
+  {
+  public:
+    counter()
+      : value_(0)
+    {
+    }
+
+    void add(uint64_t n)
+    {
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+      value_.fetch_add(n, std::memory_order_relaxed);
+#else // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+      __sync_fetch_and_add(&value_, n);
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+    }
+
+    void update_max(uint64_t n)
+    {
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+      uint64_t value = value_.load(std::memory_order_relaxed);
+      while (n > value && !value_.compare_exchange_weak(
+            value, n, std::memory_order_relaxed))
+      {
+      }
+#else // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+      uint64_t value = load();
+      while (n > value)
+      {
+        uint64_t prev = __sync_val_compare_and_swap(&value_, value, n);
+        if (prev == value)
+          break;
+        value = prev;
+      }
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+    }
+
+    uint64_t load() const
+    {
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+      return value_.load(std::memory_order_relaxed);
+#else // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+      return __sync_fetch_and_add(const_cast<volatile uint64_t*>(&value_), 0);
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+    }
+
+  private:
+#if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+    std::atomic<uint64_t> value_;
+#else // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+    volatile uint64_t value_;
+#endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  };
+
+  enum
+  {
+    histogram_buckets = handler_statistics_values::histogram_buckets,
+    operation_types = handler_statistics_values::operation_types,
+
+    // The number of sets of counters that threads are spread across.
+    num_slots = 8
+  };
+
+  // One set of counters. The counters kept for an io_service are the sum of
+  // those in all slots.
+  struct slot
+  {
+    counter queued;
+    counter executed;
+    counter handler_usec;
+    counter max_handler_usec;
+    counter reactor_waits;
+    counter reactor_wait_usec;
+    counter histogram[histogram_buckets];
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+    counter operations_completed[operation_types];
+    counter operation_usec[operation_types];
+    counter operation_histogram[operation_types][histogram_buckets];
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
+    // Keep neighbouring slots on separate cache lines.
+    char padding[64];
+  };
+
+  // Get the slot to be updated by the calling thread. Threads are told apart
+  // by the address of their stacks.
+  slot& this_slot()
+  {
+    char local = 0;
+    std::size_t addr = reinterpret_cast<std::size_t>(&local) >> 14;
+    return slots_[(addr ^ (addr >> 5) ^ (addr >> 10)) % num_slots];
+  }
+
+  // Get the histogram bucket for a duration.
+  static std::size_t bucket_of(uint64_t usec)
+  {
+    std::size_t bucket = 0;
+    while (usec && bucket < histogram_buckets - 1)
+    {
+      usec >>= 1;
+      ++bucket;
+    }
+    return bucket;
+  }
+
+  // Record the execution of a handler.
+  void handler_executed(uint64_t usec)
+  {
+    slot& s = this_slot();
+    s.executed.add(1);
+    s.handler_usec.add(usec);
+    s.max_handler_usec.update_max(usec);
+    s.histogram[bucket_of(usec)].add(1);
+  }
+
+  // Record a call into the reactor.
+  void reactor_waited(uint64_t usec)
+  {
+    slot& s = this_slot();
+    s.reactor_waits.add(1);
+    s.reactor_wait_usec.add(usec);
+  }
+
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+  // Record the completion of an operation that has a type.
+  void operation_completed(unsigned char type, uint64_t usec)
+  {
+    slot& s = this_slot();
+    s.operations_completed[type].add(1);
+    s.operation_usec[type].add(usec);
+    s.operation_histogram[type][bucket_of(usec)].add(1);
+  }
+
+  // Determine the type of an operation from the names passed to
+  // BOOST_ASIO_HANDLER_CREATION.
+  BOOST_ASIO_DECL static operation_type operation_type_of(
+      const char* object_type, const char* op_name);
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
+  // The sets of counters.
+  slot slots_[num_slots];
+};
+
+#else // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+
+// Stands in for the statistics when they are disabled.
+class handler_statistics
+{
+public:
+  void handlers_queued(std::size_t)
+  {
+  }
+
+  template <typename Operation>
+  void handlers_queued(Operation&)
+  {
+  }
+
+  class handler_timer
+  {
+  public:
+    explicit handler_timer(handler_statistics&)
+    {
+    }
+  };
+
+  class wait_timer
+  {
+  public:
+    explicit wait_timer(handler_statistics&)
+    {
+    }
+  };
+
+  BOOST_ASIO_DECL void read(handler_statistics_values& values) const;
+};
+
+#endif // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/handler_statistics.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_DETAIL_HANDLER_STATISTICS_HPP
@@ -17,6 +17,10 @@
 
 #include <boost/asio/detail/config.hpp>
 
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+# include <boost/asio/detail/handler_statistics.hpp>
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
 #if defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
 # include <boost/system/error_code.hpp>
 # include <boost/asio/detail/cstdint.hpp>
@@ -120,8 +124,14 @@ private:
 # define BOOST_ASIO_HANDLER_TRACKING_INIT \
   boost::asio::detail::handler_tracking::init()
 
-# define BOOST_ASIO_HANDLER_CREATION(args) \
+# if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+#  define BOOST_ASIO_HANDLER_CREATION(args) \
+  (boost::asio::detail::handler_tracking::creation args, \
+   boost::asio::detail::handler_statistics::creation args)
+# else // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+#  define BOOST_ASIO_HANDLER_CREATION(args) \
   boost::asio::detail::handler_tracking::creation args
+# endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
 
 # define BOOST_ASIO_HANDLER_COMPLETION(args) \
   boost::asio::detail::handler_tracking::completion tracked_completion args
@@ -140,7 +150,12 @@ private:
 # define BOOST_ASIO_INHERIT_TRACKED_HANDLER
 # define BOOST_ASIO_ALSO_INHERIT_TRACKED_HANDLER
 # define BOOST_ASIO_HANDLER_TRACKING_INIT (void)0
-# define BOOST_ASIO_HANDLER_CREATION(args) (void)0
+# if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+#  define BOOST_ASIO_HANDLER_CREATION(args) \
+  boost::asio::detail::handler_statistics::creation args
+# else // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+#  define BOOST_ASIO_HANDLER_CREATION(args) (void)0
+# endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
 # define BOOST_ASIO_HANDLER_COMPLETION(args) (void)0
 # define BOOST_ASIO_HANDLER_INVOCATION_BEGIN(args) (void)0
 # define BOOST_ASIO_HANDLER_INVOCATION_END (void)0
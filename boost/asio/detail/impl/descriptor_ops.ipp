@@ -78,6 +78,15 @@ int close(int d, state_type& state, boost::system::error_code& ec)
   return result;
 }
 
+int dup(int d, boost::system::error_code& ec)
+{
+  errno = 0;
+  int result = error_wrapper(::dup(d), ec);
+  if (result >= 0)
+    ec = boost::system::error_code();
+  return result;
+}
+
 bool set_user_non_blocking(int d, state_type& state,
     bool value, boost::system::error_code& ec)
 {
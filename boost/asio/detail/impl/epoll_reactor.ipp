@@ -40,30 +40,18 @@ epoll_reactor::epoll_reactor(boost::asio::io_service& io_service)
     io_service_(use_service<io_service_impl>(io_service)),
     mutex_(),
     interrupter_(),
-    epoll_fd_(do_epoll_create()),
+    epoll_fds_(io_service_.num_reactors(), -1),
     timer_fd_(do_timerfd_create()),
     shutdown_(false)
 {
-  // Add the interrupter's descriptor to epoll.
-  epoll_event ev = { 0, { 0 } };
-  ev.events = EPOLLIN | EPOLLERR | EPOLLET;
-  ev.data.ptr = &interrupter_;
-  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, interrupter_.read_descriptor(), &ev);
-  interrupter_.interrupt();
-
-  // Add the timer descriptor to epoll.
-  if (timer_fd_ != -1)
-  {
-    ev.events = EPOLLIN | EPOLLERR;
-    ev.data.ptr = &timer_fd_;
-    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &ev);
-  }
+  create_epoll_fds();
 }
 
 epoll_reactor::~epoll_reactor()
 {
-  if (epoll_fd_ != -1)
-    close(epoll_fd_);
+  for (std::size_t i = 0; i < epoll_fds_.size(); ++i)
+    if (epoll_fds_[i] != -1)
+      close(epoll_fds_[i]);
   if (timer_fd_ != -1)
     close(timer_fd_);
 }
@@ -93,10 +81,12 @@ void epoll_reactor::fork_service(boost::asio::io_service::fork_event fork_ev)
 {
   if (fork_ev == boost::asio::io_service::fork_child)
   {
-    if (epoll_fd_ != -1)
-      ::close(epoll_fd_);
-    epoll_fd_ = -1;
-    epoll_fd_ = do_epoll_create();
+    for (std::size_t i = 0; i < epoll_fds_.size(); ++i)
+    {
+      if (epoll_fds_[i] != -1)
+        ::close(epoll_fds_[i]);
+      epoll_fds_[i] = -1;
+    }
 
     if (timer_fd_ != -1)
       ::close(timer_fd_);
@@ -105,20 +95,7 @@ void epoll_reactor::fork_service(boost::asio::io_service::fork_event fork_ev)
 
     interrupter_.recreate();
 
-    // Add the interrupter's descriptor to epoll.
-    epoll_event ev = { 0, { 0 } };
-    ev.events = EPOLLIN | EPOLLERR | EPOLLET;
-    ev.data.ptr = &interrupter_;
-    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, interrupter_.read_descriptor(), &ev);
-    interrupter_.interrupt();
-
-    // Add the timer descriptor to epoll.
-    if (timer_fd_ != -1)
-    {
-      ev.events = EPOLLIN | EPOLLERR;
-      ev.data.ptr = &timer_fd_;
-      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &ev);
-    }
+    create_epoll_fds();
 
     update_timeout();
 
@@ -127,9 +104,11 @@ void epoll_reactor::fork_service(boost::asio::io_service::fork_event fork_ev)
     for (descriptor_state* state = registered_descriptors_.first();
         state != 0; state = state->next_)
     {
+      epoll_event ev = { 0, { 0 } };
       ev.events = state->registered_events_;
       ev.data.ptr = state;
-      int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state->descriptor_, &ev);
+      int result = epoll_ctl(epoll_fds_[state->shard_],
+          EPOLL_CTL_ADD, state->descriptor_, &ev);
       if (result != 0)
       {
         boost::system::error_code ec(errno,
@@ -155,6 +134,7 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
 
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
+    descriptor_data->shard_ = io_service_.choose_reactor();
     descriptor_data->shutdown_ = false;
   }
 
@@ -162,7 +142,8 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
   ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
   descriptor_data->registered_events_ = ev.events;
   ev.data.ptr = descriptor_data;
-  int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
+  int result = epoll_ctl(epoll_fds_[descriptor_data->shard_],
+      EPOLL_CTL_ADD, descriptor, &ev);
   if (result != 0)
     return errno;
 
@@ -180,6 +161,7 @@ int epoll_reactor::register_internal_descriptor(
 
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
+    descriptor_data->shard_ = 0;
     descriptor_data->shutdown_ = false;
     descriptor_data->op_queue_[op_type].push(op);
   }
@@ -188,7 +170,7 @@ int epoll_reactor::register_internal_descriptor(
   ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
   descriptor_data->registered_events_ = ev.events;
   ev.data.ptr = descriptor_data;
-  int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
+  int result = epoll_ctl(epoll_fds_[0], EPOLL_CTL_ADD, descriptor, &ev);
   if (result != 0)
     return errno;
 
@@ -242,7 +224,8 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
           epoll_event ev = { 0, { 0 } };
           ev.events = descriptor_data->registered_events_ | EPOLLOUT;
           ev.data.ptr = descriptor_data;
-          if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev) == 0)
+          if (epoll_ctl(epoll_fds_[descriptor_data->shard_],
+                EPOLL_CTL_MOD, descriptor, &ev) == 0)
           {
             descriptor_data->registered_events_ |= ev.events;
           }
@@ -266,7 +249,8 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
       epoll_event ev = { 0, { 0 } };
       ev.events = descriptor_data->registered_events_;
       ev.data.ptr = descriptor_data;
-      epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev);
+      epoll_ctl(epoll_fds_[descriptor_data->shard_],
+          EPOLL_CTL_MOD, descriptor, &ev);
     }
   }
 
@@ -316,7 +300,8 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
     else
     {
       epoll_event ev = { 0, { 0 } };
-      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+      epoll_ctl(epoll_fds_[descriptor_data->shard_],
+          EPOLL_CTL_DEL, descriptor, &ev);
     }
 
     op_queue<operation> ops;
@@ -353,7 +338,8 @@ void epoll_reactor::deregister_internal_descriptor(socket_type descriptor,
   if (!descriptor_data->shutdown_)
   {
     epoll_event ev = { 0, { 0 } };
-    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+    epoll_ctl(epoll_fds_[descriptor_data->shard_],
+        EPOLL_CTL_DEL, descriptor, &ev);
 
     op_queue<operation> ops;
     for (int i = 0; i < max_ops; ++i)
@@ -369,13 +355,15 @@ void epoll_reactor::deregister_internal_descriptor(socket_type descriptor,
   }
 }
 
-void epoll_reactor::run(bool block, op_queue<operation>& ops)
+void epoll_reactor::run(std::size_t shard,
+    bool block, op_queue<operation>& ops)
 {
   // This code relies on the fact that the task_io_service queues the reactor
   // task behind all descriptor operations generated by this function. This
   // means, that by the time we reach this point, any previously returned
   // descriptor operations have already been dequeued. Therefore it is now safe
   // for us to reuse and return them for the task_io_service to queue again.
+  // When there are multiple reactors, the same holds for each epoll instance.
 
   // Calculate a timeout only if timerfd is not used.
   int timeout;
@@ -389,12 +377,13 @@ void epoll_reactor::run(bool block, op_queue<operation>& ops)
 
   // Block on the epoll descriptor.
   epoll_event events[128];
-  int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
+  int num_events = epoll_wait(epoll_fds_[shard], events, 128, timeout);
 
+  // Timers are only dispatched by the first epoll instance.
 #if defined(BOOST_ASIO_HAS_TIMERFD)
-  bool check_timers = (timer_fd_ == -1);
+  bool check_timers = (shard == 0 && timer_fd_ == -1);
 #else // defined(BOOST_ASIO_HAS_TIMERFD)
-  bool check_timers = true;
+  bool check_timers = (shard == 0);
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
 
   // Dispatch the waiting events.
@@ -410,9 +399,9 @@ void epoll_reactor::run(bool block, op_queue<operation>& ops)
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
       if (timer_fd_ == -1)
-        check_timers = true;
+        check_timers = (shard == 0);
 #else // defined(BOOST_ASIO_HAS_TIMERFD)
-      check_timers = true;
+      check_timers = (shard == 0);
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
     }
 #if defined(BOOST_ASIO_HAS_TIMERFD)
@@ -421,6 +410,11 @@ void epoll_reactor::run(bool block, op_queue<operation>& ops)
       check_timers = true;
     }
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
+    else if (ptr == &epoll_fds_)
+    {
+      // A nested epoll instance has events ready. They are dispatched when
+      // the caller runs that instance.
+    }
     else
     {
       // The descriptor operation doesn't count as work in and of itself, so we
@@ -449,12 +443,55 @@ void epoll_reactor::run(bool block, op_queue<operation>& ops)
   }
 }
 
-void epoll_reactor::interrupt()
+void epoll_reactor::interrupt(std::size_t shard)
 {
   epoll_event ev = { 0, { 0 } };
   ev.events = EPOLLIN | EPOLLERR | EPOLLET;
   ev.data.ptr = &interrupter_;
-  epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, interrupter_.read_descriptor(), &ev);
+  epoll_ctl(epoll_fds_[shard], EPOLL_CTL_MOD,
+      interrupter_.read_descriptor(), &ev);
+}
+
+void epoll_reactor::nest_shard(std::size_t outer, std::size_t inner)
+{
+  // The nested instance is level-triggered so that the outer instance keeps
+  // reporting it until its events have been dispatched.
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN;
+  ev.data.ptr = &epoll_fds_;
+  epoll_ctl(epoll_fds_[outer], EPOLL_CTL_ADD, epoll_fds_[inner], &ev);
+}
+
+void epoll_reactor::unnest_shard(std::size_t outer, std::size_t inner)
+{
+  epoll_event ev = { 0, { 0 } };
+  epoll_ctl(epoll_fds_[outer], EPOLL_CTL_DEL, epoll_fds_[inner], &ev);
+}
+
+void epoll_reactor::create_epoll_fds()
+{
+  // Each epoll instance has its own registration of the interrupter, so that
+  // instances may be interrupted separately.
+  epoll_event ev = { 0, { 0 } };
+  for (std::size_t i = 0; i < epoll_fds_.size(); ++i)
+  {
+    epoll_fds_[i] = do_epoll_create();
+
+    // Add the interrupter's descriptor to epoll.
+    ev.events = EPOLLIN | EPOLLERR | EPOLLET;
+    ev.data.ptr = &interrupter_;
+    epoll_ctl(epoll_fds_[i], EPOLL_CTL_ADD,
+        interrupter_.read_descriptor(), &ev);
+  }
+  interrupter_.interrupt();
+
+  // Add the timer descriptor to epoll.
+  if (timer_fd_ != -1)
+  {
+    ev.events = EPOLLIN | EPOLLERR;
+    ev.data.ptr = &timer_fd_;
+    epoll_ctl(epoll_fds_[0], EPOLL_CTL_ADD, timer_fd_, &ev);
+  }
 }
 
 int epoll_reactor::do_epoll_create()
@@ -0,0 +1,133 @@
+//
+// detail/impl/handler_statistics.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_HANDLER_STATISTICS_IPP
+#define BOOST_ASIO_DETAIL_IMPL_HANDLER_STATISTICS_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstring>
+#include <boost/asio/detail/handler_statistics.hpp>
+
+#if defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+# if defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+#  include <boost/asio/detail/socket_types.hpp>
+# else // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+#  include <time.h>
+# endif // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+#endif // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+#if defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+
+void handler_statistics::read(handler_statistics_values& values) const
+{
+  std::memset(&values, 0, sizeof(values));
+  for (std::size_t i = 0; i < num_slots; ++i)
+  {
+    const slot& s = slots_[i];
+    values.handlers_queued += s.queued.load();
+    values.handlers_executed += s.executed.load();
+    values.handler_usec += s.handler_usec.load();
+    uint64_t max_handler_usec = s.max_handler_usec.load();
+    if (max_handler_usec > values.max_handler_usec)
+      values.max_handler_usec = max_handler_usec;
+    values.reactor_waits += s.reactor_waits.load();
+    values.reactor_wait_usec += s.reactor_wait_usec.load();
+    for (std::size_t b = 0; b < histogram_buckets; ++b)
+      values.histogram[b] += s.histogram[b].load();
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+    for (std::size_t t = 0; t < operation_types; ++t)
+    {
+      values.operations_completed[t] += s.operations_completed[t].load();
+      values.operation_usec[t] += s.operation_usec[t].load();
+      for (std::size_t b = 0; b < histogram_buckets; ++b)
+        values.operation_histogram[t][b] += s.operation_histogram[t][b].load();
+    }
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+  }
+}
+
+uint64_t handler_statistics::now_usec()
+{
+#if defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+  static LARGE_INTEGER frequency;
+  if (frequency.QuadPart == 0)
+    ::QueryPerformanceFrequency(&frequency);
+  LARGE_INTEGER counter;
+  ::QueryPerformanceCounter(&counter);
+  return static_cast<uint64_t>(counter.QuadPart / frequency.QuadPart) * 1000000
+    + static_cast<uint64_t>(counter.QuadPart % frequency.QuadPart) * 1000000
+      / static_cast<uint64_t>(frequency.QuadPart);
+#else // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+  timespec ts;
+# if defined(CLOCK_MONOTONIC)
+  ::clock_gettime(CLOCK_MONOTONIC, &ts);
+# else // defined(CLOCK_MONOTONIC)
+  ::clock_gettime(CLOCK_REALTIME, &ts);
+# endif // defined(CLOCK_MONOTONIC)
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000
+    + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+#endif // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+}
+
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
+handler_statistics::operation_type handler_statistics::operation_type_of(
+    const char* object_type, const char* op_name)
+{
+  if (std::strcmp(object_type, "io_service") == 0)
+    return posted_handler;
+  if (std::strcmp(object_type, "strand") == 0)
+    return strand_handler;
+  if (std::strcmp(object_type, "deadline_timer") == 0)
+    return timer_operation;
+  if (std::strcmp(object_type, "descriptor") == 0)
+    return descriptor_operation;
+  if (std::strcmp(object_type, "socket") == 0)
+  {
+    if (std::strncmp(op_name, "async_receive", 13) == 0)
+      return socket_receive_operation;
+    if (std::strncmp(op_name, "async_send", 10) == 0)
+      return socket_send_operation;
+    if (std::strcmp(op_name, "async_accept") == 0)
+      return socket_accept_operation;
+    if (std::strcmp(op_name, "async_connect") == 0)
+      return socket_connect_operation;
+  }
+  return other_operation;
+}
+
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
+#else // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+
+void handler_statistics::read(handler_statistics_values& values) const
+{
+  std::memset(&values, 0, sizeof(values));
+}
+
+#endif // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_IMPL_HANDLER_STATISTICS_IPP
@@ -0,0 +1,913 @@
+//
+// detail/impl/io_uring_reactor.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_IO_URING_REACTOR_IPP
+#define BOOST_ASIO_DETAIL_IMPL_IO_URING_REACTOR_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <cstddef>
+#include <cstring>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
+#include <boost/asio/detail/io_uring_ops.hpp>
+#include <boost/asio/detail/io_uring_reactor.hpp>
+#include <boost/asio/detail/throw_error.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+io_uring_reactor::io_uring_reactor(boost::asio::io_service& io_service)
+  : boost::asio::detail::service_base<io_uring_reactor>(io_service),
+    io_service_(use_service<io_service_impl>(io_service)),
+    mutex_(),
+    interrupter_(),
+    ring_(do_io_uring_setup()),
+    timer_fd_(do_timerfd_create()),
+    shutdown_(false),
+    submission_mutex_(),
+    waiting_(false)
+{
+  if (timer_fd_ == -1)
+  {
+    boost::system::error_code ec(errno,
+        boost::asio::error::get_system_category());
+    do_io_uring_teardown(ring_);
+    boost::asio::detail::throw_error(ec, "timerfd");
+  }
+
+  // Wait for the interrupter and timer descriptors to become readable.
+  mutex::scoped_lock lock(submission_mutex_);
+  submit_internal_poll(interrupter_.read_descriptor(), &interrupter_);
+  submit_internal_poll(timer_fd_, &timer_fd_);
+  lock.unlock();
+
+  interrupter_.interrupt();
+}
+
+io_uring_reactor::~io_uring_reactor()
+{
+  do_io_uring_teardown(ring_);
+  if (timer_fd_ != -1)
+    close(timer_fd_);
+}
+
+void io_uring_reactor::shutdown_service()
+{
+  mutex::scoped_lock lock(mutex_);
+  shutdown_ = true;
+  lock.unlock();
+
+  op_queue<operation> ops;
+
+  // The kernel may still be using the memory owned by operations that were
+  // submitted directly, so they cannot be destroyed until their submissions
+  // have completed.
+  std::size_t pending = 0;
+  for (descriptor_state* state = registered_descriptors_.first();
+      state != 0; state = state->next_)
+  {
+    mutex::scoped_lock descriptor_lock(state->mutex_);
+    cancel_submissions(state, ops);
+    pending += state->pending_submissions_;
+  }
+
+  mutex::scoped_lock submission_lock(submission_mutex_);
+  submit_pending();
+  submission_lock.unlock();
+
+  while (pending > 0)
+  {
+    int result = io_uring_ops::enter(ring_.fd, 0, 1, IORING_ENTER_GETEVENTS);
+    if (result < 0 && errno != EINTR)
+      break;
+
+    unsigned head = *ring_.cq_head;
+    unsigned tail = __atomic_load_n(ring_.cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+      uint64_t user_data = ring_.cqes[head & ring_.cq_mask].user_data;
+      void* ptr = io_uring_ops::user_data_ptr(user_data);
+      if (ptr != 0 && ptr != &interrupter_ && ptr != &timer_fd_)
+      {
+        descriptor_state* state = static_cast<descriptor_state*>(ptr);
+        --state->pending_submissions_;
+        --pending;
+      }
+    }
+    __atomic_store_n(ring_.cq_head, head, __ATOMIC_RELEASE);
+  }
+
+  while (descriptor_state* state = registered_descriptors_.first())
+  {
+    for (int i = 0; i < max_ops; ++i)
+      ops.push(state->op_queue_[i]);
+    state->shutdown_ = true;
+    registered_descriptors_.free(state);
+  }
+
+  timer_queues_.get_all_timers(ops);
+
+  io_service_.abandon_operations(ops);
+}
+
+void io_uring_reactor::fork_service(
+    boost::asio::io_service::fork_event fork_ev)
+{
+  if (fork_ev == boost::asio::io_service::fork_child)
+  {
+    // Submissions made by the parent are not inherited by the child, so
+    // create a new ring and submit everything again.
+    do_io_uring_teardown(ring_);
+    ring_ = do_io_uring_setup();
+
+    if (timer_fd_ != -1)
+      ::close(timer_fd_);
+    timer_fd_ = -1;
+    timer_fd_ = do_timerfd_create();
+
+    interrupter_.recreate();
+
+    mutex::scoped_lock submission_lock(submission_mutex_);
+    submit_internal_poll(interrupter_.read_descriptor(), &interrupter_);
+    if (timer_fd_ != -1)
+      submit_internal_poll(timer_fd_, &timer_fd_);
+    submission_lock.unlock();
+
+    interrupter_.interrupt();
+
+    update_timeout();
+
+    // Resubmit operations for all registered descriptors.
+    op_queue<operation> ops;
+    mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+    descriptor_state* state = registered_descriptors_.first();
+    while (state != 0)
+    {
+      descriptor_state* next_state = state->next_;
+      mutex::scoped_lock descriptor_lock(state->mutex_);
+      state->pending_submissions_ = 0;
+      for (int j = 0; j < max_ops; ++j)
+        state->submitted_[j] = descriptor_state::no_submission;
+
+      if (state->shutdown_)
+      {
+        // The descriptor was deregistered while its submissions were in
+        // flight. They will never complete in this process.
+        for (int j = 0; j < max_ops; ++j)
+        {
+          while (reactor_op* op = state->op_queue_[j].front())
+          {
+            op->ec_ = boost::asio::error::operation_aborted;
+            state->op_queue_[j].pop();
+            ops.push(op);
+          }
+        }
+        descriptor_lock.unlock();
+        registered_descriptors_.free(state);
+      }
+      else
+      {
+        for (int j = 0; j < max_ops; ++j)
+        {
+          if (!state->op_queue_[j].empty()
+              && (state->ready_mask_ & (1u << j)) == 0)
+          {
+            submit_op(state, j, j != read_op
+                || state->op_queue_[except_op].empty());
+          }
+        }
+      }
+
+      state = next_state;
+    }
+    descriptors_lock.unlock();
+
+    io_service_.post_deferred_completions(ops);
+  }
+}
+
+void io_uring_reactor::init_task()
+{
+  io_service_.init_task();
+}
+
+int io_uring_reactor::register_descriptor(socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data)
+{
+  descriptor_data = allocate_descriptor_state();
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  descriptor_data->reactor_ = this;
+  descriptor_data->descriptor_ = descriptor;
+  descriptor_data->shutdown_ = false;
+
+  return 0;
+}
+
+int io_uring_reactor::register_internal_descriptor(
+    int op_type, socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data, reactor_op* op)
+{
+  descriptor_data = allocate_descriptor_state();
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  descriptor_data->reactor_ = this;
+  descriptor_data->descriptor_ = descriptor;
+  descriptor_data->shutdown_ = false;
+  descriptor_data->op_queue_[op_type].push(op);
+  submit_op(descriptor_data, op_type, false);
+
+  return 0;
+}
+
+void io_uring_reactor::move_descriptor(socket_type,
+    io_uring_reactor::per_descriptor_data& target_descriptor_data,
+    io_uring_reactor::per_descriptor_data& source_descriptor_data)
+{
+  target_descriptor_data = source_descriptor_data;
+  source_descriptor_data = 0;
+}
+
+void io_uring_reactor::start_op(int op_type, socket_type,
+    io_uring_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
+    bool is_continuation, bool allow_speculative)
+{
+  if (!descriptor_data)
+  {
+    op->ec_ = boost::asio::error::bad_descriptor;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (descriptor_data->shutdown_)
+  {
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  if (descriptor_data->op_queue_[op_type].empty())
+  {
+    if (allow_speculative
+        && (op_type != read_op
+          || descriptor_data->op_queue_[except_op].empty()))
+    {
+      if (op->perform())
+      {
+        descriptor_lock.unlock();
+        io_service_.post_immediate_completion(op, is_continuation);
+        return;
+      }
+    }
+  }
+
+  descriptor_data->op_queue_[op_type].push(op);
+  io_service_.work_started();
+
+  // If a submission is already in flight, or a completed one is waiting to be
+  // processed, the operation will be submitted once it reaches the front of
+  // the queue.
+  if (descriptor_data->submitted_[op_type] == descriptor_state::no_submission
+      && (descriptor_data->ready_mask_ & (1u << op_type)) == 0)
+  {
+    submit_op(descriptor_data, op_type, op_type != read_op
+        || descriptor_data->op_queue_[except_op].empty());
+  }
+}
+
+void io_uring_reactor::cancel_ops(socket_type,
+    io_uring_reactor::per_descriptor_data& descriptor_data)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  cancel_submissions(descriptor_data, ops);
+
+  descriptor_lock.unlock();
+
+  io_service_.post_deferred_completions(ops);
+}
+
+void io_uring_reactor::deregister_descriptor(socket_type,
+    io_uring_reactor::per_descriptor_data& descriptor_data, bool)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (!descriptor_data->shutdown_)
+  {
+    // There is no registration to remove. The descriptor state stays
+    // allocated until the kernel has finished with any cancelled submissions.
+    op_queue<operation> ops;
+    cancel_submissions(descriptor_data, ops);
+
+    descriptor_data->descriptor_ = -1;
+    descriptor_data->ready_mask_ = 0;
+    descriptor_data->shutdown_ = true;
+    bool unused = (descriptor_data->pending_submissions_ == 0);
+
+    descriptor_lock.unlock();
+
+    if (unused)
+      free_descriptor_state(descriptor_data);
+    descriptor_data = 0;
+
+    io_service_.post_deferred_completions(ops);
+  }
+}
+
+void io_uring_reactor::deregister_internal_descriptor(socket_type,
+    io_uring_reactor::per_descriptor_data& descriptor_data)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (!descriptor_data->shutdown_)
+  {
+    op_queue<operation> ops;
+    cancel_submissions(descriptor_data, ops);
+
+    descriptor_data->descriptor_ = -1;
+    descriptor_data->ready_mask_ = 0;
+    descriptor_data->shutdown_ = true;
+    bool unused = (descriptor_data->pending_submissions_ == 0);
+
+    descriptor_lock.unlock();
+
+    if (unused)
+      free_descriptor_state(descriptor_data);
+    descriptor_data = 0;
+  }
+}
+
+void io_uring_reactor::run(bool block, op_queue<operation>& ops)
+{
+  // This code relies on the fact that the task_io_service queues the reactor
+  // task behind all descriptor operations generated by this function. This
+  // means, that by the time we reach this point, any previously returned
+  // descriptor operations have already been dequeued. Therefore it is now safe
+  // for us to reuse and return them for the task_io_service to queue again.
+
+  // Pass any batched submissions to the kernel. While we are blocked, other
+  // threads must submit their own work.
+  mutex::scoped_lock submission_lock(submission_mutex_);
+  unsigned to_submit = *ring_.sq_tail
+    - __atomic_load_n(ring_.sq_head, __ATOMIC_ACQUIRE);
+  waiting_ = block;
+  submission_lock.unlock();
+
+  if (block)
+  {
+    io_uring_ops::enter(ring_.fd, to_submit, 1, IORING_ENTER_GETEVENTS);
+
+    submission_lock.lock();
+    waiting_ = false;
+    submission_lock.unlock();
+  }
+  else if (to_submit > 0)
+  {
+    io_uring_ops::enter(ring_.fd, to_submit, 0, 0);
+  }
+
+  bool check_timers = false;
+  reap_completions(ops, check_timers);
+
+  if (check_timers)
+  {
+    mutex::scoped_lock common_lock(mutex_);
+    timer_queues_.get_ready_timers(ops);
+
+    itimerspec new_timeout;
+    itimerspec old_timeout;
+    int flags = get_timeout(new_timeout);
+    timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
+    common_lock.unlock();
+
+    submission_lock.lock();
+    submit_internal_poll(timer_fd_, &timer_fd_);
+  }
+}
+
+void io_uring_reactor::interrupt()
+{
+  interrupter_.interrupt();
+}
+
+io_uring_reactor::ring io_uring_reactor::do_io_uring_setup()
+{
+  ring r;
+  std::memset(&r, 0, sizeof(r));
+
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  r.fd = io_uring_ops::setup(ring_size, params);
+
+  if (r.fd != -1)
+  {
+    r.sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    r.cq_ring_size = params.cq_off.cqes
+      + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+      if (r.cq_ring_size > r.sq_ring_size)
+        r.sq_ring_size = r.cq_ring_size;
+      r.cq_ring_size = 0;
+    }
+
+    r.sq_ring = ::mmap(0, r.sq_ring_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, r.fd, IORING_OFF_SQ_RING);
+    if (r.sq_ring == MAP_FAILED)
+      r.sq_ring = 0;
+
+    if (r.sq_ring && r.cq_ring_size)
+    {
+      r.cq_ring = ::mmap(0, r.cq_ring_size, PROT_READ | PROT_WRITE,
+          MAP_SHARED | MAP_POPULATE, r.fd, IORING_OFF_CQ_RING);
+      if (r.cq_ring == MAP_FAILED)
+        r.cq_ring = 0;
+    }
+    else
+      r.cq_ring = r.sq_ring;
+
+    if (r.cq_ring)
+    {
+      r.sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+      void* sqes = ::mmap(0, r.sqes_size, PROT_READ | PROT_WRITE,
+          MAP_SHARED | MAP_POPULATE, r.fd, IORING_OFF_SQES);
+      if (sqes != MAP_FAILED)
+        r.sqes = static_cast<io_uring_sqe*>(sqes);
+    }
+  }
+
+  if (r.sqes == 0)
+  {
+    boost::system::error_code ec(errno,
+        boost::asio::error::get_system_category());
+    do_io_uring_teardown(r);
+    boost::asio::detail::throw_error(ec, "io_uring");
+  }
+
+  char* sq = static_cast<char*>(r.sq_ring);
+  r.sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  r.sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  r.sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  r.sq_entries = *reinterpret_cast<unsigned*>(
+      sq + params.sq_off.ring_entries);
+  r.sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+  char* cq = static_cast<char*>(r.cq_ring);
+  r.cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  r.cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  r.cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  r.cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  // Submission queue entries are always used in ring order.
+  for (unsigned i = 0; i < r.sq_entries; ++i)
+    r.sq_array[i] = i;
+
+  return r;
+}
+
+void io_uring_reactor::do_io_uring_teardown(ring& r)
+{
+  if (r.sqes)
+    ::munmap(r.sqes, r.sqes_size);
+  if (r.cq_ring && r.cq_ring != r.sq_ring)
+    ::munmap(r.cq_ring, r.cq_ring_size);
+  if (r.sq_ring)
+    ::munmap(r.sq_ring, r.sq_ring_size);
+  if (r.fd != -1)
+    ::close(r.fd);
+  std::memset(&r, 0, sizeof(r));
+  r.fd = -1;
+}
+
+int io_uring_reactor::do_timerfd_create()
+{
+#if defined(TFD_CLOEXEC)
+  int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+#else // defined(TFD_CLOEXEC)
+  int fd = -1;
+  errno = EINVAL;
+#endif // defined(TFD_CLOEXEC)
+
+  if (fd == -1 && errno == EINVAL)
+  {
+    fd = timerfd_create(CLOCK_MONOTONIC, 0);
+    if (fd != -1)
+      ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+
+  return fd;
+}
+
+io_uring_sqe& io_uring_reactor::get_sqe()
+{
+  unsigned tail = *ring_.sq_tail;
+  while (tail - __atomic_load_n(ring_.sq_head, __ATOMIC_ACQUIRE)
+      >= ring_.sq_entries)
+  {
+    submit_pending();
+  }
+  return ring_.sqes[tail & ring_.sq_mask];
+}
+
+void io_uring_reactor::submit_pending()
+{
+  unsigned to_submit = *ring_.sq_tail
+    - __atomic_load_n(ring_.sq_head, __ATOMIC_ACQUIRE);
+  if (to_submit > 0)
+    io_uring_ops::enter(ring_.fd, to_submit, 0, 0);
+}
+
+void io_uring_reactor::commit_sqe()
+{
+  __atomic_store_n(ring_.sq_tail, *ring_.sq_tail + 1, __ATOMIC_RELEASE);
+  if (waiting_)
+    submit_pending();
+}
+
+void io_uring_reactor::submit_internal_poll(int descriptor, void* user_data)
+{
+  io_uring_sqe& sqe = get_sqe();
+  io_uring_ops::prep_poll_add(sqe, descriptor, POLLIN);
+  sqe.user_data = io_uring_ops::make_user_data(user_data);
+  commit_sqe();
+}
+
+void io_uring_reactor::submit_op(descriptor_state* s,
+    int op_type, bool allow_direct)
+{
+  mutex::scoped_lock submission_lock(submission_mutex_);
+
+  io_uring_sqe& sqe = get_sqe();
+  reactor_op* op = s->op_queue_[op_type].front();
+  if (allow_direct && op->prepare(sqe))
+  {
+    s->submitted_[op_type] = descriptor_state::direct_submission;
+  }
+  else
+  {
+    static const unsigned flag[max_ops] = { POLLIN, POLLOUT, POLLPRI };
+    io_uring_ops::prep_poll_add(sqe, s->descriptor_, flag[op_type]);
+    s->submitted_[op_type] = descriptor_state::poll_submission;
+  }
+  sqe.user_data = io_uring_ops::make_user_data(s, op_type);
+
+  s->cancelled_[op_type] = false;
+  ++s->pending_submissions_;
+
+  commit_sqe();
+}
+
+void io_uring_reactor::cancel_submissions(
+    descriptor_state* s, op_queue<operation>& ops)
+{
+  mutex::scoped_lock submission_lock(submission_mutex_);
+
+  for (int j = 0; j < max_ops; ++j)
+  {
+    reactor_op* in_flight = 0;
+
+    if (s->ready_mask_ & (1u << j))
+    {
+      // A direct submission has completed but its result has not yet been
+      // processed. Any data it transferred must be reported.
+      if (s->completed_[j] == descriptor_state::direct_submission)
+      {
+        reactor_op* op = s->op_queue_[j].front();
+        s->op_queue_[j].pop();
+        if (!op->complete_submission(s->results_[j]))
+          op->ec_ = boost::asio::error::operation_aborted;
+        ops.push(op);
+      }
+      s->ready_mask_ &= ~(1u << j);
+    }
+    else if (s->submitted_[j] != descriptor_state::no_submission)
+    {
+      // The kernel may still be using an operation that was submitted
+      // directly, so it remains queued until the submission completes.
+      if (s->submitted_[j] == descriptor_state::direct_submission)
+      {
+        in_flight = s->op_queue_[j].front();
+        s->op_queue_[j].pop();
+      }
+
+      if (!s->cancelled_[j])
+      {
+        io_uring_sqe& sqe = get_sqe();
+        io_uring_ops::prep_cancel(sqe, io_uring_ops::make_user_data(s, j));
+        sqe.user_data = 0;
+        commit_sqe();
+        s->cancelled_[j] = true;
+      }
+    }
+
+    while (reactor_op* op = s->op_queue_[j].front())
+    {
+      op->ec_ = boost::asio::error::operation_aborted;
+      s->op_queue_[j].pop();
+      ops.push(op);
+    }
+
+    if (in_flight)
+      s->op_queue_[j].push(in_flight);
+  }
+}
+
+void io_uring_reactor::reap_completions(
+    op_queue<operation>& ops, bool& check_timers)
+{
+  unsigned head = *ring_.cq_head;
+  unsigned tail = __atomic_load_n(ring_.cq_tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head)
+  {
+    const io_uring_cqe& cqe = ring_.cqes[head & ring_.cq_mask];
+    uint64_t user_data = cqe.user_data;
+    int result = cqe.res;
+
+    void* ptr = io_uring_ops::user_data_ptr(user_data);
+    if (ptr == 0)
+    {
+      // Completion of a cancellation request.
+    }
+    else if (ptr == &interrupter_)
+    {
+      interrupter_.reset();
+
+      mutex::scoped_lock submission_lock(submission_mutex_);
+      submit_internal_poll(interrupter_.read_descriptor(), &interrupter_);
+    }
+    else if (ptr == &timer_fd_)
+    {
+      check_timers = true;
+    }
+    else
+    {
+      descriptor_state* s = static_cast<descriptor_state*>(ptr);
+      int op_type = static_cast<int>(user_data & io_uring_ops::op_type_mask);
+
+      mutex::scoped_lock descriptor_lock(s->mutex_);
+
+      --s->pending_submissions_;
+      descriptor_state::submission_type kind = s->submitted_[op_type];
+      s->submitted_[op_type] = descriptor_state::no_submission;
+
+      if (s->shutdown_)
+      {
+        // The descriptor has been deregistered. An operation that was
+        // submitted directly can now be completed.
+        if (kind == descriptor_state::direct_submission)
+        {
+          reactor_op* op = s->op_queue_[op_type].front();
+          s->op_queue_[op_type].pop();
+          if (!op->complete_submission(result))
+            op->ec_ = boost::asio::error::operation_aborted;
+          ops.push(op);
+        }
+
+        bool unused = (s->pending_submissions_ == 0);
+        descriptor_lock.unlock();
+        if (unused)
+          free_descriptor_state(s);
+      }
+      else
+      {
+        // The descriptor operation doesn't count as work in and of itself, so
+        // we don't call work_started() here. This still allows the io_service
+        // to stop if the only remaining operations are descriptor operations.
+        s->completed_[op_type] = kind;
+        s->results_[op_type] = result;
+        s->ready_mask_ |= (1u << op_type);
+        if (!s->queued_)
+        {
+          s->queued_ = true;
+          ops.push(s);
+        }
+      }
+    }
+  }
+  __atomic_store_n(ring_.cq_head, head, __ATOMIC_RELEASE);
+}
+
+io_uring_reactor::descriptor_state*
+io_uring_reactor::allocate_descriptor_state()
+{
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  return registered_descriptors_.alloc();
+}
+
+void io_uring_reactor::free_descriptor_state(
+    io_uring_reactor::descriptor_state* s)
+{
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  registered_descriptors_.free(s);
+}
+
+void io_uring_reactor::do_add_timer_queue(timer_queue_base& queue)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.insert(&queue);
+}
+
+void io_uring_reactor::do_remove_timer_queue(timer_queue_base& queue)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.erase(&queue);
+}
+
+void io_uring_reactor::update_timeout()
+{
+  itimerspec new_timeout;
+  itimerspec old_timeout;
+  int flags = get_timeout(new_timeout);
+  timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
+}
+
+int io_uring_reactor::get_timeout(itimerspec& ts)
+{
+  ts.it_interval.tv_sec = 0;
+  ts.it_interval.tv_nsec = 0;
+
+  long usec = timer_queues_.wait_duration_usec(5 * 60 * 1000 * 1000);
+  ts.it_value.tv_sec = usec / 1000000;
+  ts.it_value.tv_nsec = usec ? (usec % 1000000) * 1000 : 1;
+
+  return usec ? 0 : TFD_TIMER_ABSTIME;
+}
+
+struct io_uring_reactor::perform_io_cleanup_on_block_exit
+{
+  explicit perform_io_cleanup_on_block_exit(io_uring_reactor* r)
+    : reactor_(r), first_op_(0)
+  {
+  }
+
+  ~perform_io_cleanup_on_block_exit()
+  {
+    if (first_op_)
+    {
+      // Post the remaining completed operations for invocation.
+      if (!ops_.empty())
+        reactor_->io_service_.post_deferred_completions(ops_);
+
+      // A user-initiated operation has completed, but there's no need to
+      // explicitly call work_finished() here. Instead, we'll take advantage of
+      // the fact that the task_io_service will call work_finished() once we
+      // return.
+    }
+    else
+    {
+      // No user-initiated operations have completed, so we need to compensate
+      // for the work_finished() call that the task_io_service will make once
+      // this operation returns.
+      reactor_->io_service_.work_started();
+    }
+  }
+
+  io_uring_reactor* reactor_;
+  op_queue<operation> ops_;
+  operation* first_op_;
+};
+
+io_uring_reactor::descriptor_state::descriptor_state()
+  : operation(&io_uring_reactor::descriptor_state::do_complete),
+    reactor_(0),
+    descriptor_(-1),
+    ready_mask_(0),
+    pending_submissions_(0),
+    queued_(false),
+    shutdown_(false)
+{
+  for (int j = 0; j < max_ops; ++j)
+  {
+    submitted_[j] = no_submission;
+    completed_[j] = no_submission;
+    results_[j] = 0;
+    cancelled_[j] = false;
+  }
+}
+
+operation* io_uring_reactor::descriptor_state::perform_io()
+{
+  mutex_.lock();
+  perform_io_cleanup_on_block_exit io_cleanup(reactor_);
+  mutex::scoped_lock descriptor_lock(mutex_, mutex::scoped_lock::adopt_lock);
+
+  queued_ = false;
+  unsigned int ready = ready_mask_;
+  ready_mask_ = 0;
+
+  if (!shutdown_)
+  {
+    // Exception operations must be processed first to ensure that any
+    // out-of-band data is read before normal data.
+    for (int j = max_ops - 1; j >= 0; --j)
+    {
+      if ((ready & (1u << j)) == 0)
+        continue;
+
+      if (completed_[j] == direct_submission)
+      {
+        // The kernel has performed the operation at the front of the queue.
+        reactor_op* op = op_queue_[j].front();
+        bool finished = op->complete_submission(results_[j]);
+        if (!finished && cancelled_[j])
+        {
+          op->ec_ = boost::asio::error::operation_aborted;
+          finished = true;
+        }
+
+        if (finished)
+        {
+          op_queue_[j].pop();
+          io_cleanup.ops_.push(op);
+        }
+      }
+      else
+      {
+        // The descriptor is ready, so perform operations until one would
+        // block.
+        while (reactor_op* op = op_queue_[j].front())
+        {
+          if (op->perform())
+          {
+            op_queue_[j].pop();
+            io_cleanup.ops_.push(op);
+          }
+          else
+            break;
+        }
+      }
+    }
+
+    // Submit the operations that are still waiting.
+    for (int j = 0; j < max_ops; ++j)
+    {
+      if (submitted_[j] == no_submission && !op_queue_[j].empty())
+      {
+        reactor_->submit_op(this, j,
+            j != read_op || op_queue_[except_op].empty());
+      }
+    }
+  }
+
+  // The first operation will be returned for completion now. The others will
+  // be posted for later by the io_cleanup object's destructor.
+  io_cleanup.first_op_ = io_cleanup.ops_.front();
+  io_cleanup.ops_.pop();
+  return io_cleanup.first_op_;
+}
+
+void io_uring_reactor::descriptor_state::do_complete(
+    io_service_impl* owner, operation* base,
+    const boost::system::error_code& ec, std::size_t)
+{
+  if (owner)
+  {
+    descriptor_state* descriptor_data = static_cast<descriptor_state*>(base);
+    if (operation* op = descriptor_data->perform_io())
+    {
+      op->complete(*owner, ec, 0);
+    }
+  }
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IMPL_IO_URING_REACTOR_IPP
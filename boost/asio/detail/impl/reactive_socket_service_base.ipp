@@ -44,6 +44,9 @@ void reactive_socket_service_base::construct(
 {
   impl.socket_ = invalid_socket;
   impl.state_ = 0;
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  impl.sendfile_op_ = 0;
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
 }
 
 void reactive_socket_service_base::base_move_construct(
@@ -58,6 +61,12 @@ void reactive_socket_service_base::base_move_construct(
 
   reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  mutex::scoped_lock lock(sendfile_mutex_);
+  reactive_socket_sendfile_op_base::move_link(
+      impl.sendfile_op_, other_impl.sendfile_op_);
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
 }
 
 void reactive_socket_service_base::base_move_assign(
@@ -75,11 +84,24 @@ void reactive_socket_service_base::base_move_assign(
 
   other_service.reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  mutex::scoped_lock lock(other_service.sendfile_mutex_);
+  reactive_socket_sendfile_op_base::move_link(
+      impl.sendfile_op_, other_impl.sendfile_op_);
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
 }
 
 void reactive_socket_service_base::destroy(
     reactive_socket_service_base::base_implementation_type& impl)
 {
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  {
+    mutex::scoped_lock lock(sendfile_mutex_);
+    reactive_socket_sendfile_op_base::cancel(impl.sendfile_op_, true);
+  }
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
   if (impl.socket_ != invalid_socket)
   {
     BOOST_ASIO_HANDLER_OPERATION(("socket", &impl, "close"));
@@ -96,6 +118,13 @@ boost::system::error_code reactive_socket_service_base::close(
     reactive_socket_service_base::base_implementation_type& impl,
     boost::system::error_code& ec)
 {
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  {
+    mutex::scoped_lock lock(sendfile_mutex_);
+    reactive_socket_sendfile_op_base::cancel(impl.sendfile_op_, true);
+  }
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
   if (is_open(impl))
   {
     BOOST_ASIO_HANDLER_OPERATION(("socket", &impl, "close"));
@@ -131,6 +160,13 @@ boost::system::error_code reactive_socket_service_base::cancel(
 
   BOOST_ASIO_HANDLER_OPERATION(("socket", &impl, "cancel"));
 
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  {
+    mutex::scoped_lock lock(sendfile_mutex_);
+    reactive_socket_sendfile_op_base::cancel(impl.sendfile_op_, false);
+  }
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
   reactor_.cancel_ops(impl.socket_, impl.reactor_data_);
   ec = boost::system::error_code();
   return ec;
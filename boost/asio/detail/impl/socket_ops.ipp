@@ -27,6 +27,10 @@
 #include <boost/asio/detail/socket_ops.hpp>
 #include <boost/asio/error.hpp>
 
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+# include <sys/sendfile.h>
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
 #if defined(BOOST_ASIO_WINDOWS_RUNTIME)
 # include <codecvt>
 # include <locale>
@@ -722,6 +726,11 @@ inline void init_msghdr_msg_name(T& name, const socket_addr_type* addr)
   name = reinterpret_cast<T>(const_cast<socket_addr_type*>(addr));
 }
 
+#if defined(BOOST_ASIO_HAS_MMSG)
+// The maximum number of datagrams transferred by one recvmmsg or sendmmsg.
+enum { max_mmsg_count = 64 };
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
 signed_size_type recv(socket_type s, buf* bufs, size_t count,
     int flags, boost::system::error_code& ec)
 {
@@ -1105,6 +1114,97 @@ bool non_blocking_recvmsg(socket_type s,
 
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
+signed_size_type recvmmsg(socket_type s, buf* bufs, size_t count,
+    int flags, socket_addr_type* const* addrs, std::size_t* addrlens,
+    std::size_t* sizes, boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_HAS_MMSG)
+  clear_last_error();
+  mmsghdr msgs[max_mmsg_count];
+  if (count > max_mmsg_count)
+    count = max_mmsg_count;
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs[i] = mmsghdr();
+    if (addrs)
+    {
+      init_msghdr_msg_name(msgs[i].msg_hdr.msg_name, addrs[i]);
+      msgs[i].msg_hdr.msg_namelen = static_cast<int>(addrlens[i]);
+    }
+    msgs[i].msg_hdr.msg_iov = &bufs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  signed_size_type result = error_wrapper(::recvmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags | MSG_WAITFORONE, 0), ec);
+  if (result >= 0)
+  {
+    ec = boost::system::error_code();
+    for (signed_size_type i = 0; i < result; ++i)
+    {
+      sizes[i] = msgs[i].msg_len;
+      if (addrs)
+        addrlens[i] = msgs[i].msg_hdr.msg_namelen;
+    }
+  }
+  return result;
+#else // defined(BOOST_ASIO_HAS_MMSG)
+  // Receive one datagram at a time until there are no more to be had.
+  size_t i = 0;
+  for (; i < count; ++i)
+  {
+    std::size_t addrlen = addrs ? addrlens[i] : 0;
+    signed_size_type bytes = socket_ops::recvfrom(s, &bufs[i], 1, flags,
+        addrs ? addrs[i] : 0, &addrlen, ec);
+    if (bytes < 0)
+      break;
+    sizes[i] = bytes;
+    if (addrs)
+      addrlens[i] = addrlen;
+  }
+  if (i == 0 && count > 0)
+    return socket_error_retval;
+  ec = boost::system::error_code();
+  return i;
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+}
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+bool non_blocking_recvmmsg(socket_type s,
+    buf* bufs, size_t count, int flags,
+    socket_addr_type* const* addrs, std::size_t* addrlens,
+    std::size_t* sizes, boost::system::error_code& ec, size_t& messages)
+{
+  for (;;)
+  {
+    // Read some datagrams.
+    signed_size_type result = socket_ops::recvmmsg(
+        s, bufs, count, flags, addrs, addrlens, sizes, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (result >= 0)
+    {
+      ec = boost::system::error_code();
+      messages = result;
+    }
+    else
+      messages = 0;
+
+    return true;
+  }
+}
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
 signed_size_type send(socket_type s, const buf* bufs, size_t count,
     int flags, boost::system::error_code& ec)
 {
@@ -1337,6 +1437,241 @@ bool non_blocking_sendto(socket_type s,
 
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
+signed_size_type sendmmsg(socket_type s, const buf* bufs, size_t count,
+    int flags, const socket_addr_type* const* addrs,
+    const std::size_t* addrlens, boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_HAS_MMSG)
+  clear_last_error();
+  mmsghdr msgs[max_mmsg_count];
+  if (count > max_mmsg_count)
+    count = max_mmsg_count;
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs[i] = mmsghdr();
+    if (addrs)
+    {
+      init_msghdr_msg_name(msgs[i].msg_hdr.msg_name, addrs[i]);
+      msgs[i].msg_hdr.msg_namelen = static_cast<int>(addrlens[i]);
+    }
+    msgs[i].msg_hdr.msg_iov = const_cast<buf*>(&bufs[i]);
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  signed_size_type result = error_wrapper(::sendmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags | MSG_NOSIGNAL), ec);
+  if (result >= 0)
+    ec = boost::system::error_code();
+  return result;
+#else // defined(BOOST_ASIO_HAS_MMSG)
+  // Send one datagram at a time until the socket's buffer is full.
+  size_t i = 0;
+  for (; i < count; ++i)
+  {
+    signed_size_type bytes = addrs
+      ? socket_ops::sendto(s, &bufs[i], 1, flags, addrs[i], addrlens[i], ec)
+      : socket_ops::send(s, &bufs[i], 1, flags, ec);
+    if (bytes < 0)
+      break;
+  }
+  if (i == 0 && count > 0)
+    return socket_error_retval;
+  ec = boost::system::error_code();
+  return i;
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+}
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+bool non_blocking_sendmmsg(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* const* addrs, const std::size_t* addrlens,
+    boost::system::error_code& ec, size_t& messages)
+{
+  for (;;)
+  {
+    // Write some datagrams.
+    signed_size_type result = socket_ops::sendmmsg(
+        s, bufs, count, flags, addrs, addrlens, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (result >= 0)
+    {
+      ec = boost::system::error_code();
+      messages = result;
+    }
+    else
+      messages = 0;
+
+    return true;
+  }
+}
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+signed_size_type sendfile(socket_type s, int fd,
+    uint64_t& offset, std::size_t size, sendfile_buffer& pending,
+    boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+  (void)pending;
+  clear_last_error();
+  off_t off = static_cast<off_t>(offset);
+  signed_size_type result = error_wrapper(
+      ::sendfile(s, fd, &off, size), ec);
+  if (result < 0 && (ec == boost::asio::error::invalid_argument
+        || ec.value() == ESPIPE))
+  {
+    // The source does not support sendfile, as is the case for a pipe. Move
+    // the data from it using splice instead. The offset does not apply.
+    clear_last_error();
+    result = error_wrapper(::splice(fd, 0, s, 0, size,
+          SPLICE_F_MOVE | SPLICE_F_NONBLOCK), ec);
+  }
+  if (result >= 0)
+  {
+    ec = boost::system::error_code();
+    offset += result;
+  }
+  return result;
+#else // defined(BOOST_ASIO_HAS_SENDFILE)
+  // Copy the data through the buffer. Whatever the socket does not take is
+  // kept for the next call, so the offset tracks the data read rather than
+  // the data sent.
+  if (pending.begin == pending.end)
+  {
+    if (size > sizeof(pending.data))
+      size = sizeof(pending.data);
+    clear_last_error();
+    signed_size_type bytes = error_wrapper(::pread(fd, pending.data, size,
+          static_cast<off_t>(offset)), ec);
+    if (bytes < 0 && ec.value() == ESPIPE)
+    {
+      // The source is a pipe, which is read from its current position. It
+      // may be in blocking mode, so check that there is something to read
+      // first.
+      pollfd fds;
+      fds.fd = fd;
+      fds.events = POLLIN;
+      fds.revents = 0;
+      clear_last_error();
+      bytes = error_wrapper(::poll(&fds, 1, 0), ec);
+      if (bytes == 0)
+      {
+        ec = boost::asio::error::would_block;
+        return -1;
+      }
+      if (bytes > 0)
+      {
+        clear_last_error();
+        bytes = error_wrapper(::read(fd, pending.data, size), ec);
+      }
+    }
+    if (bytes <= 0)
+    {
+      if (bytes == 0)
+        ec = boost::system::error_code();
+      return bytes;
+    }
+    offset += bytes;
+    pending.begin = 0;
+    pending.end = static_cast<std::size_t>(bytes);
+  }
+  buf b;
+  init_buf(b, pending.data + pending.begin, pending.end - pending.begin);
+  signed_size_type result = socket_ops::send(s, &b, 1, 0, ec);
+  if (result >= 0)
+    pending.begin += result;
+  return result;
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+}
+
+bool non_blocking_sendfile(socket_type s, int fd,
+    uint64_t& offset, std::size_t& remaining, sendfile_buffer& pending,
+    boost::system::error_code& ec, size_t& bytes_transferred)
+{
+  while (remaining > 0)
+  {
+    // Write some data.
+    signed_size_type bytes = socket_ops::sendfile(
+        s, fd, offset, remaining, pending, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+    {
+      // Either the socket buffer is full or the source is a pipe with no
+      // data in it. Only the socket is waited for by the reactor, so find
+      // out which.
+      pollfd fds[2];
+      fds[0].fd = s;
+      fds[0].events = POLLOUT;
+      fds[0].revents = 0;
+      fds[1].fd = fd;
+      fds[1].events = POLLIN;
+      fds[1].revents = 0;
+      clear_last_error();
+      if (error_wrapper(::poll(fds, 2, 0), ec) < 0)
+        return true;
+
+      // Check if we need to run the operation again.
+      if ((fds[0].revents & POLLOUT) == 0)
+      {
+        ec = boost::asio::error::would_block;
+        return false;
+      }
+
+      // The socket can be written to but there is nothing to send. Finish
+      // with would_block so that the caller waits for the source instead.
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+      if (fds[1].revents == 0)
+#else // defined(BOOST_ASIO_HAS_SENDFILE)
+      if (fds[1].revents == 0 && pending.begin == pending.end)
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+      {
+        ec = boost::asio::error::would_block;
+        return true;
+      }
+
+      // Both have become ready since the failed attempt.
+      continue;
+    }
+
+    // Operation failed.
+    if (bytes < 0)
+      return true;
+
+    // The file ended before all of the data was sent.
+    if (bytes == 0)
+    {
+      ec = boost::asio::error::eof;
+      return true;
+    }
+
+    // Keep sending until the socket buffer is full.
+    bytes_transferred += bytes;
+    remaining -= bytes;
+  }
+
+  ec = boost::system::error_code();
+  return true;
+}
+
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
 socket_type socket(int af, int type, int protocol,
     boost::system::error_code& ec)
 {
@@ -28,6 +28,33 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+
+inline strand_service::strand_impl::strand_impl()
+  : operation(&strand_service::do_complete),
+    service_(0),
+    ref_count_(1),
+    pending_(0),
+    waiting_stack_(0),
+    next_impl_(0),
+    prev_impl_(0)
+{
+}
+
+struct strand_service::on_dispatch_exit
+{
+  io_service_impl* io_service_;
+  strand_impl* impl_;
+
+  ~on_dispatch_exit()
+  {
+    if (strand_service::unlock(impl_, 1))
+      io_service_->post_immediate_completion(impl_, false);
+  }
+};
+
+#else // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+
 inline strand_service::strand_impl::strand_impl()
   : operation(&strand_service::do_complete),
     locked_(false)
@@ -51,6 +78,8 @@ struct strand_service::on_dispatch_exit
   }
 };
 
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+
 template <typename Handler>
 void strand_service::dispatch(strand_service::implementation_type& impl,
     Handler& handler)
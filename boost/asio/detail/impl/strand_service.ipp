@@ -25,6 +25,230 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+
+struct strand_service::on_do_complete_exit
+{
+  io_service_impl* owner_;
+  strand_impl* impl_;
+  std::size_t num_completed_;
+
+  ~on_do_complete_exit()
+  {
+    if (strand_service::unlock(impl_, num_completed_))
+      owner_->post_immediate_completion(impl_, true);
+  }
+};
+
+strand_service::strand_service(boost::asio::io_service& io_service)
+  : boost::asio::detail::service_base<strand_service>(io_service),
+    io_service_(boost::asio::use_service<io_service_impl>(io_service)),
+    mutex_(),
+    impl_list_(0)
+{
+}
+
+strand_service::~strand_service()
+{
+  // Implementations still in the list are referenced only by strand objects
+  // that have not been destroyed yet. Detach them from the service, so that
+  // the last strand object frees its implementation without touching the
+  // service.
+  while (impl_list_)
+  {
+    strand_impl* impl = impl_list_;
+    impl_list_ = impl->next_impl_;
+    impl->service_ = 0;
+    impl->next_impl_ = 0;
+    impl->prev_impl_ = 0;
+  }
+}
+
+void strand_service::shutdown_service()
+{
+  op_queue<operation> ops;
+
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+
+  for (strand_impl* impl = impl_list_; impl; impl = impl->next_impl_)
+  {
+    take_waiting(impl);
+    ops.push(impl->ready_queue_);
+  }
+}
+
+void strand_service::construct(strand_service::implementation_type& impl)
+{
+  impl = new strand_impl;
+  impl->service_ = this;
+
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+
+  impl->next_impl_ = impl_list_;
+  impl->prev_impl_ = 0;
+  if (impl_list_)
+    impl_list_->prev_impl_ = impl;
+  impl_list_ = impl;
+}
+
+void strand_service::copy_construct(strand_service::implementation_type& impl,
+    const strand_service::implementation_type& other_impl)
+{
+  other_impl->ref_count_.fetch_add(1, std::memory_order_relaxed);
+  impl = other_impl;
+}
+
+void strand_service::destroy(strand_service::implementation_type& impl)
+{
+  release(impl);
+  impl = 0;
+}
+
+bool strand_service::do_dispatch(implementation_type& impl, operation* op)
+{
+  // If we are running inside the io_service, and no other handler already
+  // holds the strand lock, then the handler can run immediately.
+  if (io_service_.can_dispatch())
+  {
+    std::size_t expected = 0;
+    if (impl->pending_.compare_exchange_strong(expected, 1,
+          std::memory_order_acq_rel, std::memory_order_relaxed))
+    {
+      // Immediate invocation is allowed.
+      impl->ref_count_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  // If the handler acquires the strand lock then it is responsible for
+  // scheduling the strand.
+  if (push_waiting(impl, op))
+    io_service_.post_immediate_completion(impl, false);
+
+  return false;
+}
+
+void strand_service::do_post(implementation_type& impl,
+    operation* op, bool is_continuation)
+{
+  // If the handler acquires the strand lock then it is responsible for
+  // scheduling the strand.
+  if (push_waiting(impl, op))
+    io_service_.post_immediate_completion(impl, is_continuation);
+}
+
+void strand_service::do_complete(io_service_impl* owner, operation* base,
+    const boost::system::error_code& ec, std::size_t /*bytes_transferred*/)
+{
+  strand_impl* impl = static_cast<strand_impl*>(base);
+
+  if (owner)
+  {
+    // Indicate that this strand is executing on the current thread.
+    call_stack<strand_impl>::context ctx(impl);
+
+    // Ensure the next handler, if any, is scheduled on block exit.
+    on_do_complete_exit on_exit = { owner, impl, 0 };
+
+    // Run all ready handlers, and those that were waiting when the strand was
+    // scheduled. No lock is required since the queues are taken from only
+    // within the strand.
+    take_waiting(impl);
+    while (operation* o = impl->ready_queue_.front())
+    {
+      impl->ready_queue_.pop();
+      ++on_exit.num_completed_;
+      o->complete(*owner, ec, 0);
+    }
+  }
+  else
+  {
+    // The io_service is being destroyed while the strand is scheduled. Any
+    // pending handlers have already been destroyed by shutdown_service.
+    release(impl);
+  }
+}
+
+bool strand_service::push_waiting(implementation_type& impl, operation* op)
+{
+  bool first = impl->pending_.fetch_add(1, std::memory_order_acq_rel) == 0;
+  if (first)
+  {
+    // The strand holds a reference to its implementation while locked, so
+    // that it outlives the strand objects if handlers are still pending.
+    impl->ref_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  operation* head = impl->waiting_stack_.load(std::memory_order_relaxed);
+  do
+  {
+    op_queue_access::next(op, head);
+  } while (!impl->waiting_stack_.compare_exchange_weak(head, op,
+        std::memory_order_release, std::memory_order_relaxed));
+
+  return first;
+}
+
+void strand_service::take_waiting(implementation_type& impl)
+{
+  operation* op = impl->waiting_stack_.exchange(0, std::memory_order_acquire);
+
+  // Reverse the stack so that handlers run in the order they were submitted.
+  operation* reversed = 0;
+  while (op)
+  {
+    operation* next = op_queue_access::next(op);
+    op_queue_access::next(op, reversed);
+    reversed = op;
+    op = next;
+  }
+
+  while (reversed)
+  {
+    operation* next = op_queue_access::next(reversed);
+    impl->ready_queue_.push(reversed);
+    reversed = next;
+  }
+}
+
+bool strand_service::unlock(implementation_type& impl,
+    std::size_t num_completed)
+{
+  std::size_t pending = impl->pending_.fetch_sub(
+      num_completed, std::memory_order_acq_rel) - num_completed;
+  if (pending != 0)
+    return true;
+
+  release(impl);
+  return false;
+}
+
+void strand_service::release(implementation_type& impl)
+{
+  if (impl->ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+  {
+    // The service is null if it has been destroyed before the strand.
+    if (strand_service* service = impl->service_)
+    {
+      boost::asio::detail::mutex::scoped_lock lock(service->mutex_);
+
+      if (service->impl_list_ == impl)
+        service->impl_list_ = impl->next_impl_;
+      if (impl->prev_impl_)
+        impl->prev_impl_->next_impl_ = impl->next_impl_;
+      if (impl->next_impl_)
+        impl->next_impl_->prev_impl_ = impl->prev_impl_;
+    }
+
+    op_queue<operation> ops;
+    take_waiting(impl);
+    ops.push(impl->ready_queue_);
+    delete impl;
+  }
+}
+
+#else // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+
 struct strand_service::on_do_complete_exit
 {
   io_service_impl* owner_;
@@ -85,10 +309,14 @@ void strand_service::construct(strand_service::implementation_type& impl)
   impl = implementations_[index].get();
 }
 
-bool strand_service::running_in_this_thread(
-    const implementation_type& impl) const
+void strand_service::copy_construct(strand_service::implementation_type& impl,
+    const strand_service::implementation_type& other_impl)
+{
+  impl = other_impl;
+}
+
+void strand_service::destroy(strand_service::implementation_type&)
 {
-  return call_stack<strand_impl>::contains(impl) != 0;
 }
 
 bool strand_service::do_dispatch(implementation_type& impl, operation* op)
@@ -169,6 +397,14 @@ void strand_service::do_complete(io_service_impl* owner, operation* base,
   }
 }
 
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+
+bool strand_service::running_in_this_thread(
+    const implementation_type& impl) const
+{
+  return call_stack<strand_impl>::contains(impl) != 0;
+}
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
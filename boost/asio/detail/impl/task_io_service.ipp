@@ -23,6 +23,8 @@
 #include <boost/asio/detail/limits.hpp>
 #include <boost/asio/detail/reactor.hpp>
 #include <boost/asio/detail/task_io_service.hpp>
+#include <boost/asio/detail/task_io_service_reactor_shard.hpp>
+#include <boost/asio/detail/task_io_service_run_queue.hpp>
 #include <boost/asio/detail/task_io_service_thread_info.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -31,6 +33,13 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+handler_statistics& get_handler_statistics(task_io_service& owner)
+{
+  return owner.statistics();
+}
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
 struct task_io_service::task_cleanup
 {
   ~task_cleanup()
@@ -42,6 +51,8 @@ struct task_io_service::task_cleanup
           this_thread_->private_outstanding_work);
     }
     this_thread_->private_outstanding_work = 0;
+    task_io_service_->statistics_.handlers_queued(
+        this_thread_->private_op_queue);
 
     // Enqueue the completed operations and reinsert the task at the end of
     // the operation queue.
@@ -73,10 +84,20 @@ struct task_io_service::work_cleanup
     this_thread_->private_outstanding_work = 0;
 
 #if defined(BOOST_ASIO_HAS_THREADS)
-    if (!this_thread_->private_op_queue.empty())
+    // A thread pinned to a reactor shard keeps its handlers to itself.
+    if (!this_thread_->private_op_queue.empty()
+        && !this_thread_->reactor_shard)
     {
-      lock_->lock();
-      task_io_service_->op_queue_.push(this_thread_->private_op_queue);
+      if (task_io_service_->work_stealing_)
+      {
+        task_io_service_->push_run_queue(
+            *this_thread_, this_thread_->private_op_queue);
+      }
+      else
+      {
+        lock_->lock();
+        task_io_service_->op_queue_.push(this_thread_->private_op_queue);
+      }
     }
 #endif // defined(BOOST_ASIO_HAS_THREADS)
   }
@@ -86,6 +107,31 @@ struct task_io_service::work_cleanup
   thread_info* this_thread_;
 };
 
+struct task_io_service::run_queue_cleanup
+{
+  ~run_queue_cleanup()
+  {
+    task_io_service_->unbind_run_queue(*this_thread_);
+  }
+
+  task_io_service* task_io_service_;
+  thread_info* this_thread_;
+};
+
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+struct task_io_service::reactor_shard_cleanup
+{
+  ~reactor_shard_cleanup()
+  {
+    task_io_service_->unbind_reactor_shard(*this_thread_, outer_thread_);
+  }
+
+  task_io_service* task_io_service_;
+  thread_info* this_thread_;
+  thread_info* outer_thread_;
+};
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
 task_io_service::task_io_service(
     boost::asio::io_service& io_service, std::size_t concurrency_hint)
   : boost::asio::detail::service_base<task_io_service>(io_service),
@@ -96,9 +142,44 @@ task_io_service::task_io_service(
     outstanding_work_(0),
     stopped_(false),
     shutdown_(false),
-    first_idle_thread_(0)
+    first_idle_thread_(0),
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+    work_stealing_(concurrency_hint != 1),
+#else // defined(BOOST_ASIO_HAS_WORK_STEALING)
+    work_stealing_(false),
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+    run_queues_(0),
+    num_run_queues_(0),
+    next_run_queue_(0),
+    idle_thread_count_(0),
+    stopped_flag_(0),
+    reactor_shards_(0),
+    num_reactor_shards_(0),
+    reactor_thread_affinity_(false),
+    next_reactor_shard_(0),
+    next_descriptor_shard_(0),
+    reactor_shard_generation_(0)
 {
   BOOST_ASIO_HANDLER_TRACKING_INIT;
+
+  if (work_stealing_)
+  {
+    // One run queue per expected thread. When the number of threads is not
+    // known, use enough queues that threads rarely have to share. Only the
+    // queues that have been bound to a thread are scanned.
+    const std::size_t unknown_hint = (std::numeric_limits<std::size_t>::max)();
+    num_run_queues_ = (concurrency_hint > 1 && concurrency_hint != unknown_hint)
+      ? concurrency_hint : 16;
+    if (num_run_queues_ > 256)
+      num_run_queues_ = 256;
+    run_queues_ = new task_io_service_run_queue[num_run_queues_];
+  }
+}
+
+task_io_service::~task_io_service()
+{
+  delete[] run_queues_;
+  delete[] reactor_shards_;
 }
 
 void task_io_service::shutdown_service()
@@ -116,6 +197,22 @@ void task_io_service::shutdown_service()
       o->destroy();
   }
 
+  for (std::size_t i = 0; i < num_run_queues_; ++i)
+  {
+    while (operation* o = pop_run_queue(run_queues_[i]))
+      o->destroy();
+  }
+
+  for (std::size_t i = 0; i < num_reactor_shards_; ++i)
+  {
+    task_io_service_reactor_shard& shard = reactor_shards_[i];
+    while (operation* o = shard.ops.front())
+    {
+      shard.ops.pop();
+      o->destroy();
+    }
+  }
+
   // Reset to initial state.
   task_ = 0;
 }
@@ -131,6 +228,49 @@ void task_io_service::init_task()
   }
 }
 
+void task_io_service::create_reactors(
+    std::size_t num_reactors, bool thread_affinity)
+{
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  mutex::scoped_lock lock(mutex_);
+  if (num_reactors > 1 && !reactor_shards_ && !task_ && !shutdown_)
+  {
+    num_reactor_shards_ = num_reactors > 256 ? 256 : num_reactors;
+    reactor_shards_ = new task_io_service_reactor_shard[num_reactor_shards_];
+    for (std::size_t i = 0; i < num_reactor_shards_; ++i)
+      reactor_shards_[i].index = i;
+    reactor_thread_affinity_ = thread_affinity;
+    lock.unlock();
+
+    // Create the reactor now, as it needs to know how many epoll instances to
+    // create. The task is not queued, since each thread runs its own reactor.
+    reactor* task = &use_service<reactor>(this->get_io_service());
+    lock.lock();
+    task_ = task;
+  }
+#else // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  (void)num_reactors;
+  (void)thread_affinity;
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+}
+
+std::size_t task_io_service::choose_reactor()
+{
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  if (reactor_shards_)
+  {
+    if (reactor_thread_affinity_)
+      if (thread_info* this_thread = thread_call_stack::contains(this))
+        if (this_thread->reactor_shard)
+          return this_thread->reactor_shard->index;
+
+    return static_cast<std::size_t>(static_cast<long>(
+          ++next_descriptor_shard_)) % num_reactor_shards_;
+  }
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  return 0;
+}
+
 std::size_t task_io_service::run(boost::system::error_code& ec)
 {
   ec = boost::system::error_code();
@@ -145,8 +285,41 @@ std::size_t task_io_service::run(boost::system::error_code& ec)
   this_thread.wakeup_event = &wakeup_event;
   this_thread.private_outstanding_work = 0;
   this_thread.next = 0;
+  this_thread.run_queue = 0;
+  this_thread.reactor_shard = 0;
+  this_thread.reactor_shard_generation = -1;
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  if (reactor_shards_)
+  {
+    thread_info* outer_thread_info = ctx.next_by_key();
+    if (!bind_reactor_shard(this_thread, outer_thread_info))
+      return 0;
+    reactor_shard_cleanup on_exit = { this, &this_thread, outer_thread_info };
+    (void)on_exit;
+
+    std::size_t n = 0;
+    for (; do_run_one_pinned(this_thread, ec, true); )
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    return n;
+  }
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
+  if (work_stealing_)
+  {
+    bind_run_queue(this_thread);
+    run_queue_cleanup on_exit = { this, &this_thread };
+    (void)on_exit;
+
+    std::size_t n = 0;
+    for (; do_run_one_stealing(this_thread, ec, true); )
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    return n;
+  }
+
   mutex::scoped_lock lock(mutex_);
 
   std::size_t n = 0;
@@ -170,8 +343,33 @@ std::size_t task_io_service::run_one(boost::system::error_code& ec)
   this_thread.wakeup_event = &wakeup_event;
   this_thread.private_outstanding_work = 0;
   this_thread.next = 0;
+  this_thread.run_queue = 0;
+  this_thread.reactor_shard = 0;
+  this_thread.reactor_shard_generation = -1;
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  if (reactor_shards_)
+  {
+    thread_info* outer_thread_info = ctx.next_by_key();
+    if (!bind_reactor_shard(this_thread, outer_thread_info))
+      return 0;
+    reactor_shard_cleanup on_exit = { this, &this_thread, outer_thread_info };
+    (void)on_exit;
+
+    return do_run_one_pinned(this_thread, ec, true);
+  }
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
+  if (work_stealing_)
+  {
+    bind_run_queue(this_thread);
+    run_queue_cleanup on_exit = { this, &this_thread };
+    (void)on_exit;
+
+    return do_run_one_stealing(this_thread, ec, true);
+  }
+
   mutex::scoped_lock lock(mutex_);
 
   return do_run_one(lock, this_thread, ec);
@@ -190,8 +388,41 @@ std::size_t task_io_service::poll(boost::system::error_code& ec)
   this_thread.wakeup_event = 0;
   this_thread.private_outstanding_work = 0;
   this_thread.next = 0;
+  this_thread.run_queue = 0;
+  this_thread.reactor_shard = 0;
+  this_thread.reactor_shard_generation = -1;
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  if (reactor_shards_)
+  {
+    thread_info* outer_thread_info = ctx.next_by_key();
+    if (!bind_reactor_shard(this_thread, outer_thread_info))
+      return 0;
+    reactor_shard_cleanup on_exit = { this, &this_thread, outer_thread_info };
+    (void)on_exit;
+
+    std::size_t n = 0;
+    for (; do_run_one_pinned(this_thread, ec, false); )
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    return n;
+  }
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
+  if (work_stealing_)
+  {
+    bind_run_queue(this_thread);
+    run_queue_cleanup on_exit = { this, &this_thread };
+    (void)on_exit;
+
+    std::size_t n = 0;
+    for (; do_run_one_stealing(this_thread, ec, false); )
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    return n;
+  }
+
   mutex::scoped_lock lock(mutex_);
 
 #if defined(BOOST_ASIO_HAS_THREADS)
@@ -223,8 +454,33 @@ std::size_t task_io_service::poll_one(boost::system::error_code& ec)
   this_thread.wakeup_event = 0;
   this_thread.private_outstanding_work = 0;
   this_thread.next = 0;
+  this_thread.run_queue = 0;
+  this_thread.reactor_shard = 0;
+  this_thread.reactor_shard_generation = -1;
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  if (reactor_shards_)
+  {
+    thread_info* outer_thread_info = ctx.next_by_key();
+    if (!bind_reactor_shard(this_thread, outer_thread_info))
+      return 0;
+    reactor_shard_cleanup on_exit = { this, &this_thread, outer_thread_info };
+    (void)on_exit;
+
+    return do_run_one_pinned(this_thread, ec, false);
+  }
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
+  if (work_stealing_)
+  {
+    bind_run_queue(this_thread);
+    run_queue_cleanup on_exit = { this, &this_thread };
+    (void)on_exit;
+
+    return do_run_one_stealing(this_thread, ec, false);
+  }
+
   mutex::scoped_lock lock(mutex_);
 
 #if defined(BOOST_ASIO_HAS_THREADS)
@@ -254,13 +510,44 @@ bool task_io_service::stopped() const
 void task_io_service::reset()
 {
   mutex::scoped_lock lock(mutex_);
+  if (stopped_)
+    --stopped_flag_;
   stopped_ = false;
 }
 
 void task_io_service::post_immediate_completion(
     task_io_service::operation* op, bool is_continuation)
 {
+  statistics_.handlers_queued(1);
+
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  if (reactor_shards_)
+  {
+    thread_info* this_thread = thread_call_stack::contains(this);
+    if (this_thread && this_thread->reactor_shard)
+    {
+      ++this_thread->private_outstanding_work;
+      this_thread->private_op_queue.push(op);
+      return;
+    }
+
+    work_started();
+    post_to_reactor_shard(op);
+    return;
+  }
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
 #if defined(BOOST_ASIO_HAS_THREADS)
+  if (work_stealing_)
+  {
+    if (thread_info* this_thread = thread_call_stack::contains(this))
+    {
+      work_started();
+      push_run_queue(*this_thread, op);
+      return;
+    }
+  }
+
   if (one_thread_ || is_continuation)
   {
     if (thread_info* this_thread = thread_call_stack::contains(this))
@@ -280,12 +567,29 @@ void task_io_service::post_immediate_completion(
 
 void task_io_service::post_deferred_completion(task_io_service::operation* op)
 {
+  statistics_.handlers_queued(1);
+
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  if (reactor_shards_)
+  {
+    thread_info* this_thread = thread_call_stack::contains(this);
+    if (this_thread && this_thread->reactor_shard)
+      this_thread->private_op_queue.push(op);
+    else
+      post_to_reactor_shard(op);
+    return;
+  }
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
 #if defined(BOOST_ASIO_HAS_THREADS)
-  if (one_thread_)
+  if (one_thread_ || work_stealing_)
   {
     if (thread_info* this_thread = thread_call_stack::contains(this))
     {
-      this_thread->private_op_queue.push(op);
+      if (work_stealing_)
+        push_run_queue(*this_thread, op);
+      else
+        this_thread->private_op_queue.push(op);
       return;
     }
   }
@@ -301,12 +605,29 @@ void task_io_service::post_deferred_completions(
 {
   if (!ops.empty())
   {
+    statistics_.handlers_queued(ops);
+
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+    if (reactor_shards_)
+    {
+      thread_info* this_thread = thread_call_stack::contains(this);
+      if (this_thread && this_thread->reactor_shard)
+        this_thread->private_op_queue.push(ops);
+      else
+        post_to_reactor_shard(ops);
+      return;
+    }
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
 #if defined(BOOST_ASIO_HAS_THREADS)
-    if (one_thread_)
+    if (one_thread_ || work_stealing_)
     {
       if (thread_info* this_thread = thread_call_stack::contains(this))
       {
-        this_thread->private_op_queue.push(ops);
+        if (work_stealing_)
+          push_run_queue(*this_thread, ops);
+        else
+          this_thread->private_op_queue.push(ops);
         return;
       }
     }
@@ -322,6 +643,16 @@ void task_io_service::do_dispatch(
     task_io_service::operation* op)
 {
   work_started();
+  statistics_.handlers_queued(1);
+
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  if (reactor_shards_)
+  {
+    post_to_reactor_shard(op);
+    return;
+  }
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -365,6 +696,7 @@ std::size_t task_io_service::do_run_one(mutex::scoped_lock& lock,
         // Run the task. May throw an exception. Only block if the operation
         // queue is empty and we're not polling, otherwise we want to return
         // as soon as possible.
+        handler_statistics::wait_timer wait_timer(statistics_);
         task_->run(!more_handlers, this_thread.private_op_queue);
       }
       else
@@ -381,6 +713,7 @@ std::size_t task_io_service::do_run_one(mutex::scoped_lock& lock,
         (void)on_exit;
 
         // Complete the operation. May throw an exception. Deletes the object.
+        handler_statistics::handler_timer handler_timer(statistics_);
         o->complete(*this, ec, task_result);
 
         return 1;
@@ -419,6 +752,7 @@ std::size_t task_io_service::do_poll_one(mutex::scoped_lock& lock,
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
       // as soon as possible.
+      handler_statistics::wait_timer wait_timer(statistics_);
       task_->run(false, this_thread.private_op_queue);
     }
 
@@ -448,14 +782,602 @@ std::size_t task_io_service::do_poll_one(mutex::scoped_lock& lock,
   (void)on_exit;
 
   // Complete the operation. May throw an exception. Deletes the object.
+  handler_statistics::handler_timer handler_timer(statistics_);
   o->complete(*this, ec, task_result);
 
   return 1;
 }
 
+std::size_t task_io_service::do_run_one_stealing(
+    task_io_service::thread_info& this_thread,
+    const boost::system::error_code& ec, bool may_block)
+{
+  bool task_has_run = false;
+
+  while (stopped_flag_ == 0)
+  {
+    // Prefer handlers posted by this thread, then those posted by others.
+    operation* o = pop_run_queue(*this_thread.run_queue);
+    if (!o)
+      o = steal_operation(this_thread);
+
+    if (!o)
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (stopped_)
+        break;
+
+      if (op_queue_.empty())
+      {
+        if (!may_block)
+          return 0;
+
+        // Announce that we are about to go idle before checking the run
+        // queues one last time. A thread pushing on to a run queue checks the
+        // idle count after the push, so one of us will see the other.
+        ++idle_thread_count_;
+        if (!run_queues_empty())
+        {
+          --idle_thread_count_;
+          continue;
+        }
+
+        // Nothing to run right now, so just wait for work to do.
+        this_thread.next = first_idle_thread_;
+        first_idle_thread_ = &this_thread;
+        this_thread.wakeup_event->clear(lock);
+        this_thread.wakeup_event->wait(lock);
+        --idle_thread_count_;
+        continue;
+      }
+
+      o = op_queue_.front();
+      op_queue_.pop();
+      bool more_handlers = (!op_queue_.empty() || !run_queues_empty());
+
+      if (o == &task_operation_)
+      {
+        if (!may_block && task_has_run)
+        {
+          // The task has already been polled once, so give another thread
+          // the chance to run it.
+          op_queue_.push(&task_operation_);
+          wake_one_idle_thread_and_unlock(lock);
+          return 0;
+        }
+        task_has_run = true;
+
+        bool block = may_block && !more_handlers;
+        task_interrupted_ = !block;
+
+        if (more_handlers)
+        {
+          if (!wake_one_idle_thread_and_unlock(lock))
+            lock.unlock();
+        }
+        else
+          lock.unlock();
+
+        task_cleanup on_exit = { this, &lock, &this_thread };
+        (void)on_exit;
+
+        // Run the task. May throw an exception. Completed operations are
+        // queued on the main queue ahead of the task, as the reactor relies on
+        // them having been dequeued by the time the task runs again.
+        handler_statistics::wait_timer wait_timer(statistics_);
+        task_->run(block, this_thread.private_op_queue);
+        continue;
+      }
+
+      if (more_handlers)
+        wake_one_thread_and_unlock(lock);
+      else
+        lock.unlock();
+    }
+
+    std::size_t task_result = o->task_result_;
+
+    // Ensure the count of outstanding work is decremented on block exit.
+    work_cleanup on_exit = { this, 0, &this_thread };
+    (void)on_exit;
+
+    // Complete the operation. May throw an exception. Deletes the object.
+    handler_statistics::handler_timer handler_timer(statistics_);
+    o->complete(*this, ec, task_result);
+
+    return 1;
+  }
+
+  return 0;
+}
+
+void task_io_service::bind_run_queue(task_io_service::thread_info& this_thread)
+{
+  std::size_t index = static_cast<std::size_t>(
+      static_cast<long>(++next_run_queue_) - 1) % num_run_queues_;
+  this_thread.run_queue = &run_queues_[index];
+}
+
+std::size_t task_io_service::bound_run_queues() const
+{
+  // Queues are bound in order, so only the first ones can hold handlers.
+  std::size_t bound = static_cast<std::size_t>(
+      static_cast<long>(next_run_queue_));
+  return bound < num_run_queues_ ? bound : num_run_queues_;
+}
+
+void task_io_service::unbind_run_queue(
+    task_io_service::thread_info& this_thread)
+{
+  task_io_service_run_queue& q = *this_thread.run_queue;
+  this_thread.run_queue = 0;
+
+  // Handlers left behind may belong to a thread that is about to block, so
+  // hand them back to the main queue where any thread can pick them up.
+  op_queue<operation> ops;
+  while (operation* o = pop_run_queue(q))
+    ops.push(o);
+
+  if (!ops.empty())
+  {
+    mutex::scoped_lock lock(mutex_);
+    op_queue_.push(ops);
+    wake_one_thread_and_unlock(lock);
+  }
+}
+
+void task_io_service::push_run_queue(
+    task_io_service::thread_info& this_thread,
+    task_io_service::operation* op)
+{
+  task_io_service_run_queue& q = *this_thread.run_queue;
+  {
+    mutex::scoped_lock lock(q.queue_mutex);
+    q.ops.push(op);
+    ++q.depth;
+  }
+
+  if (idle_thread_count_ > 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (!wake_one_idle_thread_and_unlock(lock))
+      lock.unlock();
+  }
+}
+
+void task_io_service::push_run_queue(
+    task_io_service::thread_info& this_thread,
+    op_queue<task_io_service::operation>& ops)
+{
+  long n = 0;
+  for (operation* o = op_queue_access::front(ops);
+      o; o = op_queue_access::next(o))
+    ++n;
+
+  if (n == 0)
+    return;
+
+  task_io_service_run_queue& q = *this_thread.run_queue;
+  {
+    mutex::scoped_lock lock(q.queue_mutex);
+    q.ops.push(ops);
+    boost::asio::detail::increment(q.depth, n);
+  }
+
+  if (idle_thread_count_ > 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (!wake_one_idle_thread_and_unlock(lock))
+      lock.unlock();
+  }
+}
+
+task_io_service::operation* task_io_service::pop_run_queue(
+    task_io_service_run_queue& q)
+{
+  if (q.depth > 0)
+  {
+    mutex::scoped_lock lock(q.queue_mutex);
+    if (operation* o = q.ops.front())
+    {
+      q.ops.pop();
+      --q.depth;
+      return o;
+    }
+  }
+  return 0;
+}
+
+task_io_service::operation* task_io_service::steal_operation(
+    task_io_service::thread_info& this_thread)
+{
+  std::size_t n = bound_run_queues();
+  std::size_t start = this_thread.run_queue - run_queues_;
+  for (std::size_t i = 1; i < n; ++i)
+  {
+    std::size_t index = (start + i) % n;
+    if (operation* o = pop_run_queue(run_queues_[index]))
+      return o;
+  }
+  return 0;
+}
+
+bool task_io_service::run_queues_empty() const
+{
+  std::size_t n = bound_run_queues();
+  for (std::size_t i = 0; i < n; ++i)
+    if (run_queues_[i].depth > 0)
+      return false;
+  return true;
+}
+
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+std::size_t task_io_service::do_run_one_pinned(
+    task_io_service::thread_info& this_thread,
+    const boost::system::error_code& ec, bool may_block)
+{
+  task_io_service_reactor_shard& shard = *this_thread.reactor_shard;
+  bool task_has_run = false;
+
+  while (stopped_flag_ == 0)
+  {
+    // Prefer handlers queued by this thread, then those posted to its shard by
+    // other threads, then those waiting on the shards it has adopted. The
+    // latter are taken one at a time so that none are left with this thread
+    // if an adopted shard is handed over.
+    operation* o = this_thread.private_op_queue.front();
+    if (o)
+      this_thread.private_op_queue.pop();
+    else if (take_reactor_shard(shard, this_thread.private_op_queue))
+      continue;
+    else
+    {
+      for (task_io_service_reactor_shard* adopted = shard.first_adopted;
+          adopted && !o; adopted = adopted->next_adopted)
+        o = pop_reactor_shard(*adopted);
+    }
+
+    if (o)
+    {
+      std::size_t task_result = o->task_result_;
+
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_cleanup on_exit = { this, 0, &this_thread };
+      (void)on_exit;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      handler_statistics::handler_timer handler_timer(statistics_);
+      o->complete(*this, ec, task_result);
+
+      return 1;
+    }
+
+    // A thread has been pinned to or has left a shard since we last looked.
+    long generation = reactor_shard_generation_;
+    if (this_thread.reactor_shard_generation != generation)
+    {
+      mutex::scoped_lock lock(mutex_);
+      this_thread.reactor_shard_generation = generation;
+      rebalance_reactor_shards(shard, lock);
+      continue;
+    }
+
+    if (!may_block && task_has_run)
+      return 0;
+    task_has_run = true;
+
+    // Run the reactors. Completed operations from the thread's own reactor
+    // are queued privately and have all been dequeued by the time it runs
+    // again. Those from adopted reactors are queued on their shards.
+    run_reactor_shards(shard, may_block, this_thread.private_op_queue);
+  }
+
+  return 0;
+}
+
+bool task_io_service::bind_reactor_shard(
+    task_io_service::thread_info& this_thread,
+    task_io_service::thread_info* outer_thread)
+{
+  if (outer_thread && outer_thread->reactor_shard)
+  {
+    // Handlers queued by the outer call may be run by this one, so the work
+    // they represent is accounted for now.
+    this_thread.reactor_shard = outer_thread->reactor_shard;
+    if (outer_thread->private_outstanding_work > 0)
+    {
+      boost::asio::detail::increment(outstanding_work_,
+          outer_thread->private_outstanding_work);
+    }
+    outer_thread->private_outstanding_work = 0;
+    this_thread.private_op_queue.push(outer_thread->private_op_queue);
+    return true;
+  }
+
+  mutex::scoped_lock lock(mutex_);
+  while (!stopped_)
+  {
+    // Prefer a shard that no other thread is running.
+    task_io_service_reactor_shard* claimed = 0;
+    for (std::size_t i = 0; i < num_reactor_shards_; ++i)
+    {
+      task_io_service_reactor_shard& shard = reactor_shards_[i];
+      if (!shard.owner)
+      {
+        if (!shard.adopter)
+        {
+          claimed = &shard;
+          break;
+        }
+        if (!claimed && this_thread.wakeup_event)
+          claimed = &shard;
+      }
+    }
+
+    if (claimed)
+    {
+      claimed->owner = &this_thread;
+      this_thread.reactor_shard = claimed;
+      ++reactor_shard_generation_;
+
+      // Wait for the adopting thread to hand the shard over.
+      if (claimed->adopter)
+      {
+        if (task_)
+          task_->interrupt(claimed->adopter->index);
+        while (claimed->adopter)
+        {
+          this_thread.wakeup_event->clear(lock);
+          this_thread.wakeup_event->wait(lock);
+        }
+      }
+
+      return true;
+    }
+
+    // All shards have threads of their own, so wait for one to leave.
+    if (!this_thread.wakeup_event)
+      return false;
+    this_thread.next = first_idle_thread_;
+    first_idle_thread_ = &this_thread;
+    this_thread.wakeup_event->clear(lock);
+    this_thread.wakeup_event->wait(lock);
+  }
+
+  return false;
+}
+
+void task_io_service::unbind_reactor_shard(
+    task_io_service::thread_info& this_thread,
+    task_io_service::thread_info* outer_thread)
+{
+  task_io_service_reactor_shard& shard = *this_thread.reactor_shard;
+  this_thread.reactor_shard = 0;
+
+  if (this_thread.private_outstanding_work > 0)
+  {
+    boost::asio::detail::increment(outstanding_work_,
+        this_thread.private_outstanding_work);
+  }
+  this_thread.private_outstanding_work = 0;
+
+  if (outer_thread && outer_thread->reactor_shard)
+  {
+    outer_thread->private_op_queue.push(this_thread.private_op_queue);
+    return;
+  }
+
+  // Handlers left behind are run by whichever thread runs the shard next.
+  push_reactor_shard(shard, this_thread.private_op_queue);
+
+  mutex::scoped_lock lock(mutex_);
+  while (task_io_service_reactor_shard* adopted = shard.first_adopted)
+  {
+    shard.first_adopted = adopted->next_adopted;
+    release_reactor_shard(shard, *adopted, lock);
+  }
+  shard.owner = 0;
+  ++reactor_shard_generation_;
+
+  // Let a waiting thread take over the shard. Failing that, have one of the
+  // running threads adopt it.
+  if (!wake_one_idle_thread_and_unlock(lock))
+  {
+    for (std::size_t i = 0; i < num_reactor_shards_; ++i)
+    {
+      if (reactor_shards_[i].owner && task_)
+      {
+        task_->interrupt(reactor_shards_[i].index);
+        break;
+      }
+    }
+    lock.unlock();
+  }
+}
+
+void task_io_service::rebalance_reactor_shards(
+    task_io_service_reactor_shard& shard, mutex::scoped_lock& lock)
+{
+  task_io_service_reactor_shard** adopted = &shard.first_adopted;
+  while (*adopted)
+  {
+    if ((*adopted)->owner)
+    {
+      task_io_service_reactor_shard* claimed = *adopted;
+      *adopted = claimed->next_adopted;
+      release_reactor_shard(shard, *claimed, lock);
+    }
+    else
+      adopted = &(*adopted)->next_adopted;
+  }
+
+  for (std::size_t i = 0; i < num_reactor_shards_; ++i)
+  {
+    task_io_service_reactor_shard& orphan = reactor_shards_[i];
+    if (&orphan != &shard && !orphan.owner && !orphan.adopter && task_)
+    {
+      task_->nest_shard(shard.index, orphan.index);
+      orphan.adopter = &shard;
+      orphan.next_adopted = shard.first_adopted;
+      shard.first_adopted = &orphan;
+    }
+  }
+}
+
+void task_io_service::release_reactor_shard(
+    task_io_service_reactor_shard& shard,
+    task_io_service_reactor_shard& adopted, mutex::scoped_lock& lock)
+{
+  if (task_)
+    task_->unnest_shard(shard.index, adopted.index);
+  adopted.adopter = 0;
+  adopted.next_adopted = 0;
+  if (adopted.owner)
+    adopted.owner->wakeup_event->signal(lock);
+}
+
+void task_io_service::run_reactor_shards(
+    task_io_service_reactor_shard& shard,
+    bool block, op_queue<task_io_service::operation>& ops)
+{
+  // Only block if nothing is waiting on any of the shards. A thread that
+  // posts to a shard afterwards interrupts the reactor.
+  bool blocking = block;
+  if (blocking)
+  {
+    blocking = set_task_blocked(shard, true);
+    for (task_io_service_reactor_shard* adopted = shard.first_adopted;
+        adopted && blocking; adopted = adopted->next_adopted)
+      blocking = set_task_blocked(*adopted, true);
+    if (stopped_flag_ != 0)
+      blocking = false;
+  }
+
+  {
+    handler_statistics::wait_timer wait_timer(statistics_);
+    task_->run(shard.index, blocking, ops);
+  }
+  statistics_.handlers_queued(ops);
+
+  if (block)
+  {
+    set_task_blocked(shard, false);
+    for (task_io_service_reactor_shard* adopted = shard.first_adopted;
+        adopted; adopted = adopted->next_adopted)
+      set_task_blocked(*adopted, false);
+  }
+
+  for (task_io_service_reactor_shard* adopted = shard.first_adopted;
+      adopted; adopted = adopted->next_adopted)
+  {
+    op_queue<operation> adopted_ops;
+    task_->run(adopted->index, false, adopted_ops);
+    statistics_.handlers_queued(adopted_ops);
+    push_reactor_shard(*adopted, adopted_ops);
+  }
+}
+
+bool task_io_service::set_task_blocked(
+    task_io_service_reactor_shard& shard, bool blocked)
+{
+  mutex::scoped_lock lock(shard.queue_mutex);
+  if (blocked && !shard.ops.empty())
+    return false;
+  shard.task_blocked = blocked;
+  return true;
+}
+
+void task_io_service::post_to_reactor_shard(task_io_service::operation* op)
+{
+  std::size_t index = static_cast<std::size_t>(
+      static_cast<long>(++next_reactor_shard_)) % num_reactor_shards_;
+  task_io_service_reactor_shard& shard = reactor_shards_[index];
+
+  mutex::scoped_lock lock(shard.queue_mutex);
+  shard.ops.push(op);
+  ++shard.depth;
+  if (shard.task_blocked && task_)
+  {
+    shard.task_blocked = false;
+    task_->interrupt(shard.index);
+  }
+}
+
+void task_io_service::post_to_reactor_shard(
+    op_queue<task_io_service::operation>& ops)
+{
+  std::size_t index = static_cast<std::size_t>(
+      static_cast<long>(++next_reactor_shard_)) % num_reactor_shards_;
+  task_io_service_reactor_shard& shard = reactor_shards_[index];
+
+  push_reactor_shard(shard, ops);
+
+  mutex::scoped_lock lock(shard.queue_mutex);
+  if (shard.task_blocked && task_)
+  {
+    shard.task_blocked = false;
+    task_->interrupt(shard.index);
+  }
+}
+
+void task_io_service::push_reactor_shard(
+    task_io_service_reactor_shard& shard,
+    op_queue<task_io_service::operation>& ops)
+{
+  long n = 0;
+  for (operation* o = op_queue_access::front(ops);
+      o; o = op_queue_access::next(o))
+    ++n;
+
+  if (n > 0)
+  {
+    mutex::scoped_lock lock(shard.queue_mutex);
+    shard.ops.push(ops);
+    boost::asio::detail::increment(shard.depth, n);
+  }
+}
+
+bool task_io_service::take_reactor_shard(
+    task_io_service_reactor_shard& shard,
+    op_queue<task_io_service::operation>& ops)
+{
+  bool taken = false;
+  if (shard.depth > 0)
+  {
+    mutex::scoped_lock lock(shard.queue_mutex);
+    while (operation* o = shard.ops.front())
+    {
+      shard.ops.pop();
+      ops.push(o);
+      --shard.depth;
+      taken = true;
+    }
+  }
+  return taken;
+}
+
+task_io_service::operation* task_io_service::pop_reactor_shard(
+    task_io_service_reactor_shard& shard)
+{
+  if (shard.depth > 0)
+  {
+    mutex::scoped_lock lock(shard.queue_mutex);
+    if (operation* o = shard.ops.front())
+    {
+      shard.ops.pop();
+      --shard.depth;
+      return o;
+    }
+  }
+  return 0;
+}
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
 void task_io_service::stop_all_threads(
     mutex::scoped_lock& lock)
 {
+  if (!stopped_)
+    ++stopped_flag_;
   stopped_ = true;
 
   while (first_idle_thread_)
@@ -471,6 +1393,19 @@ void task_io_service::stop_all_threads(
     task_interrupted_ = true;
     task_->interrupt();
   }
+
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  for (std::size_t i = 0; i < num_reactor_shards_; ++i)
+  {
+    task_io_service_reactor_shard& shard = reactor_shards_[i];
+    mutex::scoped_lock shard_lock(shard.queue_mutex);
+    if (shard.task_blocked && task_)
+    {
+      shard.task_blocked = false;
+      task_->interrupt(shard.index);
+    }
+  }
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
 }
 
 bool task_io_service::wake_one_idle_thread_and_unlock(
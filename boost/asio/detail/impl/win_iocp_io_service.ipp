@@ -33,6 +33,13 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+handler_statistics& get_handler_statistics(win_iocp_io_service& owner)
+{
+  return owner.statistics();
+}
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
 struct win_iocp_io_service::work_finished_on_block_exit
 {
   ~work_finished_on_block_exit()
@@ -361,10 +368,15 @@ size_t win_iocp_io_service::do_one(bool block, boost::system::error_code& ec)
     DWORD bytes_transferred = 0;
     dword_ptr_t completion_key = 0;
     LPOVERLAPPED overlapped = 0;
-    ::SetLastError(0);
-    BOOL ok = ::GetQueuedCompletionStatus(iocp_.handle, &bytes_transferred,
-        &completion_key, &overlapped, block ? gqcs_timeout : 0);
-    DWORD last_error = ::GetLastError();
+    BOOL ok;
+    DWORD last_error;
+    {
+      handler_statistics::wait_timer wait_timer(statistics_);
+      ::SetLastError(0);
+      ok = ::GetQueuedCompletionStatus(iocp_.handle, &bytes_transferred,
+          &completion_key, &overlapped, block ? gqcs_timeout : 0);
+      last_error = ::GetLastError();
+    }
 
     if (overlapped)
     {
@@ -400,6 +412,8 @@ size_t win_iocp_io_service::do_one(bool block, boost::system::error_code& ec)
         work_finished_on_block_exit on_exit = { this };
         (void)on_exit;
 
+        statistics_.handlers_queued(1);
+        handler_statistics::handler_timer handler_timer(statistics_);
         op->complete(*this, result_ec, bytes_transferred);
         ec = boost::system::error_code();
         return 1;
@@ -0,0 +1,161 @@
+//
+// detail/io_uring_ops.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_OPS_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_OPS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include <boost/system/error_code.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+namespace io_uring_ops {
+
+inline int setup(unsigned entries, io_uring_params& params)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+inline int enter(int fd, unsigned to_submit,
+    unsigned min_complete, unsigned flags)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter,
+        fd, to_submit, min_complete, flags, 0, 0));
+}
+
+// Fill in the fields common to all submissions.
+inline void prep_rw(io_uring_sqe& sqe, int opcode, int fd,
+    const void* addr, std::size_t len, uint64_t offset)
+{
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = static_cast<uint8_t>(opcode);
+  sqe.fd = fd;
+  sqe.off = offset;
+  sqe.addr = reinterpret_cast<uint64_t>(addr);
+  sqe.len = static_cast<uint32_t>(len);
+}
+
+inline void prep_recv(io_uring_sqe& sqe, int fd,
+    void* data, std::size_t size, int flags)
+{
+  prep_rw(sqe, IORING_OP_RECV, fd, data, size, 0);
+  sqe.msg_flags = static_cast<uint32_t>(flags);
+}
+
+inline void prep_send(io_uring_sqe& sqe, int fd,
+    const void* data, std::size_t size, int flags)
+{
+  prep_rw(sqe, IORING_OP_SEND, fd, data, size, 0);
+  sqe.msg_flags = static_cast<uint32_t>(flags | MSG_NOSIGNAL);
+}
+
+// Reads and writes use the descriptor's current position.
+inline void prep_read(io_uring_sqe& sqe, int fd, void* data, std::size_t size)
+{
+  prep_rw(sqe, IORING_OP_READ, fd, data, size, static_cast<uint64_t>(-1));
+}
+
+inline void prep_write(io_uring_sqe& sqe, int fd,
+    const void* data, std::size_t size)
+{
+  prep_rw(sqe, IORING_OP_WRITE, fd, data, size, static_cast<uint64_t>(-1));
+}
+
+inline void prep_accept(io_uring_sqe& sqe, int fd,
+    void* addr, socklen_t* addrlen)
+{
+  prep_rw(sqe, IORING_OP_ACCEPT, fd, addr, 0,
+      reinterpret_cast<uint64_t>(addrlen));
+}
+
+inline void prep_poll_add(io_uring_sqe& sqe, int fd, unsigned poll_mask)
+{
+  prep_rw(sqe, IORING_OP_POLL_ADD, fd, 0, 0, 0);
+#if defined(IORING_FEAT_POLL_32BITS)
+  sqe.poll32_events = poll_mask;
+#else // defined(IORING_FEAT_POLL_32BITS)
+  sqe.poll_events = static_cast<uint16_t>(poll_mask);
+#endif // defined(IORING_FEAT_POLL_32BITS)
+}
+
+inline void prep_cancel(io_uring_sqe& sqe, uint64_t user_data)
+{
+  prep_rw(sqe, IORING_OP_ASYNC_CANCEL, -1, 0, 0, 0);
+  sqe.addr = user_data;
+}
+
+// The low bits of a descriptor submission's user data hold the operation type.
+const uint64_t op_type_mask = 3;
+
+inline uint64_t make_user_data(void* p, int op_type = 0)
+{
+  return static_cast<uint64_t>(reinterpret_cast<std::size_t>(p)) | op_type;
+}
+
+inline void* user_data_ptr(uint64_t user_data)
+{
+  return reinterpret_cast<void*>(
+      static_cast<std::size_t>(user_data & ~op_type_mask));
+}
+
+// Translate the result of a completed submission. Returns the number of bytes
+// transferred, or 0 if the submission failed.
+inline std::size_t translate_result(int result, boost::system::error_code& ec)
+{
+  if (result >= 0)
+  {
+    ec = boost::system::error_code();
+    return static_cast<std::size_t>(result);
+  }
+
+  if (result == -ECANCELED)
+    ec = boost::asio::error::operation_aborted;
+  else
+    ec = boost::system::error_code(-result,
+        boost::asio::error::get_system_category());
+  return 0;
+}
+
+// Determine whether a submission failed only because the descriptor was not
+// ready, in which case the operation must wait for readiness instead.
+inline bool would_block(int result)
+{
+  return result == -EAGAIN || result == -EWOULDBLOCK || result == -EINTR;
+}
+
+} // namespace io_uring_ops
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_OPS_HPP
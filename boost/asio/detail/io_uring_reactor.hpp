@@ -0,0 +1,319 @@
+//
+// detail/io_uring_reactor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_REACTOR_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_REACTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/limits.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/object_pool.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/select_interrupter.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+#include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/detail/timer_queue_set.hpp>
+#include <boost/asio/detail/wait_op.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A completion-based replacement for the epoll_reactor. Operations that are
+// able to describe themselves as an io_uring submission (single-buffer send
+// and receive, descriptor reads and writes, and accept) are performed by the
+// kernel, so that a completion costs no additional system call. All other
+// operations wait for readiness using a one-shot poll submission on the same
+// ring, after which they are performed as for the other reactors. New
+// submissions are batched and passed to the kernel by the same io_uring_enter
+// call that waits for completions.
+class io_uring_reactor
+  : public boost::asio::detail::service_base<io_uring_reactor>
+{
+public:
+  enum op_types { read_op = 0, write_op = 1,
+    connect_op = 1, except_op = 2, max_ops = 3 };
+
+  // Per-descriptor queues.
+  class descriptor_state : operation
+  {
+    friend class io_uring_reactor;
+    friend class object_pool_access;
+
+    // The kind of submission in flight for an operation type.
+    enum submission_type { no_submission, poll_submission,
+      direct_submission };
+
+    descriptor_state* next_;
+    descriptor_state* prev_;
+
+    mutex mutex_;
+    io_uring_reactor* reactor_;
+    int descriptor_;
+    op_queue<reactor_op> op_queue_[max_ops];
+    submission_type submitted_[max_ops];
+    submission_type completed_[max_ops];
+    int results_[max_ops];
+    bool cancelled_[max_ops];
+    unsigned int ready_mask_;
+    std::size_t pending_submissions_;
+    bool queued_;
+    bool shutdown_;
+
+    BOOST_ASIO_DECL descriptor_state();
+    BOOST_ASIO_DECL operation* perform_io();
+    BOOST_ASIO_DECL static void do_complete(
+        io_service_impl* owner, operation* base,
+        const boost::system::error_code& ec, std::size_t bytes_transferred);
+  };
+
+  // Per-descriptor data.
+  typedef descriptor_state* per_descriptor_data;
+
+  // Constructor.
+  BOOST_ASIO_DECL io_uring_reactor(boost::asio::io_service& io_service);
+
+  // Destructor.
+  BOOST_ASIO_DECL ~io_uring_reactor();
+
+  // Destroy all user-defined handler objects owned by the service.
+  BOOST_ASIO_DECL void shutdown_service();
+
+  // Recreate internal descriptors following a fork.
+  BOOST_ASIO_DECL void fork_service(
+      boost::asio::io_service::fork_event fork_ev);
+
+  // Initialise the task.
+  BOOST_ASIO_DECL void init_task();
+
+  // Register a socket with the reactor. Returns 0 on success, system error
+  // code on failure.
+  BOOST_ASIO_DECL int register_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data);
+
+  // Register a descriptor with an associated single operation. Returns 0 on
+  // success, system error code on failure.
+  BOOST_ASIO_DECL int register_internal_descriptor(
+      int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op);
+
+  // Move descriptor registration from one descriptor_data object to another.
+  BOOST_ASIO_DECL void move_descriptor(socket_type descriptor,
+      per_descriptor_data& target_descriptor_data,
+      per_descriptor_data& source_descriptor_data);
+
+  // Post a reactor operation for immediate completion.
+  void post_immediate_completion(reactor_op* op, bool is_continuation)
+  {
+    io_service_.post_immediate_completion(op, is_continuation);
+  }
+
+  // Start a new operation. The operation is submitted to the kernel, or is
+  // performed when the given descriptor is flagged as ready.
+  BOOST_ASIO_DECL void start_op(int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op,
+      bool is_continuation, bool allow_speculative);
+
+  // Cancel all operations associated with the given descriptor. The
+  // handlers associated with the descriptor will be invoked with the
+  // operation_aborted error.
+  BOOST_ASIO_DECL void cancel_ops(socket_type descriptor,
+      per_descriptor_data& descriptor_data);
+
+  // Cancel any operations that are running against the descriptor and remove
+  // its registration from the reactor.
+  BOOST_ASIO_DECL void deregister_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data, bool closing);
+
+  // Remote the descriptor's registration from the reactor.
+  BOOST_ASIO_DECL void deregister_internal_descriptor(
+      socket_type descriptor, per_descriptor_data& descriptor_data);
+
+  // Add a new timer queue to the reactor.
+  template <typename Time_Traits>
+  void add_timer_queue(timer_queue<Time_Traits>& timer_queue);
+
+  // Remove a timer queue from the reactor.
+  template <typename Time_Traits>
+  void remove_timer_queue(timer_queue<Time_Traits>& timer_queue);
+
+  // Schedule a new operation in the given timer queue to expire at the
+  // specified absolute time.
+  template <typename Time_Traits>
+  void schedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer, wait_op* op);
+
+  // Cancel the timer operations associated with the given token. Returns the
+  // number of operations that have been posted or dispatched.
+  template <typename Time_Traits>
+  std::size_t cancel_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
+
+  // Submit pending work and wait until interrupted or completions are ready
+  // to be dispatched.
+  BOOST_ASIO_DECL void run(bool block, op_queue<operation>& ops);
+
+  // Interrupt the wait.
+  BOOST_ASIO_DECL void interrupt();
+
+private:
+  // The number of entries in the submission queue.
+  enum { ring_size = 1024 };
+
+  // The ring buffers shared with the kernel.
+  struct ring
+  {
+    int fd;
+    void* sq_ring;
+    std::size_t sq_ring_size;
+    void* cq_ring;
+    std::size_t cq_ring_size;
+    io_uring_sqe* sqes;
+    std::size_t sqes_size;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned cq_mask;
+    io_uring_cqe* cqes;
+  };
+
+  // Create the ring and map it into memory. Throws an exception on failure.
+  BOOST_ASIO_DECL static ring do_io_uring_setup();
+
+  // Unmap and close the ring.
+  BOOST_ASIO_DECL static void do_io_uring_teardown(ring& r);
+
+  // Create the timerfd file descriptor. Does not throw.
+  BOOST_ASIO_DECL static int do_timerfd_create();
+
+  // Get a free submission queue entry, passing queued submissions to the
+  // kernel if the queue is full. The submission mutex must be held.
+  BOOST_ASIO_DECL io_uring_sqe& get_sqe();
+
+  // Pass all queued submissions to the kernel. The submission mutex must be
+  // held.
+  BOOST_ASIO_DECL void submit_pending();
+
+  // Make the queued submissions visible to the kernel. If no thread is
+  // waiting for completions they will be passed on by the next call to run().
+  // The submission mutex must be held.
+  BOOST_ASIO_DECL void commit_sqe();
+
+  // Submit a one-shot poll for one of the internal descriptors.
+  BOOST_ASIO_DECL void submit_internal_poll(int descriptor, void* user_data);
+
+  // Submit the operation at the front of the given queue, either directly or
+  // as a poll for readiness. The descriptor's mutex must be held.
+  BOOST_ASIO_DECL void submit_op(descriptor_state* s,
+      int op_type, bool allow_direct);
+
+  // Request cancellation of any in-flight submissions for the descriptor.
+  // Operations that the kernel is not using are aborted and moved to the
+  // given queue. The descriptor's mutex must be held.
+  BOOST_ASIO_DECL void cancel_submissions(descriptor_state* s,
+      op_queue<operation>& ops);
+
+  // Consume all available completions.
+  BOOST_ASIO_DECL void reap_completions(op_queue<operation>& ops,
+      bool& check_timers);
+
+  // Allocate a new descriptor state object.
+  BOOST_ASIO_DECL descriptor_state* allocate_descriptor_state();
+
+  // Free an existing descriptor state object.
+  BOOST_ASIO_DECL void free_descriptor_state(descriptor_state* s);
+
+  // Helper function to add a new timer queue.
+  BOOST_ASIO_DECL void do_add_timer_queue(timer_queue_base& queue);
+
+  // Helper function to remove a timer queue.
+  BOOST_ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
+
+  // Called to recalculate and update the timeout.
+  BOOST_ASIO_DECL void update_timeout();
+
+  // Get the timeout value for the timer descriptor. The return value is the
+  // flag argument to be used when calling timerfd_settime.
+  BOOST_ASIO_DECL int get_timeout(itimerspec& ts);
+
+  // The io_service implementation used to post completions.
+  io_service_impl& io_service_;
+
+  // Mutex to protect access to internal data.
+  mutex mutex_;
+
+  // The interrupter is used to break a blocking wait for completions.
+  select_interrupter interrupter_;
+
+  // The io_uring instance.
+  ring ring_;
+
+  // The timer file descriptor.
+  int timer_fd_;
+
+  // The timer queues.
+  timer_queue_set timer_queues_;
+
+  // Whether the service has been shut down.
+  bool shutdown_;
+
+  // Mutex to protect access to the submission queue.
+  mutex submission_mutex_;
+
+  // Whether a thread is blocked waiting for completions, in which case new
+  // submissions must be passed to the kernel immediately.
+  bool waiting_;
+
+  // Mutex to protect access to the registered descriptors.
+  mutex registered_descriptors_mutex_;
+
+  // Keep track of all registered descriptors.
+  object_pool<descriptor_state> registered_descriptors_;
+
+  // Helper class to do post-perform_io cleanup.
+  struct perform_io_cleanup_on_block_exit;
+  friend struct perform_io_cleanup_on_block_exit;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/detail/impl/io_uring_reactor.hpp>
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/io_uring_reactor.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_REACTOR_HPP
@@ -20,6 +20,7 @@
 #include <boost/asio/detail/bind_handler.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
 #include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/io_uring_ops.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
@@ -44,6 +45,10 @@ public:
       protocol_(protocol),
       peer_endpoint_(peer_endpoint)
   {
+#if defined(BOOST_ASIO_HAS_IO_URING)
+    this->set_submission_funcs(&reactive_socket_accept_op_base::do_prepare,
+        &reactive_socket_accept_op_base::do_complete_submission);
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
   }
 
   static bool do_perform(reactor_op* base)
@@ -70,12 +75,65 @@ public:
     return result;
   }
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  static bool do_prepare(reactor_op* base, io_uring_sqe& sqe)
+  {
+    reactive_socket_accept_op_base* o(
+        static_cast<reactive_socket_accept_op_base*>(base));
+
+    o->addrlen_ = static_cast<socklen_t>(
+        o->peer_endpoint_ ? o->peer_endpoint_->capacity() : 0);
+    io_uring_ops::prep_accept(sqe, o->socket_,
+        o->peer_endpoint_ ? o->peer_endpoint_->data() : 0,
+        o->peer_endpoint_ ? &o->addrlen_ : 0);
+    return true;
+  }
+
+  static bool do_complete_submission(reactor_op* base, int result)
+  {
+    reactive_socket_accept_op_base* o(
+        static_cast<reactive_socket_accept_op_base*>(base));
+
+    if (io_uring_ops::would_block(result))
+    {
+      if ((o->state_ & socket_ops::user_set_non_blocking) == 0)
+        return false;
+    }
+    else if (result == -ECONNABORTED
+#if defined(EPROTO)
+        || result == -EPROTO
+#endif // defined(EPROTO)
+        )
+    {
+      if ((o->state_ & socket_ops::enable_connection_aborted) == 0)
+        return false;
+    }
+
+    io_uring_ops::translate_result(result, o->ec_);
+
+    // On success, assign new connection to peer socket object.
+    if (result >= 0)
+    {
+      socket_holder new_socket_holder(result);
+      if (o->peer_endpoint_)
+        o->peer_endpoint_->resize(o->addrlen_);
+      if (!o->peer_.assign(o->protocol_, result, o->ec_))
+        new_socket_holder.release();
+    }
+
+    return true;
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 private:
   socket_type socket_;
   socket_ops::state_type state_;
   Socket& peer_;
   Protocol protocol_;
   typename Protocol::endpoint* peer_endpoint_;
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  socklen_t addrlen_;
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
 };
 
 template <typename Socket, typename Protocol, typename Handler>
@@ -0,0 +1,290 @@
+//
+// detail/reactive_socket_sendfile_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDFILE_OP_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDFILE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/descriptor_ops.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/reactor.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Sends a range of a file. The operation is not complete until the whole range
+// has been sent, the end of the file is reached, or an error occurs.
+//
+// The operation normally waits for the socket to become writable. If the file
+// is a pipe that has no data in it, the operation instead waits for the pipe
+// to become readable and then goes back to waiting for the socket. The pipe is
+// registered with the reactor using a duplicate descriptor, so that the
+// registration cannot clash with one made by the owner of the pipe.
+//
+// While the operation is outstanding it is linked to the socket, so that
+// closing or cancelling the socket can reach it when it is not queued on the
+// socket's descriptor. The link is protected by a mutex owned by the socket
+// service.
+class reactive_socket_sendfile_op_base : public reactor_op
+{
+public:
+  reactive_socket_sendfile_op_base(reactor& r, mutex& m, socket_type socket,
+      const reactor::per_descriptor_data& socket_data, int file,
+      uint64_t offset, std::size_t length, func_type complete_func)
+    : reactor_op(&reactive_socket_sendfile_op_base::do_perform, complete_func),
+      reactor_(r),
+      mutex_(m),
+      link_(0),
+      cancelled_(false),
+      socket_(socket),
+      socket_data_(socket_data),
+      file_(file),
+      source_(-1),
+      source_data_(),
+      waiting_for_source_(false),
+      offset_(offset),
+      remaining_(length),
+      pending_()
+  {
+  }
+
+  static bool do_perform(reactor_op* base)
+  {
+    reactive_socket_sendfile_op_base* o(
+        static_cast<reactive_socket_sendfile_op_base*>(base));
+
+    if (o->waiting_for_source_)
+      return descriptor_ops::poll_read(o->source_,
+          descriptor_ops::user_set_non_blocking, o->ec_) != 0;
+
+    return socket_ops::non_blocking_sendfile(o->socket_, o->file_,
+        o->offset_, o->remaining_, o->pending_, o->ec_, o->bytes_transferred_);
+  }
+
+  // Link the operation to a socket. Returns false if the socket already has
+  // a send_file operation in progress. The mutex must be held.
+  bool link(reactive_socket_sendfile_op_base*& slot)
+  {
+    if (slot)
+      return false;
+    slot = this;
+    link_ = &slot;
+    return true;
+  }
+
+  // Move the link to another socket implementation. The mutex must be held.
+  static void move_link(reactive_socket_sendfile_op_base*& target,
+      reactive_socket_sendfile_op_base*& source)
+  {
+    target = source;
+    source = 0;
+    if (target)
+      target->link_ = &target;
+  }
+
+  // Abort the operation linked to a socket, if any, when the socket is
+  // cancelled or closed. Closing also breaks the link, after which the
+  // operation no longer uses the socket's descriptor. The mutex must be held.
+  static void cancel(reactive_socket_sendfile_op_base*& slot, bool closing)
+  {
+    if (reactive_socket_sendfile_op_base* o = slot)
+    {
+      o->cancelled_ = true;
+      if (o->waiting_for_source_)
+        o->reactor_.cancel_ops(o->source_, o->source_data_);
+      if (closing)
+      {
+        o->link_ = 0;
+        slot = 0;
+      }
+    }
+  }
+
+protected:
+  // Called when a step of the operation has finished. Returns false if the
+  // operation has been restarted to wait for the pipe or the socket, or true
+  // if the handler is to be called.
+  bool resume()
+  {
+    mutex::scoped_lock lock(mutex_);
+
+    bool source_ready = waiting_for_source_ && !ec_;
+    bool source_empty = !waiting_for_source_
+      && ec_ == boost::asio::error::would_block;
+    waiting_for_source_ = false;
+
+    if (!source_ready && !source_empty)
+      return true;
+
+    // The socket has been cancelled or closed since this step started.
+    if (cancelled_)
+    {
+      ec_ = boost::asio::error::operation_aborted;
+      return true;
+    }
+
+    // Data has been written to the pipe.
+    if (source_ready)
+    {
+      reactor_.start_op(reactor::write_op, socket_,
+          socket_data_, this, true, true);
+      return false;
+    }
+
+    // The socket can be written to but the pipe is empty.
+    if (source_ == -1)
+    {
+      source_ = descriptor_ops::dup(file_, ec_);
+      if (source_ == -1)
+        return true;
+
+      if (int err = reactor_.register_descriptor(source_, source_data_))
+      {
+        ec_ = boost::system::error_code(err,
+            boost::asio::error::get_system_category());
+        close_source();
+        return true;
+      }
+    }
+
+    ec_ = boost::system::error_code();
+    waiting_for_source_ = true;
+    reactor_.start_op(reactor::read_op, source_,
+        source_data_, this, true, true);
+    return false;
+  }
+
+  // Unlink the operation from the socket and close the duplicate descriptor
+  // of the pipe, if there is one.
+  void finish(bool registered)
+  {
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (link_)
+      {
+        *link_ = 0;
+        link_ = 0;
+      }
+    }
+
+    if (source_ != -1)
+    {
+      if (registered)
+        reactor_.deregister_descriptor(source_, source_data_, false);
+      close_source();
+    }
+  }
+
+private:
+  void close_source()
+  {
+    descriptor_ops::state_type state = 0;
+    boost::system::error_code ignored_ec;
+    descriptor_ops::close(source_, state, ignored_ec);
+    source_ = -1;
+  }
+
+  reactor& reactor_;
+  mutex& mutex_;
+  reactive_socket_sendfile_op_base** link_;
+  bool cancelled_;
+  socket_type socket_;
+  reactor::per_descriptor_data socket_data_;
+  int file_;
+  int source_;
+  reactor::per_descriptor_data source_data_;
+  bool waiting_for_source_;
+  uint64_t offset_;
+  std::size_t remaining_;
+  socket_ops::sendfile_buffer pending_;
+};
+
+template <typename Handler>
+class reactive_socket_sendfile_op : public reactive_socket_sendfile_op_base
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_sendfile_op);
+
+  reactive_socket_sendfile_op(reactor& r, mutex& m, socket_type socket,
+      const reactor::per_descriptor_data& socket_data, int file,
+      uint64_t offset, std::size_t length, Handler& handler)
+    : reactive_socket_sendfile_op_base(r, m, socket, socket_data, file,
+        offset, length, &reactive_socket_sendfile_op::do_complete),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(handler))
+  {
+  }
+
+  static void do_complete(io_service_impl* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    reactive_socket_sendfile_op* o(
+        static_cast<reactive_socket_sendfile_op*>(base));
+
+    // Wait for the pipe or the socket if there is more to send.
+    if (owner && !o->resume())
+      return;
+    o->finish(owner != 0);
+
+    // Take ownership of the handler object.
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      boost_asio_handler_invoke_helpers::invoke(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#endif // BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDFILE_OP_HPP
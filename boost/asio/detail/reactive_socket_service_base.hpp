@@ -26,10 +26,12 @@
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/detail/addressof.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/reactive_null_buffers_op.hpp>
 #include <boost/asio/detail/reactive_socket_recv_op.hpp>
 #include <boost/asio/detail/reactive_socket_recvmsg_op.hpp>
 #include <boost/asio/detail/reactive_socket_send_op.hpp>
+#include <boost/asio/detail/reactive_socket_sendfile_op.hpp>
 #include <boost/asio/detail/reactor.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
@@ -59,6 +61,11 @@ public:
 
     // Per-descriptor data used by the reactor.
     reactor::per_descriptor_data reactor_data_;
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    // The send_file operation in progress on the socket, if any.
+    reactive_socket_sendfile_op_base* sendfile_op_;
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
   };
 
   // Constructor.
@@ -242,6 +249,44 @@ public:
     p.v = p.p = 0;
   }
 
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  // Start an asynchronous send of a range of a file. The handler is called
+  // once the whole range has been sent.
+  template <typename Handler>
+  void async_send_file(base_implementation_type& impl, int file,
+      uint64_t offset, std::size_t length, Handler& handler)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendfile_op<Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(reactor_, sendfile_mutex_, impl.socket_,
+        impl.reactor_data_, file, offset, length, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_send_file"));
+
+    bool linked;
+    {
+      mutex::scoped_lock lock(sendfile_mutex_);
+      linked = p.p->link(impl.sendfile_op_);
+    }
+
+    if (linked)
+      start_op(impl, reactor::write_op, p.p, is_continuation, true,
+          length == 0);
+    else
+    {
+      p.p->ec_ = boost::asio::error::already_started;
+      reactor_.post_immediate_completion(p.p, is_continuation);
+    }
+    p.v = p.p = 0;
+  }
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
   // Receive some data from the peer. Returns the number of bytes received.
   template <typename MutableBufferSequence>
   size_t receive(base_implementation_type& impl,
@@ -434,6 +479,11 @@ protected:
 
   // The selector that performs event demultiplexing for the service.
   reactor& reactor_;
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  // Mutex to protect the links between sockets and send_file operations.
+  mutex sendfile_mutex_;
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
 };
 
 } // namespace detail
@@ -20,6 +20,10 @@
 
 #include <boost/asio/detail/push_options.hpp>
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+struct io_uring_sqe;
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 namespace boost {
 namespace asio {
 namespace detail {
@@ -40,6 +44,23 @@ public:
     return perform_func_(this);
   }
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  // Prepare a submission that has the kernel perform the operation directly.
+  // Returns false if the operation must instead wait for the descriptor to
+  // become ready and then be performed using perform().
+  bool prepare(io_uring_sqe& sqe)
+  {
+    return prepare_func_ ? prepare_func_(this, sqe) : false;
+  }
+
+  // Handle the result of a submission made using prepare(). Returns true if
+  // the operation is finished.
+  bool complete_submission(int result)
+  {
+    return submission_func_(this, result);
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 protected:
   typedef bool (*perform_func_type)(reactor_op*);
 
@@ -48,10 +69,30 @@ protected:
       bytes_transferred_(0),
       perform_func_(perform_func)
   {
+#if defined(BOOST_ASIO_HAS_IO_URING)
+    set_submission_funcs(0, 0);
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+  }
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  typedef bool (*prepare_func_type)(reactor_op*, io_uring_sqe&);
+  typedef bool (*submission_func_type)(reactor_op*, int);
+
+  // Allow the kernel to perform the operation on the reactor's behalf.
+  void set_submission_funcs(prepare_func_type prepare_func,
+      submission_func_type submission_func)
+  {
+    prepare_func_ = prepare_func;
+    submission_func_ = submission_func;
   }
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
 
 private:
   perform_func_type perform_func_;
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  prepare_func_type prepare_func_;
+  submission_func_type submission_func_;
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
 };
 
 } // namespace detail
@@ -18,6 +18,7 @@
 #include <boost/asio/detail/config.hpp>
 
 #include <boost/system/error_code.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/shared_ptr.hpp>
 #include <boost/asio/detail/socket_types.hpp>
 #include <boost/asio/detail/weak_ptr.hpp>
@@ -196,6 +197,19 @@ BOOST_ASIO_DECL bool non_blocking_recvmsg(socket_type s,
 
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
+BOOST_ASIO_DECL signed_size_type recvmmsg(socket_type s, buf* bufs,
+    size_t count, int flags, socket_addr_type* const* addrs,
+    std::size_t* addrlens, std::size_t* sizes, boost::system::error_code& ec);
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+BOOST_ASIO_DECL bool non_blocking_recvmmsg(socket_type s,
+    buf* bufs, size_t count, int flags,
+    socket_addr_type* const* addrs, std::size_t* addrlens,
+    std::size_t* sizes, boost::system::error_code& ec, size_t& messages);
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
 BOOST_ASIO_DECL signed_size_type send(socket_type s, const buf* bufs,
     size_t count, int flags, boost::system::error_code& ec);
 
@@ -234,6 +248,47 @@ BOOST_ASIO_DECL bool non_blocking_sendto(socket_type s,
 
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
+BOOST_ASIO_DECL signed_size_type sendmmsg(socket_type s, const buf* bufs,
+    size_t count, int flags, const socket_addr_type* const* addrs,
+    const std::size_t* addrlens, boost::system::error_code& ec);
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+BOOST_ASIO_DECL bool non_blocking_sendmmsg(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* const* addrs, const std::size_t* addrlens,
+    boost::system::error_code& ec, size_t& messages);
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+// Data that has been read from the file but not yet taken by the socket. It
+// is only needed when sendfile is emulated by reading into a buffer, since
+// data read from a pipe cannot be read again.
+struct sendfile_buffer
+{
+#if !defined(BOOST_ASIO_HAS_SENDFILE)
+  sendfile_buffer() : begin(0), end(0) {}
+  enum { max_size = 8192 };
+  char data[max_size];
+  std::size_t begin;
+  std::size_t end;
+#endif // !defined(BOOST_ASIO_HAS_SENDFILE)
+};
+
+BOOST_ASIO_DECL signed_size_type sendfile(socket_type s, int fd,
+    uint64_t& offset, std::size_t size, sendfile_buffer& pending,
+    boost::system::error_code& ec);
+
+// Returns true and sets ec to would_block if the source is a pipe that is
+// empty, so that the caller can wait for the pipe rather than the socket.
+BOOST_ASIO_DECL bool non_blocking_sendfile(socket_type s, int fd,
+    uint64_t& offset, std::size_t& remaining, sendfile_buffer& pending,
+    boost::system::error_code& ec, size_t& bytes_transferred);
+
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
 BOOST_ASIO_DECL socket_type socket(int af, int type, int protocol,
     boost::system::error_code& ec);
 
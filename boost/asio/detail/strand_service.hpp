@@ -22,6 +22,10 @@
 #include <boost/asio/detail/operation.hpp>
 #include <boost/asio/detail/scoped_ptr.hpp>
 
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+# include <atomic>
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -54,6 +58,35 @@ public:
     friend struct on_do_complete_exit;
     friend struct on_dispatch_exit;
 
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+    // The service that owns the implementation, or null once the service has
+    // been destroyed.
+    strand_service* service_;
+
+    // The number of strand objects that refer to the implementation, plus one
+    // while the strand is locked.
+    std::atomic<long> ref_count_;
+
+    // The number of handlers that have been submitted to the strand but have
+    // not yet completed. The strand is "locked" while this is non-zero, and
+    // the thread that makes it non-zero is responsible for scheduling the
+    // strand. The count is incremented before a handler is added to the
+    // waiting stack.
+    std::atomic<std::size_t> pending_;
+
+    // The handlers that are waiting on the strand, most recent first. Any
+    // thread may push onto the stack, but only the thread that holds the
+    // strand lock may take from it.
+    std::atomic<operation*> waiting_stack_;
+
+    // The handlers that are ready to be run. The ready queue is only modified
+    // from within the strand.
+    op_queue<operation> ready_queue_;
+
+    // Pointers to adjacent implementations in the service's list.
+    strand_impl* next_impl_;
+    strand_impl* prev_impl_;
+#else // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
     // Mutex to protect access to internal data.
     boost::asio::detail::mutex mutex_;
 
@@ -71,6 +104,7 @@ public:
     // handlers that hold the strand's lock. The ready queue is only modified
     // from within the strand and so may be accessed without locking the mutex.
     op_queue<operation> ready_queue_;
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
   };
 
   typedef strand_impl* implementation_type;
@@ -78,12 +112,26 @@ public:
   // Construct a new strand service for the specified io_service.
   BOOST_ASIO_DECL explicit strand_service(boost::asio::io_service& io_service);
 
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+  // Destructor.
+  BOOST_ASIO_DECL ~strand_service();
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+
   // Destroy all user-defined handler objects owned by the service.
   BOOST_ASIO_DECL void shutdown_service();
 
   // Construct a new strand implementation.
   BOOST_ASIO_DECL void construct(implementation_type& impl);
 
+  // Construct a strand implementation that refers to the same strand as
+  // another.
+  BOOST_ASIO_DECL void copy_construct(implementation_type& impl,
+      const implementation_type& other_impl);
+
+  // Destroy a strand implementation. May be called after the service has been
+  // destroyed.
+  BOOST_ASIO_DECL static void destroy(implementation_type& impl);
+
   // Request the io_service to invoke the given handler.
   template <typename Handler>
   void dispatch(implementation_type& impl, Handler& handler);
@@ -109,9 +157,34 @@ private:
       operation* base, const boost::system::error_code& ec,
       std::size_t bytes_transferred);
 
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+  // Helper function to add a handler to the strand's waiting stack. Returns
+  // true if the caller has acquired the strand lock.
+  BOOST_ASIO_DECL static bool push_waiting(
+      implementation_type& impl, operation* op);
+
+  // Helper function to move the waiting handlers to the ready queue.
+  BOOST_ASIO_DECL static void take_waiting(implementation_type& impl);
+
+  // Helper function to release the strand lock after the given number of
+  // handlers have completed. Returns true if more handlers are pending.
+  BOOST_ASIO_DECL static bool unlock(implementation_type& impl,
+      std::size_t num_completed);
+
+  // Helper function to release a reference to an implementation.
+  BOOST_ASIO_DECL static void release(implementation_type& impl);
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+
   // The io_service implementation used to post completions.
   io_service_impl& io_service_;
 
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+  // Mutex to protect access to the list of implementations.
+  boost::asio::detail::mutex mutex_;
+
+  // The head of a linked list of all implementations.
+  strand_impl* impl_list_;
+#else // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
   // Mutex to protect access to the array of implementations.
   boost::asio::detail::mutex mutex_;
 
@@ -128,6 +201,7 @@ private:
   // Extra value used when hashing to prevent recycled memory locations from
   // getting the same strand implementation.
   std::size_t salt_;
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
 };
 
 } // namespace detail
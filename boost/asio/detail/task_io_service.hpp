@@ -23,10 +23,13 @@
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/handler_statistics.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/reactor_fwd.hpp>
 #include <boost/asio/detail/task_io_service_operation.hpp>
+#include <boost/asio/detail/task_io_service_reactor_shard.hpp>
+#include <boost/asio/detail/task_io_service_run_queue.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -47,12 +50,30 @@ public:
   BOOST_ASIO_DECL task_io_service(boost::asio::io_service& io_service,
       std::size_t concurrency_hint = 0);
 
+  // Destructor.
+  BOOST_ASIO_DECL ~task_io_service();
+
   // Destroy all user-defined handler objects owned by the service.
   BOOST_ASIO_DECL void shutdown_service();
 
   // Initialise the task, if required.
   BOOST_ASIO_DECL void init_task();
 
+  // Give each thread running the io_service its own reactor. Has no effect
+  // unless called before the reactor has been created, or if the reactor does
+  // not support multiple instances.
+  BOOST_ASIO_DECL void create_reactors(
+      std::size_t num_reactors, bool thread_affinity);
+
+  // Get the number of reactors that the reactor service should create.
+  std::size_t num_reactors() const
+  {
+    return num_reactor_shards_ > 1 ? num_reactor_shards_ : 1;
+  }
+
+  // Choose the reactor with which a new descriptor is to be registered.
+  BOOST_ASIO_DECL std::size_t choose_reactor();
+
   // Run the event loop until interrupted or no more work.
   BOOST_ASIO_DECL std::size_t run(boost::system::error_code& ec);
 
@@ -74,6 +95,12 @@ public:
   // Reset in preparation for a subsequent run invocation.
   BOOST_ASIO_DECL void reset();
 
+  // Get the counters kept for the handlers run by the io_service.
+  handler_statistics& statistics()
+  {
+    return statistics_;
+  }
+
   // Notify that some work has started.
   void work_started()
   {
@@ -134,6 +161,90 @@ private:
   BOOST_ASIO_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const boost::system::error_code& ec);
 
+  // Run at most one operation using the sharded run queues. Blocks only if
+  // may_block is true.
+  BOOST_ASIO_DECL std::size_t do_run_one_stealing(thread_info& this_thread,
+      const boost::system::error_code& ec, bool may_block);
+
+  // Bind the calling thread to one of the sharded run queues.
+  BOOST_ASIO_DECL void bind_run_queue(thread_info& this_thread);
+
+  // Move any operations left on the thread's run queue to the main queue.
+  BOOST_ASIO_DECL void unbind_run_queue(thread_info& this_thread);
+
+  // Get the number of run queues that have been bound to a thread.
+  BOOST_ASIO_DECL std::size_t bound_run_queues() const;
+
+  // Push operations on to the thread's run queue and wake an idle thread so
+  // that it may steal them.
+  BOOST_ASIO_DECL void push_run_queue(thread_info& this_thread,
+      operation* op);
+  BOOST_ASIO_DECL void push_run_queue(thread_info& this_thread,
+      op_queue<operation>& ops);
+
+  // Pop an operation from the given run queue. Returns 0 if it is empty.
+  BOOST_ASIO_DECL operation* pop_run_queue(task_io_service_run_queue& q);
+
+  // Try to take an operation from the run queue of another thread.
+  BOOST_ASIO_DECL operation* steal_operation(thread_info& this_thread);
+
+  // Determine whether all of the sharded run queues are empty.
+  BOOST_ASIO_DECL bool run_queues_empty() const;
+
+#if defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+  // Run at most one operation on the thread's reactor shard, or one of the
+  // shards it has adopted. Blocks only if may_block is true.
+  BOOST_ASIO_DECL std::size_t do_run_one_pinned(thread_info& this_thread,
+      const boost::system::error_code& ec, bool may_block);
+
+  // Pin the calling thread to a reactor shard, waiting for one to become free
+  // if the thread may block. A nested call shares the shard of the outer
+  // call. Returns false if the thread could not be pinned.
+  BOOST_ASIO_DECL bool bind_reactor_shard(
+      thread_info& this_thread, thread_info* outer_thread);
+
+  // Release the thread's reactor shard so that another thread may run it.
+  BOOST_ASIO_DECL void unbind_reactor_shard(
+      thread_info& this_thread, thread_info* outer_thread);
+
+  // Hand back adopted shards that have been claimed by a thread, and adopt
+  // those that have no thread. The mutex must be held.
+  BOOST_ASIO_DECL void rebalance_reactor_shards(
+      task_io_service_reactor_shard& shard, mutex::scoped_lock& lock);
+
+  // Stop running an adopted shard's reactor. The mutex must be held.
+  BOOST_ASIO_DECL void release_reactor_shard(
+      task_io_service_reactor_shard& shard,
+      task_io_service_reactor_shard& adopted, mutex::scoped_lock& lock);
+
+  // Run the reactor of the given shard, and poll the reactors of the shards it
+  // has adopted.
+  BOOST_ASIO_DECL void run_reactor_shards(task_io_service_reactor_shard& shard,
+      bool block, op_queue<operation>& ops);
+
+  // Record whether a thread is about to block on the shard's reactor. Returns
+  // false, without blocking, if handlers are waiting on the shard.
+  BOOST_ASIO_DECL bool set_task_blocked(
+      task_io_service_reactor_shard& shard, bool blocked);
+
+  // Queue operations posted from outside the io_service on one of the shards
+  // and wake the thread running it.
+  BOOST_ASIO_DECL void post_to_reactor_shard(operation* op);
+  BOOST_ASIO_DECL void post_to_reactor_shard(op_queue<operation>& ops);
+
+  // Push operations on to a shard's queue.
+  BOOST_ASIO_DECL void push_reactor_shard(
+      task_io_service_reactor_shard& shard, op_queue<operation>& ops);
+
+  // Move all operations from a shard's queue. Returns false if it is empty.
+  BOOST_ASIO_DECL bool take_reactor_shard(
+      task_io_service_reactor_shard& shard, op_queue<operation>& ops);
+
+  // Pop an operation from a shard's queue. Returns 0 if it is empty.
+  BOOST_ASIO_DECL operation* pop_reactor_shard(
+      task_io_service_reactor_shard& shard);
+#endif // defined(BOOST_ASIO_HAS_MULTIPLE_REACTORS)
+
   // Stop the task and all idle threads.
   BOOST_ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
@@ -155,6 +266,14 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+  // Helper class to release a thread's run queue on block exit.
+  struct run_queue_cleanup;
+  friend struct run_queue_cleanup;
+
+  // Helper class to release a thread's reactor shard on block exit.
+  struct reactor_shard_cleanup;
+  friend struct reactor_shard_cleanup;
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -176,6 +295,9 @@ private:
   // The count of unfinished work.
   atomic_count outstanding_work_;
 
+  // The counters kept for the handlers run by the io_service.
+  handler_statistics statistics_;
+
   // The queue of handlers that are ready to be delivered.
   op_queue<operation> op_queue_;
 
@@ -190,6 +312,47 @@ private:
 
   // The threads that are currently idle.
   thread_info* first_idle_thread_;
+
+  // Whether handlers posted from within the io_service are queued on
+  // per-thread run queues that idle threads may steal from.
+  const bool work_stealing_;
+
+  // The sharded run queues used when work stealing is enabled.
+  task_io_service_run_queue* run_queues_;
+
+  // The number of sharded run queues.
+  std::size_t num_run_queues_;
+
+  // Used to assign run queues to threads in round-robin order.
+  atomic_count next_run_queue_;
+
+  // The number of threads waiting for work. May be read without holding the
+  // mutex.
+  atomic_count idle_thread_count_;
+
+  // Mirror of stopped_ that may be read without holding the mutex.
+  atomic_count stopped_flag_;
+
+  // The reactor shards used when there is more than one reactor.
+  task_io_service_reactor_shard* reactor_shards_;
+
+  // The number of reactor shards.
+  std::size_t num_reactor_shards_;
+
+  // Whether descriptors are registered with the reactor of the thread that
+  // creates them.
+  bool reactor_thread_affinity_;
+
+  // Used to spread posted handlers across the reactor shards.
+  atomic_count next_reactor_shard_;
+
+  // Used to spread new descriptors across the reactor shards.
+  atomic_count next_descriptor_shard_;
+
+  // Incremented whenever a thread is pinned to or leaves a reactor shard, so
+  // that running threads know to adopt or hand back shards. May be read
+  // without holding the mutex.
+  atomic_count reactor_shard_generation_;
 };
 
 } // namespace detail
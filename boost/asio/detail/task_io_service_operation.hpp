@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/system/error_code.hpp>
+#include <boost/asio/detail/handler_statistics.hpp>
 #include <boost/asio/detail/handler_tracking.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 
@@ -27,6 +28,12 @@ namespace detail {
 
 class task_io_service;
 
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+// Get the statistics kept by a task_io_service.
+BOOST_ASIO_DECL handler_statistics& get_handler_statistics(
+    task_io_service& owner);
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
 // Base class for all operations. A function pointer is used instead of virtual
 // functions to avoid the associated overhead.
 class task_io_service_operation BOOST_ASIO_INHERIT_TRACKED_HANDLER
@@ -35,6 +42,10 @@ public:
   void complete(task_io_service& owner,
       const boost::system::error_code& ec, std::size_t bytes_transferred)
   {
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+    handler_statistics::operation_timer timer(
+        get_handler_statistics(owner), statistics_type_);
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
     func_(&owner, this, ec, bytes_transferred);
   }
 
@@ -52,6 +63,9 @@ protected:
     : next_(0),
       func_(func),
       task_result_(0)
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+      , statistics_type_(handler_statistics::untyped_operation)
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
   {
   }
 
@@ -67,6 +81,11 @@ private:
 protected:
   friend class task_io_service;
   unsigned int task_result_; // Passed into bytes transferred.
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+private:
+  friend class handler_statistics;
+  unsigned char statistics_type_;
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
 };
 
 } // namespace detail
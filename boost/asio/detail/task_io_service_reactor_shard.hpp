@@ -0,0 +1,91 @@
+//
+// detail/task_io_service_reactor_shard.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_TASK_IO_SERVICE_REACTOR_SHARD_HPP
+#define BOOST_ASIO_DETAIL_TASK_IO_SERVICE_REACTOR_SHARD_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class task_io_service_operation;
+struct task_io_service_thread_info;
+
+// One of the reactors of a task_io_service that has been constructed with
+// more than one. Each thread running the io_service is pinned to a shard and
+// is the only thread that runs its reactor. A shard without a thread of its
+// own is adopted by another thread, which runs its reactor alongside its own.
+struct task_io_service_reactor_shard
+  : private noncopyable
+{
+  task_io_service_reactor_shard()
+    : index(0),
+      depth(0),
+      task_blocked(false),
+      owner(0),
+      adopter(0),
+      first_adopted(0),
+      next_adopted(0)
+  {
+  }
+
+  // The reactor's index within the reactor service.
+  std::size_t index;
+
+  // Mutex to protect access to the queue and the task_blocked flag.
+  mutex queue_mutex;
+
+  // Handlers posted to the shard from other threads, and completions from its
+  // reactor while it is adopted.
+  op_queue<task_io_service_operation> ops;
+
+  // The number of handlers in the queue. May be read without holding the
+  // mutex to determine whether the queue is worth locking.
+  atomic_count depth;
+
+  // Whether a thread may be blocked waiting for the reactor. Protected by the
+  // queue mutex.
+  bool task_blocked;
+
+  // The thread pinned to the shard. Protected by the io_service's mutex.
+  task_io_service_thread_info* owner;
+
+  // The shard whose thread runs this shard's reactor while it has no owner.
+  // Protected by the io_service's mutex.
+  task_io_service_reactor_shard* adopter;
+
+  // The shards adopted by this one. Only accessed by the thread running the
+  // shard.
+  task_io_service_reactor_shard* first_adopted;
+  task_io_service_reactor_shard* next_adopted;
+
+  // Keep neighbouring shards on separate cache lines.
+  char padding[64];
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_TASK_IO_SERVICE_REACTOR_SHARD_HPP
@@ -0,0 +1,63 @@
+//
+// detail/task_io_service_run_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_TASK_IO_SERVICE_RUN_QUEUE_HPP
+#define BOOST_ASIO_DETAIL_TASK_IO_SERVICE_RUN_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class task_io_service_operation;
+
+// A shard of the task_io_service's ready queue, used when work stealing is
+// enabled. Each thread running the io_service is bound to one shard, posts
+// handlers to it and drains it first. Idle threads steal from other shards.
+struct task_io_service_run_queue
+  : private noncopyable
+{
+  task_io_service_run_queue()
+    : depth(0)
+  {
+  }
+
+  // Mutex to protect access to the queue. Only contended by stealing threads.
+  mutex queue_mutex;
+
+  // The handlers that are ready to be delivered.
+  op_queue<task_io_service_operation> ops;
+
+  // The number of handlers in the queue. May be read without holding the
+  // mutex to determine whether the queue is worth locking.
+  atomic_count depth;
+
+  // Keep neighbouring shards on separate cache lines.
+  char padding[64];
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_TASK_IO_SERVICE_RUN_QUEUE_HPP
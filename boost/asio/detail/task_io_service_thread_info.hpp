@@ -27,6 +27,8 @@ namespace detail {
 
 class task_io_service;
 class task_io_service_operation;
+struct task_io_service_reactor_shard;
+struct task_io_service_run_queue;
 
 struct task_io_service_thread_info : public thread_info_base
 {
@@ -34,6 +36,9 @@ struct task_io_service_thread_info : public thread_info_base
   op_queue<task_io_service_operation> private_op_queue;
   long private_outstanding_work;
   task_io_service_thread_info* next;
+  task_io_service_run_queue* run_queue;
+  task_io_service_reactor_shard* reactor_shard;
+  long reactor_shard_generation;
 };
 
 } // namespace detail
@@ -15,73 +15,234 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
-#include <climits>
+#include <boost/asio/detail/config.hpp>
 #include <cstddef>
 #include <boost/asio/detail/noncopyable.hpp>
 
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+# include <boost/asio/detail/atomic_count.hpp>
+# include <boost/asio/detail/static_mutex.hpp>
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
 namespace asio {
 namespace detail {
 
+// Per-thread cache of memory blocks used for handler allocation. Block sizes
+// are rounded up to one of a small number of size classes, so that a block
+// may be returned to the cache of any thread regardless of which thread
+// allocated it. Each size class holds up to a fixed number of blocks.
 class thread_info_base
   : private noncopyable
 {
 public:
   thread_info_base()
-    : reusable_memory_(0)
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+    : hits_(0),
+      misses_(0)
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
   {
+    for (std::size_t i = 0; i < num_size_classes; ++i)
+      cache_count_[i] = 0;
+
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+    stats_state* state = get_stats_state();
+    state->mutex_.init();
+    static_mutex::scoped_lock lock(state->mutex_);
+    prev_ = 0;
+    next_ = state->first_;
+    if (next_)
+      next_->prev_ = this;
+    state->first_ = this;
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
   }
 
   ~thread_info_base()
   {
-    if (reusable_memory_)
-      ::operator delete(reusable_memory_);
+    for (std::size_t i = 0; i < num_size_classes; ++i)
+      while (cache_count_[i] > 0)
+        ::operator delete(cache_[i][--cache_count_[i]]);
+
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+    // Keep the counts of exiting threads in the totals.
+    stats_state* state = get_stats_state();
+    static_mutex::scoped_lock lock(state->mutex_);
+    state->hits_ += hits_;
+    state->misses_ += misses_;
+    if (prev_)
+      prev_->next_ = next_;
+    else
+      state->first_ = next_;
+    if (next_)
+      next_->prev_ = prev_;
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
   }
 
   static void* allocate(thread_info_base* this_thread, std::size_t size)
   {
-    if (this_thread && this_thread->reusable_memory_)
+    std::size_t size_class = size_class_of(size);
+    if (size_class == num_size_classes)
     {
-      void* const pointer = this_thread->reusable_memory_;
-      this_thread->reusable_memory_ = 0;
-
-      unsigned char* const mem = static_cast<unsigned char*>(pointer);
-      if (static_cast<std::size_t>(mem[0]) >= size)
-      {
-        mem[size] = mem[0];
-        return pointer;
-      }
+      // Blocks that are too large for any size class are not cached.
+      count_miss(this_thread);
+      return ::operator new(size);
+    }
 
-      ::operator delete(pointer);
+    if (this_thread && this_thread->cache_count_[size_class] > 0)
+    {
+      count_hit(this_thread);
+      return this_thread->cache_[size_class][
+        --this_thread->cache_count_[size_class]];
     }
 
-    void* const pointer = ::operator new(size + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (size <= UCHAR_MAX) ? static_cast<unsigned char>(size) : 0;
-    return pointer;
+    count_miss(this_thread);
+    return ::operator new(block_size(size_class));
   }
 
   static void deallocate(thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= UCHAR_MAX)
+    std::size_t size_class = size_class_of(size);
+    if (size_class != num_size_classes && this_thread
+        && this_thread->cache_count_[size_class] < cache_size)
     {
-      if (this_thread && this_thread->reusable_memory_ == 0)
-      {
-        unsigned char* const mem = static_cast<unsigned char*>(pointer);
-        mem[0] = mem[size];
-        this_thread->reusable_memory_ = pointer;
-        return;
-      }
+      this_thread->cache_[size_class][
+        this_thread->cache_count_[size_class]++] = pointer;
+      return;
     }
 
     ::operator delete(pointer);
   }
 
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+  // The number of allocations that were served from a thread's cache.
+  static long allocation_hits()
+  {
+    return sum_counts(&thread_info_base::hits_, &stats_state::hits_);
+  }
+
+  // The number of allocations that required a call to ::operator new.
+  static long allocation_misses()
+  {
+    return sum_counts(&thread_info_base::misses_, &stats_state::misses_);
+  }
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+
 private:
-  void* reusable_memory_;
+  enum
+  {
+    // The block size of the smallest size class.
+    min_block_size = 64,
+
+    // The number of size classes. Each is double the size of the last.
+    num_size_classes = 5,
+
+    // The number of blocks held for each size class. Zero disables caching.
+#if defined(BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+    cache_size = BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
+#else // defined(BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+    cache_size = 4
+#endif // defined(BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+  };
+
+  // Get the size class for a block of the given size, or num_size_classes if
+  // the block is too large to be cached.
+  static std::size_t size_class_of(std::size_t size)
+  {
+    std::size_t size_class = 0;
+    std::size_t class_size = min_block_size;
+    while (size > class_size && size_class < num_size_classes)
+    {
+      class_size <<= 1;
+      ++size_class;
+    }
+    return size_class;
+  }
+
+  // Get the size of the blocks in a size class.
+  static std::size_t block_size(std::size_t size_class)
+  {
+    return static_cast<std::size_t>(min_block_size) << size_class;
+  }
+
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+  // The registry of the threads' counters. Counts of threads that have exited
+  // and of allocations made outside any thread running an io_service are
+  // added to the totals here.
+  struct stats_state
+  {
+    static_mutex mutex_;
+    thread_info_base* first_;
+    long hits_;
+    long misses_;
+  };
+
+  static stats_state* get_stats_state()
+  {
+    static stats_state state = { BOOST_ASIO_STATIC_MUTEX_INIT, 0, 0, 0 };
+    return &state;
+  }
+
+  static long sum_counts(atomic_count thread_info_base::* thread_count,
+      long stats_state::* total)
+  {
+    stats_state* state = get_stats_state();
+    state->mutex_.init();
+    static_mutex::scoped_lock lock(state->mutex_);
+    long count = state->*total;
+    for (thread_info_base* t = state->first_; t; t = t->next_)
+      count += static_cast<long>(t->*thread_count);
+    return count;
+  }
+
+  // Each thread only updates its own counters, so they are never contended.
+  static void count_hit(thread_info_base* this_thread)
+  {
+    ++this_thread->hits_;
+  }
+
+  static void count_miss(thread_info_base* this_thread)
+  {
+    if (this_thread)
+    {
+      ++this_thread->misses_;
+    }
+    else
+    {
+      stats_state* state = get_stats_state();
+      state->mutex_.init();
+      static_mutex::scoped_lock lock(state->mutex_);
+      ++state->misses_;
+    }
+  }
+#else // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+  static void count_hit(thread_info_base*)
+  {
+  }
+
+  static void count_miss(thread_info_base*)
+  {
+  }
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+
+  // The cached blocks for each size class. There is always room for one
+  // block so that the array is not empty when caching is disabled.
+  void* cache_[num_size_classes][cache_size > 0 ? cache_size : 1];
+
+  // The number of cached blocks for each size class.
+  std::size_t cache_count_[num_size_classes];
+
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+  // The number of allocations served from, and missing, this thread's cache.
+  atomic_count hits_;
+  atomic_count misses_;
+
+  // The neighbouring threads in the registry.
+  thread_info_base* prev_;
+  thread_info_base* next_;
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
 };
 
 } // namespace detail
@@ -0,0 +1,550 @@
+//
+// detail/timer_wheel.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
+#define BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/timer_wheel_traits.hpp>
+#include <boost/asio/detail/chrono_time_traits.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/date_time_fwd.hpp>
+#include <boost/asio/detail/limits.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/timer_queue.hpp>
+#include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/detail/wait_op.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A hierarchical timing wheel with a resolution of one millisecond. Each level
+// of the wheel has 64 slots, and a slot at level n covers 64^n ticks. Timers
+// are moved to a lower level when the wheel reaches their slot, and all timers
+// in a level 0 slot become ready together. Timers that are ready are checked
+// against their exact expiry time before they are dequeued.
+template <typename Time_Traits>
+class timer_wheel
+  : public timer_queue_base
+{
+public:
+  // The time type.
+  typedef typename Time_Traits::time_type time_type;
+
+  // The duration type.
+  typedef typename Time_Traits::duration_type duration_type;
+
+  // Per-timer data.
+  class per_timer_data
+  {
+  public:
+    per_timer_data() : level_(no_level), next_(0), prev_(0) {}
+
+  private:
+    friend class timer_wheel;
+
+    // The operations waiting on the timer.
+    op_queue<wait_op> op_queue_;
+
+    // The time when the timer should fire.
+    time_type time_;
+
+    // The tick in which the timer should fire.
+    int64_t tick_;
+
+    // The level and slot of the wheel that holds the timer.
+    int level_;
+    std::size_t slot_;
+
+    // Pointers to adjacent timers in the same slot.
+    per_timer_data* next_;
+    per_timer_data* prev_;
+  };
+
+  // Constructor.
+  timer_wheel()
+    : origin_(Time_Traits::now()),
+      current_tick_(0),
+      ready_(0),
+      infinite_(0),
+      wakeup_usec_((std::numeric_limits<int64_t>::max)())
+  {
+    for (int level = 0; level < num_levels; ++level)
+    {
+      occupied_[level] = 0;
+      for (std::size_t slot = 0; slot < num_slots; ++slot)
+        slots_[level][slot] = 0;
+    }
+  }
+
+  // Add a new timer to the queue. Returns true if the timer expires before
+  // the queue is next due to be checked, in which case the reactor's event
+  // demultiplexing function call may need to be interrupted and restarted.
+  bool enqueue_timer(const time_type& time, per_timer_data& timer, wait_op* op)
+  {
+    // Enqueue the timer object.
+    if (timer.level_ == no_level)
+    {
+      timer.time_ = time;
+      if (this->is_positive_infinity(time))
+      {
+        // No wheel slot is required for timers that never expire.
+        timer.level_ = infinite_level;
+        push_front(infinite_, timer);
+      }
+      else
+      {
+        timer.tick_ = to_tick(to_usec(time));
+        link_timer(timer);
+      }
+    }
+
+    // Enqueue the individual timer operation.
+    timer.op_queue_.push(op);
+
+    // Interrupt reactor only if the new timer expires before the reactor is
+    // next due to wake up.
+    if (timer.level_ != infinite_level && timer.op_queue_.front() == op)
+    {
+      int64_t usec = to_usec(time);
+      if (usec < wakeup_usec_)
+      {
+        wakeup_usec_ = usec;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Whether there are no timers in the queue.
+  virtual bool empty() const
+  {
+    if (ready_ || infinite_)
+      return false;
+    for (int level = 0; level < num_levels; ++level)
+      if (occupied_[level] != 0)
+        return false;
+    return true;
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    const time_type now = Time_Traits::now();
+    int64_t usec = wait_duration(now,
+        static_cast<int64_t>(max_duration) * 1000);
+    long msec = static_cast<long>(usec / 1000);
+    if (msec == 0 && usec > 0)
+      msec = 1;
+    wakeup_usec_ = to_usec(now) + static_cast<int64_t>(msec) * 1000;
+    return msec;
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    const time_type now = Time_Traits::now();
+    int64_t usec = wait_duration(now, max_duration);
+    wakeup_usec_ = to_usec(now) + usec;
+    return static_cast<long>(usec);
+  }
+
+  // Dequeue all timers not later than the current time.
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    const time_type now = Time_Traits::now();
+    advance(to_tick(to_usec(now)));
+
+    per_timer_data* timer = ready_;
+    while (timer)
+    {
+      per_timer_data* next = timer->next_;
+      if (!Time_Traits::less_than(now, timer->time_))
+      {
+        ops.push(timer->op_queue_);
+        unlink_timer(*timer);
+      }
+      timer = next;
+    }
+  }
+
+  // Dequeue all timers.
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    get_all_timers(ready_, ops);
+    get_all_timers(infinite_, ops);
+    for (int level = 0; level < num_levels; ++level)
+    {
+      occupied_[level] = 0;
+      for (std::size_t slot = 0; slot < num_slots; ++slot)
+        get_all_timers(slots_[level][slot], ops);
+    }
+  }
+
+  // Cancel and dequeue operations for the given timer.
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
+  {
+    std::size_t num_cancelled = 0;
+    if (timer.level_ != no_level)
+    {
+      while (wait_op* op = (num_cancelled != max_cancelled)
+          ? timer.op_queue_.front() : 0)
+      {
+        op->ec_ = boost::asio::error::operation_aborted;
+        timer.op_queue_.pop();
+        ops.push(op);
+        ++num_cancelled;
+      }
+      if (timer.op_queue_.empty())
+        unlink_timer(timer);
+    }
+    return num_cancelled;
+  }
+
+private:
+  enum
+  {
+    // The number of bits of the tick used to select a slot at each level.
+    slot_bits = 6,
+
+    // The number of levels in the wheel.
+    num_levels = 6,
+
+    // The number of microseconds in a tick.
+    tick_usec = 1000,
+
+    // Values of per_timer_data::level_ for timers that are not in a slot.
+    ready_level = -1,
+    infinite_level = -2,
+    no_level = -3
+  };
+
+  // The number of slots at each level.
+  static const std::size_t num_slots = std::size_t(1) << slot_bits;
+
+  // The furthest a timer can be placed from the current tick. Timers that
+  // expire later than this are placed in the last slot, and are moved again
+  // when the wheel reaches it.
+  static int64_t max_delta()
+  {
+    return (int64_t(1) << (slot_bits * num_levels)) - 1;
+  }
+
+  // Get the number of microseconds between the wheel's origin and a time.
+  int64_t to_usec(const time_type& time) const
+  {
+    return Time_Traits::to_posix_duration(
+        Time_Traits::subtract(time, origin_)).total_microseconds();
+  }
+
+  // Get the tick that contains a time, given in microseconds since the origin.
+  static int64_t to_tick(int64_t usec)
+  {
+    return usec < 0 ? -1 : usec / tick_usec;
+  }
+
+  // Get the head of the list that holds the timer.
+  per_timer_data*& list_head(per_timer_data& timer)
+  {
+    if (timer.level_ == ready_level)
+      return ready_;
+    if (timer.level_ == infinite_level)
+      return infinite_;
+    return slots_[timer.level_][timer.slot_];
+  }
+
+  // Insert a timer at the front of a list.
+  static void push_front(per_timer_data*& head, per_timer_data& timer)
+  {
+    timer.prev_ = 0;
+    timer.next_ = head;
+    if (head)
+      head->prev_ = &timer;
+    head = &timer;
+  }
+
+  // Dequeue all timers in a list.
+  static void get_all_timers(per_timer_data*& head, op_queue<operation>& ops)
+  {
+    while (head)
+    {
+      per_timer_data* timer = head;
+      head = timer->next_;
+      ops.push(timer->op_queue_);
+      timer->level_ = no_level;
+      timer->next_ = 0;
+      timer->prev_ = 0;
+    }
+  }
+
+  // Place a timer in the wheel according to its tick.
+  void link_timer(per_timer_data& timer)
+  {
+    int64_t delta = timer.tick_ - current_tick_;
+    if (delta <= 0)
+    {
+      timer.level_ = ready_level;
+    }
+    else
+    {
+      int64_t tick = timer.tick_;
+      if (delta > max_delta())
+      {
+        delta = max_delta();
+        tick = current_tick_ + delta;
+      }
+
+      int level = 0;
+      while (delta >= (int64_t(1) << (slot_bits * (level + 1))))
+        ++level;
+
+      timer.level_ = level;
+      timer.slot_ = static_cast<std::size_t>(
+          tick >> (slot_bits * level)) & (num_slots - 1);
+      occupied_[level] |= uint64_t(1) << timer.slot_;
+    }
+
+    push_front(list_head(timer), timer);
+  }
+
+  // Remove a timer from the queue.
+  void unlink_timer(per_timer_data& timer)
+  {
+    per_timer_data*& head = list_head(timer);
+    if (head == &timer)
+      head = timer.next_;
+    if (timer.prev_)
+      timer.prev_->next_ = timer.next_;
+    if (timer.next_)
+      timer.next_->prev_ = timer.prev_;
+
+    if (head == 0 && timer.level_ >= 0)
+      occupied_[timer.level_] &= ~(uint64_t(1) << timer.slot_);
+
+    timer.level_ = no_level;
+    timer.next_ = 0;
+    timer.prev_ = 0;
+  }
+
+  // Move the timers in a slot to their new positions.
+  void cascade(int level, std::size_t slot)
+  {
+    per_timer_data* timer = slots_[level][slot];
+    slots_[level][slot] = 0;
+    occupied_[level] &= ~(uint64_t(1) << slot);
+
+    while (timer)
+    {
+      per_timer_data* next = timer->next_;
+      link_timer(*timer);
+      timer = next;
+    }
+  }
+
+  // Advance the wheel to the given tick, making ready all timers in the level
+  // 0 slots that are passed.
+  void advance(int64_t tick)
+  {
+    while (current_tick_ < tick)
+    {
+      if (occupied_[0] == 0)
+      {
+        bool empty = true;
+        for (int level = 1; level < num_levels; ++level)
+          if (occupied_[level] != 0)
+            empty = false;
+        if (empty)
+        {
+          current_tick_ = tick;
+          return;
+        }
+
+        // Skip to the end of the current level 0 rotation, since nothing can
+        // become ready before the next slot at a higher level is reached.
+        int64_t last = current_tick_ | int64_t(num_slots - 1);
+        current_tick_ = last < tick ? last : tick;
+        if (current_tick_ == tick)
+          return;
+      }
+
+      ++current_tick_;
+
+      // Move timers down from the higher levels whenever a lower level
+      // completes a rotation.
+      std::size_t slot = static_cast<std::size_t>(current_tick_)
+        & (num_slots - 1);
+      for (int level = 1; slot == 0 && level < num_levels; ++level)
+      {
+        slot = static_cast<std::size_t>(
+            current_tick_ >> (slot_bits * level)) & (num_slots - 1);
+        cascade(level, slot);
+      }
+
+      cascade(0, static_cast<std::size_t>(current_tick_) & (num_slots - 1));
+    }
+  }
+
+  // Get the distance, from 1 to num_slots, to the next occupied slot after
+  // the given one.
+  static std::size_t next_occupied(uint64_t bits, std::size_t slot)
+  {
+    std::size_t shift = (slot + 1) & (num_slots - 1);
+    if (shift != 0)
+      bits = (bits >> shift) | (bits << (num_slots - shift));
+    std::size_t distance = 1;
+    while ((bits & 1) == 0)
+    {
+      bits >>= 1;
+      ++distance;
+    }
+    return distance;
+  }
+
+  // Get the number of microseconds until a time, rounded up to at least one
+  // microsecond if the time has not yet been reached.
+  static int64_t usec_until(const time_type& time, const time_type& now)
+  {
+    return to_positive_usec(Time_Traits::to_posix_duration(
+          Time_Traits::subtract(time, now)));
+  }
+
+  // Helper function to convert a duration into microseconds.
+  template <typename Duration>
+  static int64_t to_positive_usec(const Duration& d)
+  {
+    if (d.ticks() <= 0)
+      return 0;
+    int64_t usec = d.total_microseconds();
+    return usec == 0 ? 1 : usec;
+  }
+
+  // Get the number of microseconds until the next timer may become ready.
+  int64_t wait_duration(const time_type& now, int64_t max_duration) const
+  {
+    int64_t result = max_duration;
+
+    // Timers that are ready need only wait until their exact expiry time.
+    for (per_timer_data* timer = ready_; timer; timer = timer->next_)
+    {
+      int64_t usec = usec_until(timer->time_, now);
+      if (usec < result)
+        result = usec;
+    }
+
+    // Timers in the first occupied slot at level 0 all fall in the same tick.
+    // For higher levels, wake up when the slot is moved down.
+    int64_t now_usec = to_usec(now);
+    for (int level = 0; level < num_levels; ++level)
+    {
+      if (occupied_[level] == 0)
+        continue;
+
+      int shift = slot_bits * level;
+      std::size_t slot = static_cast<std::size_t>(
+          current_tick_ >> shift) & (num_slots - 1);
+      std::size_t distance = next_occupied(occupied_[level], slot);
+
+      if (level == 0)
+      {
+        for (per_timer_data* timer =
+              slots_[0][(slot + distance) & (num_slots - 1)];
+            timer; timer = timer->next_)
+        {
+          int64_t usec = usec_until(timer->time_, now);
+          if (usec < result)
+            result = usec;
+        }
+      }
+      else
+      {
+        int64_t tick = ((current_tick_ >> shift)
+            + static_cast<int64_t>(distance)) << shift;
+        int64_t usec = tick * tick_usec - now_usec;
+        if (usec < 0)
+          usec = 0;
+        if (usec < result)
+          result = usec;
+      }
+    }
+
+    return result;
+  }
+
+  // Determine if the specified absolute time is positive infinity.
+  template <typename Time_Type>
+  static bool is_positive_infinity(const Time_Type&)
+  {
+    return false;
+  }
+
+  // Determine if the specified absolute time is positive infinity.
+  template <typename T, typename TimeSystem>
+  static bool is_positive_infinity(
+      const boost::date_time::base_time<T, TimeSystem>& time)
+  {
+    return time.is_pos_infinity();
+  }
+
+  // The time corresponding to the start of tick 0.
+  time_type origin_;
+
+  // The tick that the wheel has most recently advanced to.
+  int64_t current_tick_;
+
+  // The head of a linked list of timers whose tick has been reached.
+  per_timer_data* ready_;
+
+  // The head of a linked list of timers that never expire.
+  per_timer_data* infinite_;
+
+  // The slots at each level of the wheel.
+  per_timer_data* slots_[num_levels][num_slots];
+
+  // A bit mask of the occupied slots at each level of the wheel.
+  uint64_t occupied_[num_levels];
+
+  // The latest time, in microseconds since the origin, at which the reactor
+  // is known to check the queue again.
+  mutable int64_t wakeup_usec_;
+};
+
+// Select the timing wheel for deadline timers that use timer_wheel_traits.
+template <typename Time_Traits>
+class timer_queue<boost::asio::timer_wheel_traits<Time_Traits> >
+  : public timer_wheel<boost::asio::timer_wheel_traits<Time_Traits> >
+{
+};
+
+// Select the timing wheel for waitable timers that use timer_wheel_traits.
+template <typename Clock, typename WaitTraits>
+class timer_queue<chrono_time_traits<Clock,
+    boost::asio::timer_wheel_traits<WaitTraits> > >
+  : public timer_wheel<chrono_time_traits<Clock,
+      boost::asio::timer_wheel_traits<WaitTraits> > >
+{
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
@@ -21,6 +21,7 @@
 
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/handler_statistics.hpp>
 #include <boost/asio/detail/limits.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
@@ -90,6 +91,12 @@ public:
     ::InterlockedExchange(&stopped_, 0);
   }
 
+  // Get the counters kept for the handlers run by the io_service.
+  handler_statistics& statistics()
+  {
+    return statistics_;
+  }
+
   // Notify that some work has started.
   void work_started()
   {
@@ -233,6 +240,10 @@ private:
   // The count of unfinished work.
   long outstanding_work_;
 
+  // The counters kept for the handlers run by the io_service. Operations are
+  // counted as queued when they are dequeued from the completion port.
+  handler_statistics statistics_;
+
   // Flag to indicate whether the event loop has been stopped.
   mutable long stopped_;
 
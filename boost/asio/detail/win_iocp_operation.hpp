@@ -19,6 +19,7 @@
 
 #if defined(BOOST_ASIO_HAS_IOCP)
 
+#include <boost/asio/detail/handler_statistics.hpp>
 #include <boost/asio/detail/handler_tracking.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/socket_types.hpp>
@@ -32,6 +33,12 @@ namespace detail {
 
 class win_iocp_io_service;
 
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+// Get the statistics kept by a win_iocp_io_service.
+BOOST_ASIO_DECL handler_statistics& get_handler_statistics(
+    win_iocp_io_service& owner);
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
 // Base class for all operations. A function pointer is used instead of virtual
 // functions to avoid the associated overhead.
 class win_iocp_operation
@@ -43,6 +50,10 @@ public:
       const boost::system::error_code& ec,
       std::size_t bytes_transferred)
   {
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+    handler_statistics::operation_timer timer(
+        get_handler_statistics(owner), statistics_type_);
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
     func_(&owner, this, ec, bytes_transferred);
   }
 
@@ -59,6 +70,9 @@ protected:
   win_iocp_operation(func_type func)
     : next_(0),
       func_(func)
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+      , statistics_type_(handler_statistics::untyped_operation)
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
   {
     reset();
   }
@@ -84,6 +98,10 @@ private:
   win_iocp_operation* next_;
   func_type func_;
   long ready_;
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+  friend class handler_statistics;
+  unsigned char statistics_type_;
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
 };
 
 } // namespace detail
@@ -48,6 +48,20 @@ io_service::io_service(std::size_t concurrency_hint)
 {
 }
 
+io_service::io_service(std::size_t num_reactors,
+    reactor_assignment assignment)
+  : service_registry_(new boost::asio::detail::service_registry(
+        *this, static_cast<impl_type*>(0), num_reactors)),
+    impl_(service_registry_->first_service<impl_type>())
+{
+#if defined(BOOST_ASIO_HAS_IOCP)
+  (void)assignment;
+#else // defined(BOOST_ASIO_HAS_IOCP)
+  impl_.create_reactors(num_reactors,
+      assignment == thread_affinity_assignment);
+#endif // defined(BOOST_ASIO_HAS_IOCP)
+}
+
 io_service::~io_service()
 {
   delete service_registry_;
@@ -175,7 +175,8 @@ namespace detail
     read_op(read_op&& other)
       : detail::base_from_completion_cond<CompletionCondition>(other),
         stream_(other.stream_),
-        buffers_(other.buffers_),
+        buffers_(BOOST_ASIO_MOVE_CAST2(boost::asio::detail::consuming_buffers<
+          mutable_buffer, MutableBufferSequence>)(other.buffers_)),
         start_(other.start_),
         total_transferred_(other.total_transferred_),
         handler_(BOOST_ASIO_MOVE_CAST(ReadHandler)(other.handler_))
@@ -192,8 +193,15 @@ namespace detail
         buffers_.prepare(this->check_for_completion(ec, total_transferred_));
         for (;;)
         {
-          stream_.async_read_some(buffers_,
-              BOOST_ASIO_MOVE_CAST(read_op)(*this));
+          {
+            // The buffers are prepared before the call, as the handler may
+            // be moved from when the argument is constructed.
+            typename boost::asio::detail::consuming_buffers<mutable_buffer,
+              MutableBufferSequence>::prepared_buffers_type prepared_buffers
+                = buffers_.prepared();
+            stream_.async_read_some(prepared_buffers,
+                BOOST_ASIO_MOVE_CAST(read_op)(*this));
+          }
           return; default:
           total_transferred_ += bytes_transferred;
           buffers_.consume(bytes_transferred);
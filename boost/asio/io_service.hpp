@@ -213,6 +213,49 @@ public:
    */
   BOOST_ASIO_DECL explicit io_service(std::size_t concurrency_hint);
 
+  /// Determines which reactor a new socket or descriptor is registered with,
+  /// when the io_service has more than one.
+  enum reactor_assignment
+  {
+    /// Spread descriptors across the reactors in turn.
+    round_robin_assignment,
+
+    /// Use the reactor owned by the thread that creates or opens the
+    /// descriptor, if it is running the io_service. For example, sockets
+    /// accepted in a handler stay with the thread that runs the acceptor.
+    /// Descriptors created by other threads are spread across the reactors in
+    /// turn.
+    thread_affinity_assignment
+  };
+
+  /// Constructor.
+  /**
+   * Construct with a separate reactor for each thread that runs the
+   * io_service.
+   *
+   * Each thread that calls run(), run_one(), poll() or poll_one() is pinned
+   * to one of the reactors for the duration of the call. It waits for events
+   * on that reactor only, and handlers it posts are run on the same thread.
+   * Handlers posted from outside the io_service are spread across the
+   * threads, which are woken through the reactor's eventfd. A reactor with no
+   * thread of its own is run by one of the other threads until a thread
+   * becomes available for it. Threads beyond the number of reactors wait until
+   * a reactor becomes free.
+   *
+   * @param num_reactors The number of reactors to create. This should be the
+   * number of threads that will run the io_service.
+   *
+   * @param assignment Determines which reactor each new socket or descriptor
+   * is registered with.
+   *
+   * @note Only the epoll-based implementation supports more than one reactor.
+   * Other implementations use a single reactor, as if constructed with
+   * @c num_reactors as the concurrency hint. Timers are always run by the
+   * first reactor.
+   */
+  BOOST_ASIO_DECL io_service(std::size_t num_reactors,
+      reactor_assignment assignment);
+
   /// Destructor.
   /**
    * On destruction, the io_service performs the following sequence of
@@ -0,0 +1,217 @@
+//
+// io_service_statistics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IO_SERVICE_STATISTICS_HPP
+#define BOOST_ASIO_IO_SERVICE_STATISTICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/handler_statistics.hpp>
+#include <boost/asio/io_service.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// A snapshot of the counters kept for the handlers run by an io_service.
+/**
+ * The io_service_statistics class takes a copy of the counters that an
+ * io_service keeps for the handlers it runs: how many have been queued, how
+ * many have been executed, how long they took, and how long was spent waiting
+ * for the reactor.
+ *
+ * The counters are only kept when the program is compiled with
+ * @c BOOST_ASIO_ENABLE_HANDLER_STATISTICS defined, and broken down by the type
+ * of operation when @c BOOST_ASIO_ENABLE_HANDLER_TYPE_STATISTICS is defined.
+ * Otherwise all values are zero.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * A snapshot may be taken from any thread without blocking the threads that
+ * are running the io_service. The counters are read one at a time, so the
+ * values in a snapshot that is taken while handlers are running may differ
+ * slightly from one another.
+ *
+ * @par Example
+ * Finding handlers that have run for longer than 10 milliseconds:
+ * @code
+ * boost::asio::io_service_statistics stats(my_io_service);
+ * for (std::size_t i = 0; i < stats.histogram_buckets; ++i)
+ *   if (stats.histogram_bucket_limit_usec(i) > 10000)
+ *     slow_handlers += stats.handler_histogram(i);
+ * @endcode
+ */
+class io_service_statistics
+{
+public:
+  /// The types of operation that are counted separately.
+  enum operation_type
+  {
+    /// Handlers passed to io_service::post() or io_service::dispatch().
+    posted_handlers = 0,
+
+    /// Handlers passed to strand::post() or strand::dispatch().
+    strand_handlers,
+
+    /// Asynchronous waits on a timer.
+    timer_operations,
+
+    /// Asynchronous receive operations on a socket.
+    socket_receive_operations,
+
+    /// Asynchronous send operations on a socket.
+    socket_send_operations,
+
+    /// Asynchronous accept operations.
+    socket_accept_operations,
+
+    /// Asynchronous connect operations.
+    socket_connect_operations,
+
+    /// Asynchronous operations on a POSIX stream descriptor.
+    descriptor_operations,
+
+    /// All other asynchronous operations.
+    other_operations,
+
+    /// The number of operation types.
+    operation_types
+  };
+
+  /// The number of buckets in a histogram of execution times.
+  BOOST_ASIO_STATIC_CONSTANT(std::size_t, histogram_buckets
+      = detail::handler_statistics_values::histogram_buckets);
+
+  /// Construct a snapshot in which all values are zero.
+  BOOST_ASIO_DECL io_service_statistics();
+
+  /// Construct a snapshot of the counters kept by an io_service.
+  BOOST_ASIO_DECL explicit io_service_statistics(
+      boost::asio::io_service& io_service);
+
+  /// Get the number of handlers that have been queued for execution.
+  /**
+   * Counts handlers passed to post() or dispatch() that could not be run
+   * immediately, and the completion handlers of asynchronous operations.
+   */
+  uint64_t handlers_queued() const
+  {
+    return values_.handlers_queued;
+  }
+
+  /// Get the number of handlers that have been executed.
+  uint64_t handlers_executed() const
+  {
+    return values_.handlers_executed;
+  }
+
+  /// Get the number of handlers that are queued or running.
+  /**
+   * A queue depth that keeps growing while handlers_executed() stays the same
+   * means that the threads running the io_service are stalled.
+   *
+   * On Windows, operations that are waiting in the I/O completion port are not
+   * included.
+   */
+  uint64_t queue_depth() const
+  {
+    return values_.handlers_queued > values_.handlers_executed
+      ? values_.handlers_queued - values_.handlers_executed : 0;
+  }
+
+  /// Get the total time spent executing handlers, in microseconds.
+  uint64_t handler_usec() const
+  {
+    return values_.handler_usec;
+  }
+
+  /// Get the longest time taken by a single handler, in microseconds.
+  uint64_t max_handler_usec() const
+  {
+    return values_.max_handler_usec;
+  }
+
+  /// Get the number of handlers whose execution time fell into a bucket.
+  /**
+   * Bucket @c n counts handlers that ran for less than
+   * <tt>histogram_bucket_limit_usec(n)</tt> microseconds, and for at least
+   * <tt>histogram_bucket_limit_usec(n - 1)</tt> if @c n is non-zero. The last
+   * bucket has no upper limit.
+   */
+  uint64_t handler_histogram(std::size_t bucket) const
+  {
+    return bucket < histogram_buckets ? values_.histogram[bucket] : 0;
+  }
+
+  /// Get the upper limit of a histogram bucket, in microseconds.
+  static uint64_t histogram_bucket_limit_usec(std::size_t bucket)
+  {
+    return static_cast<uint64_t>(1) << bucket;
+  }
+
+  /// Get the number of times that the reactor has been run.
+  uint64_t reactor_waits() const
+  {
+    return values_.reactor_waits;
+  }
+
+  /// Get the total time spent in the reactor, in microseconds.
+  /**
+   * Includes both the time spent waiting for events and the time spent
+   * processing them.
+   */
+  uint64_t reactor_wait_usec() const
+  {
+    return values_.reactor_wait_usec;
+  }
+
+  /// Get the number of operations of a type that have completed.
+  uint64_t operations_completed(operation_type type) const
+  {
+    return type < operation_types ? values_.operations_completed[type] : 0;
+  }
+
+  /// Get the total time spent completing operations of a type, in
+  /// microseconds.
+  uint64_t operation_usec(operation_type type) const
+  {
+    return type < operation_types ? values_.operation_usec[type] : 0;
+  }
+
+  /// Get the number of operations of a type whose completion time fell into a
+  /// histogram bucket.
+  uint64_t operation_histogram(operation_type type, std::size_t bucket) const
+  {
+    return type < operation_types && bucket < histogram_buckets
+      ? values_.operation_histogram[type][bucket] : 0;
+  }
+
+private:
+  detail::handler_statistics_values values_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/io_service_statistics.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_IO_SERVICE_STATISTICS_HPP
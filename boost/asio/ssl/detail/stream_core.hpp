@@ -42,6 +42,9 @@ struct stream_core
   // sufficient to hold the largest possible TLS record.
   enum { max_tls_record_size = 17 * 1024 };
 
+  // The most application data that fits in a single TLS record.
+  enum { max_tls_record_data_size = 16 * 1024 };
+
   stream_core(SSL_CTX* context, boost::asio::io_service& io_service)
     : engine_(context),
       pending_read_(io_service),
@@ -114,6 +117,10 @@ struct stream_core
 
   // The buffer pointing to the engine's unconsumed input.
   boost::asio::const_buffer input_;
+
+  // Buffer space used to gather small buffers into a single record. Only
+  // allocated when write coalescing is enabled.
+  std::vector<unsigned char> write_coalescing_space_;
 };
 
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
@@ -18,6 +18,7 @@
 #include <boost/asio/detail/config.hpp>
 
 #if !defined(BOOST_ASIO_ENABLE_OLD_SSL)
+# include <cstring>
 # include <boost/asio/detail/buffer_sequence_adapter.hpp>
 # include <boost/asio/ssl/detail/engine.hpp>
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
@@ -35,8 +36,11 @@ template <typename ConstBufferSequence>
 class write_op
 {
 public:
-  write_op(const ConstBufferSequence& buffers)
-    : buffers_(buffers)
+  // Small buffers are only coalesced if storage is provided for them.
+  explicit write_op(const ConstBufferSequence& buffers,
+      const boost::asio::mutable_buffer& storage = boost::asio::mutable_buffer())
+    : buffers_(buffers),
+      storage_(storage)
   {
   }
 
@@ -44,9 +48,7 @@ public:
       boost::system::error_code& ec,
       std::size_t& bytes_transferred) const
   {
-    boost::asio::const_buffer buffer =
-      boost::asio::detail::buffer_sequence_adapter<boost::asio::const_buffer,
-        ConstBufferSequence>::first(buffers_);
+    boost::asio::const_buffer buffer = coalesce();
 
     return eng.write(buffer, ec, bytes_transferred);
   }
@@ -60,7 +62,59 @@ public:
   }
 
 private:
+  // Get the data to be written in the next record. A first buffer that is
+  // large enough to fill the storage is used as is. Otherwise the data from as
+  // many buffers as will fit is copied into the storage, so that a sequence
+  // of small buffers is sent as one record rather than one record for each.
+  boost::asio::const_buffer coalesce() const
+  {
+    boost::asio::const_buffer first =
+      boost::asio::detail::buffer_sequence_adapter<boost::asio::const_buffer,
+        ConstBufferSequence>::first(buffers_);
+    std::size_t max_record_data = boost::asio::buffer_size(storage_);
+    if (boost::asio::buffer_size(first) >= max_record_data)
+      return first;
+
+    unsigned char* storage =
+      boost::asio::buffer_cast<unsigned char*>(storage_);
+
+    // The first buffer is only copied once a second one has been found.
+    std::size_t length = boost::asio::buffer_size(first);
+    bool seen_first = false;
+    bool copied = false;
+    typename ConstBufferSequence::const_iterator iter = buffers_.begin();
+    typename ConstBufferSequence::const_iterator end = buffers_.end();
+    for (; iter != end && length < max_record_data; ++iter)
+    {
+      boost::asio::const_buffer buffer(*iter);
+      std::size_t size = boost::asio::buffer_size(buffer);
+      if (size == 0)
+        continue;
+      if (!seen_first)
+      {
+        seen_first = true;
+        continue;
+      }
+      if (!copied)
+      {
+        std::memcpy(storage,
+            boost::asio::buffer_cast<const void*>(first), length);
+        copied = true;
+      }
+      if (size > max_record_data - length)
+        size = max_record_data - length;
+      std::memcpy(storage + length,
+          boost::asio::buffer_cast<const void*>(buffer), size);
+      length += size;
+    }
+
+    if (!copied)
+      return first;
+    return boost::asio::const_buffer(storage, length);
+  }
+
   ConstBufferSequence buffers_;
+  boost::asio::mutable_buffer storage_;
 };
 
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
@@ -348,6 +348,28 @@ public:
         new detail::verify_callback<VerifyCallback>(callback), ec);
   }
 
+  /// Set whether small buffers are coalesced into full records.
+  /**
+   * This function is used to specify whether a write operation given a
+   * sequence of small buffers copies as many of them as will fit into a single
+   * TLS record, rather than sending a separate record for each buffer. It is
+   * disabled by default.
+   *
+   * Enabling coalescing allocates a 16 KB staging buffer owned by the stream.
+   * Disabling it frees that buffer. This function must not be called while a
+   * write operation is outstanding.
+   *
+   * @param enabled Whether write coalescing is to be enabled.
+   */
+  void set_write_coalescing(bool enabled)
+  {
+    if (enabled)
+      core_.write_coalescing_space_.resize(
+          detail::stream_core::max_tls_record_data_size);
+    else
+      std::vector<unsigned char>().swap(core_.write_coalescing_space_);
+  }
+
   /// Perform SSL handshaking.
   /**
    * This function is used to perform SSL handshaking on the stream. The
@@ -604,7 +626,8 @@ public:
       boost::system::error_code& ec)
   {
     return detail::io(next_layer_, core_,
-        detail::write_op<ConstBufferSequence>(buffers), ec);
+        detail::write_op<ConstBufferSequence>(buffers,
+          boost::asio::buffer(core_.write_coalescing_space_)), ec);
   }
 
   /// Start an asynchronous write.
@@ -644,7 +667,8 @@ public:
         BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
 
     detail::async_io(next_layer_, core_,
-        detail::write_op<ConstBufferSequence>(buffers), init.handler);
+        detail::write_op<ConstBufferSequence>(buffers,
+          boost::asio::buffer(core_.write_coalescing_space_)), init.handler);
 
     return init.result.get();
   }
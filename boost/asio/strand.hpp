@@ -100,6 +100,18 @@ public:
     service_.construct(impl_);
   }
 
+  /// Copy constructor.
+  /**
+   * Constructs a strand object that refers to the same strand as @c other.
+   * Handlers submitted through either object will not be executed
+   * concurrently with each other.
+   */
+  strand(const strand& other)
+    : service_(other.service_)
+  {
+    service_.copy_construct(impl_, other.impl_);
+  }
+
   /// Destructor.
   /**
    * Destroys a strand.
@@ -109,6 +121,8 @@ public:
    */
   ~strand()
   {
+    // The io_service, and with it the service, may already be destroyed.
+    boost::asio::detail::strand_service::destroy(impl_);
   }
 
   /// Get the io_service associated with the strand.
@@ -18,6 +18,7 @@
 #include <boost/asio/detail/config.hpp>
 #include <cstddef>
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/type_traits.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/io_service.hpp>
@@ -332,6 +333,27 @@ public:
     return init.result.get();
   }
 
+#if (!defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a range of a file.
+  template <typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_file(implementation_type& impl, int file,
+      uint64_t offset, std::size_t length,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    detail::async_result_init<
+      WriteHandler, void (boost::system::error_code, std::size_t)> init(
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+
+    service_impl_.async_send_file(impl, file, offset, length, init.handler);
+
+    return init.result.get();
+  }
+#endif // (!defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__))
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data from the peer.
   template <typename MutableBufferSequence>
   std::size_t receive(implementation_type& impl,
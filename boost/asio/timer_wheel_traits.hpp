@@ -0,0 +1,66 @@
+//
+// timer_wheel_traits.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_TIMER_WHEEL_TRAITS_HPP
+#define BOOST_ASIO_TIMER_WHEEL_TRAITS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Traits adapter that selects a timing wheel to hold a timer service's
+/// pending timers.
+/**
+ * By default, the timers belonging to a timer service are kept in a binary
+ * heap, so that starting or cancelling a wait costs O(log n). When the @c
+ * Traits argument of a timer is wrapped in @c timer_wheel_traits, the timers
+ * are instead kept in a hierarchical timing wheel with a resolution of one
+ * millisecond. Starting or cancelling a wait is then O(1), and timers that
+ * expire in the same millisecond are dequeued together. This suits programs
+ * that hold a very large number of timers that are frequently rescheduled,
+ * such as per-connection inactivity timeouts. A timer never expires before
+ * its expiry time.
+ *
+ * The adapter may be used with either the @c TimeTraits argument of
+ * basic_deadline_timer, or the @c WaitTraits argument of
+ * basic_waitable_timer:
+ *
+ * @code
+ * typedef boost::asio::basic_deadline_timer<boost::posix_time::ptime,
+ *     boost::asio::timer_wheel_traits<
+ *       boost::asio::time_traits<boost::posix_time::ptime> > >
+ *   wheel_deadline_timer;
+ *
+ * typedef boost::asio::basic_waitable_timer<boost::chrono::steady_clock,
+ *     boost::asio::timer_wheel_traits<
+ *       boost::asio::wait_traits<boost::chrono::steady_clock> > >
+ *   wheel_steady_timer;
+ * @endcode
+ *
+ * Timers that use different traits types are held by different timer
+ * services, so the two kinds of queue may be used side by side.
+ */
+template <typename Traits>
+struct timer_wheel_traits
+  : Traits
+{
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_TIMER_WHEEL_TRAITS_HPP
@@ -124,6 +124,32 @@ template <class Key
          ,class Allocator = std::allocator<std::pair<Key, T> > >
 class flat_multimap;
 
+//btree_set class
+template <class Key
+         ,class Compare  = std::less<Key>
+         ,class Allocator = std::allocator<Key> >
+class btree_set;
+
+//btree_multiset class
+template <class Key
+         ,class Compare  = std::less<Key>
+         ,class Allocator = std::allocator<Key> >
+class btree_multiset;
+
+//btree_map class
+template <class Key
+         ,class T
+         ,class Compare  = std::less<Key>
+         ,class Allocator = std::allocator<std::pair<const Key, T> > >
+class btree_map;
+
+//btree_multimap class
+template <class Key
+         ,class T
+         ,class Compare  = std::less<Key>
+         ,class Allocator = std::allocator<std::pair<const Key, T> > >
+class btree_multimap;
+
 //basic_string class
 template <class CharT
          ,class Traits = std::char_traits<CharT>
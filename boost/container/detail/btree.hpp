@@ -0,0 +1,1493 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2005-2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_BTREE_HPP
+#define BOOST_CONTAINER_BTREE_HPP
+
+#include "config_begin.hpp"
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/container_fwd.hpp>
+
+#include <boost/move/utility.hpp>
+#include <boost/intrusive/pointer_traits.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <boost/detail/no_exceptions_support.hpp>
+#include <boost/container/detail/utilities.hpp>
+#include <boost/container/detail/mpl.hpp>
+#include <boost/container/detail/pair.hpp>
+#include <boost/container/detail/tree.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include <boost/container/allocator_traits.hpp>
+#ifndef BOOST_CONTAINER_PERFECT_FORWARDING
+#include <boost/container/detail/preprocessor.hpp>
+#endif
+
+#include <utility>   //std::pair
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+//! The size in bytes that btree_set, btree_map and their multi variants aim for
+//! with each node, including the node header. The number of values per node is
+//! derived from it, but it is never smaller than 3.
+#ifndef BOOST_CONTAINER_BTREE_NODE_SIZE
+#define BOOST_CONTAINER_BTREE_NODE_SIZE 256
+#endif
+
+namespace boost {
+namespace container {
+namespace container_detail {
+
+//Values are stored with a non-const key so that they can be moved
+//between nodes. The iterators type-pun them to value_type, as rbtree does.
+template<class T>
+struct btree_internal_data_type
+{
+   typedef T type;
+};
+
+template<class T1, class T2>
+struct btree_internal_data_type< std::pair<const T1, T2> >
+{
+   typedef pair<T1, T2> type;
+};
+
+template<class T1, class T2>
+struct btree_internal_data_type< std::pair<T1, T2> >
+{
+   typedef pair<T1, T2> type;
+};
+
+template<class T, class VoidPointer>
+struct btree_node;
+
+template<class T, class VoidPointer>
+struct btree_internal_node;
+
+template<class T, class VoidPointer>
+struct btree_node_header
+{
+   typedef typename boost::intrusive::pointer_traits<VoidPointer>::template
+      rebind_pointer<btree_node<T, VoidPointer> >::type  node_ptr;
+
+   node_ptr       m_parent;
+   //Index of this node in the children of m_parent
+   unsigned short m_position;
+   unsigned short m_count;
+   bool           m_leaf;
+};
+
+template<class T, class VoidPointer>
+struct btree_node_capacity
+{
+   static const std::size_t header_size = sizeof(btree_node_header<T, VoidPointer>);
+   static const std::size_t value =
+      (BOOST_CONTAINER_BTREE_NODE_SIZE >= header_size + 3u*sizeof(T))
+         ? (BOOST_CONTAINER_BTREE_NODE_SIZE - header_size)/sizeof(T)
+         : 3u;
+   BOOST_STATIC_ASSERT(value < 65535u);
+};
+
+//A leaf node: a header followed by up to "capacity" values, sorted.
+template<class T, class VoidPointer>
+struct btree_node
+   :  public btree_node_header<T, VoidPointer>
+{
+   typedef btree_node_header<T, VoidPointer>       header_t;
+   typedef typename header_t::node_ptr             node_ptr;
+   typedef btree_internal_node<T, VoidPointer>     internal_node_t;
+   static const std::size_t capacity = btree_node_capacity<T, VoidPointer>::value;
+
+   T *values()
+   {  return static_cast<T*>(m_values.address());  }
+
+   const T *values() const
+   {  return static_cast<const T*>(m_values.address());  }
+
+   btree_node *parent() const
+   {  return container_detail::to_raw_pointer(this->m_parent);  }
+
+   btree_node *child(std::size_t i) const
+   {  return container_detail::to_raw_pointer(static_cast<const internal_node_t*>(this)->m_children[i]);  }
+
+   boost::aligned_storage<sizeof(T)*capacity, alignment_of<T>::value> m_values;
+};
+
+//An internal node: "m_count" values separating "m_count + 1" children.
+template<class T, class VoidPointer>
+struct btree_internal_node
+   :  public btree_node<T, VoidPointer>
+{
+   typedef typename btree_node<T, VoidPointer>::node_ptr node_ptr;
+   node_ptr m_children[btree_node<T, VoidPointer>::capacity + 1];
+};
+
+template<class Node, class Value, class Pointer, bool IsConst>
+class btree_iterator
+   :  public std::iterator
+      < std::bidirectional_iterator_tag
+      , Value
+      , typename boost::intrusive::pointer_traits<Pointer>::difference_type
+      , typename if_c< IsConst
+                     , typename boost::intrusive::pointer_traits<Pointer>::template
+                        rebind_pointer<const Value>::type
+                     , Pointer>::type
+      , typename if_c<IsConst, const Value &, Value &>::type>
+{
+   public:
+   typedef Value                                                     value_type;
+   typedef typename if_c< IsConst
+                        , typename boost::intrusive::pointer_traits<Pointer>::template
+                           rebind_pointer<const Value>::type
+                        , Pointer>::type                             pointer;
+   typedef typename if_c<IsConst, const Value &, Value &>::type      reference;
+
+   btree_iterator()
+      :  m_node(0), m_pos(0)
+   {}
+
+   btree_iterator(Node *node, std::size_t pos) BOOST_CONTAINER_NOEXCEPT
+      :  m_node(node), m_pos(pos)
+   {}
+
+   btree_iterator(btree_iterator<Node, Value, Pointer, false> const& other) BOOST_CONTAINER_NOEXCEPT
+      :  m_node(other.get_node()), m_pos(other.get_pos())
+   {}
+
+   btree_iterator& operator++() BOOST_CONTAINER_NOEXCEPT
+   {
+      if(!m_node->m_leaf || ++m_pos == m_node->m_count){
+         this->increment_slow();
+      }
+      return *this;
+   }
+
+   btree_iterator operator++(int) BOOST_CONTAINER_NOEXCEPT
+   {
+      btree_iterator result (*this);
+      ++*this;
+      return result;
+   }
+
+   btree_iterator& operator--() BOOST_CONTAINER_NOEXCEPT
+   {
+      if(m_node->m_leaf && m_pos != 0){
+         --m_pos;
+      }
+      else{
+         this->decrement_slow();
+      }
+      return *this;
+   }
+
+   btree_iterator operator--(int) BOOST_CONTAINER_NOEXCEPT
+   {
+      btree_iterator result (*this);
+      --*this;
+      return result;
+   }
+
+   friend bool operator== (const btree_iterator& l, const btree_iterator& r) BOOST_CONTAINER_NOEXCEPT
+   {  return l.m_node == r.m_node && l.m_pos == r.m_pos;   }
+
+   friend bool operator!= (const btree_iterator& l, const btree_iterator& r) BOOST_CONTAINER_NOEXCEPT
+   {  return !(l == r); }
+
+   reference operator*()  const BOOST_CONTAINER_NOEXCEPT
+   {  return *reinterpret_cast<Value*>(&m_node->values()[m_pos]);  }
+
+   pointer   operator->() const BOOST_CONTAINER_NOEXCEPT
+   {  return ::boost::intrusive::pointer_traits<pointer>::pointer_to(this->operator*());  }
+
+   Node *get_node() const BOOST_CONTAINER_NOEXCEPT
+   {  return m_node;   }
+
+   std::size_t get_pos() const BOOST_CONTAINER_NOEXCEPT
+   {  return m_pos;   }
+
+   private:
+   void increment_slow()
+   {
+      if(m_node->m_leaf){
+         //Past the last value of a leaf: climb until we come from a child
+         //that has a separator on its right. end() stays in the rightmost leaf.
+         Node * const leaf = m_node;
+         const std::size_t leaf_pos = m_pos;
+         while(m_pos == m_node->m_count && m_node->m_parent){
+            m_pos  = m_node->m_position;
+            m_node = m_node->parent();
+         }
+         if(m_pos == m_node->m_count){
+            m_node = leaf;
+            m_pos  = leaf_pos;
+         }
+      }
+      else{
+         //The successor of a separator is the first value of the leftmost
+         //leaf of its right subtree
+         m_node = m_node->child(m_pos + 1);
+         while(!m_node->m_leaf){
+            m_node = m_node->child(0);
+         }
+         m_pos = 0;
+      }
+   }
+
+   void decrement_slow()
+   {
+      if(m_node->m_leaf){
+         while(m_pos == 0 && m_node->m_parent){
+            m_pos  = m_node->m_position;
+            m_node = m_node->parent();
+         }
+         BOOST_ASSERT(m_pos != 0);
+         --m_pos;
+      }
+      else{
+         m_node = m_node->child(m_pos);
+         while(!m_node->m_leaf){
+            m_node = m_node->child(m_node->m_count);
+         }
+         m_pos = m_node->m_count - 1;
+      }
+   }
+
+   Node        *m_node;
+   std::size_t m_pos;
+};
+
+//Destroys a value constructed in raw storage when going out of scope
+template<class A, class T>
+class btree_value_destructor
+{
+   public:
+   btree_value_destructor(A &a, T &v)
+      :  m_a(a), m_v(v)
+   {}
+
+   ~btree_value_destructor()
+   {  allocator_traits<A>::destroy(m_a, &m_v);  }
+
+   private:
+   A &m_a;
+   T &m_v;
+};
+
+//A B-tree of values ordered by the keys KeyOfValue extracts from them. It
+//offers the interface of rbtree, so that btree_set and btree_map are
+//implemented like set and map. Each node stores as many values as
+//fit in BOOST_CONTAINER_BTREE_NODE_SIZE bytes, which makes lookups and
+//traversals touch far fewer cache lines than a node-per-value tree.
+//Like in the B-trees of most databases and of Abseil, values are stored both
+//in internal nodes and in leaves. Values are moved between nodes when
+//nodes are split, merged or rebalanced, so insertions and erasures invalidate
+//iterators and references, as in flat_tree.
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A>
+class btree
+{
+   typedef tree_value_compare
+            <Key, Value, KeyCompare, KeyOfValue>               ValComp;
+   typedef typename btree_internal_data_type<Value>::type     internal_type;
+   typedef typename allocator_traits<A>::void_pointer          void_pointer;
+   typedef btree_node<internal_type, void_pointer>             node_t;
+   typedef btree_internal_node<internal_type, void_pointer>    internal_node_t;
+   typedef typename boost::intrusive::pointer_traits
+      <void_pointer>::template rebind_pointer<node_t>::type    node_ptr;
+   typedef allocator_traits<A>                                 alloc_traits;
+   typedef typename alloc_traits::template
+      portable_rebind_alloc<node_t>::type                      leaf_allocator_t;
+   typedef typename alloc_traits::template
+      portable_rebind_alloc<internal_node_t>::type             internal_allocator_t;
+   typedef allocator_traits<leaf_allocator_t>                  leaf_alloc_traits;
+   typedef allocator_traits<internal_allocator_t>              internal_alloc_traits;
+   typedef btree < Key, Value, KeyOfValue
+                 , KeyCompare, A>                              ThisType;
+   typedef btree_value_destructor<A, internal_type>            value_destructor_t;
+
+   struct members_holder
+      :  public ValComp, public A
+   {
+      explicit members_holder(const ValComp &c)
+         :  ValComp(c), A(), m_root(), m_leftmost(), m_rightmost(), m_size(0)
+      {}
+
+      template<class AllocConvertible>
+      members_holder(const ValComp &c, BOOST_FWD_REF(AllocConvertible) a)
+         :  ValComp(c), A(boost::forward<AllocConvertible>(a))
+         ,  m_root(), m_leftmost(), m_rightmost(), m_size(0)
+      {}
+
+      node_ptr    m_root;
+      node_ptr    m_leftmost;
+      node_ptr    m_rightmost;
+      std::size_t m_size;
+   } m_data;
+
+   BOOST_COPYABLE_AND_MOVABLE(btree)
+
+   public:
+
+   typedef Key                                        key_type;
+   typedef Value                                      value_type;
+   typedef A                                          allocator_type;
+   typedef KeyCompare                                 key_compare;
+   typedef ValComp                                    value_compare;
+   typedef typename boost::container::
+      allocator_traits<A>::pointer                    pointer;
+   typedef typename boost::container::
+      allocator_traits<A>::const_pointer              const_pointer;
+   typedef typename boost::container::
+      allocator_traits<A>::reference                  reference;
+   typedef typename boost::container::
+      allocator_traits<A>::const_reference            const_reference;
+   typedef typename boost::container::
+      allocator_traits<A>::size_type                  size_type;
+   typedef typename boost::container::
+      allocator_traits<A>::difference_type            difference_type;
+   typedef difference_type                            rbtree_difference_type;
+   typedef pointer                                    rbtree_pointer;
+   typedef const_pointer                              rbtree_const_pointer;
+   typedef reference                                  rbtree_reference;
+   typedef const_reference                            rbtree_const_reference;
+   typedef A                                          stored_allocator_type;
+
+   typedef btree_iterator<node_t, Value, pointer, false>    iterator;
+   typedef btree_iterator<node_t, Value, pointer, true>     const_iterator;
+   typedef std::reverse_iterator<iterator>                  reverse_iterator;
+   typedef std::reverse_iterator<const_iterator>            const_reverse_iterator;
+
+   btree()
+      : m_data(ValComp(key_compare()))
+   {}
+
+   explicit btree(const key_compare& comp, const allocator_type& a = allocator_type())
+      : m_data(ValComp(comp), a)
+   {}
+
+   explicit btree(const allocator_type& a)
+      : m_data(ValComp(key_compare()), a)
+   {}
+
+   template <class InputIterator>
+   btree(bool unique_insertion, InputIterator first, InputIterator last, const key_compare& comp,
+          const allocator_type& a)
+      : m_data(ValComp(comp), a)
+   {
+      BOOST_TRY{
+         //Use cend() as hint to achieve linear time for
+         //ordered ranges as required by the standard
+         //for the constructor
+         if(unique_insertion){
+            for ( ; first != last; ++first){
+               this->insert_unique(this->cend(), *first);
+            }
+         }
+         else{
+            for ( ; first != last; ++first){
+               this->insert_equal(this->cend(), *first);
+            }
+         }
+      }
+      BOOST_CATCH(...){
+         this->clear();
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+   }
+
+   template <class InputIterator>
+   btree( ordered_range_t, InputIterator first, InputIterator last
+        , const key_compare& comp = key_compare(), const allocator_type& a = allocator_type())
+      : m_data(ValComp(comp), a)
+   {
+      BOOST_TRY{
+         for ( ; first != last; ++first){
+            this->push_back_impl(*first);
+         }
+      }
+      BOOST_CATCH(...){
+         this->clear();
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+   }
+
+   btree(const btree& x)
+      :  m_data(x.value_comp(), alloc_traits::select_on_container_copy_construction(x.m_data))
+   {  this->priv_copy_from(x);   }
+
+   btree(BOOST_RV_REF(btree) x)
+      :  m_data(x.value_comp(), ::boost::move(x.alloc()))
+   {  this->priv_steal(x);   }
+
+   btree(const btree& x, const allocator_type &a)
+      :  m_data(x.value_comp(), a)
+   {  this->priv_copy_from(x);   }
+
+   btree(BOOST_RV_REF(btree) x, const allocator_type &a)
+      :  m_data(x.value_comp(), a)
+   {
+      if(this->alloc() == x.alloc()){
+         this->priv_steal(x);
+      }
+      else{
+         this->priv_move_from(x);
+      }
+   }
+
+   ~btree()
+   {  this->clear();  }
+
+   btree& operator=(BOOST_COPY_ASSIGN_REF(btree) x)
+   {
+      if (&x != this){
+         A &this_alloc     = this->alloc();
+         const A &x_alloc  = x.alloc();
+         container_detail::bool_<allocator_traits<A>::
+            propagate_on_container_copy_assignment::value> flag;
+         this->clear();
+         container_detail::assign_alloc(this_alloc, x_alloc, flag);
+         this->priv_copy_from(x);
+      }
+      return *this;
+   }
+
+   btree& operator=(BOOST_RV_REF(btree) x)
+   {
+      if (&x != this){
+         A &this_alloc = this->alloc();
+         A &x_alloc    = x.alloc();
+         container_detail::bool_<allocator_traits<A>::
+            propagate_on_container_move_assignment::value> flag;
+         this->clear();
+         //If allocators are equal or propagate we can just steal the nodes
+         if(flag || this_alloc == x_alloc){
+            container_detail::move_alloc(this_alloc, x_alloc, flag);
+            this->priv_steal(x);
+         }
+         //If unequal allocators, then do a one by one move
+         else{
+            this->priv_move_from(x);
+         }
+      }
+      return *this;
+   }
+
+   public:
+   // accessors:
+   value_compare value_comp() const
+   {  return static_cast<const ValComp &>(m_data); }
+
+   key_compare key_comp() const
+   {  return static_cast<const ValComp &>(m_data).key_comp(); }
+
+   allocator_type get_allocator() const
+   {  return allocator_type(this->alloc()); }
+
+   const stored_allocator_type &get_stored_allocator() const
+   {  return this->alloc(); }
+
+   stored_allocator_type &get_stored_allocator()
+   {  return this->alloc(); }
+
+   iterator begin()
+   { return iterator(this->priv_leftmost(), 0); }
+
+   const_iterator begin() const
+   {  return this->cbegin();  }
+
+   iterator end()
+   {
+      node_t *const n = this->priv_rightmost();
+      return iterator(n, n ? n->m_count : 0);
+   }
+
+   const_iterator end() const
+   {  return this->cend();  }
+
+   reverse_iterator rbegin()
+   {  return reverse_iterator(end());  }
+
+   const_reverse_iterator rbegin() const
+   {  return this->crbegin();  }
+
+   reverse_iterator rend()
+   {  return reverse_iterator(begin());   }
+
+   const_reverse_iterator rend() const
+   {  return this->crend();   }
+
+   //! <b>Effects</b>: Returns a const_iterator to the first element contained in the container.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_iterator cbegin() const
+   { return const_iterator(this->priv_leftmost(), 0); }
+
+   //! <b>Effects</b>: Returns a const_iterator to the end of the container.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_iterator cend() const
+   {
+      node_t *const n = this->priv_rightmost();
+      return const_iterator(n, n ? n->m_count : 0);
+   }
+
+   //! <b>Effects</b>: Returns a const_reverse_iterator pointing to the beginning
+   //! of the reversed container.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_reverse_iterator crbegin() const
+   { return const_reverse_iterator(cend()); }
+
+   //! <b>Effects</b>: Returns a const_reverse_iterator pointing to the end
+   //! of the reversed container.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   const_reverse_iterator crend() const
+   { return const_reverse_iterator(cbegin()); }
+
+   bool empty() const
+   {  return !m_data.m_size;  }
+
+   size_type size() const
+   {  return m_data.m_size;  }
+
+   size_type max_size() const
+   {  return alloc_traits::max_size(this->alloc());  }
+
+   void swap(ThisType& x)
+   {
+      container_detail::bool_<allocator_traits<A>::
+         propagate_on_container_swap::value> flag;
+      container_detail::swap_alloc(this->alloc(), x.alloc(), flag);
+      std::swap(static_cast<ValComp&>(m_data), static_cast<ValComp&>(x.m_data));
+      std::swap(m_data.m_root, x.m_data.m_root);
+      std::swap(m_data.m_leftmost, x.m_data.m_leftmost);
+      std::swap(m_data.m_rightmost, x.m_data.m_rightmost);
+      std::swap(m_data.m_size, x.m_data.m_size);
+   }
+
+   public:
+
+   std::pair<iterator,bool> insert_unique(const value_type& v)
+   {  return this->priv_insert_unique(v);  }
+
+   template<class MovableConvertible>
+   std::pair<iterator,bool> insert_unique(BOOST_FWD_REF(MovableConvertible) mv)
+   {  return this->priv_insert_unique(boost::forward<MovableConvertible>(mv));  }
+
+   template<class MovableConvertible>
+   void push_back_impl(BOOST_FWD_REF(MovableConvertible) mv)
+   {
+      BOOST_ASSERT(this->empty() || !this->key_comp()(KeyOfValue()(mv), KeyOfValue()(*(--this->cend()))));
+      node_t *const n = this->priv_rightmost();
+      this->priv_insert_at(n, n ? n->m_count : 0, boost::forward<MovableConvertible>(mv));
+   }
+
+   #ifdef BOOST_CONTAINER_PERFECT_FORWARDING
+
+   template <class... Args>
+   std::pair<iterator, bool> emplace_unique(Args&&... args)
+   {
+      boost::aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;
+      internal_type &val = *static_cast<internal_type *>(v.address());
+      alloc_traits::construct(this->alloc(), &val, ::boost::forward<Args>(args)... );
+      value_destructor_t d(this->alloc(), val);
+      return this->insert_unique(::boost::move(val));
+   }
+
+   template <class... Args>
+   iterator emplace_hint_unique(const_iterator hint, Args&&... args)
+   {
+      boost::aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;
+      internal_type &val = *static_cast<internal_type *>(v.address());
+      alloc_traits::construct(this->alloc(), &val, ::boost::forward<Args>(args)... );
+      value_destructor_t d(this->alloc(), val);
+      return this->insert_unique(hint, ::boost::move(val));
+   }
+
+   template <class... Args>
+   iterator emplace_equal(Args&&... args)
+   {
+      boost::aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;
+      internal_type &val = *static_cast<internal_type *>(v.address());
+      alloc_traits::construct(this->alloc(), &val, ::boost::forward<Args>(args)... );
+      value_destructor_t d(this->alloc(), val);
+      return this->insert_equal(::boost::move(val));
+   }
+
+   template <class... Args>
+   iterator emplace_hint_equal(const_iterator hint, Args&&... args)
+   {
+      boost::aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;
+      internal_type &val = *static_cast<internal_type *>(v.address());
+      alloc_traits::construct(this->alloc(), &val, ::boost::forward<Args>(args)... );
+      value_destructor_t d(this->alloc(), val);
+      return this->insert_equal(hint, ::boost::move(val));
+   }
+
+   #else //#ifdef BOOST_CONTAINER_PERFECT_FORWARDING
+
+   #define BOOST_PP_LOCAL_MACRO(n)                                                                          \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >)                   \
+   std::pair<iterator, bool> emplace_unique(BOOST_PP_ENUM(n, BOOST_CONTAINER_PP_PARAM_LIST, _))             \
+   {                                                                                                        \
+      boost::aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;                  \
+      internal_type &val = *static_cast<internal_type *>(v.address());                                      \
+      alloc_traits::construct(this->alloc(), &val                                                           \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                                  \
+      value_destructor_t d(this->alloc(), val);                                                             \
+      return this->insert_unique(::boost::move(val));                                                       \
+   }                                                                                                        \
+                                                                                                            \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >)                   \
+   iterator emplace_hint_unique(const_iterator hint                                                         \
+                       BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_LIST, _))                         \
+   {                                                                                                        \
+      boost::aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;                  \
+      internal_type &val = *static_cast<internal_type *>(v.address());                                      \
+      alloc_traits::construct(this->alloc(), &val                                                           \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                                  \
+      value_destructor_t d(this->alloc(), val);                                                             \
+      return this->insert_unique(hint, ::boost::move(val));                                                 \
+   }                                                                                                        \
+                                                                                                            \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >)                   \
+   iterator emplace_equal(BOOST_PP_ENUM(n, BOOST_CONTAINER_PP_PARAM_LIST, _))                               \
+   {                                                                                                        \
+      boost::aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;                  \
+      internal_type &val = *static_cast<internal_type *>(v.address());                                      \
+      alloc_traits::construct(this->alloc(), &val                                                           \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                                  \
+      value_destructor_t d(this->alloc(), val);                                                             \
+      return this->insert_equal(::boost::move(val));                                                        \
+   }                                                                                                        \
+                                                                                                            \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >)                   \
+   iterator emplace_hint_equal(const_iterator hint                                                          \
+                       BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_LIST, _))                         \
+   {                                                                                                        \
+      boost::aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;                  \
+      internal_type &val = *static_cast<internal_type *>(v.address());                                      \
+      alloc_traits::construct(this->alloc(), &val                                                           \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                                  \
+      value_destructor_t d(this->alloc(), val);                                                             \
+      return this->insert_equal(hint, ::boost::move(val));                                                  \
+   }                                                                                                        \
+   //!
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_CONTAINER_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+
+   #endif   //#ifdef BOOST_CONTAINER_PERFECT_FORWARDING
+
+   iterator insert_unique(const_iterator hint, const value_type& v)
+   {  return this->priv_insert_unique(hint, v);  }
+
+   template<class MovableConvertible>
+   iterator insert_unique(const_iterator hint, BOOST_FWD_REF(MovableConvertible) mv)
+   {  return this->priv_insert_unique(hint, boost::forward<MovableConvertible>(mv));  }
+
+   template <class InputIterator>
+   void insert_unique(InputIterator first, InputIterator last)
+   {
+      for( ; first != last; ++first)
+         this->insert_unique(*first);
+   }
+
+   iterator insert_equal(const value_type& v)
+   {  return this->priv_insert_equal(v);  }
+
+   template<class MovableConvertible>
+   iterator insert_equal(BOOST_FWD_REF(MovableConvertible) mv)
+   {  return this->priv_insert_equal(boost::forward<MovableConvertible>(mv));  }
+
+   iterator insert_equal(const_iterator hint, const value_type& v)
+   {  return this->priv_insert_equal(hint, v);  }
+
+   template<class MovableConvertible>
+   iterator insert_equal(const_iterator hint, BOOST_FWD_REF(MovableConvertible) mv)
+   {  return this->priv_insert_equal(hint, boost::forward<MovableConvertible>(mv));  }
+
+   template <class InputIterator>
+   void insert_equal(InputIterator first, InputIterator last)
+   {
+      for( ; first != last; ++first)
+         this->insert_equal(*first);
+   }
+
+   iterator erase(const_iterator position)
+   {
+      node_t *n = position.get_node();
+      std::size_t pos = position.get_pos();
+      BOOST_ASSERT(n && pos < n->m_count);
+      A &a = this->alloc();
+      alloc_traits::destroy(a, &n->values()[pos]);
+      const bool internal_erase = !n->m_leaf;
+      if(internal_erase){
+         //Replace the value with its predecessor, which is the last value
+         //of a leaf, and erase the predecessor from that leaf instead
+         --position;
+         node_t *const leaf = position.get_node();
+         this->priv_relocate(n->values()[pos], leaf->values()[position.get_pos()]);
+         n   = leaf;
+         pos = position.get_pos();
+      }
+      else{
+         this->priv_move_values(n->values() + pos, n->values() + pos + 1, n->m_count - pos - 1);
+      }
+      --n->m_count;
+      --m_data.m_size;
+      iterator ret(this->priv_rebalance_after_erase(n, pos));
+      if(internal_erase){
+         //ret points to the predecessor, now stored where the erased value was
+         ++ret;
+      }
+      return ret;
+   }
+
+   size_type erase(const key_type& k)
+   {
+      std::pair<iterator,iterator> ret = this->equal_range(k);
+      const size_type n = static_cast<size_type>(std::distance(ret.first, ret.second));
+      this->priv_erase_n(ret.first, n);
+      return n;
+   }
+
+   iterator erase(const_iterator first, const_iterator last)
+   {
+      //Each erasure invalidates "last", so count the values first
+      return this->priv_erase_n
+         (first, static_cast<size_type>(std::distance(first, last)));
+   }
+
+   void clear()
+   {
+      if(node_t *const r = this->priv_root()){
+         this->priv_destroy_subtree(r);
+         m_data.m_root = m_data.m_leftmost = m_data.m_rightmost = node_ptr();
+         m_data.m_size = 0;
+      }
+   }
+
+   // set operations:
+   iterator find(const key_type& k)
+   {
+      iterator i = this->lower_bound(k);
+      return (i == this->end() || this->key_comp()(k, KeyOfValue()(*i))) ? this->end() : i;
+   }
+
+   const_iterator find(const key_type& k) const
+   {  return const_cast<btree&>(*this).find(k);  }
+
+   size_type count(const key_type& k) const
+   {
+      std::pair<const_iterator, const_iterator> ret = this->equal_range(k);
+      return static_cast<size_type>(std::distance(ret.first, ret.second));
+   }
+
+   iterator lower_bound(const key_type& k)
+   {
+      node_t *n = this->priv_root();
+      if(!n){
+         return this->end();
+      }
+      std::size_t pos;
+      for(;;){
+         pos = this->priv_node_lower_bound(n, k);
+         if(n->m_leaf)
+            break;
+         n = n->child(pos);
+      }
+      return this->priv_climb_from_leaf_end(n, pos);
+   }
+
+   const_iterator lower_bound(const key_type& k) const
+   {  return const_cast<btree&>(*this).lower_bound(k);  }
+
+   iterator upper_bound(const key_type& k)
+   {
+      node_t *n = this->priv_root();
+      if(!n){
+         return this->end();
+      }
+      std::size_t pos;
+      for(;;){
+         pos = this->priv_node_upper_bound(n, k);
+         if(n->m_leaf)
+            break;
+         n = n->child(pos);
+      }
+      return this->priv_climb_from_leaf_end(n, pos);
+   }
+
+   const_iterator upper_bound(const key_type& k) const
+   {  return const_cast<btree&>(*this).upper_bound(k);  }
+
+   std::pair<iterator,iterator> equal_range(const key_type& k)
+   {  return std::pair<iterator,iterator>(this->lower_bound(k), this->upper_bound(k));  }
+
+   std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+   {
+      return std::pair<const_iterator,const_iterator>
+         (this->lower_bound(k), this->upper_bound(k));
+   }
+
+   private:
+
+   A &alloc()
+   {  return m_data;  }
+
+   const A &alloc() const
+   {  return m_data;  }
+
+   //Every node but the root keeps at least this number of values. Not a
+   //constant of the class, so that it can be instantiated with incomplete types.
+   static std::size_t priv_min_node_values()
+   {  return node_t::capacity/2;  }
+
+   node_t *priv_root() const
+   {  return container_detail::to_raw_pointer(m_data.m_root);  }
+
+   node_t *priv_leftmost() const
+   {  return container_detail::to_raw_pointer(m_data.m_leftmost);  }
+
+   node_t *priv_rightmost() const
+   {  return container_detail::to_raw_pointer(m_data.m_rightmost);  }
+
+   static node_ptr priv_ptr(node_t *n)
+   {  return n ? boost::intrusive::pointer_traits<node_ptr>::pointer_to(*n) : node_ptr();  }
+
+   node_t *priv_new_node(node_t *parent, bool leaf)
+   {
+      node_t *n;
+      if(leaf){
+         leaf_allocator_t na(this->alloc());
+         n = container_detail::to_raw_pointer(leaf_alloc_traits::allocate(na, 1));
+         ::new(static_cast<void*>(n)) node_t;
+      }
+      else{
+         internal_allocator_t na(this->alloc());
+         n = container_detail::to_raw_pointer(internal_alloc_traits::allocate(na, 1));
+         ::new(static_cast<void*>(n)) internal_node_t;
+      }
+      n->m_parent   = priv_ptr(parent);
+      n->m_position = 0;
+      n->m_count    = 0;
+      n->m_leaf     = leaf;
+      return n;
+   }
+
+   //Deallocates the node, which must hold no values
+   void priv_delete_node(node_t *n)
+   {
+      if(n->m_leaf){
+         leaf_allocator_t na(this->alloc());
+         n->~node_t();
+         leaf_alloc_traits::deallocate
+            (na, boost::intrusive::pointer_traits<typename leaf_alloc_traits::pointer>::pointer_to(*n), 1);
+      }
+      else{
+         internal_allocator_t na(this->alloc());
+         internal_node_t *const in = static_cast<internal_node_t*>(n);
+         in->~internal_node_t();
+         internal_alloc_traits::deallocate
+            (na, boost::intrusive::pointer_traits<typename internal_alloc_traits::pointer>::pointer_to(*in), 1);
+      }
+   }
+
+   void priv_destroy_subtree(node_t *n)
+   {
+      if(!n->m_leaf){
+         for(std::size_t i = 0; i <= n->m_count; ++i){
+            this->priv_destroy_subtree(n->child(i));
+         }
+      }
+      A &a = this->alloc();
+      for(std::size_t i = 0; i != n->m_count; ++i){
+         alloc_traits::destroy(a, &n->values()[i]);
+      }
+      this->priv_delete_node(n);
+   }
+
+   static void priv_set_child(node_t *parent, std::size_t i, node_t *child)
+   {
+      static_cast<internal_node_t*>(parent)->m_children[i] = priv_ptr(child);
+      child->m_parent   = priv_ptr(parent);
+      child->m_position = static_cast<unsigned short>(i);
+   }
+
+   //Moves the value in src to the uninitialized slot dst
+   void priv_relocate(internal_type &dst, internal_type &src)
+   {
+      A &a = this->alloc();
+      alloc_traits::construct(a, &dst, ::boost::move(src));
+      alloc_traits::destroy(a, &src);
+   }
+
+   //Relocates n values to a lower or a non-overlapping range
+   void priv_move_values(internal_type *dst, internal_type *src, std::size_t n)
+   {
+      for(std::size_t i = 0; i != n; ++i){
+         this->priv_relocate(dst[i], src[i]);
+      }
+   }
+
+   //Relocates n values to a higher or a non-overlapping range
+   void priv_move_values_backward(internal_type *dst, internal_type *src, std::size_t n)
+   {
+      while(n--){
+         this->priv_relocate(dst[n], src[n]);
+      }
+   }
+
+   static void priv_move_children(node_t *dst, std::size_t dst_i, node_t *src, std::size_t src_i, std::size_t n)
+   {
+      for(std::size_t i = 0; i != n; ++i){
+         priv_set_child(dst, dst_i + i, src->child(src_i + i));
+      }
+   }
+
+   static void priv_move_children_backward(node_t *dst, std::size_t dst_i, node_t *src, std::size_t src_i, std::size_t n)
+   {
+      while(n--){
+         priv_set_child(dst, dst_i + n, src->child(src_i + n));
+      }
+   }
+
+   std::size_t priv_node_lower_bound(const node_t *n, const key_type &k) const
+   {
+      const key_compare &comp = static_cast<const ValComp &>(m_data).key_comp();
+      const internal_type *const v = n->values();
+      std::size_t first = 0, len = n->m_count;
+      while(len){
+         const std::size_t half = len/2;
+         if(comp(KeyOfValue()(v[first + half]), k)){
+            first += half + 1;
+            len   -= half + 1;
+         }
+         else{
+            len = half;
+         }
+      }
+      return first;
+   }
+
+   std::size_t priv_node_upper_bound(const node_t *n, const key_type &k) const
+   {
+      const key_compare &comp = static_cast<const ValComp &>(m_data).key_comp();
+      const internal_type *const v = n->values();
+      std::size_t first = 0, len = n->m_count;
+      while(len){
+         const std::size_t half = len/2;
+         if(!comp(k, KeyOfValue()(v[first + half]))){
+            first += half + 1;
+            len   -= half + 1;
+         }
+         else{
+            len = half;
+         }
+      }
+      return first;
+   }
+
+   //A search that ends past the last value of a leaf continues with the
+   //first ancestor separator on its right, if any
+   iterator priv_climb_from_leaf_end(node_t *n, std::size_t pos)
+   {
+      while(pos == n->m_count){
+         if(!n->m_parent){
+            return this->end();
+         }
+         pos = n->m_position;
+         n   = n->parent();
+      }
+      return iterator(n, pos);
+   }
+
+   template<class MovableConvertible>
+   std::pair<iterator,bool> priv_insert_unique(BOOST_FWD_REF(MovableConvertible) mv)
+   {
+      const key_compare &comp = static_cast<const ValComp &>(m_data).key_comp();
+      const key_type &k = KeyOfValue()(mv);
+      node_t *n = this->priv_root();
+      std::size_t pos = 0;
+      while(n){
+         pos = this->priv_node_lower_bound(n, k);
+         if(pos != n->m_count && !comp(k, KeyOfValue()(n->values()[pos]))){
+            return std::pair<iterator,bool>(iterator(n, pos), false);
+         }
+         if(n->m_leaf)
+            break;
+         n = n->child(pos);
+      }
+      return std::pair<iterator,bool>
+         (this->priv_insert_at(n, pos, boost::forward<MovableConvertible>(mv)), true);
+   }
+
+   template<class MovableConvertible>
+   iterator priv_insert_unique(const_iterator hint, BOOST_FWD_REF(MovableConvertible) mv)
+   {
+      const key_compare &comp = static_cast<const ValComp &>(m_data).key_comp();
+      const key_type &k = KeyOfValue()(mv);
+      if(hint == this->cend() || comp(k, KeyOfValue()(*hint))){
+         if(hint == this->cbegin()){
+            return this->priv_insert_before(hint, boost::forward<MovableConvertible>(mv));
+         }
+         const_iterator prev(hint);
+         --prev;
+         if(comp(KeyOfValue()(*prev), k)){
+            return this->priv_insert_before(hint, boost::forward<MovableConvertible>(mv));
+         }
+      }
+      else if(!comp(KeyOfValue()(*hint), k)){
+         return iterator(hint.get_node(), hint.get_pos());
+      }
+      //The hint was wrong
+      return this->priv_insert_unique(boost::forward<MovableConvertible>(mv)).first;
+   }
+
+   template<class MovableConvertible>
+   iterator priv_insert_equal(BOOST_FWD_REF(MovableConvertible) mv)
+   {
+      const key_type &k = KeyOfValue()(mv);
+      node_t *n = this->priv_root();
+      std::size_t pos = 0;
+      while(n){
+         pos = this->priv_node_upper_bound(n, k);
+         if(n->m_leaf)
+            break;
+         n = n->child(pos);
+      }
+      return this->priv_insert_at(n, pos, boost::forward<MovableConvertible>(mv));
+   }
+
+   template<class MovableConvertible>
+   iterator priv_insert_equal(const_iterator hint, BOOST_FWD_REF(MovableConvertible) mv)
+   {
+      const key_compare &comp = static_cast<const ValComp &>(m_data).key_comp();
+      const key_type &k = KeyOfValue()(mv);
+      if(hint == this->cend() || !comp(KeyOfValue()(*hint), k)){
+         if(hint == this->cbegin()){
+            return this->priv_insert_before(hint, boost::forward<MovableConvertible>(mv));
+         }
+         const_iterator prev(hint);
+         --prev;
+         if(!comp(k, KeyOfValue()(*prev))){
+            return this->priv_insert_before(hint, boost::forward<MovableConvertible>(mv));
+         }
+      }
+      //The hint was wrong
+      return this->priv_insert_equal(boost::forward<MovableConvertible>(mv));
+   }
+
+   //Values are only inserted in leaves: the position before a separator is
+   //the end of the rightmost leaf of its left subtree
+   template<class MovableConvertible>
+   iterator priv_insert_before(const_iterator hint, BOOST_FWD_REF(MovableConvertible) mv)
+   {
+      node_t *n = hint.get_node();
+      if(n && !n->m_leaf){
+         --hint;
+         return this->priv_insert_at
+            (hint.get_node(), hint.get_pos() + 1, boost::forward<MovableConvertible>(mv));
+      }
+      return this->priv_insert_at(n, hint.get_pos(), boost::forward<MovableConvertible>(mv));
+   }
+
+   //Inserts the value at position pos of the leaf n, which is null if the tree is empty
+   template<class MovableConvertible>
+   iterator priv_insert_at(node_t *n, std::size_t pos, BOOST_FWD_REF(MovableConvertible) mv)
+   {
+      if(!n){
+         n = this->priv_new_node(0, true);
+         m_data.m_root = m_data.m_leftmost = m_data.m_rightmost = priv_ptr(n);
+         pos = 0;
+      }
+      else if(n->m_count == node_t::capacity){
+         this->priv_split(n, pos);
+      }
+      internal_type *const v = n->values();
+      this->priv_move_values_backward(v + pos + 1, v + pos, n->m_count - pos);
+      BOOST_TRY{
+         alloc_traits::construct(this->alloc(), v + pos, boost::forward<MovableConvertible>(mv));
+      }
+      BOOST_CATCH(...){
+         this->priv_move_values(v + pos, v + pos + 1, n->m_count - pos);
+         if(!n->m_count && n == this->priv_root()){
+            this->priv_delete_node(n);
+            m_data.m_root = m_data.m_leftmost = m_data.m_rightmost = node_ptr();
+         }
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+      ++n->m_count;
+      ++m_data.m_size;
+      return iterator(n, pos);
+   }
+
+   //Splits the full node n, moving its median to the parent. n and pos are
+   //updated to the node and position where a value inserted at position pos
+   //of the old node belongs. Inserting at the end of the node leaves the other
+   //values in the left node, and inserting at the beginning leaves them in the
+   //right node, so that ascending and descending insertions produce compact trees.
+   void priv_split(node_t *&n, std::size_t &pos)
+   {
+      BOOST_ASSERT(n->m_count == node_t::capacity);
+      node_t *parent = n->parent();
+      if(!parent){
+         parent = this->priv_new_node(0, false);
+         priv_set_child(parent, 0, n);
+         m_data.m_root = priv_ptr(parent);
+      }
+      else if(parent->m_count == node_t::capacity){
+         std::size_t parent_pos = n->m_position;
+         this->priv_split(parent, parent_pos);
+         //n may have been moved to the new sibling of its parent
+         parent = n->parent();
+      }
+
+      std::size_t right_count;
+      if(pos == 0){
+         right_count = n->m_count - 1;
+      }
+      else if(pos == node_t::capacity){
+         right_count = 0;
+      }
+      else{
+         right_count = n->m_count/2;
+      }
+      const std::size_t left_count = n->m_count - right_count - 1;
+
+      node_t *const right = this->priv_new_node(parent, n->m_leaf);
+      this->priv_move_values(right->values(), n->values() + left_count + 1, right_count);
+      if(!n->m_leaf){
+         priv_move_children(right, 0, n, left_count + 1, right_count + 1);
+      }
+      right->m_count = static_cast<unsigned short>(right_count);
+
+      //Make room in the parent for the median and the new child
+      const std::size_t i = n->m_position;
+      internal_type *const pv = parent->values();
+      this->priv_move_values_backward(pv + i + 1, pv + i, parent->m_count - i);
+      priv_move_children_backward(parent, i + 2, parent, i + 1, parent->m_count - i);
+      this->priv_relocate(pv[i], n->values()[left_count]);
+      priv_set_child(parent, i + 1, right);
+      ++parent->m_count;
+      n->m_count = static_cast<unsigned short>(left_count);
+
+      if(n == this->priv_rightmost()){
+         m_data.m_rightmost = priv_ptr(right);
+      }
+      if(pos > left_count){
+         pos -= left_count + 1;
+         n = right;
+      }
+   }
+
+   //Restores the minimum occupancy of the leaf n after erasing its value
+   //at position pos, and returns an iterator to the value that followed it.
+   iterator priv_rebalance_after_erase(node_t *n, std::size_t pos)
+   {
+      iterator ret(n, pos);
+      bool first = true;
+      for(;;){
+         if(n == this->priv_root()){
+            this->priv_try_shrink();
+            if(this->empty()){
+               return this->end();
+            }
+            break;
+         }
+         if(n->m_count >= priv_min_node_values()){
+            break;
+         }
+         const bool merged = this->priv_try_merge_or_rebalance(n, pos);
+         if(first){
+            ret   = iterator(n, pos);
+            first = false;
+         }
+         if(!merged){
+            break;
+         }
+         pos = n->m_position;
+         n   = n->parent();
+      }
+      //Past the last value of a node: advance to the next value
+      if(ret.get_pos() == ret.get_node()->m_count){
+         ret = iterator(ret.get_node(), ret.get_pos() - 1);
+         ++ret;
+      }
+      return ret;
+   }
+
+   //Merges n with a sibling if both fit in a node, and otherwise moves values
+   //from a sibling to n. Returns true if nodes were merged, as the parent lost
+   //a value then. n and pos are updated to follow the value at position pos.
+   bool priv_try_merge_or_rebalance(node_t *&n, std::size_t &pos)
+   {
+      node_t *const parent = n->parent();
+      const std::size_t i = n->m_position;
+      if(i > 0){
+         node_t *const left = parent->child(i - 1);
+         if(1u + left->m_count + n->m_count <= node_t::capacity){
+            pos += 1u + left->m_count;
+            this->priv_merge_nodes(left, n);
+            n = left;
+            return true;
+         }
+      }
+      if(i < parent->m_count){
+         node_t *const right = parent->child(i + 1);
+         if(1u + n->m_count + right->m_count <= node_t::capacity){
+            this->priv_merge_nodes(n, right);
+            return true;
+         }
+         //Unless we erased the first value of n, which is the usual case of
+         //erasing from the front, fill n from the right sibling
+         if(right->m_count > priv_min_node_values() && (n->m_count == 0 || pos > 0)){
+            std::size_t to_move = (right->m_count - n->m_count)/2;
+            to_move = (std::min)(to_move, std::size_t(right->m_count - 1u));
+            this->priv_rebalance_right_to_left(n, right, to_move);
+            return false;
+         }
+      }
+      if(i > 0){
+         node_t *const left = parent->child(i - 1);
+         if(left->m_count > priv_min_node_values() && (n->m_count == 0 || pos < n->m_count)){
+            std::size_t to_move = (left->m_count - n->m_count)/2;
+            to_move = (std::min)(to_move, std::size_t(left->m_count - 1u));
+            this->priv_rebalance_left_to_right(left, n, to_move);
+            pos += to_move;
+            return false;
+         }
+      }
+      return false;
+   }
+
+   //Moves the separator and all the values and children of right to
+   //left, and deletes right
+   void priv_merge_nodes(node_t *left, node_t *right)
+   {
+      node_t *const parent = left->parent();
+      const std::size_t i = left->m_position;
+      internal_type *const lv = left->values();
+      this->priv_relocate(lv[left->m_count], parent->values()[i]);
+      this->priv_move_values(lv + left->m_count + 1, right->values(), right->m_count);
+      if(!left->m_leaf){
+         priv_move_children(left, left->m_count + 1u, right, 0, right->m_count + 1u);
+      }
+      left->m_count = static_cast<unsigned short>(left->m_count + 1u + right->m_count);
+      right->m_count = 0;
+
+      internal_type *const pv = parent->values();
+      this->priv_move_values(pv + i, pv + i + 1, parent->m_count - i - 1);
+      priv_move_children(parent, i + 1, parent, i + 2, parent->m_count - i - 1);
+      --parent->m_count;
+
+      if(right == this->priv_rightmost()){
+         m_data.m_rightmost = priv_ptr(left);
+      }
+      this->priv_delete_node(right);
+   }
+
+   void priv_rebalance_right_to_left(node_t *left, node_t *right, std::size_t to_move)
+   {
+      BOOST_ASSERT(to_move >= 1 && to_move <= right->m_count);
+      node_t *const parent = left->parent();
+      const std::size_t i = left->m_position;
+      internal_type *const lv = left->values();
+      internal_type *const rv = right->values();
+      this->priv_relocate(lv[left->m_count], parent->values()[i]);
+      this->priv_move_values(lv + left->m_count + 1, rv, to_move - 1);
+      this->priv_relocate(parent->values()[i], rv[to_move - 1]);
+      this->priv_move_values(rv, rv + to_move, right->m_count - to_move);
+      if(!left->m_leaf){
+         priv_move_children(left, left->m_count + 1u, right, 0, to_move);
+         priv_move_children(right, 0, right, to_move, right->m_count + 1u - to_move);
+      }
+      left->m_count  = static_cast<unsigned short>(left->m_count + to_move);
+      right->m_count = static_cast<unsigned short>(right->m_count - to_move);
+   }
+
+   void priv_rebalance_left_to_right(node_t *left, node_t *right, std::size_t to_move)
+   {
+      BOOST_ASSERT(to_move >= 1 && to_move <= left->m_count);
+      node_t *const parent = left->parent();
+      const std::size_t i = left->m_position;
+      internal_type *const lv = left->values();
+      internal_type *const rv = right->values();
+      this->priv_move_values_backward(rv + to_move, rv, right->m_count);
+      this->priv_relocate(rv[to_move - 1], parent->values()[i]);
+      this->priv_move_values(rv, lv + left->m_count - to_move + 1, to_move - 1);
+      this->priv_relocate(parent->values()[i], lv[left->m_count - to_move]);
+      if(!left->m_leaf){
+         priv_move_children_backward(right, to_move, right, 0, right->m_count + 1u);
+         priv_move_children(right, 0, left, left->m_count - to_move + 1u, to_move);
+      }
+      left->m_count  = static_cast<unsigned short>(left->m_count - to_move);
+      right->m_count = static_cast<unsigned short>(right->m_count + to_move);
+   }
+
+   //Deletes the root if it holds no values
+   void priv_try_shrink()
+   {
+      node_t *const r = this->priv_root();
+      if(r->m_count){
+         return;
+      }
+      if(r->m_leaf){
+         m_data.m_root = m_data.m_leftmost = m_data.m_rightmost = node_ptr();
+      }
+      else{
+         node_t *const c = r->child(0);
+         c->m_parent   = node_ptr();
+         c->m_position = 0;
+         m_data.m_root = priv_ptr(c);
+      }
+      this->priv_delete_node(r);
+   }
+
+   iterator priv_erase_n(const_iterator first, size_type n)
+   {
+      if(n == this->size()){
+         this->clear();
+         return this->end();
+      }
+      iterator ret(first.get_node(), first.get_pos());
+      while(n--){
+         ret = this->erase(ret);
+      }
+      return ret;
+   }
+
+   //Appends the values of x, which leaves every node but the rightmost
+   //ones of each level full
+   void priv_copy_from(const btree &x)
+   {
+      BOOST_TRY{
+         for(const_iterator it = x.cbegin(), itend = x.cend(); it != itend; ++it){
+            this->push_back_impl
+               (*reinterpret_cast<const internal_type*>(&it.get_node()->values()[it.get_pos()]));
+         }
+      }
+      BOOST_CATCH(...){
+         this->clear();
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+   }
+
+   void priv_move_from(btree &x)
+   {
+      BOOST_TRY{
+         for(iterator it = x.begin(), itend = x.end(); it != itend; ++it){
+            this->push_back_impl(::boost::move(it.get_node()->values()[it.get_pos()]));
+         }
+      }
+      BOOST_CATCH(...){
+         this->clear();
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+   }
+
+   void priv_steal(btree &x)
+   {
+      BOOST_ASSERT(this->empty());
+      m_data.m_root      = x.m_data.m_root;
+      m_data.m_leftmost  = x.m_data.m_leftmost;
+      m_data.m_rightmost = x.m_data.m_rightmost;
+      m_data.m_size      = x.m_data.m_size;
+      x.m_data.m_root = x.m_data.m_leftmost = x.m_data.m_rightmost = node_ptr();
+      x.m_data.m_size = 0;
+   }
+};
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A>
+inline bool
+operator==(const btree<Key,Value,KeyOfValue,KeyCompare,A>& x,
+           const btree<Key,Value,KeyOfValue,KeyCompare,A>& y)
+{
+  return x.size() == y.size() &&
+         std::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A>
+inline bool
+operator<(const btree<Key,Value,KeyOfValue,KeyCompare,A>& x,
+          const btree<Key,Value,KeyOfValue,KeyCompare,A>& y)
+{
+  return std::lexicographical_compare(x.begin(), x.end(),
+                                      y.begin(), y.end());
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A>
+inline bool
+operator!=(const btree<Key,Value,KeyOfValue,KeyCompare,A>& x,
+           const btree<Key,Value,KeyOfValue,KeyCompare,A>& y) {
+  return !(x == y);
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A>
+inline bool
+operator>(const btree<Key,Value,KeyOfValue,KeyCompare,A>& x,
+          const btree<Key,Value,KeyOfValue,KeyCompare,A>& y) {
+  return y < x;
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A>
+inline bool
+operator<=(const btree<Key,Value,KeyOfValue,KeyCompare,A>& x,
+           const btree<Key,Value,KeyOfValue,KeyCompare,A>& y) {
+  return !(y < x);
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A>
+inline bool
+operator>=(const btree<Key,Value,KeyOfValue,KeyCompare,A>& x,
+           const btree<Key,Value,KeyOfValue,KeyCompare,A>& y) {
+  return !(x < y);
+}
+
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A>
+inline void
+swap(btree<Key,Value,KeyOfValue,KeyCompare,A>& x,
+     btree<Key,Value,KeyOfValue,KeyCompare,A>& y)
+{
+  x.swap(y);
+}
+
+} //namespace container_detail {
+} //namespace container {
+} //namespace boost  {
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif //BOOST_CONTAINER_BTREE_HPP
@@ -26,6 +26,8 @@
 
 #include <boost/type_traits/has_trivial_destructor.hpp>
 #include <boost/move/utility.hpp>
+#include <boost/move/iterator.hpp>
+#include <boost/move/algorithm.hpp>
 
 #include <boost/container/detail/utilities.hpp>
 #include <boost/container/detail/pair.hpp>
@@ -73,6 +75,97 @@ class flat_tree_value_compare
       {  return *this;  }
 };
 
+template<class T, class Compare>
+bool flat_tree_is_sorted(const T *first, const T *last, const Compare &comp)
+{
+   if(first != last){
+      for(++first; first != last; ++first){
+         if(comp(*first, first[-1])){
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+template<class T, class Compare>
+void flat_tree_insertion_sort(T *first, T *last, const Compare &comp)
+{
+   if(first == last){
+      return;
+   }
+   for(T *i = first + 1; i != last; ++i){
+      if(comp(*i, i[-1])){
+         T tmp(boost::move(*i));
+         T *j = i;
+         do{
+            *j = boost::move(j[-1]);
+            --j;
+         } while(j != first && comp(tmp, j[-1]));
+         *j = boost::move(tmp);
+      }
+   }
+}
+
+//Stable merge of [first1, last1) and [first2, last2) into dest
+template<class T, class Compare>
+void flat_tree_merge(T *first1, T *last1, T *first2, T *last2, T *dest, const Compare &comp)
+{
+   while(first1 != last1 && first2 != last2){
+      if(comp(*first2, *first1)){
+         *dest++ = boost::move(*first2++);
+      }
+      else{
+         *dest++ = boost::move(*first1++);
+      }
+   }
+   dest = boost::move(first1, last1, dest);
+   boost::move(first2, last2, dest);
+}
+
+//Stable merge of the range [first1, last1) and the range [first2, last2) into
+//the range that ends in d_last and starts in first1. Elements of the first
+//range go before equivalent elements of the second range.
+template<class T, class Compare>
+void flat_tree_merge_backward(T *first1, T *last1, T *first2, T *last2, T *d_last, const Compare &comp)
+{
+   while(first2 != last2){
+      if(first1 != last1 && comp(last2[-1], last1[-1])){
+         *--d_last = boost::move(*--last1);
+      }
+      else{
+         *--d_last = boost::move(*--last2);
+      }
+   }
+}
+
+//Stable sort of [first, first + n). [buf, buf + n) must hold constructed
+//values and it's used as scratch space.
+template<class T, class Compare>
+void flat_tree_merge_sort(T *first, T *buf, std::size_t n, const Compare &comp)
+{
+   const std::size_t run = 16u;
+   for(std::size_t i = 0; i < n; i += run){
+      flat_tree_insertion_sort(first + i, first + (n - i < run ? n : i + run), comp);
+   }
+
+   T *src = first;
+   T *dst = buf;
+   for(std::size_t width = run; width < n; width *= 2u){
+      for(std::size_t lo = 0; lo < n; lo += 2u*width){
+         const std::size_t mid = n - lo < width    ? n : lo + width;
+         const std::size_t hi  = n - lo < 2u*width ? n : lo + 2u*width;
+         flat_tree_merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+      }
+      T *tmp = src;
+      src = dst;
+      dst = tmp;
+   }
+   if(src != first){
+      boost::move(src, src + n, first);
+   }
+}
+
 template<class Pointer>
 struct get_flat_tree_iterators
 {
@@ -240,20 +333,9 @@ class flat_tree
             , const allocator_type& a = allocator_type())
       : m_data(comp, a)
    {
-      //Use cend() as hint to achieve linear time for
-      //ordered ranges as required by the standard
-      //for the constructor
-      //Call end() every iteration as reallocation might have invalidated iterators
-      if(unique_insertion){
-         for ( ; first != last; ++first){
-            this->insert_unique(this->cend(), *first);
-         }
-      }
-      else{
-         for ( ; first != last; ++first){
-            this->insert_equal(this->cend(), *first);
-         }
-      }
+      //Linear time for ordered ranges as required by the standard
+      //for the constructor, N log N otherwise
+      this->priv_insert_range(first, last, unique_insertion, false);
    }
 
    ~flat_tree()
@@ -395,169 +477,27 @@ class flat_tree
       return this->priv_insert_commit(data, boost::move(mval));
    }
 
+   //Range insertions append the new elements, sort them if they are not
+   //already ordered and merge them with the old elements, so inserting
+   //N elements in a tree of size() elements is O(size() + N log N) instead
+   //of O(size()*N).
    template <class InIt>
    void insert_unique(InIt first, InIt last)
-   {
-      for ( ; first != last; ++first){
-         this->insert_unique(*first);
-      }
-   }
+   {  this->priv_insert_range(first, last, true, false);  }
 
    template <class InIt>
-   void insert_equal(InIt first, InIt last
-      #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
-      , typename container_detail::enable_if_c
-         < container_detail::is_input_iterator<InIt>::value
-         >::type * = 0
-      #endif
-      )
-   {  this->priv_insert_equal_loop(first, last);  }
-
-   template <class InIt>
-   void insert_equal(InIt first, InIt last
-      #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
-      , typename container_detail::enable_if_c
-         < !container_detail::is_input_iterator<InIt>::value
-         >::type * = 0
-      #endif
-      )
-   {
-      const size_type len = static_cast<size_type>(std::distance(first, last));
-      this->reserve(this->size()+len);
-      this->priv_insert_equal_loop(first, last);
-   }
+   void insert_equal(InIt first, InIt last)
+   {  this->priv_insert_range(first, last, false, false);  }
 
    //Ordered
 
    template <class InIt>
-   void insert_equal(ordered_range_t, InIt first, InIt last
-      #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
-      , typename container_detail::enable_if_c
-         < container_detail::is_input_iterator<InIt>::value
-         >::type * = 0
-      #endif
-      )
-   {  this->priv_insert_equal_loop_ordered(first, last); }
-
-   template <class FwdIt>
-   void insert_equal(ordered_range_t, FwdIt first, FwdIt last
-      #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
-      , typename container_detail::enable_if_c
-         < !container_detail::is_input_iterator<FwdIt>::value &&
-		   container_detail::is_forward_iterator<FwdIt>::value
-         >::type * = 0
-      #endif
-      )
-   {
-      const size_type len = static_cast<size_type>(std::distance(first, last));
-      this->reserve(this->size()+len);
-      this->priv_insert_equal_loop_ordered(first, last);
-   }
-
-   template <class BidirIt>
-   void insert_equal(ordered_range_t, BidirIt first, BidirIt last
-      #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
-      , typename container_detail::enable_if_c
-         < !container_detail::is_input_iterator<BidirIt>::value &&
-           !container_detail::is_forward_iterator<BidirIt>::value
-         >::type * = 0
-      #endif
-      )
-   {
-      size_type len = static_cast<size_type>(std::distance(first, last));
-      const size_type BurstSize = 16;
-      size_type positions[BurstSize];
-
-      //Prereserve all memory so that iterators are not invalidated
-      this->reserve(this->size()+len);
-      const const_iterator b(this->cbegin());
-      const_iterator pos(b);
-      //Loop in burst sizes
-      while(len){
-         const size_type burst = len < BurstSize ? len : BurstSize;
-         const const_iterator ce(this->cend());
-         len -= burst;
-         for(size_type i = 0; i != burst; ++i){
-            //Get the insertion position for each key
-            pos = const_cast<const flat_tree&>(*this).priv_upper_bound(pos, ce, KeyOfValue()(*first));
-            positions[i] = static_cast<size_type>(pos - b);
-            ++first;
-         }
-         //Insert all in a single step in the precalculated positions
-         this->m_data.m_vect.insert_ordered_at(burst, positions + burst, first);
-         //Next search position updated
-         pos += burst;
-      }
-   }
+   void insert_equal(ordered_range_t, InIt first, InIt last)
+   {  this->priv_insert_range(first, last, false, true);  }
 
    template <class InIt>
-   void insert_unique(ordered_unique_range_t, InIt first, InIt last
-      #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
-      , typename container_detail::enable_if_c
-         < container_detail::is_input_iterator<InIt>::value ||
-           container_detail::is_forward_iterator<InIt>::value
-         >::type * = 0
-      #endif
-      )
-   {
-      const_iterator pos(this->cend());
-      for ( ; first != last; ++first){
-         pos = this->insert_unique(pos, *first);
-         ++pos;
-      }
-   }
-
-   template <class BidirIt>
-   void insert_unique(ordered_unique_range_t, BidirIt first, BidirIt last
-      #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
-      , typename container_detail::enable_if_c
-         < !(container_detail::is_input_iterator<BidirIt>::value ||
-             container_detail::is_forward_iterator<BidirIt>::value)
-         >::type * = 0
-      #endif
-      )
-   {
-      size_type len = static_cast<size_type>(std::distance(first, last));
-      const size_type BurstSize = 16;
-      size_type positions[BurstSize];
-      size_type skips[BurstSize];
-
-      //Prereserve all memory so that iterators are not invalidated
-      this->reserve(this->size()+len);
-      const const_iterator b(this->cbegin());
-      const_iterator pos(b);
-      const value_compare &value_comp = this->m_data;
-      skips[0u] = 0u;
-      //Loop in burst sizes
-      while(len){
-         const size_type burst = len < BurstSize ? len : BurstSize;
-         size_type unique_burst = 0u;
-         const const_iterator ce(this->cend());
-         while(unique_burst < burst && len > 0){
-            //Get the insertion position for each key
-            const value_type & val = *first++;
-            --len;
-            pos = const_cast<const flat_tree&>(*this).priv_lower_bound(pos, ce, KeyOfValue()(val));
-            //Check if already present
-            if(pos != ce && !value_comp(val, *pos)){
-               if(unique_burst > 0){
-                  ++skips[unique_burst-1];
-               }
-               continue;
-            }
-
-            //If not present, calculate position
-            positions[unique_burst] = static_cast<size_type>(pos - b);
-            skips[unique_burst++] = 0u;
-         }
-         if(unique_burst){
-            //Insert all in a single step in the precalculated positions
-            this->m_data.m_vect.insert_ordered_at(unique_burst, positions + unique_burst, skips + unique_burst, first);
-            //Next search position updated
-            pos += unique_burst;
-         }
-      }
-   }
+   void insert_unique(ordered_unique_range_t, InIt first, InIt last)
+   {  this->priv_insert_range(first, last, true, true);  }
 
    #ifdef BOOST_CONTAINER_PERFECT_FORWARDING
 
@@ -930,23 +870,85 @@ class flat_tree
    }
 
    template<class InIt>
-   void priv_insert_equal_loop(InIt first, InIt last)
+   void priv_insert_range(InIt first, InIt last, bool unique, bool ordered)
    {
-      for ( ; first != last; ++first){
-         this->insert_equal(*first);
+      vector_t &v = this->m_data.m_vect;
+      const size_type old_size = v.size();
+      v.insert(v.cend(), first, last);
+      const size_type n = v.size() - old_size;
+      if(!n){
+         return;
       }
+
+      const value_compare &value_comp = this->m_data;
+      value_type *const b = v.data();
+      value_type *const m = b + old_size;
+      value_type *e = b + v.size();
+      vector_t buf(v.get_stored_allocator());
+      bool merging = false;
+      BOOST_TRY{
+         //Sort the new elements, the sort is stable so that the first of
+         //equivalent elements is kept by unique insertions
+         if(!ordered && !container_detail::flat_tree_is_sorted(m, e, value_comp)){
+            buf.insert(buf.cend(), boost::make_move_iterator(m), boost::make_move_iterator(e));
+            container_detail::flat_tree_merge_sort(buf.data(), m, n, value_comp);
+            boost::move(buf.data(), buf.data() + n, m);
+         }
+
+         if(unique){
+            e = this->priv_remove_duplicates(b, m, e);
+            v.erase(v.cbegin() + (e - b), v.cend());
+         }
+
+         //Merge the new elements with the old ones, unless they all go after them
+         if(old_size && m != e && value_comp(*m, m[-1])){
+            const size_type new_n = static_cast<size_type>(e - m);
+            if(buf.empty()){
+               buf.insert(buf.cend(), boost::make_move_iterator(m), boost::make_move_iterator(e));
+            }
+            else{
+               boost::move(m, e, buf.data());
+            }
+            merging = true;
+            container_detail::flat_tree_merge_backward
+               (b, m, buf.data(), buf.data() + new_n, e, value_comp);
+         }
+      }
+      BOOST_CATCH(...){
+         //Old elements might have been moved, so only an empty tree is ordered.
+         if(merging){
+            v.clear();
+         }
+         else{
+            v.erase(v.cbegin() + old_size, v.cend());
+         }
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
    }
 
-   template<class InIt>
-   void priv_insert_equal_loop_ordered(InIt first, InIt last)
+   //Removes from the ordered range [m, e) the elements that are equivalent
+   //to a previous one or to an element of the ordered range [b, m).
+   //Returns the new end of the range.
+   value_type *priv_remove_duplicates(value_type *b, value_type *m, value_type *e)
    {
-      const_iterator pos(this->cend());
-      for ( ; first != last; ++first){
-         //If ordered, then try hint version
-         //to achieve constant-time complexity per insertion
-         pos = this->insert_equal(pos, *first);
-         ++pos;
+      const value_compare &value_comp = this->m_data;
+      value_type *pos = b;
+      value_type *out = m;
+      for(value_type *it = m; it != e; ++it){
+         if(out != m && !value_comp(out[-1], *it)){
+            continue;
+         }
+         pos = const_cast<const flat_tree&>(*this).priv_lower_bound(pos, m, KeyOfValue()(*it));
+         if(pos != m && !value_comp(*it, *pos)){
+            continue;
+         }
+         if(out != it){
+            *out = boost::move(*it);
+         }
+         ++out;
       }
+      return out;
    }
 };
 
@@ -16,6 +16,7 @@
 #include <boost/assert.hpp>
 
 #include <boost/mem_fn.hpp>
+#include <boost/heap/detail/bulk_push.hpp>
 #include <boost/heap/detail/heap_comparison.hpp>
 #include <boost/heap/detail/ordered_adaptor_iterator.hpp>
 #include <boost/heap/detail/stable_heap.hpp>
@@ -156,6 +157,13 @@ public:
         super_t(cmp)
     {}
 
+    template <typename InputIterator>
+    d_ary_heap(InputIterator first, InputIterator last, value_compare const & cmp = value_compare()):
+        super_t(cmp)
+    {
+        push(first, last);
+    }
+
     d_ary_heap(d_ary_heap const & rhs):
         super_t(rhs), q_(rhs.q_)
     {}
@@ -218,6 +226,22 @@ public:
         siftup(q_.size() - 1);
     }
 
+    template <typename InputIterator>
+    void push(InputIterator first, InputIterator last)
+    {
+        const size_type old_size = q_.size();
+        for (; first != last; ++first) {
+            q_.push_back(super_t::make_node(*first));
+            reset_index(size() - 1, size() - 1);
+        }
+
+        if (bulk_push_should_rebuild(old_size, q_.size() - old_size))
+            build_heap();
+        else
+            for (size_type i = old_size; i != q_.size(); ++i)
+                siftup(i);
+    }
+
 #if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
     template <class... Args>
     void emplace(Args&&... args)
@@ -277,6 +301,17 @@ public:
     }
 
 private:
+    /* restores the heap property bottom-up, in linear time (floyd) */
+    void build_heap(void)
+    {
+        if (q_.size() < 2)
+            return;
+
+        size_type index = parent_index(q_.size() - 1) + 1;
+        while (index != 0)
+            siftdown(--index);
+    }
+
     void reset_index(size_type index, size_type new_index)
     {
         BOOST_HEAP_ASSERT(index < q_.size());
@@ -522,6 +557,20 @@ public:
         super_t(cmp)
     {}
 
+    /**
+     * \b Effects: constructs a d-ary heap from the elements of the range [first, last).
+     *
+     * \b Complexity: Linear.
+     *
+     * \b Requirement: data structure must not be configured as mutable
+     * */
+    template <typename InputIterator>
+    d_ary_heap(InputIterator first, InputIterator last, value_compare const & cmp = value_compare()):
+        super_t(first, last, cmp)
+    {
+        BOOST_STATIC_ASSERT(!is_mutable);
+    }
+
     /// \copydoc boost::heap::priority_queue::priority_queue(priority_queue const &)
     d_ary_heap(d_ary_heap const & rhs):
         super_t(rhs)
@@ -590,6 +639,20 @@ public:
         return super_t::push(v);
     }
 
+    /**
+     * \b Effects: Adds the elements of the range [first, last) to the priority queue.
+     *
+     * \b Complexity: Linear in the resulting size, or N log(size()) for N new elements, whichever is less.
+     *
+     * \b Requirement: data structure must not be configured as mutable
+     * */
+    template <typename InputIterator>
+    void push(InputIterator first, InputIterator last)
+    {
+        BOOST_STATIC_ASSERT(!is_mutable);
+        super_t::push(first, last);
+    }
+
 #if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
     /// \copydoc boost::heap::priority_queue::emplace
     template <class... Args>
@@ -816,6 +879,15 @@ public:
     }
 };
 
+namespace detail {
+
+template <typename T, class A0, class A1, class A2, class A3, class A4, class A5>
+struct has_bulk_push<boost::heap::d_ary_heap<T, A0, A1, A2, A3, A4, A5> >:
+    boost::integral_constant<bool, !extract_mutable<typename d_ary_heap_signature::bind<A0, A1, A2, A3, A4, A5>::type>::value>
+{};
+
+} /* namespace detail */
+
 } /* namespace heap */
 } /* namespace boost */
 
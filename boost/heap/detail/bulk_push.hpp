@@ -0,0 +1,49 @@
+// boost heap: helpers for bulk insertion into array-based heaps
+//
+// Copyright (C) 2013 Tim Blechmann
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HEAP_DETAIL_BULK_PUSH_HPP
+#define BOOST_HEAP_DETAIL_BULK_PUSH_HPP
+
+#include <cstddef>
+
+#include <boost/type_traits/integral_constant.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost  {
+namespace heap   {
+namespace detail {
+
+/* true for heaps that provide push(first, last) */
+template <typename Heap>
+struct has_bulk_push:
+    boost::false_type
+{};
+
+/* decides whether count elements that have been appended to a heap of old_size elements
+ * should be inserted by rebuilding the whole heap in linear time or by sifting up
+ * each of them, which costs up to log(old_size) comparisons per element */
+inline bool bulk_push_should_rebuild(std::size_t old_size, std::size_t count)
+{
+    if (old_size < count)
+        return true;
+
+    std::size_t log2_old_size = 0;
+    while ((old_size >> log2_old_size) > 1)
+        ++log2_old_size;
+
+    return 2 * (old_size + count) < count * log2_old_size;
+}
+
+} /* namespace detail */
+} /* namespace heap */
+} /* namespace boost */
+
+#endif /* BOOST_HEAP_DETAIL_BULK_PUSH_HPP */
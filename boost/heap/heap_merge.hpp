@@ -11,6 +11,7 @@
 
 #include <boost/concept/assert.hpp>
 #include <boost/heap/heap_concepts.hpp>
+#include <boost/heap/detail/bulk_push.hpp>
 #include <boost/type_traits/is_same.hpp>
 
 #ifdef BOOST_HAS_PRAGMA_ONCE
@@ -52,7 +53,6 @@ struct heap_merge_emulate
             }
         }
 
-        // FIXME: container adaptors could benefit from first appending all elements and then restoring the heap order
         // FIXME: optimize: if we have ordered iterators and we can efficiently insert keys with a below the lowest key in the heap
         //                  d-ary, b and fibonacci heaps fall into this category
 
@@ -69,6 +69,36 @@ struct heap_merge_emulate
 };
 
 
+/* array-based heaps append all elements of rhs and restore the heap order in one go.
+ * elements of a stable rhs are still pushed in order, so that equivalent elements keep their order */
+template <typename Heap1, typename Heap2>
+struct heap_merge_bulk
+{
+    static void merge(Heap1 & lhs, Heap2 & rhs)
+    {
+        lhs.push(rhs.begin(), rhs.end());
+        rhs.clear();
+    }
+};
+
+
+template <typename Heap1, typename Heap2>
+struct heap_merge_unmergable
+{
+    static const bool use_bulk_push = has_bulk_push<Heap1>::value && !Heap2::is_stable;
+
+    typedef typename boost::mpl::if_c<use_bulk_push,
+                                      heap_merge_bulk<Heap1, Heap2>,
+                                      heap_merge_emulate<Heap1, Heap2>
+                                     >::type heap_merger;
+
+    static void merge(Heap1 & lhs, Heap2 & rhs)
+    {
+        heap_merger::merge(lhs, rhs);
+    }
+};
+
+
 template <typename Heap>
 struct heap_merge_same_mergable
 {
@@ -85,7 +115,7 @@ struct heap_merge_same
     static const bool is_mergable = Heap::is_mergable;
     typedef typename boost::mpl::if_c<is_mergable,
                                       heap_merge_same_mergable<Heap>,
-                                      heap_merge_emulate<Heap, Heap>
+                                      heap_merge_unmergable<Heap, Heap>
                                      >::type heap_merger;
 
     static void merge(Heap & lhs, Heap & rhs)
@@ -101,6 +131,10 @@ struct heap_merge_same
  *
  *  \b Effect: lhs contains all elements that have been part of rhs, rhs is empty.
  *
+ *  \b Complexity: Depends on the heaps. Mergable heaps of the same type use their merge() member.
+ *  priority_queue and immutable d_ary_heap append the elements of a non-stable rhs in bulk,
+ *  in linear time. Otherwise, the elements of rhs are popped and pushed one by one.
+ *
  * */
 template <typename Heap1,
           typename Heap2
@@ -117,7 +151,7 @@ void heap_merge(Heap1 & lhs, Heap2 & rhs)
 
     typedef typename boost::mpl::if_c<same_heaps,
                                       detail::heap_merge_same<Heap1>,
-                                      detail::heap_merge_emulate<Heap1, Heap2>
+                                      detail::heap_merge_unmergable<Heap1, Heap2>
                                      >::type heap_merger;
 
     heap_merger::merge(lhs, rhs);
@@ -16,6 +16,7 @@
 
 #include <boost/assert.hpp>
 
+#include <boost/heap/detail/bulk_push.hpp>
 #include <boost/heap/detail/heap_comparison.hpp>
 #include <boost/heap/detail/stable_heap.hpp>
 
@@ -118,6 +119,19 @@ public:
         super_t(cmp)
     {}
 
+    /**
+     * \b Effects: constructs a priority queue from the elements of the range [first, last).
+     *
+     * \b Complexity: Linear.
+     *
+     * */
+    template <typename InputIterator>
+    priority_queue(InputIterator first, InputIterator last, value_compare const & cmp = value_compare()):
+        super_t(cmp)
+    {
+        push(first, last);
+    }
+
     /**
      * \b Effects: copy-constructs priority queue from rhs.
      *
@@ -247,6 +261,27 @@ public:
         std::push_heap(q_.begin(), q_.end(), static_cast<super_t const &>(*this));
     }
 
+    /**
+     * \b Effects: Adds the elements of the range [first, last) to the priority queue.
+     *
+     * \b Complexity: Linear in the resulting size, or N log(size()) for N new elements, whichever is less.
+     *
+     * */
+    template <typename InputIterator>
+    void push(InputIterator first, InputIterator last)
+    {
+        const size_type old_size = q_.size();
+        for (; first != last; ++first)
+            q_.push_back(super_t::make_node(*first));
+
+        super_t const & cmp = *this;
+        if (detail::bulk_push_should_rebuild(old_size, q_.size() - old_size))
+            std::make_heap(q_.begin(), q_.end(), cmp);
+        else
+            for (size_type i = old_size; i != q_.size(); ++i)
+                std::push_heap(q_.begin(), q_.begin() + i + 1, cmp);
+    }
+
 #if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
     /**
      * \b Effects: Adds a new element to the priority queue. The element is directly constructed in-place.
@@ -404,6 +439,15 @@ public:
     }
 };
 
+namespace detail {
+
+template <typename T, class A0, class A1, class A2, class A3>
+struct has_bulk_push<priority_queue<T, A0, A1, A2, A3> >:
+    boost::true_type
+{};
+
+} /* namespace detail */
+
 } /* namespace heap */
 } /* namespace boost */
 
@@ -0,0 +1,258 @@
+// boost heap: radix heap for monotone integer keys
+//
+// Copyright (C) 2013 Tim Blechmann
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HEAP_RADIX_HEAP_HPP
+#define BOOST_HEAP_RADIX_HEAP_HPP
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+
+namespace boost  {
+namespace heap   {
+namespace detail {
+
+/* number of significant bits of x, i.e. 0 for 0, 1 for 1, 2 for 2 and 3, ... */
+template <typename Key>
+inline unsigned int radix_heap_bit_width(Key x)
+{
+#if defined(__GNUC__)
+    if (x == 0)
+        return 0;
+    if (std::numeric_limits<Key>::digits <= std::numeric_limits<unsigned long>::digits)
+        return std::numeric_limits<unsigned long>::digits - __builtin_clzl(static_cast<unsigned long>(x));
+    if (std::numeric_limits<Key>::digits <= std::numeric_limits<unsigned long long>::digits)
+        return std::numeric_limits<unsigned long long>::digits - __builtin_clzll(static_cast<unsigned long long>(x));
+#endif
+    unsigned int ret = 0;
+    while (x) {
+        x >>= 1;
+        ++ret;
+    }
+    return ret;
+}
+
+}
+
+/**
+ * \class radix_heap
+ * \brief radix heap for monotone integer keys
+ *
+ * A radix heap is a priority queue for the special case, that the keys are unsigned integers and that no key is smaller
+ * than the key that has been popped last. This is the case for the tentative distances of Dijkstra's shortest path
+ * algorithm or for the time stamps of an event queue. Elements are kept in std::numeric_limits<Key>::digits + 1 buckets;
+ * bucket i holds the elements whose keys differ from the last popped key in the (i-1)th bit, but not in any higher bit.
+ * push() only computes the bucket index and appends the element to the bucket. pop() only redistributes the elements of
+ * the first non-empty bucket to lower buckets, when there is no element left with the last popped key, so each element
+ * is moved at most std::numeric_limits<Key>::digits times.
+ *
+ * In contrast to the other heaps of boost.heap, the radix heap is a min-heap: top() returns the element with the
+ * smallest key. It stores a value of type Value with each key and does not model the PriorityQueue concept.
+ * Elements with the same key are popped in an unspecified order.
+ *
+ * \b Requirements: Key is an unsigned integer type.
+ *
+ */
+template <typename Key,
+          typename Value,
+          class Allocator = std::allocator<std::pair<Key, Value> >
+         >
+class radix_heap
+{
+    BOOST_STATIC_ASSERT(boost::is_integral<Key>::value && !std::numeric_limits<Key>::is_signed);
+
+    static const unsigned int bucket_count = std::numeric_limits<Key>::digits + 1;
+
+public:
+    typedef Key key_type;
+    typedef Value mapped_type;
+    typedef std::pair<Key, Value> value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+    typedef value_type const & const_reference;
+
+private:
+    typedef std::vector<value_type, allocator_type> bucket_type;
+
+    /* top() redistributes the elements lazily, so that bucket 0 is not empty */
+    mutable bucket_type buckets_[bucket_count];
+    mutable key_type last_;
+    size_type size_;
+
+public:
+    /**
+     * \b Effects: constructs an empty radix heap.
+     *
+     * \b Complexity: Constant.
+     *
+     * */
+    radix_heap(void):
+        last_(0), size_(0)
+    {}
+
+    /**
+     * \b Effects: Returns true, if the radix heap contains no elements.
+     *
+     * \b Complexity: Constant.
+     *
+     * */
+    bool empty(void) const
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * \b Effects: Returns the number of elements contained in the radix heap.
+     *
+     * \b Complexity: Constant.
+     *
+     * */
+    size_type size(void) const
+    {
+        return size_;
+    }
+
+    /**
+     * \b Effects: Removes all elements from the radix heap. Afterwards, keys can be pushed in any order.
+     *
+     * \b Complexity: Linear.
+     *
+     * */
+    void clear(void)
+    {
+        for (unsigned int i = 0; i != bucket_count; ++i)
+            buckets_[i].clear();
+        last_ = 0;
+        size_ = 0;
+    }
+
+    /**
+     * \b Effects: Returns the smallest key, that may currently be pushed to the radix heap. This is the key of the last
+     * element, that has been accessed via top() or pop(), or 0.
+     *
+     * \b Complexity: Constant.
+     *
+     * */
+    key_type min_key(void) const
+    {
+        return last_;
+    }
+
+    /**
+     * \b Effects: Adds a new element with key k and value v to the radix heap.
+     *
+     * \b Complexity: Constant, amortized O(log(C)) for each pop() of the element, where C is the range of the keys.
+     *
+     * \b Requirements: k is not smaller than min_key().
+     *
+     * */
+    void push(key_type k, mapped_type const & v)
+    {
+        push(value_type(k, v));
+    }
+
+    /**
+     * \b Effects: Adds the pair v to the radix heap.
+     *
+     * \b Complexity: Constant, amortized O(log(C)) for each pop() of the element, where C is the range of the keys.
+     *
+     * \b Requirements: v.first is not smaller than min_key().
+     *
+     * */
+    void push(value_type const & v)
+    {
+        BOOST_ASSERT(!(v.first < last_));
+        buckets_[bucket_index(v.first)].push_back(v);
+        ++size_;
+    }
+
+    /**
+     * \b Effects: Returns a const_reference to the element with the smallest key.
+     *
+     * \b Complexity: Amortized constant.
+     *
+     * */
+    const_reference top(void) const
+    {
+        BOOST_ASSERT(!empty());
+        redistribute();
+        return buckets_[0].back();
+    }
+
+    /**
+     * \b Effects: Removes the element with the smallest key.
+     *
+     * \b Complexity: Amortized constant.
+     *
+     * */
+    void pop(void)
+    {
+        BOOST_ASSERT(!empty());
+        redistribute();
+        buckets_[0].pop_back();
+        --size_;
+    }
+
+    /**
+     * \b Effects: Swaps two radix heaps.
+     *
+     * \b Complexity: Constant.
+     *
+     * */
+    void swap(radix_heap & rhs)
+    {
+        for (unsigned int i = 0; i != bucket_count; ++i)
+            buckets_[i].swap(rhs.buckets_[i]);
+        std::swap(last_, rhs.last_);
+        std::swap(size_, rhs.size_);
+    }
+
+private:
+    unsigned int bucket_index(key_type k) const
+    {
+        return detail::radix_heap_bit_width<key_type>(k ^ last_);
+    }
+
+    /* moves the elements of the first non-empty bucket to lower buckets, after setting last_ to their smallest key */
+    void redistribute(void) const
+    {
+        if (!buckets_[0].empty())
+            return;
+
+        unsigned int i = 1;
+        while (buckets_[i].empty())
+            ++i;
+
+        bucket_type & bucket = buckets_[i];
+        key_type new_last = bucket.front().first;
+        for (typename bucket_type::const_iterator it = bucket.begin() + 1; it != bucket.end(); ++it)
+            if (it->first < new_last)
+                new_last = it->first;
+
+        last_ = new_last;
+        for (typename bucket_type::const_iterator it = bucket.begin(); it != bucket.end(); ++it)
+            buckets_[bucket_index(it->first)].push_back(*it);
+        bucket.clear();
+    }
+};
+
+} /* namespace heap */
+} /* namespace boost */
+
+#endif /* BOOST_HEAP_RADIX_HEAP_HPP */
@@ -0,0 +1,211 @@
+//  epoch-based memory reclamation from
+//  Fraser, K.,
+//  "Practical lock-freedom"
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_EPOCH_BASED_RECLAMATION_HPP_INCLUDED
+#define BOOST_LOCKFREE_EPOCH_BASED_RECLAMATION_HPP_INCLUDED
+
+#include <cstddef>
+#include <memory>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/reclaiming_pool.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/* node pool that returns a retired node to the allocator once the global epoch has advanced twice.
+ *
+ * each operation owns a record that announces the global epoch at the start of the operation. the global epoch only
+ * advances when all running operations have announced it, so a node that is retired in epoch e cannot be referenced by
+ * any operation once the global epoch has reached e + 2. the retired nodes are kept in the record, in one list for each
+ * of the last three epochs. */
+template <typename T,
+          typename Alloc = std::allocator<T>
+         >
+class epoch_based_pool:
+    public reclaiming_pool<T, Alloc>
+{
+    typedef reclaiming_pool<T, Alloc> base;
+    typedef typename base::retired_node retired_node;
+
+    /* the number of retired nodes of a record between two attempts to advance the global epoch */
+    static const std::size_t advance_interval = 64;
+
+    struct record
+    {
+        record(void):
+            active(false), epoch(0), next(NULL), retired_since_advance(0)
+        {
+            for (std::size_t i = 0; i != 3; ++i) {
+                retired[i] = NULL;
+                retired_epoch[i] = 0;
+            }
+        }
+
+        atomic<bool> active;
+        atomic<std::size_t> epoch;
+        record * next;
+
+        /* only accessed by the owner of the record */
+        retired_node * retired[3];
+        std::size_t retired_epoch[3];
+        std::size_t retired_since_advance;
+    };
+
+public:
+    typedef typename base::tagged_node_handle tagged_node_handle;
+
+    /* announces the epoch of an operation, a guard must not be shared between threads */
+    class guard:
+        boost::noncopyable
+    {
+    public:
+        /* all nodes accessed during the operation are protected, but a retired node may be overwritten by the list of
+         * retired nodes, so traversals have to revalidate their starting point before following a pointer */
+        static const bool validate_traversal = true;
+
+        explicit guard(epoch_based_pool & pool):
+            pool_(pool), record_(pool.enter())
+        {}
+
+        ~guard(void)
+        {
+            pool_.records_.release(record_);
+        }
+
+        template <typename Handle>
+        Handle protect(std::size_t /* slot */, atomic<Handle> const & src, memory_order order)
+        {
+            return src.load(order);
+        }
+
+        template <typename Handle>
+        Handle protect(std::size_t /* slot */, atomic<Handle> const & /* src */, Handle h,
+                       memory_order /* order */ = memory_order_acquire)
+        {
+            return h;
+        }
+
+        void publish(std::size_t /* slot */, T * /* p */)
+        {}
+
+        void retire(tagged_node_handle h)
+        {
+            retire(h.get_ptr());
+        }
+
+        void retire(T * n)
+        {
+            pool_.retire(record_, n);
+        }
+
+        template <typename NextNode>
+        void retire_chain(T * first, std::size_t count, NextNode const & next_node)
+        {
+            T * n = first;
+            for (std::size_t i = 0; i != count; ++i) {
+                T * next = (i + 1 != count) ? next_node(n) : NULL;
+                retire(n);
+                n = next;
+            }
+        }
+
+    private:
+        epoch_based_pool & pool_;
+        record * record_;
+    };
+
+    template <typename Allocator>
+    epoch_based_pool (Allocator const & alloc, std::size_t n = 0):
+        base(alloc, n), global_epoch_(0)
+    {}
+
+    ~epoch_based_pool(void)
+    {
+        for (record * r = records_.first(); r != NULL; r = r->next) {
+            for (std::size_t i = 0; i != 3; ++i)
+                base::deallocate_list(r->retired[i]);
+        }
+    }
+
+    bool is_lock_free(void) const
+    {
+        return base::is_lock_free() && records_.is_lock_free() && global_epoch_.is_lock_free();
+    }
+
+private:
+    record * enter(void)
+    {
+        record * r = records_.acquire();
+        r->epoch.store(global_epoch_.load(memory_order_relaxed), memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        return r;
+    }
+
+    void retire(record * r, T * n)
+    {
+        retired_node * node = base::release(n);
+
+        /* the node has been unlinked before the epoch is read, so operations that start in a later epoch can't
+         * reach it */
+        std::size_t epoch = global_epoch_.load(memory_order_seq_cst);
+        std::size_t index = epoch % 3;
+        if (r->retired_epoch[index] != epoch) {
+            /* the list holds the nodes of epoch - 3 or earlier */
+            base::deallocate_list(r->retired[index]);
+            r->retired[index] = NULL;
+            r->retired_epoch[index] = epoch;
+        }
+
+        node->next.store(r->retired[index], memory_order_relaxed);
+        r->retired[index] = node;
+
+        r->retired_since_advance += 1;
+        if (r->retired_since_advance == advance_interval) {
+            r->retired_since_advance = 0;
+            try_advance(epoch);
+            collect(r);
+        }
+    }
+
+    /* advances the global epoch if all running operations have announced it */
+    void try_advance(std::size_t epoch)
+    {
+        for (record * r = records_.first(); r != NULL; r = r->next) {
+            if (r->active.load(memory_order_seq_cst) && r->epoch.load(memory_order_seq_cst) != epoch)
+                return;
+        }
+        global_epoch_.compare_exchange_strong(epoch, epoch + 1, memory_order_seq_cst);
+    }
+
+    /* deallocates the retired nodes of r that have been retired two epochs ago or earlier */
+    void collect(record * r)
+    {
+        std::size_t epoch = global_epoch_.load(memory_order_acquire);
+        for (std::size_t i = 0; i != 3; ++i) {
+            if (r->retired[i] && epoch - r->retired_epoch[i] >= 2) {
+                base::deallocate_list(r->retired[i]);
+                r->retired[i] = NULL;
+            }
+        }
+    }
+
+    reclamation_records<record> records_;
+    atomic<std::size_t> global_epoch_;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_EPOCH_BASED_RECLAMATION_HPP_INCLUDED */
@@ -21,6 +21,7 @@
 #include <boost/lockfree/detail/atomic.hpp>
 #include <boost/lockfree/detail/parameter.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
+#include <boost/lockfree/detail/untagged_ptr.hpp>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -114,6 +115,28 @@ public:
         deallocate<ThreadSafe>(n);
     }
 
+    /* destructs count nodes, starting at first and following next_node, and pushes them to the freelist at once */
+    template <bool ThreadSafe, typename NextNode>
+    void destruct_chain (T * first, std::size_t count, NextNode const & next_node)
+    {
+        freelist_node * chain_top = NULL;
+        freelist_node * chain_bottom = NULL;
+        T * n = first;
+        for (std::size_t i = 0; i != count; ++i) {
+            T * next = (i + 1 != count) ? next_node(n) : NULL;
+            n->~T();
+            void * node = n;
+            freelist_node * new_top = reinterpret_cast<freelist_node*>(node);
+            new_top->next.set_ptr(chain_top);
+            if (chain_bottom == NULL)
+                chain_bottom = new_top;
+            chain_top = new_top;
+            n = next;
+        }
+        if (chain_top)
+            deallocate_chain<ThreadSafe>(chain_top, chain_bottom);
+    }
+
     ~freelist_stack(void)
     {
         tagged_node_ptr current = pool_.load();
@@ -248,6 +271,26 @@ private:
         pool_.store(new_pool, memory_order_relaxed);
     }
 
+    template <bool ThreadSafe>
+    void deallocate_chain (freelist_node * chain_top, freelist_node * chain_bottom)
+    {
+        if (ThreadSafe) {
+            tagged_node_ptr old_pool = pool_.load(memory_order_consume);
+
+            for(;;) {
+                tagged_node_ptr new_pool (chain_top, old_pool.get_tag());
+                chain_bottom->next.set_ptr(old_pool.get_ptr());
+
+                if (pool_.compare_exchange_weak(old_pool, new_pool))
+                    return;
+            }
+        } else {
+            tagged_node_ptr old_pool = pool_.load(memory_order_relaxed);
+            chain_bottom->next.set_ptr(old_pool.get_ptr());
+            pool_.store(tagged_node_ptr(chain_top, old_pool.get_tag()), memory_order_relaxed);
+        }
+    }
+
     atomic<tagged_node_ptr> pool_;
 };
 
@@ -477,6 +520,28 @@ public:
         deallocate<ThreadSafe>(n - NodeStorage::nodes());
     }
 
+    /* destructs count nodes, starting at first and following next_node, and pushes them to the freelist at once */
+    template <bool ThreadSafe, typename NextNode>
+    void destruct_chain (T * first, std::size_t count, NextNode const & next_node)
+    {
+        index_t chain_top = null_handle();
+        index_t chain_bottom = null_handle();
+        T * n = first;
+        for (std::size_t i = 0; i != count; ++i) {
+            T * next = (i + 1 != count) ? next_node(n) : NULL;
+            n->~T();
+            index_t index = static_cast<index_t>(n - NodeStorage::nodes());
+            freelist_node * new_top = reinterpret_cast<freelist_node*>(n);
+            new_top->next.set_index(chain_top);
+            if (chain_bottom == null_handle())
+                chain_bottom = index;
+            chain_top = index;
+            n = next;
+        }
+        if (chain_top != null_handle())
+            deallocate_chain<ThreadSafe>(chain_top, chain_bottom);
+    }
+
     bool is_lock_free(void) const
     {
         return pool_.is_lock_free();
@@ -599,6 +664,26 @@ private:
         pool_.store(new_pool);
     }
 
+    template <bool ThreadSafe>
+    void deallocate_chain (index_t chain_top, index_t chain_bottom)
+    {
+        freelist_node * bottom_node = reinterpret_cast<freelist_node*>(NodeStorage::nodes() + chain_bottom);
+        tagged_index old_pool = pool_.load(memory_order_consume);
+
+        if (ThreadSafe) {
+            for(;;) {
+                tagged_index new_pool (chain_top, old_pool.get_tag());
+                bottom_node->next.set_index(old_pool.get_index());
+
+                if (pool_.compare_exchange_weak(old_pool, new_pool))
+                    return;
+            }
+        } else {
+            bottom_node->next.set_index(old_pool.get_index());
+            pool_.store(tagged_index(chain_top, old_pool.get_tag()));
+        }
+    }
+
     atomic<tagged_index> pool_;
 };
 
@@ -621,11 +706,16 @@ struct select_freelist
                               >::type type;
 };
 
-template <typename T, bool IsNodeBased>
+template <typename T, bool IsNodeBased, bool IsTagged = true>
 struct select_tagged_handle
 {
-    typedef typename mpl::if_c<IsNodeBased,
+    typedef typename mpl::if_c<IsTagged,
                                tagged_ptr<T>,
+                               untagged_ptr<T>
+                              >::type tagged_pointer_type;
+
+    typedef typename mpl::if_c<IsNodeBased,
+                               tagged_pointer_type,
                                tagged_index
                               >::type tagged_handle_type;
 
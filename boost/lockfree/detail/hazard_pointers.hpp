@@ -0,0 +1,209 @@
+//  hazard pointer memory reclamation from
+//  Michael, M. M.,
+//  "Hazard pointers: safe memory reclamation for lock-free objects"
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_HAZARD_POINTERS_HPP_INCLUDED
+#define BOOST_LOCKFREE_HAZARD_POINTERS_HPP_INCLUDED
+
+#include <cstddef>
+#include <memory>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/reclaiming_pool.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/* node pool that returns a retired node to the allocator once no hazard pointer refers to it.
+ *
+ * each operation owns a record with hazards_per_record hazard pointers for its duration. the retired nodes are kept in
+ * the record and they are deallocated by a scan of all hazard pointers when their number exceeds twice the number of
+ * hazard pointers. */
+template <typename T,
+          typename Alloc = std::allocator<T>
+         >
+class hazard_pointer_pool:
+    public reclaiming_pool<T, Alloc>
+{
+    typedef reclaiming_pool<T, Alloc> base;
+    typedef typename base::retired_node retired_node;
+
+public:
+    static const std::size_t hazards_per_record = 2;
+
+private:
+    struct record
+    {
+        record(void):
+            active(false), next(NULL), retired(NULL), retired_count(0)
+        {
+            for (std::size_t i = 0; i != hazards_per_record; ++i)
+                hazards[i].store(NULL, memory_order_relaxed);
+        }
+
+        atomic<T*> hazards[hazards_per_record];
+        atomic<bool> active;
+        record * next;
+
+        /* only accessed by the owner of the record */
+        retired_node * retired;
+        std::size_t retired_count;
+    };
+
+public:
+    typedef typename base::tagged_node_handle tagged_node_handle;
+
+    /* protects the nodes accessed by an operation, a guard must not be shared between threads */
+    class guard:
+        boost::noncopyable
+    {
+    public:
+        /* a node read from another node is only protected if the node it was read from is still reachable once the
+         * hazard pointer has been published, so traversals have to revalidate their starting point. */
+        static const bool validate_traversal = true;
+
+        explicit guard(hazard_pointer_pool & pool):
+            pool_(pool), record_(pool.records_.acquire())
+        {}
+
+        ~guard(void)
+        {
+            for (std::size_t i = 0; i != hazards_per_record; ++i)
+                record_->hazards[i].store(NULL, memory_order_release);
+            pool_.records_.release(record_);
+        }
+
+        /* loads src and publishes it in the hazard pointer slot, until src still holds the published node */
+        template <typename Handle>
+        Handle protect(std::size_t slot, atomic<Handle> const & src, memory_order order)
+        {
+            return protect(slot, src, src.load(memory_order_relaxed), order);
+        }
+
+        /* publishes h, which has been loaded from src, in the hazard pointer slot */
+        template <typename Handle>
+        Handle protect(std::size_t slot, atomic<Handle> const & src, Handle h, memory_order order = memory_order_acquire)
+        {
+            for (;;) {
+                publish(slot, h.get_ptr());
+                Handle current = src.load(order);
+                if (current == h)
+                    return h;
+                h = current;
+            }
+        }
+
+        /* publishes p, the caller has to check that p has not been retired before the hazard pointer was visible.
+         *
+         * the store releases the node that was protected by the slot before, so it must not be reordered with the
+         * accesses to that node, and the fence orders it before the validation of p. */
+        void publish(std::size_t slot, T * p)
+        {
+            record_->hazards[slot].store(p, memory_order_release);
+            atomic_thread_fence(memory_order_seq_cst);
+        }
+
+        void retire(tagged_node_handle h)
+        {
+            retire(h.get_ptr());
+        }
+
+        void retire(T * n)
+        {
+            pool_.retire(record_, n);
+        }
+
+        template <typename NextNode>
+        void retire_chain(T * first, std::size_t count, NextNode const & next_node)
+        {
+            T * n = first;
+            for (std::size_t i = 0; i != count; ++i) {
+                T * next = (i + 1 != count) ? next_node(n) : NULL;
+                retire(n);
+                n = next;
+            }
+        }
+
+    private:
+        hazard_pointer_pool & pool_;
+        record * record_;
+    };
+
+    template <typename Allocator>
+    hazard_pointer_pool (Allocator const & alloc, std::size_t n = 0):
+        base(alloc, n)
+    {}
+
+    ~hazard_pointer_pool(void)
+    {
+        for (record * r = records_.first(); r != NULL; r = r->next)
+            base::deallocate_list(r->retired);
+    }
+
+    bool is_lock_free(void) const
+    {
+        return base::is_lock_free() && records_.is_lock_free();
+    }
+
+private:
+    void retire(record * r, T * n)
+    {
+        retired_node * node = base::release(n);
+        node->next.store(r->retired, memory_order_relaxed);
+        r->retired = node;
+        r->retired_count += 1;
+
+        if (r->retired_count >= 2 * hazards_per_record * records_.size())
+            scan(r);
+    }
+
+    /* deallocates the retired nodes of r that are not referenced by a hazard pointer */
+    void scan(record * r)
+    {
+        atomic_thread_fence(memory_order_seq_cst);
+
+        retired_node * pending = r->retired;
+        r->retired = NULL;
+        r->retired_count = 0;
+
+        while (pending) {
+            retired_node * next = pending->next.load(memory_order_relaxed);
+            if (is_hazardous(pending)) {
+                pending->next.store(r->retired, memory_order_relaxed);
+                r->retired = pending;
+                r->retired_count += 1;
+            } else
+                base::deallocate(pending);
+            pending = next;
+        }
+    }
+
+    bool is_hazardous(retired_node * n) const
+    {
+        void * node = n;
+        for (record * r = records_.first(); r != NULL; r = r->next) {
+            for (std::size_t i = 0; i != hazards_per_record; ++i) {
+                if (r->hazards[i].load(memory_order_acquire) == node)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    reclamation_records<record> records_;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_HAZARD_POINTERS_HPP_INCLUDED */
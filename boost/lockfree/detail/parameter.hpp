@@ -65,6 +65,16 @@ struct extract_fixed_sized
     static const bool value = type::value;
 };
 
+template <typename bound_args>
+struct extract_reclamation
+{
+    static const bool has_reclamation = has_arg<bound_args, tag::reclamation>::value;
+
+    typedef typename mpl::if_c<has_reclamation,
+                               typename has_arg<bound_args, tag::reclamation>::type,
+                               freelist_reclamation
+                              >::type type;
+};
 
 } /* namespace detail */
 } /* namespace lockfree */
@@ -0,0 +1,264 @@
+//  node pool that returns freed nodes to the allocator, base of the memory reclamation schemes
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_RECLAIMING_POOL_HPP_INCLUDED
+#define BOOST_LOCKFREE_RECLAIMING_POOL_HPP_INCLUDED
+
+#include <cstddef>
+#include <memory>
+
+#include <boost/config.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/untagged_ptr.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/* the list of the records of the threads that run an operation. records are reused by later operations and they are
+ * only deleted with the list, so a record can be accessed without protection while the list exists. */
+template <typename Record>
+class reclamation_records:
+    boost::noncopyable
+{
+public:
+    reclamation_records(void):
+        head_(NULL), count_(0)
+    {}
+
+    ~reclamation_records(void)
+    {
+        Record * r = head_.load(memory_order_relaxed);
+        while (r) {
+            Record * next = r->next;
+            delete r;
+            r = next;
+        }
+    }
+
+    /* takes ownership of an unused record, allocates a new one if all records are in use */
+    Record * acquire(void)
+    {
+        for (Record * r = head_.load(memory_order_acquire); r != NULL; r = r->next) {
+            bool active = false;
+            if (!r->active.load(memory_order_relaxed) &&
+                r->active.compare_exchange_strong(active, true, memory_order_acquire, memory_order_relaxed))
+                return r;
+        }
+
+        Record * r = new Record();
+        r->active.store(true, memory_order_relaxed);
+
+        Record * old_head = head_.load(memory_order_relaxed);
+        do {
+            r->next = old_head;
+        } while (!head_.compare_exchange_weak(old_head, r, memory_order_release, memory_order_relaxed));
+
+        count_.fetch_add(1, memory_order_relaxed);
+        return r;
+    }
+
+    void release(Record * r)
+    {
+        r->active.store(false, memory_order_release);
+    }
+
+    Record * first(void) const
+    {
+        return head_.load(memory_order_acquire);
+    }
+
+    std::size_t size(void) const
+    {
+        return count_.load(memory_order_relaxed);
+    }
+
+    bool is_lock_free(void) const
+    {
+        return head_.is_lock_free();
+    }
+
+private:
+    atomic<Record*> head_;
+    atomic<std::size_t> count_;
+};
+
+/* allocates the nodes from Alloc and returns them to Alloc when they are destructed. the reclamation schemes defer the
+ * deallocation of the nodes that other threads may still access.
+ *
+ * Bounded operations fail when the data structure already holds as many nodes as have been reserved. unlike with the
+ * freelists, a bounded operation allocates its node from Alloc. */
+template <typename T,
+          typename Alloc = std::allocator<T>
+         >
+class reclaiming_pool:
+    Alloc
+{
+protected:
+    /* freed nodes are linked through their first word, like the nodes of the freelist. the link is atomic, because
+     * threads that still hold a pointer to a retired node may load its next pointer before they notice that the node
+     * has been removed from the data structure. */
+    struct retired_node
+    {
+        atomic<retired_node*> next;
+    };
+
+public:
+    typedef untagged_ptr<T> tagged_node_handle;
+
+    template <typename Allocator>
+    reclaiming_pool (Allocator const & alloc, std::size_t n = 0):
+        Alloc(alloc), node_count_(0), capacity_(n)
+    {}
+
+    template <bool ThreadSafe>
+    void reserve (std::size_t count)
+    {
+        capacity_.fetch_add(count, memory_order_relaxed);
+    }
+
+    template <bool ThreadSafe, bool Bounded>
+    T * construct (void)
+    {
+        T * node = allocate<Bounded>();
+        if (node)
+            new(node) T();
+        return node;
+    }
+
+    template <bool ThreadSafe, bool Bounded, typename ArgumentType>
+    T * construct (ArgumentType const & arg)
+    {
+        T * node = allocate<Bounded>();
+        if (node)
+            new(node) T(arg);
+        return node;
+    }
+
+    template <bool ThreadSafe, bool Bounded, typename ArgumentType1, typename ArgumentType2>
+    T * construct (ArgumentType1 const & arg1, ArgumentType2 const & arg2)
+    {
+        T * node = allocate<Bounded>();
+        if (node)
+            new(node) T(arg1, arg2);
+        return node;
+    }
+
+    /* destruct and destruct_chain deallocate the nodes immediately: they may only be used for nodes that cannot be
+     * accessed by other threads. the guards of the reclamation schemes retire the nodes of concurrent operations. */
+    template <bool ThreadSafe>
+    void destruct (tagged_node_handle tagged_ptr)
+    {
+        destruct<ThreadSafe>(tagged_ptr.get_ptr());
+    }
+
+    template <bool ThreadSafe>
+    void destruct (T * n)
+    {
+        deallocate(release(n));
+    }
+
+    template <bool ThreadSafe, typename NextNode>
+    void destruct_chain (T * first, std::size_t count, NextNode const & next_node)
+    {
+        T * n = first;
+        for (std::size_t i = 0; i != count; ++i) {
+            T * next = (i + 1 != count) ? next_node(n) : NULL;
+            destruct<ThreadSafe>(n);
+            n = next;
+        }
+    }
+
+    bool is_lock_free(void) const
+    {
+        return node_count_.is_lock_free();
+    }
+
+    T * get_handle(T * pointer) const
+    {
+        return pointer;
+    }
+
+    T * get_handle(tagged_node_handle const & handle) const
+    {
+        return get_pointer(handle);
+    }
+
+    T * get_pointer(tagged_node_handle const & tptr) const
+    {
+        return tptr.get_ptr();
+    }
+
+    T * get_pointer(T * pointer) const
+    {
+        return pointer;
+    }
+
+    T * null_handle(void) const
+    {
+        return NULL;
+    }
+
+protected:
+    /* destroys n and removes it from the node count, the memory can be linked in a list of retired nodes */
+    retired_node * release (T * n)
+    {
+        node_count_.fetch_sub(1, memory_order_relaxed);
+        n->~T();
+        void * node = n;
+        return new(node) retired_node;
+    }
+
+    void deallocate (retired_node * n)
+    {
+        n->~retired_node();
+        void * node = n;
+        Alloc::deallocate(reinterpret_cast<T*>(node), 1);
+    }
+
+    void deallocate_list (retired_node * n)
+    {
+        while (n) {
+            retired_node * next = n->next.load(memory_order_relaxed);
+            deallocate(n);
+            n = next;
+        }
+    }
+
+private:
+    template <bool Bounded>
+    T * allocate (void)
+    {
+        if (Bounded) {
+            std::size_t count = node_count_.load(memory_order_relaxed);
+            do {
+                if (count >= capacity_.load(memory_order_relaxed))
+                    return 0;
+            } while (!node_count_.compare_exchange_weak(count, count + 1, memory_order_relaxed));
+        } else
+            node_count_.fetch_add(1, memory_order_relaxed);
+
+        try {
+            return Alloc::allocate(1);
+        } catch (...) {
+            node_count_.fetch_sub(1, memory_order_relaxed);
+            throw;
+        }
+    }
+
+    atomic<std::size_t> node_count_;
+    atomic<std::size_t> capacity_;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_RECLAIMING_POOL_HPP_INCLUDED */
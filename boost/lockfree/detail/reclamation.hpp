@@ -0,0 +1,136 @@
+//  selection of the node pool and of the guard of a memory reclamation scheme
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_RECLAMATION_HPP_INCLUDED
+#define BOOST_LOCKFREE_RECLAMATION_HPP_INCLUDED
+
+#include <cstddef>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/lockfree/policies.hpp>
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/epoch_based_reclamation.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/hazard_pointers.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/* guard of the freelists: nodes are never returned to the allocator and the tags of the handles prevent the aba
+ * problem, so there is nothing to protect and nodes are freed immediately */
+template <typename Pool>
+class freelist_guard
+{
+public:
+    static const bool validate_traversal = false;
+
+    explicit freelist_guard(Pool & pool):
+        pool_(pool)
+    {}
+
+    template <typename Handle>
+    Handle protect(std::size_t /* slot */, atomic<Handle> const & src, memory_order order) const
+    {
+        return src.load(order);
+    }
+
+    template <typename Handle>
+    Handle protect(std::size_t /* slot */, atomic<Handle> const & /* src */, Handle h,
+                   memory_order /* order */ = memory_order_acquire) const
+    {
+        return h;
+    }
+
+    template <typename Pointer>
+    void publish(std::size_t /* slot */, Pointer /* p */) const
+    {}
+
+    template <typename Handle>
+    void retire(Handle h) const
+    {
+        pool_.template destruct<true>(h);
+    }
+
+    template <typename Node, typename NextNode>
+    void retire_chain(Node * first, std::size_t count, NextNode const & next_node) const
+    {
+        pool_.template destruct_chain<true>(first, count, next_node);
+    }
+
+private:
+    Pool & pool_;
+};
+
+template <typename Reclamation>
+struct reclamation_uses_tags
+{
+    static const bool value = true;
+};
+
+template <>
+struct reclamation_uses_tags<hazard_pointer_reclamation>
+{
+    static const bool value = false;
+};
+
+template <>
+struct reclamation_uses_tags<epoch_based_reclamation>
+{
+    static const bool value = false;
+};
+
+template <typename T,
+          typename Alloc,
+          typename Reclamation,
+          bool IsCompileTimeSized,
+          bool IsFixedSize,
+          std::size_t Capacity
+          >
+struct select_reclamation
+{
+    typedef typename select_freelist<T, Alloc, IsCompileTimeSized, IsFixedSize, Capacity>::type type;
+    typedef freelist_guard<type> guard;
+};
+
+template <typename T,
+          typename Alloc,
+          bool IsCompileTimeSized,
+          bool IsFixedSize,
+          std::size_t Capacity
+          >
+struct select_reclamation<T, Alloc, hazard_pointer_reclamation, IsCompileTimeSized, IsFixedSize, Capacity>
+{
+    /* the nodes of a fixed-sized data structure are stored in an array and can't be returned to the allocator */
+    BOOST_STATIC_ASSERT(!IsCompileTimeSized && !IsFixedSize);
+
+    typedef hazard_pointer_pool<T, Alloc> type;
+    typedef typename type::guard guard;
+};
+
+template <typename T,
+          typename Alloc,
+          bool IsCompileTimeSized,
+          bool IsFixedSize,
+          std::size_t Capacity
+          >
+struct select_reclamation<T, Alloc, epoch_based_reclamation, IsCompileTimeSized, IsFixedSize, Capacity>
+{
+    /* the nodes of a fixed-sized data structure are stored in an array and can't be returned to the allocator */
+    BOOST_STATIC_ASSERT(!IsCompileTimeSized && !IsFixedSize);
+
+    typedef epoch_based_pool<T, Alloc> type;
+    typedef typename type::guard guard;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_RECLAMATION_HPP_INCLUDED */
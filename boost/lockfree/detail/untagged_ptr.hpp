@@ -0,0 +1,132 @@
+//  pointer with the interface of tagged_ptr, for data structures whose nodes are protected from reuse by a
+//  memory reclamation scheme and therefore don't need a tag to prevent the aba problem.
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_UNTAGGED_PTR_HPP_INCLUDED
+#define BOOST_LOCKFREE_UNTAGGED_PTR_HPP_INCLUDED
+
+#include <cstddef>              /* for std::size_t */
+
+#include <boost/config.hpp>
+
+namespace boost {
+namespace lockfree {
+namespace detail {
+
+/** pointer-sized replacement of tagged_ptr: the tag is always 0, so an atomic<untagged_ptr> only requires a
+ *  single-width compare-and-swap */
+template <class T>
+class untagged_ptr
+{
+public:
+    typedef std::size_t tag_t;
+
+    /** uninitialized constructor */
+    untagged_ptr(void) BOOST_NOEXCEPT//: ptr(0)
+    {}
+
+    /** copy constructor */
+#ifdef BOOST_NO_CXX11_DEFAULTED_FUNCTIONS
+    untagged_ptr(untagged_ptr const & p):
+        ptr(p.ptr)
+    {}
+#else
+    untagged_ptr(untagged_ptr const & p) = default;
+#endif
+
+    explicit untagged_ptr(T * p, tag_t /* t */ = 0):
+        ptr(p)
+    {}
+
+    /** unsafe set operation */
+    /* @{ */
+#ifdef BOOST_NO_CXX11_DEFAULTED_FUNCTIONS
+    untagged_ptr & operator= (untagged_ptr const & p)
+    {
+        ptr = p.ptr;
+        return *this;
+    }
+#else
+    untagged_ptr & operator= (untagged_ptr const & p) = default;
+#endif
+
+    void set(T * p, tag_t /* t */)
+    {
+        ptr = p;
+    }
+    /* @} */
+
+    /** comparing semantics */
+    /* @{ */
+    bool operator== (volatile untagged_ptr const & p) const
+    {
+        return (ptr == p.ptr);
+    }
+
+    bool operator!= (volatile untagged_ptr const & p) const
+    {
+        return !operator==(p);
+    }
+    /* @} */
+
+    /** pointer access */
+    /* @{ */
+    T * get_ptr(void) const
+    {
+        return ptr;
+    }
+
+    void set_ptr(T * p)
+    {
+        ptr = p;
+    }
+    /* @} */
+
+    /** tag access */
+    /* @{ */
+    tag_t get_tag() const
+    {
+        return 0;
+    }
+
+    tag_t get_next_tag() const
+    {
+        return 0;
+    }
+
+    void set_tag(tag_t /* t */)
+    {}
+    /* @} */
+
+    /** smart pointer support  */
+    /* @{ */
+    T & operator*() const
+    {
+        return *ptr;
+    }
+
+    T * operator->() const
+    {
+        return ptr;
+    }
+
+    operator bool(void) const
+    {
+        return ptr != 0;
+    }
+    /* @} */
+
+protected:
+    T * ptr;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_UNTAGGED_PTR_HPP_INCLUDED */
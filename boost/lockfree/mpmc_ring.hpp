@@ -0,0 +1,626 @@
+//  lock-free bounded multi-producer/multi-consumer ringbuffer
+//  based on the bounded mpmc queue by Dmitry Vyukov,
+//  http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_MPMC_RING_HPP_INCLUDED
+#define BOOST_LOCKFREE_MPMC_RING_HPP_INCLUDED
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+#include <boost/aligned_storage.hpp>
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/copy_payload.hpp>
+#include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+typedef parameter::parameters<boost::parameter::optional<tag::capacity>,
+                              boost::parameter::optional<tag::allocator>
+                             > mpmc_ring_signature;
+
+template <typename T>
+struct mpmc_ring_cell
+{
+    /* the position, for which the cell can be written, or the position + 1, for which it can be read */
+    atomic<std::size_t> sequence;
+    typename boost::aligned_storage<sizeof(T), boost::alignment_of<T>::value>::type storage;
+
+    T * data(void)
+    {
+        return static_cast<T*>(static_cast<void*>(&storage));
+    }
+};
+
+/* the sequence numbers can't tell a full cell from an empty one with less than two cells, so smaller
+ * sizes are rounded up to 2 */
+template <std::size_t Size>
+struct round_up_to_power_of_two
+{
+    BOOST_STATIC_ASSERT(Size > 0);
+
+    static const std::size_t v0 = (Size < 2 ? 2 : Size) - 1;
+    static const std::size_t v1 = v0 | (v0 >> 1);
+    static const std::size_t v2 = v1 | (v1 >> 2);
+    static const std::size_t v3 = v2 | (v2 >> 4);
+    static const std::size_t v4 = v3 | (v3 >> 8);
+    static const std::size_t v5 = v4 | (v4 >> 16);
+    static const std::size_t v6 = v5 | (v5 >> 16 >> 16);
+    static const std::size_t value = v6 + 1;
+};
+
+inline std::size_t round_up_to_power_of_two_runtime(std::size_t size)
+{
+    std::size_t ret = 2;
+    while (ret < size)
+        ret *= 2;
+    return ret;
+}
+
+template <typename Cell, std::size_t Size>
+class compile_time_sized_mpmc_ring_storage
+{
+    static const std::size_t max_size = round_up_to_power_of_two<Size>::value;
+
+    typedef typename boost::aligned_storage<max_size * sizeof(Cell), boost::alignment_of<Cell>::value>::type storage_type;
+
+    storage_type storage_;
+
+protected:
+    Cell * cells(void)
+    {
+        return static_cast<Cell*>(static_cast<void*>(&storage_));
+    }
+
+    std::size_t max_number_of_elements(void) const
+    {
+        return max_size;
+    }
+};
+
+template <typename Cell, typename Alloc>
+class runtime_sized_mpmc_ring_storage:
+    private Alloc
+{
+    Cell * cells_;
+    std::size_t max_elements_;
+
+protected:
+    typedef Alloc allocator;
+
+    explicit runtime_sized_mpmc_ring_storage(std::size_t max_elements):
+        max_elements_(round_up_to_power_of_two_runtime(max_elements))
+    {
+        cells_ = Alloc::allocate(max_elements_);
+    }
+
+    template <typename Allocator>
+    runtime_sized_mpmc_ring_storage(Allocator const & alloc, std::size_t max_elements):
+        Alloc(alloc), max_elements_(round_up_to_power_of_two_runtime(max_elements))
+    {
+        cells_ = Alloc::allocate(max_elements_);
+    }
+
+    ~runtime_sized_mpmc_ring_storage(void)
+    {
+        Alloc::deallocate(cells_, max_elements_);
+    }
+
+    Cell * cells(void)
+    {
+        return cells_;
+    }
+
+    std::size_t max_number_of_elements(void) const
+    {
+        return max_elements_;
+    }
+};
+
+template <typename T, typename A0, typename A1>
+struct make_mpmc_ring
+{
+    typedef typename mpmc_ring_signature::bind<A0, A1>::type bound_args;
+
+    typedef extract_capacity<bound_args> extract_capacity_t;
+
+    static const bool runtime_sized = !extract_capacity_t::has_capacity;
+    static const std::size_t capacity = extract_capacity_t::capacity;
+
+    typedef mpmc_ring_cell<T> cell;
+    typedef extract_allocator<bound_args, cell> extract_allocator_t;
+    typedef typename extract_allocator_t::type allocator;
+
+    // allocator argument is only sane, for run-time sized ringbuffers
+    BOOST_STATIC_ASSERT((mpl::if_<mpl::bool_<!runtime_sized>,
+                                  mpl::bool_<!extract_allocator_t::has_allocator>,
+                                  mpl::true_
+                                 >::type::value));
+
+    typedef typename mpl::if_c<runtime_sized,
+                               runtime_sized_mpmc_ring_storage<cell, allocator>,
+                               compile_time_sized_mpmc_ring_storage<cell, capacity>
+                              >::type storage_type;
+};
+
+} /* namespace detail */
+
+
+/** The mpmc_ring class provides a bounded multi-producer/multi-consumer fifo queue, pushing and popping is lock-free.
+ *  The elements are stored in a ringbuffer, in which each slot carries a sequence number telling whether it can be
+ *  written or read at a given position. Unlike the node-based \ref boost::lockfree::queue, it does not need a freelist
+ *  or tagged pointers: each operation claims its slots with a single compare-and-swap on the write or read index.
+ *
+ *  \b Policies:
+ *  - \c boost::lockfree::capacity<>, optional <br>
+ *    If this template argument is passed to the options, the size of the ringbuffer is set at compile-time and the
+ *    ringbuffer is stored inside the object, without any dynamic memory allocation.
+ *
+ *  - \c boost::lockfree::allocator<>, defaults to \c boost::lockfree::allocator<std::allocator<T>> <br>
+ *    Specifies the allocator that is used to allocate the ringbuffer. This option is only valid, if the ringbuffer is configured
+ *    to be sized at run-time
+ *
+ *  The capacity is rounded up to the next power of two, and is at least 2.
+ *
+ *  \b Requirements:
+ *  - T must be copyable
+ *  - the copy constructor and the assignment operator of T must not throw
+ * */
+#ifndef BOOST_DOXYGEN_INVOKED
+template <typename T,
+          class A0 = boost::parameter::void_,
+          class A1 = boost::parameter::void_>
+#else
+template <typename T, ...Options>
+#endif
+class mpmc_ring:
+    private detail::make_mpmc_ring<T, A0, A1>::storage_type
+{
+private:
+
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef detail::make_mpmc_ring<T, A0, A1> make_mpmc_ring_t;
+    typedef typename make_mpmc_ring_t::storage_type base_type;
+    typedef typename make_mpmc_ring_t::cell cell;
+    static const bool runtime_sized = make_mpmc_ring_t::runtime_sized;
+    typedef typename make_mpmc_ring_t::allocator allocator_arg;
+
+    struct implementation_defined
+    {
+        typedef allocator_arg allocator;
+        typedef std::size_t size_type;
+    };
+
+    /* consume_all applies the functor to at most this number of elements per claim */
+    static const std::size_t consume_batch_size = 16;
+#endif
+
+    BOOST_DELETED_FUNCTION(mpmc_ring(mpmc_ring const&))
+    BOOST_DELETED_FUNCTION(mpmc_ring& operator= (mpmc_ring const&))
+
+public:
+    typedef T value_type;
+    typedef typename implementation_defined::allocator allocator;
+    typedef typename implementation_defined::size_type size_type;
+
+    /** Constructs a mpmc_ring
+     *
+     *  \pre mpmc_ring must be configured to be sized at compile-time
+     */
+    // @{
+    mpmc_ring(void)
+    {
+        BOOST_ASSERT(!runtime_sized);
+        initialize();
+    }
+
+    template <typename U>
+    explicit mpmc_ring(typename allocator::template rebind<U>::other const & alloc)
+    {
+        // just for API compatibility: we don't actually need an allocator
+        BOOST_STATIC_ASSERT(!runtime_sized);
+        initialize();
+    }
+
+    explicit mpmc_ring(allocator const & alloc)
+    {
+        // just for API compatibility: we don't actually need an allocator
+        BOOST_ASSERT(!runtime_sized);
+        initialize();
+    }
+    // @}
+
+
+    /** Constructs a mpmc_ring for element_count elements
+     *
+     *  \pre mpmc_ring must be configured to be sized at run-time
+     */
+    // @{
+    explicit mpmc_ring(size_type element_count):
+        base_type(element_count)
+    {
+        BOOST_ASSERT(runtime_sized);
+        initialize();
+    }
+
+    template <typename U>
+    mpmc_ring(size_type element_count, typename allocator::template rebind<U>::other const & alloc):
+        base_type(alloc, element_count)
+    {
+        BOOST_STATIC_ASSERT(runtime_sized);
+        initialize();
+    }
+
+    mpmc_ring(size_type element_count, allocator_arg const & alloc):
+        base_type(alloc, element_count)
+    {
+        BOOST_ASSERT(runtime_sized);
+        initialize();
+    }
+    // @}
+
+    /** Destroys mpmc_ring, destroying the elements, which have not been popped.
+     *
+     *  \note not thread-safe
+     * */
+    ~mpmc_ring(void)
+    {
+        size_type pos = dequeue_pos_.load(memory_order_relaxed);
+        const size_type end = enqueue_pos_.load(memory_order_relaxed);
+        for (; pos != end; ++pos)
+            get_cell(pos).data()->~T();
+    }
+
+    /**
+     * \return true, if implementation is lock-free.
+     * */
+    bool is_lock_free(void) const
+    {
+        return enqueue_pos_.is_lock_free() && dequeue_pos_.is_lock_free();
+    }
+
+    /** Check if the mpmc_ring is empty
+     *
+     * \return true, if the mpmc_ring is empty, false otherwise
+     * \note The result is only accurate, if no other thread modifies the mpmc_ring. Therefore it is rarely practical to use this
+     *       value in program logic.
+     * */
+    bool empty(void) const
+    {
+        return enqueue_pos_.load(memory_order_relaxed) == dequeue_pos_.load(memory_order_relaxed);
+    }
+
+    /** Pushes object t to the mpmc_ring.
+     *
+     * \post object will be pushed to the mpmc_ring, unless it is full.
+     * \return true, if the push operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool push(T const & t)
+    {
+        size_type pos;
+        if (claim_push(1, pos) == 0)
+            return false;
+
+        publish(pos, t);
+        return true;
+    }
+
+    /** Pushes object t to the mpmc_ring.
+     *
+     * \post object will be pushed to the mpmc_ring, unless it is full.
+     * \return true, if the push operation is successful.
+     *
+     * \note Thread-safe and non-blocking. Same as push, as the mpmc_ring is always bounded: provided for interface
+     *       compatibility with boost::lockfree::queue
+     * */
+    bool bounded_push(T const & t)
+    {
+        return push(t);
+    }
+
+    /** Pushes as many objects from the array t as there are consecutive free slots.
+     *
+     * \return number of pushed items
+     *
+     * \note Thread-safe and non-blocking. The slots are claimed with a single compare-and-swap, so the pushed objects
+     *       are popped in order, without objects of other threads in between.
+     */
+    size_type push(T const * t, size_type size)
+    {
+        return push(t, t + size) - t;
+    }
+
+    /** Pushes as many objects from the array t as there are consecutive free slots.
+     *
+     * \return number of pushed items
+     *
+     * \note Thread-safe and non-blocking
+     */
+    template <size_type size>
+    size_type push(T const (&t)[size])
+    {
+        return push(t, size);
+    }
+
+    /** Pushes as many objects from the range [begin, end) as there are consecutive free slots.
+     *
+     * \return iterator to the first element, which has not been pushed
+     *
+     * \note Thread-safe and non-blocking
+     */
+    template <typename ConstIterator>
+    ConstIterator push(ConstIterator begin, ConstIterator end)
+    {
+        const size_type input_count = std::distance(begin, end);
+        if (input_count == 0)
+            return begin;
+
+        size_type pos;
+        const size_type count = claim_push(input_count, pos);
+        for (size_type i = 0; i != count; ++i, ++begin)
+            publish(pos + i, *begin);
+
+        return begin;
+    }
+
+    /** Pops one object from mpmc_ring.
+     *
+     * \post if mpmc_ring is not empty, object will be copied to ret.
+     * \return true, if the pop operation is successful, false if mpmc_ring was empty.
+     *
+     * \note Thread-safe and non-blocking
+     */
+    bool pop(T & ret)
+    {
+        return pop<T>(ret);
+    }
+
+    /** Pops one object from mpmc_ring.
+     *
+     * \pre type U must be constructible by T and copyable, or T must be convertible to U
+     * \post if mpmc_ring is not empty, object will be copied to ret.
+     * \return true, if the pop operation is successful, false if mpmc_ring was empty.
+     *
+     * \note Thread-safe and non-blocking
+     */
+    template <typename U>
+    bool pop(U & ret)
+    {
+        size_type pos;
+        if (claim_pop(1, pos) == 0)
+            return false;
+
+        T * data = get_cell(pos).data();
+        detail::copy_payload(*data, ret);
+        release(pos);
+        return true;
+    }
+
+    /** Pops a maximum of size objects from mpmc_ring.
+     *
+     * \return number of popped items
+     *
+     * \note Thread-safe and non-blocking. The slots are claimed with a single compare-and-swap.
+     * */
+    size_type pop(T * ret, size_type size)
+    {
+        if (size == 0)
+            return 0;
+
+        size_type pos;
+        const size_type count = claim_pop(size, pos);
+        for (size_type i = 0; i != count; ++i) {
+            ret[i] = *get_cell(pos + i).data();
+            release(pos + i);
+        }
+        return count;
+    }
+
+    /** Pops a maximum of size objects from mpmc_ring.
+     *
+     * \return number of popped items
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    template <size_type size>
+    size_type pop(T (&ret)[size])
+    {
+        return pop(ret, size);
+    }
+
+    /** consumes one element via a functor
+     *
+     *  pops one element from the mpmc_ring and applies the functor on this object
+     *
+     * \returns true, if one element was consumed
+     *
+     * \note Thread-safe and non-blocking, if functor is thread-safe and non-blocking. The functor is applied to the
+     *       element in place, its slot is released when the functor returns.
+     * */
+    template <typename Functor>
+    bool consume_one(Functor & f)
+    {
+        return do_consume<Functor>(f, 1) != 0;
+    }
+
+    /// \copydoc boost::lockfree::mpmc_ring::consume_one(Functor & rhs)
+    template <typename Functor>
+    bool consume_one(Functor const & f)
+    {
+        return do_consume<Functor const>(f, 1) != 0;
+    }
+
+    /** consumes all elements via a functor
+     *
+     * pops all elements from the mpmc_ring in batches and applies the functor on each object, in order
+     *
+     * \returns number of elements that are consumed
+     *
+     * \note Thread-safe and non-blocking, if functor is thread-safe and non-blocking
+     * */
+    template <typename Functor>
+    size_type consume_all(Functor & f)
+    {
+        size_type element_count = 0;
+        for (;;) {
+            size_type count = do_consume<Functor>(f, consume_batch_size);
+            if (count == 0)
+                return element_count;
+            element_count += count;
+        }
+    }
+
+    /// \copydoc boost::lockfree::mpmc_ring::consume_all(Functor & rhs)
+    template <typename Functor>
+    size_type consume_all(Functor const & f)
+    {
+        size_type element_count = 0;
+        for (;;) {
+            size_type count = do_consume<Functor const>(f, consume_batch_size);
+            if (count == 0)
+                return element_count;
+            element_count += count;
+        }
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    void initialize(void)
+    {
+        cell * cells = base_type::cells();
+        for (size_type i = 0; i != base_type::max_number_of_elements(); ++i)
+            new (&cells[i].sequence) atomic<size_type>(i);
+
+        enqueue_pos_.store(0, memory_order_relaxed);
+        dequeue_pos_.store(0, memory_order_release);
+    }
+
+    cell & get_cell(size_type pos)
+    {
+        return base_type::cells()[pos & (base_type::max_number_of_elements() - 1)];
+    }
+
+    /* claims up to max_count consecutive slots at the write index, for which the previous element has been popped.
+     * while enqueue_pos_ has not passed a free slot, no other thread can write it, so the slots, which have been
+     * checked before the compare-and-swap, are still free after it. */
+    size_type claim_push(size_type max_count, size_type & pos)
+    {
+        using detail::likely;
+
+        pos = enqueue_pos_.load(memory_order_relaxed);
+        for (;;) {
+            size_type count = 0;
+            std::ptrdiff_t dif = 0;
+            for (; count != max_count; ++count) {
+                size_type seq = get_cell(pos + count).sequence.load(memory_order_acquire);
+                dif = static_cast<std::ptrdiff_t>(seq - (pos + count));
+                if (dif != 0)
+                    break;
+            }
+
+            if (likely(count != 0)) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + count, memory_order_relaxed))
+                    return count;
+            } else if (dif < 0)
+                return 0; /* ringbuffer is full */
+            else
+                pos = enqueue_pos_.load(memory_order_relaxed);
+        }
+    }
+
+    /* claims up to max_count consecutive slots at the read index, which have been published */
+    size_type claim_pop(size_type max_count, size_type & pos)
+    {
+        using detail::likely;
+
+        pos = dequeue_pos_.load(memory_order_relaxed);
+        for (;;) {
+            size_type count = 0;
+            std::ptrdiff_t dif = 0;
+            for (; count != max_count; ++count) {
+                size_type seq = get_cell(pos + count).sequence.load(memory_order_acquire);
+                dif = static_cast<std::ptrdiff_t>(seq - (pos + count + 1));
+                if (dif != 0)
+                    break;
+            }
+
+            if (likely(count != 0)) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + count, memory_order_relaxed))
+                    return count;
+            } else if (dif < 0)
+                return 0; /* ringbuffer is empty */
+            else
+                pos = dequeue_pos_.load(memory_order_relaxed);
+        }
+    }
+
+    template <typename U>
+    void publish(size_type pos, U const & value)
+    {
+        cell & c = get_cell(pos);
+        new (c.data()) T(value);
+        c.sequence.store(pos + 1, memory_order_release);
+    }
+
+    void release(size_type pos)
+    {
+        cell & c = get_cell(pos);
+        c.data()->~T();
+        c.sequence.store(pos + base_type::max_number_of_elements(), memory_order_release);
+    }
+
+    template <typename Functor>
+    size_type do_consume(Functor & f, size_type max_count)
+    {
+        size_type pos;
+        const size_type count = claim_pop(max_count, pos);
+        size_type i = 0;
+        try {
+            for (; i != count; ++i) {
+                f(*get_cell(pos + i).data());
+                release(pos + i);
+            }
+        } catch (...) {
+            /* the claimed slots have to be released, or the producers would stall on them */
+            for (; i != count; ++i)
+                release(pos + i);
+            throw;
+        }
+        return count;
+    }
+
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(size_type);
+    char padding0[padding_size]; /* keep the indices apart from the ringbuffer and from each other */
+    atomic<size_type> enqueue_pos_;
+    char padding1[padding_size];
+    atomic<size_type> dequeue_pos_;
+    char padding2[padding_size];
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+
+#endif /* BOOST_LOCKFREE_MPMC_RING_HPP_INCLUDED */
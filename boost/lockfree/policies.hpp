@@ -21,6 +21,7 @@ namespace lockfree {
 namespace tag { struct allocator ; }
 namespace tag { struct fixed_sized; }
 namespace tag { struct capacity; }
+namespace tag { struct reclamation; }
 
 #endif
 
@@ -52,6 +53,35 @@ struct allocator:
     boost::parameter::template_keyword<tag::allocator, Alloc>
 {};
 
+/** Selects the \b memory \b reclamation scheme of the nodes of a node-based data structure.
+ *
+ *  The scheme is one of \ref boost::lockfree::freelist_reclamation, \ref boost::lockfree::hazard_pointer_reclamation
+ *  or \ref boost::lockfree::epoch_based_reclamation. The reclamation schemes other than the freelist require a data
+ *  structure that is not fixed-sized.
+ * */
+template <class Scheme>
+struct reclamation:
+    boost::parameter::template_keyword<tag::reclamation, Scheme>
+{};
+
+/** Freed nodes are pushed to a freelist and reused, they are only returned to the allocator when the data structure is
+ *  destroyed. Tagged pointers prevent the aba problem, which requires a double-width compare-and-exchange on platforms
+ *  without pointer compression.
+ * */
+struct freelist_reclamation {};
+
+/** Threads publish the nodes they access in hazard pointers, and freed nodes are returned to the allocator once they are
+ *  not referenced by any hazard pointer. Memory is released shortly after the nodes are freed, at the cost of a fence
+ *  for each protected node.
+ * */
+struct hazard_pointer_reclamation {};
+
+/** Threads announce the global epoch in which their operations run, and freed nodes are returned to the allocator once
+ *  the global epoch has advanced twice. Operations are cheaper than with hazard pointers, but a thread that stalls inside
+ *  an operation delays the release of all nodes that are freed in the meantime.
+ * */
+struct epoch_based_reclamation {};
+
 }
 }
 
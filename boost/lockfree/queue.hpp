@@ -13,6 +13,7 @@
 
 #include <boost/assert.hpp>
 #include <boost/static_assert.hpp>
+#include <boost/tuple/tuple.hpp>
 #include <boost/type_traits/has_trivial_assign.hpp>
 #include <boost/type_traits/has_trivial_destructor.hpp>
 
@@ -20,6 +21,7 @@
 #include <boost/lockfree/detail/copy_payload.hpp>
 #include <boost/lockfree/detail/freelist.hpp>
 #include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/reclamation.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 
 #ifdef BOOST_HAS_PRAGMA_ONCE
@@ -45,7 +47,7 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
 
 
 /** The queue class provides a multi-writer/multi-reader queue, pushing and popping is lock-free,
- *  construction/destruction has to be synchronized. It uses a freelist for memory management,
+ *  construction/destruction has to be synchronized. By default it uses a freelist for memory management,
  *  freed nodes are pushed to the freelist and not returned to the OS before the queue is destroyed.
  *
  *  \b Policies:
@@ -63,6 +65,12 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
  *  - \ref boost::lockfree::allocator, defaults to \c boost::lockfree::allocator<std::allocator<void>> \n
  *    Specifies the allocator that is used for the internal freelist
  *
+ *  - \ref boost::lockfree::reclamation, defaults to \c boost::lockfree::reclamation<boost::lockfree::freelist_reclamation> \n
+ *    With \c hazard_pointer_reclamation or \c epoch_based_reclamation, freed nodes are returned to the allocator once no
+ *    thread can access them, so the memory of the queue shrinks after a burst, and the queue does not need tagged pointers,
+ *    which require double-width compare-and-exchange instructions on some platforms. Pushing and popping may then allocate
+ *    and deallocate memory, and the queue cannot be fixed-sized.
+ *
  *  \b Requirements:
  *   - T must have a copy constructor
  *   - T must have a trivial assignment operator
@@ -97,11 +105,13 @@ private:
     static const bool fixed_sized = detail::extract_fixed_sized<bound_args>::value;
     static const bool node_based = !(has_capacity || fixed_sized);
     static const bool compile_time_sized = has_capacity;
+    typedef typename detail::extract_reclamation<bound_args>::type reclamation_scheme;
+    static const bool tagged = detail::reclamation_uses_tags<reclamation_scheme>::value;
 
     struct BOOST_LOCKFREE_CACHELINE_ALIGNMENT node
     {
-        typedef typename detail::select_tagged_handle<node, node_based>::tagged_handle_type tagged_node_handle;
-        typedef typename detail::select_tagged_handle<node, node_based>::handle_type handle_type;
+        typedef typename detail::select_tagged_handle<node, node_based, tagged>::tagged_handle_type tagged_node_handle;
+        typedef typename detail::select_tagged_handle<node, node_based, tagged>::handle_type handle_type;
 
         node(T const & v, handle_type null_handle):
             data(v)//, next(tagged_node_handle(0, 0))
@@ -124,9 +134,21 @@ private:
     };
 
     typedef typename detail::extract_allocator<bound_args, node>::type node_allocator;
-    typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity>::type pool_t;
+    typedef detail::select_reclamation<node, node_allocator, reclamation_scheme, compile_time_sized, fixed_sized, capacity> reclamation_t;
+    typedef typename reclamation_t::type pool_t;
+    typedef typename reclamation_t::guard guard_t;
     typedef typename pool_t::tagged_node_handle tagged_node_handle;
-    typedef typename detail::select_tagged_handle<node, node_based>::handle_type handle_type;
+    typedef typename detail::select_tagged_handle<node, node_based, tagged>::handle_type handle_type;
+
+    struct next_node_fn
+    {
+        pool_t * pool;
+
+        node * operator()(node * n) const
+        {
+            return pool->get_pointer(n->next.load(memory_order_relaxed));
+        }
+    };
 
     void initialize(void)
     {
@@ -294,8 +316,9 @@ private:
         if (n == NULL)
             return false;
 
+        guard_t guard(pool);
         for (;;) {
-            tagged_node_handle tail = tail_.load(memory_order_acquire);
+            tagged_node_handle tail = guard.protect(0, tail_, memory_order_acquire);
             node * tail_node = pool.get_pointer(tail);
             tagged_node_handle next = tail_node->next.load(memory_order_acquire);
             node * next_ptr = pool.get_pointer(next);
@@ -317,8 +340,143 @@ private:
             }
         }
     }
+
+    /* links the chain of nodes [first_node, last_node] after the last node with a single compare-and-swap */
+    void link_nodes_atomic(node * first_node, node * last_node)
+    {
+        using detail::likely;
+
+        handle_type first_handle = pool.get_handle(first_node);
+        handle_type last_handle = pool.get_handle(last_node);
+
+        guard_t guard(pool);
+        for (;;) {
+            tagged_node_handle tail = guard.protect(0, tail_, memory_order_acquire);
+            node * tail_node = pool.get_pointer(tail);
+            tagged_node_handle next = tail_node->next.load(memory_order_acquire);
+            node * next_ptr = pool.get_pointer(next);
+
+            tagged_node_handle tail2 = tail_.load(memory_order_acquire);
+            if (likely(tail == tail2)) {
+                if (next_ptr == 0) {
+                    tagged_node_handle new_tail_next(first_handle, next.get_next_tag());
+                    if ( tail_node->next.compare_exchange_weak(next, new_tail_next) ) {
+                        /* if this fails, other threads advance the tail along the chain one node at a time */
+                        tagged_node_handle new_tail(last_handle, tail.get_next_tag());
+                        tail_.compare_exchange_strong(tail, new_tail);
+                        return;
+                    }
+                }
+                else {
+                    tagged_node_handle new_tail(pool.get_handle(next_ptr), tail.get_next_tag());
+                    tail_.compare_exchange_strong(tail, new_tail);
+                }
+            }
+        }
+    }
+
+    void link_nodes_unsafe(node * first_node, node * last_node)
+    {
+        for (;;) {
+            tagged_node_handle tail = tail_.load(memory_order_relaxed);
+            node * tail_node = pool.get_pointer(tail);
+            tagged_node_handle next = tail_node->next.load(memory_order_relaxed);
+            node * next_ptr = pool.get_pointer(next);
+
+            if (next_ptr == 0) {
+                tail_node->next.store(tagged_node_handle(pool.get_handle(first_node), next.get_next_tag()), memory_order_relaxed);
+                tail_.store(tagged_node_handle(pool.get_handle(last_node), tail.get_next_tag()), memory_order_relaxed);
+                return;
+            }
+            else
+                tail_.store(tagged_node_handle(pool.get_handle(next_ptr), tail.get_next_tag()), memory_order_relaxed);
+        }
+    }
+
+    /* allocates and links the nodes for the elements of [begin, end), until the freelist is exhausted */
+    template <bool Threadsafe, bool Bounded, typename ConstIterator>
+    tuple<node*, node*> prepare_node_list(ConstIterator begin, ConstIterator end, ConstIterator & ret)
+    {
+        ConstIterator it = begin;
+        node * first_node = pool.template construct<Threadsafe, Bounded>(*it++, pool.null_handle());
+        if (first_node == NULL) {
+            ret = begin;
+            return make_tuple<node*, node*>(NULL, NULL);
+        }
+
+        node * last_node = first_node;
+
+        try {
+            for (; it != end; ++it) {
+                node * newnode = pool.template construct<Threadsafe, Bounded>(*it, pool.null_handle());
+                if (newnode == NULL)
+                    break;
+                tagged_node_handle last_next = last_node->next.load(memory_order_relaxed);
+                last_node->next.store(tagged_node_handle(pool.get_handle(newnode), last_next.get_tag()), memory_order_relaxed);
+                last_node = newnode;
+            }
+        } catch (...) {
+            for (node * current_node = first_node; current_node != NULL;) {
+                node * next = current_node == last_node ? NULL
+                                                        : pool.get_pointer(current_node->next.load(memory_order_relaxed));
+                pool.template destruct<Threadsafe>(current_node);
+                current_node = next;
+            }
+            throw;
+        }
+        ret = it;
+        return make_tuple(first_node, last_node);
+    }
+
+    template <bool Bounded, typename ConstIterator>
+    ConstIterator do_push(ConstIterator begin, ConstIterator end)
+    {
+        if (begin == end)
+            return end;
+
+        node * first_node;
+        node * last_node;
+        ConstIterator ret;
+
+        tie(first_node, last_node) = prepare_node_list<true, Bounded>(begin, end, ret);
+        if (first_node)
+            link_nodes_atomic(first_node, last_node);
+
+        return ret;
+    }
 #endif
 
+public:
+    /** Pushes as many objects from the range [begin, end) as freelist node can be allocated.
+     *
+     * \return iterator to the first element, which has not been pushed
+     *
+     * \note Operation is applied atomically: the elements are linked to the queue with a single compare-and-swap and
+     *       are popped in the order of the range, without elements of other threads in between.
+     * \note Thread-safe. If internal memory pool is exhausted and the memory pool is not fixed-sized, a new node will be allocated
+     *                    from the OS. This may not be lock-free.
+     * \throws if memory allocator throws
+     */
+    template <typename ConstIterator>
+    ConstIterator push(ConstIterator begin, ConstIterator end)
+    {
+        return do_push<false, ConstIterator>(begin, end);
+    }
+
+    /** Pushes as many objects from the range [begin, end) as freelist node can be allocated.
+     *
+     * \return iterator to the first element, which has not been pushed
+     *
+     * \note Operation is applied atomically
+     * \note Thread-safe and non-blocking. If internal memory pool is exhausted, the push operation will fail
+     * \throws if memory allocator throws
+     */
+    template <typename ConstIterator>
+    ConstIterator bounded_push(ConstIterator begin, ConstIterator end)
+    {
+        return do_push<true, ConstIterator>(begin, end);
+    }
+
 public:
 
     /** Pushes object t to the queue.
@@ -352,6 +510,31 @@ public:
         }
     }
 
+    /** Pushes as many objects from the range [begin, end) as freelist node can be allocated.
+     *
+     * \return iterator to the first element, which has not been pushed
+     *
+     * \note Not thread-safe. If internal memory pool is exhausted and the memory pool is not fixed-sized, a new node will be allocated
+     *       from the OS. This may not be lock-free.
+     * \throws if memory allocator throws
+     */
+    template <typename ConstIterator>
+    ConstIterator unsynchronized_push(ConstIterator begin, ConstIterator end)
+    {
+        if (begin == end)
+            return end;
+
+        node * first_node;
+        node * last_node;
+        ConstIterator ret;
+
+        tie(first_node, last_node) = prepare_node_list<false, false>(begin, end, ret);
+        if (first_node)
+            link_nodes_unsafe(first_node, last_node);
+
+        return ret;
+    }
+
     /** Pops object from queue.
      *
      * \post if pop operation is successful, object will be copied to ret.
@@ -376,13 +559,15 @@ public:
     bool pop (U & ret)
     {
         using detail::likely;
+        guard_t guard(pool);
         for (;;) {
-            tagged_node_handle head = head_.load(memory_order_acquire);
+            tagged_node_handle head = guard.protect(0, head_, memory_order_acquire);
             node * head_ptr = pool.get_pointer(head);
 
             tagged_node_handle tail = tail_.load(memory_order_acquire);
             tagged_node_handle next = head_ptr->next.load(memory_order_acquire);
             node * next_ptr = pool.get_pointer(next);
+            guard.publish(1, next_ptr);
 
             tagged_node_handle head2 = head_.load(memory_order_acquire);
             if (likely(head == head2)) {
@@ -405,7 +590,7 @@ public:
 
                     tagged_node_handle new_head(pool.get_handle(next), head.get_next_tag());
                     if (head_.compare_exchange_weak(head, new_head)) {
-                        pool.template destruct<true>(head);
+                        guard.retire(head);
                         return true;
                     }
                 }
@@ -413,6 +598,78 @@ public:
         }
     }
 
+    /** Pops up to size objects from queue.
+     *
+     * \post the popped objects are copied to ret, in the order in which they have been pushed.
+     * \returns number of popped objects, 0 if the queue was empty.
+     *
+     * \note Thread-safe and non-blocking. The objects are detached from the queue with a single compare-and-swap on its
+     *       head, so a batch never holds more than the elements that had been linked before its tail.
+     * */
+    size_type pop(T * ret, size_type size)
+    {
+        using detail::likely;
+        if (size == 0)
+            return 0;
+
+        guard_t guard(pool);
+        for (;;) {
+            tagged_node_handle head = guard.protect(0, head_, memory_order_acquire);
+            node * head_ptr = pool.get_pointer(head);
+
+            tagged_node_handle tail = tail_.load(memory_order_acquire);
+            tagged_node_handle next = head_ptr->next.load(memory_order_acquire);
+            node * next_ptr = pool.get_pointer(next);
+            guard.publish(1, next_ptr);
+
+            tagged_node_handle head2 = head_.load(memory_order_acquire);
+            if (likely(head == head2)) {
+                if (pool.get_handle(head) == pool.get_handle(tail)) {
+                    if (next_ptr == 0)
+                        return 0;
+
+                    tagged_node_handle new_tail(pool.get_handle(next), tail.get_next_tag());
+                    tail_.compare_exchange_strong(tail, new_tail);
+
+                } else {
+                    /* copy the payloads up to the tail: the head must never pass the tail, because the tail node is
+                     * still referenced by pushing threads. if the head has moved in the meantime, the nodes may have
+                     * been reused and the copies are discarded when the compare-and-swap fails. */
+                    size_type count = 0;
+                    node * last_ptr = NULL;
+                    bool head_moved = false;
+                    while (next_ptr != 0) {
+                        detail::copy_payload(next_ptr->data, ret[count]);
+                        last_ptr = next_ptr;
+                        ++count;
+                        if (count == size || pool.get_handle(next_ptr) == pool.get_handle(tail))
+                            break;
+                        next_ptr = pool.get_pointer(next_ptr->next.load(memory_order_acquire));
+                        guard.publish(1, next_ptr);
+
+                        /* with a reclamation scheme, the nodes behind the head are only protected from deallocation
+                         * while the head has not moved */
+                        if (guard_t::validate_traversal && head_.load(memory_order_acquire) != head) {
+                            head_moved = true;
+                            break;
+                        }
+                    }
+                    if (count == 0 || head_moved)
+                        /* see pop(U &) */
+                        continue;
+
+                    tagged_node_handle new_head(pool.get_handle(last_ptr), head.get_next_tag());
+                    if (head_.compare_exchange_weak(head, new_head)) {
+                        /* the old head and all popped nodes but the last one, which is the new dummy node */
+                        next_node_fn next_node = { &pool };
+                        guard.retire_chain(head_ptr, count, next_node);
+                        return count;
+                    }
+                }
+            }
+        }
+    }
+
     /** Pops object from queue.
      *
      * \post if pop operation is successful, object will be copied to ret.
@@ -501,7 +758,7 @@ public:
 
     /** consumes all elements via a functor
      *
-     * sequentially pops all elements from the queue and applies the functor on each object
+     * pops all elements from the queue in batches and applies the functor on each object, in order
      *
      * \returns number of elements that are consumed
      *
@@ -510,25 +767,38 @@ public:
     template <typename Functor>
     size_t consume_all(Functor & f)
     {
-        size_t element_count = 0;
-        while (consume_one(f))
-            element_count += 1;
-
-        return element_count;
+        return do_consume_all<Functor>(f);
     }
 
     /// \copydoc boost::lockfree::queue::consume_all(Functor & rhs)
     template <typename Functor>
     size_t consume_all(Functor const & f)
     {
+        return do_consume_all<Functor const>(f);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    /* consume_all pops the elements in batches of up to 512 bytes */
+    static const size_type consume_batch_size = sizeof(T) >= 512 ? 1 : (512 / sizeof(T) < 32 ? 512 / sizeof(T) : 32);
+
+    template <typename Functor>
+    size_t do_consume_all(Functor & f)
+    {
+        T elements[consume_batch_size];
         size_t element_count = 0;
-        while (consume_one(f))
-            element_count += 1;
+        for (;;) {
+            size_type count = pop(elements, consume_batch_size);
+            for (size_type i = 0; i != count; ++i)
+                f(elements[i]);
 
-        return element_count;
+            element_count += count;
+            if (count == 0)
+                return element_count;
+        }
     }
+#endif
 
-private:
 #ifndef BOOST_DOXYGEN_INVOKED
     atomic<tagged_node_handle> head_;
     static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(tagged_node_handle);
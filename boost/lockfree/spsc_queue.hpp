@@ -37,6 +37,64 @@ typedef parameter::parameters<boost::parameter::optional<tag::capacity>,
                               boost::parameter::optional<tag::allocator>
                              > ringbuffer_signature;
 
+/* a contiguous part of the ringbuffer */
+template <typename T>
+struct ringbuffer_span
+{
+    T * first;
+    std::size_t count;
+
+    ringbuffer_span(void):
+        first(0), count(0)
+    {}
+
+    ringbuffer_span(T * first, std::size_t count):
+        first(first), count(count)
+    {}
+
+    T * begin(void) const
+    {
+        return first;
+    }
+
+    T * end(void) const
+    {
+        return first + count;
+    }
+
+    std::size_t size(void) const
+    {
+        return count;
+    }
+
+    bool empty(void) const
+    {
+        return count == 0;
+    }
+};
+
+/* the part of the ringbuffer up to its end and the part, which wraps around to its start */
+template <typename T>
+struct ringbuffer_span_pair
+{
+    ringbuffer_span<T> first;
+    ringbuffer_span<T> second;
+
+    ringbuffer_span_pair(ringbuffer_span<T> const & first, ringbuffer_span<T> const & second):
+        first(first), second(second)
+    {}
+
+    std::size_t size(void) const
+    {
+        return first.size() + second.size();
+    }
+
+    bool empty(void) const
+    {
+        return first.empty();
+    }
+};
+
 template <typename T>
 class ringbuffer_base
 {
@@ -230,6 +288,57 @@ protected:
         read_index_.store(new_read_index, memory_order_release);
         return avail;
     }
+
+    ringbuffer_span_pair<T> acquire_write(size_t count, T * internal_buffer, size_t max_size)
+    {
+        const size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
+        const size_t read_index  = read_index_.load(memory_order_acquire);
+        const size_t avail = (std::min)(count, write_available(write_index, read_index, max_size));
+
+        return make_span_pair(internal_buffer, write_index, avail, max_size);
+    }
+
+    void commit_write(size_t count, size_t max_size)
+    {
+        const size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
+        BOOST_ASSERT(count <= write_available(write_index, read_index_.load(memory_order_relaxed), max_size));
+
+        size_t new_write_index = write_index + count;
+        if (new_write_index >= max_size)
+            new_write_index -= max_size;
+
+        write_index_.store(new_write_index, memory_order_release);
+    }
+
+    ringbuffer_span_pair<T> acquire_read(T * internal_buffer, size_t max_size)
+    {
+        const size_t write_index = write_index_.load(memory_order_acquire);
+        const size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
+        const size_t avail = read_available(write_index, read_index, max_size);
+
+        return make_span_pair(internal_buffer, read_index, avail, max_size);
+    }
+
+    void release_read(size_t count, T * internal_buffer, size_t max_size)
+    {
+        const size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
+        BOOST_ASSERT(count <= read_available(write_index_.load(memory_order_relaxed), read_index, max_size));
+
+        size_t new_read_index = read_index + count;
+
+        if (!boost::has_trivial_destructor<T>::value) {
+            if (new_read_index > max_size) {
+                destroy(internal_buffer + read_index, internal_buffer + max_size);
+                destroy(internal_buffer, internal_buffer + new_read_index - max_size);
+            } else
+                destroy(internal_buffer + read_index, internal_buffer + new_read_index);
+        }
+
+        if (new_read_index >= max_size)
+            new_read_index -= max_size;
+
+        read_index_.store(new_read_index, memory_order_release);
+    }
 #endif
 
 
@@ -277,6 +386,19 @@ private:
         return write_index == read_index;
     }
 
+    static ringbuffer_span_pair<T> make_span_pair(T * internal_buffer, size_t index, size_t count, size_t max_size)
+    {
+        const size_t count0 = (std::min)(count, max_size - index);
+        return ringbuffer_span_pair<T>(ringbuffer_span<T>(internal_buffer + index, count0),
+                                       ringbuffer_span<T>(internal_buffer, count - count0));
+    }
+
+    static void destroy(T * first, T * last)
+    {
+        for (; first != last; ++first)
+            first->~T();
+    }
+
     template< class OutputIterator >
     OutputIterator copy_and_delete( T * first, T * last, OutputIterator out )
     {
@@ -360,6 +482,26 @@ public:
     {
         return ringbuffer_base<T>::pop(it, data(), max_size);
     }
+
+    ringbuffer_span_pair<T> acquire_write(size_type count)
+    {
+        return ringbuffer_base<T>::acquire_write(count, data(), max_size);
+    }
+
+    void commit_write(size_type count)
+    {
+        ringbuffer_base<T>::commit_write(count, max_size);
+    }
+
+    ringbuffer_span_pair<T> acquire_read(void)
+    {
+        return ringbuffer_base<T>::acquire_read(data(), max_size);
+    }
+
+    void release_read(size_type count)
+    {
+        ringbuffer_base<T>::release_read(count, data(), max_size);
+    }
 };
 
 template <typename T, typename Alloc>
@@ -450,6 +592,26 @@ public:
     {
         return ringbuffer_base<T>::pop(it, array_, max_elements_);
     }
+
+    ringbuffer_span_pair<T> acquire_write(size_type count)
+    {
+        return ringbuffer_base<T>::acquire_write(count, &*array_, max_elements_);
+    }
+
+    void commit_write(size_type count)
+    {
+        ringbuffer_base<T>::commit_write(count, max_elements_);
+    }
+
+    ringbuffer_span_pair<T> acquire_read(void)
+    {
+        return ringbuffer_base<T>::acquire_read(&*array_, max_elements_);
+    }
+
+    void release_read(size_type count)
+    {
+        ringbuffer_base<T>::release_read(count, &*array_, max_elements_);
+    }
 };
 
 template <typename T, typename A0, typename A1>
@@ -516,6 +678,8 @@ private:
     {
         typedef allocator_arg allocator;
         typedef std::size_t size_type;
+        typedef detail::ringbuffer_span<T> span;
+        typedef detail::ringbuffer_span_pair<T> span_pair;
     };
 #endif
 
@@ -523,6 +687,11 @@ public:
     typedef T value_type;
     typedef typename implementation_defined::allocator allocator;
     typedef typename implementation_defined::size_type size_type;
+    /** A contiguous part of the ringbuffer, with \c begin(), \c end() and \c size() */
+    typedef typename implementation_defined::span span;
+    /** The contiguous parts \c first and \c second of a range of the ringbuffer: \c second is only non-empty, when the
+     *  range wraps around the end of the ringbuffer */
+    typedef typename implementation_defined::span_pair span_pair;
 
     /** Constructs a spsc_queue
      *
@@ -676,6 +845,58 @@ public:
         return base_type::pop(it);
     }
 
+    /** Gives access to the free space of the ringbuffer, so that elements can be written without a copy.
+     *
+     * \pre only one thread is allowed to push data to the spsc_queue
+     * \return the spans of at most count slots, which can be written. The slots are uninitialized: objects must be
+     *         constructed in them, unless T has a trivial default constructor and destructor.
+     * \post the slots will be visible to the consumer after commit_write
+     *
+     * \note Thread-safe and wait-free
+     */
+    span_pair acquire_write(size_type count)
+    {
+        return base_type::acquire_write(count);
+    }
+
+    /** Publishes the first count slots returned by acquire_write to the consumer.
+     *
+     * \pre only one thread is allowed to push data to the spsc_queue
+     * \pre count is at most the size of the spans returned by the last call to acquire_write, and the objects have
+     *      been constructed in these slots
+     *
+     * \note Thread-safe and wait-free
+     */
+    void commit_write(size_type count)
+    {
+        base_type::commit_write(count);
+    }
+
+    /** Gives access to the elements, which can be read, without a copy.
+     *
+     * \pre only one thread is allowed to pop data to the spsc_queue
+     * \return the spans of all elements, which are available for read
+     * \post the elements stay in the spsc_queue until they are released with release_read
+     *
+     * \note Thread-safe and wait-free
+     */
+    span_pair acquire_read(void)
+    {
+        return base_type::acquire_read();
+    }
+
+    /** Destroys the first count elements returned by acquire_read and gives their slots back to the producer.
+     *
+     * \pre only one thread is allowed to pop data to the spsc_queue
+     * \pre count is at most the size of the spans returned by the last call to acquire_read
+     *
+     * \note Thread-safe and wait-free
+     */
+    void release_read(size_type count)
+    {
+        base_type::release_read(count);
+    }
+
     /** consumes one element via a functor
      *
      *  pops one element from the queue and applies the functor on this object
@@ -19,6 +19,7 @@
 #include <boost/lockfree/detail/copy_payload.hpp>
 #include <boost/lockfree/detail/freelist.hpp>
 #include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/reclamation.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 
 #ifdef BOOST_HAS_PRAGMA_ONCE
@@ -55,6 +56,12 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
  *  - \c boost::lockfree::allocator<>, defaults to \c boost::lockfree::allocator<std::allocator<void>> <br>
  *    Specifies the allocator that is used for the internal freelist
  *
+ *  - \c boost::lockfree::reclamation<>, defaults to \c boost::lockfree::reclamation<boost::lockfree::freelist_reclamation> <br>
+ *    With \c hazard_pointer_reclamation or \c epoch_based_reclamation, freed nodes are returned to the allocator once no
+ *    thread can access them, so the memory of the stack shrinks after a burst, and the stack does not need tagged pointers,
+ *    which require double-width compare-and-exchange instructions on some platforms. Pushing and popping may then allocate
+ *    and deallocate memory, and the stack cannot be fixed-sized.
+ *
  *  \b Requirements:
  *  - T must have a copy constructor
  * */
@@ -80,6 +87,7 @@ private:
     static const bool fixed_sized = detail::extract_fixed_sized<bound_args>::value;
     static const bool node_based = !(has_capacity || fixed_sized);
     static const bool compile_time_sized = has_capacity;
+    typedef typename detail::extract_reclamation<bound_args>::type reclamation_scheme;
 
     struct node
     {
@@ -93,7 +101,9 @@ private:
     };
 
     typedef typename detail::extract_allocator<bound_args, node>::type node_allocator;
-    typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity>::type pool_t;
+    typedef detail::select_reclamation<node, node_allocator, reclamation_scheme, compile_time_sized, fixed_sized, capacity> reclamation_t;
+    typedef typename reclamation_t::type pool_t;
+    typedef typename reclamation_t::guard guard_t;
     typedef typename pool_t::tagged_node_handle tagged_node_handle;
 
     // check compile-time capacity
@@ -488,7 +498,8 @@ public:
     template <typename Functor>
     bool consume_one(Functor & f)
     {
-        tagged_node_handle old_tos = tos.load(detail::memory_order_consume);
+        guard_t guard(pool);
+        tagged_node_handle old_tos = guard.protect(0, tos, detail::memory_order_consume);
 
         for (;;) {
             node * old_tos_pointer = pool.get_pointer(old_tos);
@@ -499,9 +510,10 @@ public:
 
             if (tos.compare_exchange_weak(old_tos, new_tos)) {
                 f(old_tos_pointer->v);
-                pool.template destruct<true>(old_tos);
+                guard.retire(old_tos);
                 return true;
             }
+            old_tos = guard.protect(0, tos, old_tos);
         }
     }
 
@@ -509,7 +521,8 @@ public:
     template <typename Functor>
     bool consume_one(Functor const & f)
     {
-        tagged_node_handle old_tos = tos.load(detail::memory_order_consume);
+        guard_t guard(pool);
+        tagged_node_handle old_tos = guard.protect(0, tos, detail::memory_order_consume);
 
         for (;;) {
             node * old_tos_pointer = pool.get_pointer(old_tos);
@@ -520,9 +533,10 @@ public:
 
             if (tos.compare_exchange_weak(old_tos, new_tos)) {
                 f(old_tos_pointer->v);
-                pool.template destruct<true>(old_tos);
+                guard.retire(old_tos);
                 return true;
             }
+            old_tos = guard.protect(0, tos, old_tos);
         }
     }
 
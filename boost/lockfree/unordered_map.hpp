@@ -0,0 +1,601 @@
+//  lock-free hash table from
+//  Shalev, O. and Shavit, N.,
+//  "Split-ordered lists: lock-free extensible hash tables"
+//  with the lock-free list of
+//  Michael, M. M.,
+//  "High performance dynamic lock-free hash tables and list-based sets"
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_UNORDERED_MAP_HPP_INCLUDED
+#define BOOST_LOCKFREE_UNORDERED_MAP_HPP_INCLUDED
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+
+#include <boost/aligned_storage.hpp>
+#include <boost/assert.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_assign.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/tagged_ptr.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+typedef parameter::parameters<boost::parameter::optional<tag::allocator>
+                             > unordered_map_signature;
+
+inline std::size_t reverse_bits(std::size_t value)
+{
+    std::size_t ret = 0;
+    for (std::size_t i = 0; i != sizeof(std::size_t); ++i, value >>= 8) {
+        std::size_t byte = value & 0xff;
+        byte = (((byte * 0x0802u) & 0x22110u) | ((byte * 0x8020u) & 0x88440u)) * 0x10101u >> 16;
+        ret = (ret << 8) | (byte & 0xff);
+    }
+    return ret;
+}
+
+/* index of the most significant bit, value must not be 0 */
+inline std::size_t log2_floor(std::size_t value)
+{
+    std::size_t ret = 0;
+    for (std::size_t shift = sizeof(std::size_t) * 4; shift != 0; shift /= 2) {
+        if (value >> shift) {
+            value >>= shift;
+            ret += shift;
+        }
+    }
+    return ret;
+}
+
+} /* namespace detail */
+
+/** The unordered_map class provides a hash table, lookups, insertions and erasures are lock-free,
+ *  construction/destruction has to be synchronized. It uses a freelist for memory management,
+ *  erased elements are pushed to the freelist and not returned to the OS before the unordered_map is destroyed.
+ *
+ *  The elements are kept in a single lock-free linked list, sorted by the bit-reversed hash values ("split order"). The
+ *  buckets are pointers to dummy nodes in this list, so doubling the number of buckets does not move any element: a
+ *  new bucket is initialized by the first operation that uses it, by inserting its dummy node behind the dummy node of
+ *  its parent bucket. The bucket array is allocated in segments of growing size, which are never moved.
+ *
+ *  The elements cannot be modified in place and there are no iterators: find copies the mapped value, which is only
+ *  returned if the element has not been erased while it was copied.
+ *
+ *  \b Policies:
+ *  - \ref boost::lockfree::allocator, defaults to \c boost::lockfree::allocator<std::allocator<void>> \n
+ *    Specifies the allocator that is used for the internal freelist and for the bucket array
+ *
+ *  \b Requirements:
+ *   - Key and T must have a copy constructor
+ *   - Key and T must have a trivial assignment operator
+ *   - Key and T must have a trivial destructor
+ *   - Hash and Pred must not throw. As erased nodes are reused, they may be called with keys that are being
+ *     overwritten, whose results are discarded
+ *
+ * */
+#ifndef BOOST_DOXYGEN_INVOKED
+template <typename Key,
+          typename T,
+          typename Hash = boost::hash<Key>,
+          typename Pred = std::equal_to<Key>,
+          class A0 = boost::parameter::void_>
+#else
+template <typename Key, typename T, typename Hash, typename Pred, ...Options>
+#endif
+class unordered_map
+{
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+
+#ifdef BOOST_HAS_TRIVIAL_DESTRUCTOR
+    BOOST_STATIC_ASSERT((boost::has_trivial_destructor<Key>::value));
+    BOOST_STATIC_ASSERT((boost::has_trivial_destructor<T>::value));
+#endif
+
+#ifdef BOOST_HAS_TRIVIAL_ASSIGN
+    BOOST_STATIC_ASSERT((boost::has_trivial_assign<Key>::value));
+    BOOST_STATIC_ASSERT((boost::has_trivial_assign<T>::value));
+#endif
+
+    typedef typename detail::unordered_map_signature::bind<A0>::type bound_args;
+
+    struct node;
+    typedef detail::tagged_ptr<node> tagged_node_ptr;
+    typedef typename tagged_node_ptr::tag_t tag_t;
+
+    /* the lowest bit of the tag of a next pointer marks its node as erased. every change of a next pointer increments
+     * the rest of the tag, so a compare-and-exchange fails if the node has been erased and reused in between */
+    static bool is_marked(tagged_node_ptr p)
+    {
+        return p.get_tag() & 1;
+    }
+
+    static tag_t next_tag(tagged_node_ptr p, bool marked)
+    {
+        return tag_t(((p.get_tag() | 1) + 1) | (marked ? 1 : 0));
+    }
+
+    struct element
+    {
+        element(Key const & k, T const & v):
+            key(k), value(v)
+        {}
+
+        Key key;
+        T value;
+    };
+
+    struct node
+    {
+        explicit node(std::size_t key):
+            split_order_key(key)
+        {
+            /* increment tag to avoid ABA problem, this also clears the mark of the erased node */
+            tagged_node_ptr old_next = next.load(memory_order_relaxed);
+            tagged_node_ptr new_next (NULL, next_tag(old_next, false));
+            next.store(new_next, memory_order_release);
+        }
+
+        element & data(void)
+        {
+            return *static_cast<element*>(static_cast<void*>(&storage));
+        }
+
+        atomic<tagged_node_ptr> next;
+        std::size_t split_order_key;
+        typename boost::aligned_storage<sizeof(element), boost::alignment_of<element>::value>::type storage;
+    };
+
+    typedef atomic<node*> bucket;
+
+    typedef typename detail::extract_allocator<bound_args, node>::type node_allocator;
+    typedef typename node_allocator::template rebind<bucket>::other bucket_allocator;
+    typedef detail::freelist_stack<node, node_allocator> pool_t;
+
+    /* the first segment holds one bucket, segment s holds buckets 2**s - 1 to 2**(s+1) - 2 */
+    static const std::size_t segment_count = sizeof(std::size_t) * 8;
+    static const std::size_t max_bucket_count = std::size_t(1) << (segment_count - 2);
+
+    /* the average number of elements per bucket, before the number of buckets is doubled */
+    static const std::size_t max_load_factor = 2;
+
+    static std::size_t regular_key(std::size_t hash)
+    {
+        return detail::reverse_bits(hash | (std::size_t(1) << (segment_count - 1)));
+    }
+
+    static std::size_t dummy_key(std::size_t bucket_index)
+    {
+        return detail::reverse_bits(bucket_index);
+    }
+
+    static bool is_dummy_key(std::size_t key)
+    {
+        return (key & 1) == 0;
+    }
+
+    struct implementation_defined
+    {
+        typedef node_allocator allocator;
+        typedef std::size_t size_type;
+    };
+
+#endif
+
+    BOOST_DELETED_FUNCTION(unordered_map(unordered_map const&))
+    BOOST_DELETED_FUNCTION(unordered_map& operator= (unordered_map const&))
+
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef Hash hasher;
+    typedef Pred key_equal;
+    typedef typename implementation_defined::allocator allocator;
+    typedef typename implementation_defined::size_type size_type;
+
+    /**
+     * \return true, if implementation is lock-free.
+     *
+     * \warning It only checks, if the bucket array, the counters and the freelist can be modified in a lock-free manner.
+     *       Initializing a segment of the bucket array and allocating nodes from the OS are not lock-free.
+     * */
+    bool is_lock_free (void) const
+    {
+        return segments_[0].is_lock_free() && bucket_count_.is_lock_free() && pool.is_lock_free();
+    }
+
+    //! Construct unordered_map
+    unordered_map(void):
+        pool(node_allocator(), 0)
+    {
+        initialize(0);
+    }
+
+    //! Construct unordered_map, allocate n nodes for the freelist and enough buckets for n elements.
+    explicit unordered_map(size_type n, hasher const & hf = hasher(), key_equal const & eql = key_equal()):
+        hash_function_(hf), key_eq_(eql), pool(node_allocator(), n)
+    {
+        initialize(n);
+    }
+
+    //! Construct unordered_map, allocate n nodes for the freelist and enough buckets for n elements.
+    unordered_map(size_type n, hasher const & hf, key_equal const & eql, allocator const & alloc):
+        hash_function_(hf), key_eq_(eql), pool(alloc, n), bucket_allocator_(alloc)
+    {
+        initialize(n);
+    }
+
+    /** Allocate n nodes for the freelist
+     *
+     * \note thread-safe, may block if memory allocator blocks
+     * */
+    void reserve(size_type n)
+    {
+        pool.template reserve<true>(n);
+    }
+
+    /** Destroys unordered_map, free all nodes and the bucket array.
+     *
+     * \note not thread-safe
+     * */
+    ~unordered_map(void)
+    {
+        node * n = segments_[0].load(memory_order_relaxed)[0].load(memory_order_relaxed);
+        while (n) {
+            node * next = n->next.load(memory_order_relaxed).get_ptr();
+            pool.template destruct<false>(n);
+            n = next;
+        }
+
+        for (std::size_t s = 0; s != segment_count; ++s) {
+            bucket * segment = segments_[s].load(memory_order_relaxed);
+            if (segment)
+                deallocate_segment(segment, s);
+        }
+    }
+
+    /** Check if the unordered_map is empty
+     *
+     * \return true, if the unordered_map is empty, false otherwise
+     * \note The result is only accurate, if no other thread modifies the unordered_map. Therefore it is rarely practical to use this
+     *       value in program logic.
+     * */
+    bool empty(void) const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * \return the number of elements
+     * \note The result is only accurate, if no other thread modifies the unordered_map.
+     * */
+    size_type size(void) const
+    {
+        return element_count_.load(memory_order_relaxed);
+    }
+
+    /**
+     * \return the number of buckets. It is doubled, when the number of elements exceeds twice the number of buckets.
+     * */
+    size_type bucket_count(void) const
+    {
+        return bucket_count_.load(memory_order_relaxed);
+    }
+
+    hasher hash_function(void) const
+    {
+        return hash_function_;
+    }
+
+    key_equal key_eq(void) const
+    {
+        return key_eq_;
+    }
+
+    /** Inserts the element (key, value), unless the unordered_map contains an element with an equivalent key.
+     *
+     * \post the unordered_map contains an element with the key
+     * \return true, if the element has been inserted
+     *
+     * \note Thread-safe. If internal memory pool is exhausted and the memory pool is not fixed-sized, a new node will be allocated
+     *                    from the OS. This may not be lock-free.
+     * */
+    bool insert(key_type const & key, mapped_type const & value)
+    {
+        std::size_t hash = hash_function_(key);
+        std::size_t key_order = regular_key(hash);
+
+        node * n = pool.template construct<true, false>(key_order);
+        new(&n->storage) element(key, value);
+
+        node * head = get_bucket(hash);
+
+        for (;;) {
+            atomic<tagged_node_ptr> * prev;
+            tagged_node_ptr cur, next;
+            if (find_position(head, key_order, &key, prev, cur, next)) {
+                pool.template destruct<true>(n);
+                return false;
+            }
+
+            tagged_node_ptr n_next = n->next.load(memory_order_relaxed);
+            n->next.store(tagged_node_ptr(cur.get_ptr(), n_next.get_tag()), memory_order_relaxed);
+
+            tagged_node_ptr new_cur(n, next_tag(cur, false));
+            if (prev->compare_exchange_weak(cur, new_cur))
+                break;
+        }
+
+        std::size_t count = element_count_.fetch_add(1, memory_order_relaxed) + 1;
+        std::size_t buckets = bucket_count_.load(memory_order_relaxed);
+        if (count > buckets * max_load_factor && buckets < max_bucket_count)
+            bucket_count_.compare_exchange_strong(buckets, buckets * 2, memory_order_relaxed);
+        return true;
+    }
+
+    /** Erases the element with the key
+     *
+     * \return true, if an element has been erased
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool erase(key_type const & key)
+    {
+        std::size_t hash = hash_function_(key);
+        std::size_t key_order = regular_key(hash);
+        node * head = get_bucket(hash);
+
+        for (;;) {
+            atomic<tagged_node_ptr> * prev;
+            tagged_node_ptr cur, next;
+            if (!find_position(head, key_order, &key, prev, cur, next))
+                return false;
+
+            node * cur_node = cur.get_ptr();
+            tagged_node_ptr marked_next(next.get_ptr(), next_tag(next, true));
+            if (!cur_node->next.compare_exchange_strong(next, marked_next))
+                continue;
+
+            /* the element is erased, once it is marked. if the node can't be unlinked, find_position unlinks it */
+            tagged_node_ptr new_cur(next.get_ptr(), next_tag(cur, false));
+            if (prev->compare_exchange_strong(cur, new_cur))
+                pool.template destruct<true>(cur_node);
+            else
+                find_position(head, key_order, &key, prev, cur, next);
+
+            element_count_.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+    }
+
+    /** Looks up the element with the key and copies its mapped value to ret
+     *
+     * \return true, if the unordered_map contains an element with the key. Otherwise ret is not modified.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool find(key_type const & key, mapped_type & ret) const
+    {
+        std::size_t hash = hash_function_(key);
+        std::size_t key_order = regular_key(hash);
+        node * head = get_bucket(hash);
+
+        for (;;) {
+            atomic<tagged_node_ptr> * prev;
+            tagged_node_ptr cur, next;
+            if (!find_position(head, key_order, &key, prev, cur, next))
+                return false;
+
+            node * cur_node = cur.get_ptr();
+            typename boost::aligned_storage<sizeof(T), boost::alignment_of<T>::value>::type value;
+            new(&value) T(cur_node->data().value);
+
+            /* the element has neither been erased nor been reused while it was copied, if its next pointer is unchanged */
+            atomic_thread_fence(memory_order_acquire);
+            if (cur_node->next.load(memory_order_relaxed) == next) {
+                ret = *static_cast<T*>(static_cast<void*>(&value));
+                return true;
+            }
+        }
+    }
+
+    /**
+     * \return true, if the unordered_map contains an element with the key
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool contains(key_type const & key) const
+    {
+        std::size_t hash = hash_function_(key);
+        atomic<tagged_node_ptr> * prev;
+        tagged_node_ptr cur, next;
+        return find_position(get_bucket(hash), regular_key(hash), &key, prev, cur, next);
+    }
+
+    /**
+     * \return 1, if the unordered_map contains an element with the key, 0 otherwise
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    size_type count(key_type const & key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    void initialize(size_type n)
+    {
+        std::size_t buckets = 1;
+        while (buckets * max_load_factor < n && buckets < max_bucket_count)
+            buckets *= 2;
+
+        for (std::size_t s = 0; s != segment_count; ++s)
+            segments_[s].store(NULL, memory_order_relaxed);
+        element_count_.store(0, memory_order_relaxed);
+        bucket_count_.store(buckets, memory_order_relaxed);
+
+        node * head = pool.template construct<true, false>(dummy_key(0));
+        bucket_slot(0).store(head, memory_order_release);
+    }
+
+    static std::size_t segment_size(std::size_t segment)
+    {
+        return std::size_t(1) << segment;
+    }
+
+    void deallocate_segment(bucket * segment, std::size_t s) const
+    {
+        for (std::size_t i = 0; i != segment_size(s); ++i)
+            segment[i].~bucket();
+        bucket_allocator_.deallocate(segment, segment_size(s));
+    }
+
+    bucket & bucket_slot(std::size_t bucket_index) const
+    {
+        std::size_t s = detail::log2_floor(bucket_index + 1);
+        std::size_t index = bucket_index + 1 - segment_size(s);
+
+        bucket * segment = segments_[s].load(memory_order_acquire);
+        if (detail::unlikely(segment == NULL)) {
+            bucket * new_segment = bucket_allocator_.allocate(segment_size(s));
+            for (std::size_t i = 0; i != segment_size(s); ++i)
+                new(new_segment + i) bucket(NULL);
+
+            if (segments_[s].compare_exchange_strong(segment, new_segment, memory_order_acq_rel, memory_order_acquire))
+                segment = new_segment;
+            else
+                deallocate_segment(new_segment, s);
+        }
+        return segment[index];
+    }
+
+    /* the dummy node of the bucket of hash, initializes the bucket if necessary */
+    node * get_bucket(std::size_t hash) const
+    {
+        std::size_t bucket_index = hash & (bucket_count_.load(memory_order_relaxed) - 1);
+        return get_bucket_by_index(bucket_index);
+    }
+
+    node * get_bucket_by_index(std::size_t bucket_index) const
+    {
+        bucket & slot = bucket_slot(bucket_index);
+        node * head = slot.load(memory_order_acquire);
+        if (detail::likely(head != NULL))
+            return head;
+        return initialize_bucket(bucket_index, slot);
+    }
+
+    /* the buckets are split by doubling the number of buckets, so the parent bucket of a bucket is the bucket that
+     * is obtained by clearing its most significant bit. its dummy node is inserted behind the dummy node of the parent */
+    node * initialize_bucket(std::size_t bucket_index, bucket & slot) const
+    {
+        std::size_t parent_index = bucket_index & ~(std::size_t(1) << detail::log2_floor(bucket_index));
+        node * parent = get_bucket_by_index(parent_index);
+
+        std::size_t key_order = dummy_key(bucket_index);
+        node * dummy = pool.template construct<true, false>(key_order);
+
+        for (;;) {
+            atomic<tagged_node_ptr> * prev;
+            tagged_node_ptr cur, next;
+            if (find_position(parent, key_order, NULL, prev, cur, next)) {
+                /* another thread has initialized the bucket */
+                pool.template destruct<true>(dummy);
+                dummy = cur.get_ptr();
+                break;
+            }
+
+            tagged_node_ptr dummy_next = dummy->next.load(memory_order_relaxed);
+            dummy->next.store(tagged_node_ptr(cur.get_ptr(), dummy_next.get_tag()), memory_order_relaxed);
+
+            tagged_node_ptr new_cur(dummy, next_tag(cur, false));
+            if (prev->compare_exchange_weak(cur, new_cur))
+                break;
+        }
+
+        slot.store(dummy, memory_order_release);
+        return dummy;
+    }
+
+    /* searches the list from head for the node with key_order and key (or the dummy node with key_order, if key is
+     * NULL). on return, *prev holds cur and cur is either the node that has been found or the first node with a greater
+     * key_order. marked nodes are unlinked on the way. */
+    bool find_position(node * head, std::size_t key_order, key_type const * key,
+                       atomic<tagged_node_ptr> *& prev, tagged_node_ptr & cur, tagged_node_ptr & next) const
+    {
+    try_again:
+        prev = &head->next;
+        cur = prev->load(memory_order_acquire);
+
+        for (;;) {
+            node * cur_node = cur.get_ptr();
+            if (cur_node == NULL)
+                return false;
+
+            next = cur_node->next.load(memory_order_acquire);
+            std::size_t cur_order = cur_node->split_order_key;
+            bool found = (cur_order == key_order) &&
+                         (key == NULL || (!is_dummy_key(cur_order) && key_eq_(cur_node->data().key, *key)));
+
+            /* the node may have been erased and reused while it was read, its data is only valid if it is still
+             * linked */
+            atomic_thread_fence(memory_order_acquire);
+            if (prev->load(memory_order_relaxed) != cur)
+                goto try_again;
+
+            if (!is_marked(next)) {
+                if (found)
+                    return true;
+                if (cur_order > key_order)
+                    return false;
+
+                prev = &cur_node->next;
+                cur = next;
+            } else {
+                tagged_node_ptr new_cur(next.get_ptr(), next_tag(cur, false));
+                if (!prev->compare_exchange_strong(cur, new_cur))
+                    goto try_again;
+
+                pool.template destruct<true>(cur_node);
+                cur = new_cur;
+            }
+        }
+    }
+
+    hasher hash_function_;
+    key_equal key_eq_;
+
+    mutable pool_t pool;
+    mutable bucket_allocator bucket_allocator_;
+    mutable atomic<bucket*> segments_[segment_count];
+    atomic<std::size_t> element_count_;
+    atomic<std::size_t> bucket_count_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_UNORDERED_MAP_HPP_INCLUDED */
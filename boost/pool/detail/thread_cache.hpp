@@ -0,0 +1,341 @@
+// Copyright (C) 2013 John Maddock
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org for updates, documentation, and revision history.
+
+#ifndef BOOST_POOL_THREAD_CACHE_HPP
+#define BOOST_POOL_THREAD_CACHE_HPP
+
+/*!
+  \file
+  \brief Per-thread caches of free chunks in front of a singleton_pool.
+  \details detail/thread_cache.hpp provides a type thread_cache<Mutex>
+  that lets each thread keep a small list of free chunks, so that
+  singleton_pool's malloc() and free() of single chunks usually take
+  no lock at all. Threads exchange chunks in batches through a
+  lock-free list, and only go to the mutex-protected pool when that
+  list is empty.
+
+  The cache is used when threading is enabled and POSIX threads are
+  available, unless BOOST_POOL_NO_THREAD_CACHE is defined.
+  BOOST_POOL_THREAD_CACHE_SIZE sets the number of chunks moved in
+  each batch (default 32); a thread caches at most twice that number.
+*/
+
+#include <boost/config.hpp>
+#include <boost/pool/detail/mutex.hpp>
+#include <boost/pool/detail/guard.hpp>
+
+#if defined(BOOST_HAS_THREADS) && !defined(BOOST_NO_MT) && !defined(BOOST_POOL_NO_MT) \
+    && defined(BOOST_HAS_PTHREADS) && !defined(BOOST_POOL_VALGRIND) \
+    && !defined(BOOST_POOL_NO_THREAD_CACHE)
+#  define BOOST_POOL_HAS_THREAD_CACHE
+#endif
+
+#ifdef BOOST_POOL_HAS_THREAD_CACHE
+
+#include <boost/atomic.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <new>
+
+#include <pthread.h>
+
+#ifndef BOOST_POOL_THREAD_CACHE_SIZE
+#  define BOOST_POOL_THREAD_CACHE_SIZE 32
+#endif
+
+namespace boost {
+
+namespace details {
+namespace pool {
+
+inline void * & cached_nextof(void * const ptr)
+{ //! Free chunks are linked through their first word, as in simple_segregated_storage.
+  return *(static_cast<void **>(ptr));
+}
+
+inline void * merge_chunks(void * a, void * b)
+{ //! Merges two lists of chunks sorted by address.
+  void * ret = 0;
+  void * * tail = &ret;
+  while (a != 0 && b != 0)
+  {
+    void * & smaller = std::less<void *>()(a, b) ? a : b;
+    *tail = smaller;
+    tail = &cached_nextof(smaller);
+    smaller = cached_nextof(smaller);
+  }
+  *tail = (a != 0) ? a : b;
+  return ret;
+}
+
+inline void * sort_chunks(void * list)
+{ //! Sorts a list of chunks by address, without allocating.
+  //! bins[i] is either 0 or a sorted list of 2^i chunks.
+  void * bins[sizeof(std::size_t) * 8] = { 0 };
+  std::size_t fill = 0;
+  while (list != 0)
+  {
+    void * carry = list;
+    list = cached_nextof(list);
+    cached_nextof(carry) = 0;
+
+    std::size_t i = 0;
+    for (; i != fill && bins[i] != 0; ++i)
+    {
+      carry = merge_chunks(bins[i], carry);
+      bins[i] = 0;
+    }
+    bins[i] = carry;
+    if (i == fill)
+      ++fill;
+  }
+
+  void * ret = 0;
+  for (std::size_t i = 0; i != fill; ++i)
+    ret = merge_chunks(bins[i], ret);
+  return ret;
+}
+
+class shared_chunk_list
+{ //! A lock-free list of free chunks, shared by the thread caches of one pool.
+  //! Chunks are pushed in batches and taken all at once, so no thread ever
+  //! reads a chunk that another thread may own, and there is no ABA problem.
+  private:
+    boost::atomic<void *> head;
+
+    shared_chunk_list(const shared_chunk_list &);
+    void operator=(const shared_chunk_list &);
+
+  public:
+    shared_chunk_list()
+    :head(0)
+    {
+    }
+
+    void push(void * const first, void * const last)
+    { //! Pushes the chunks first...last, which must be linked together.
+      void * old = head.load(boost::memory_order_relaxed);
+      do
+        cached_nextof(last) = old;
+      while (!head.compare_exchange_weak(old, first,
+          boost::memory_order_release, boost::memory_order_relaxed));
+    }
+
+    void give_back(void * const first)
+    { //! Pushes a list of chunks of unknown length.
+      void * expected = 0;
+      if (head.compare_exchange_strong(expected, first,
+          boost::memory_order_release, boost::memory_order_relaxed))
+        return;
+
+      void * last = first;
+      while (cached_nextof(last) != 0)
+        last = cached_nextof(last);
+      push(first, last);
+    }
+
+    void * take()
+    { //! \returns all the chunks in the list, or 0 if it is empty.
+      if (head.load(boost::memory_order_relaxed) == 0)
+        return 0;
+      return head.exchange(0, boost::memory_order_acquire);
+    }
+};
+
+template <typename Mutex> //!< \tparam Mutex The mutex of the singleton_pool.
+class thread_cache
+{ //! The thread caches of one singleton_pool.
+  //! Disabled when Mutex is null_mutex, or if no thread-specific key is available;
+  //! malloc() and free() then go straight to the pool under the mutex.
+  private:
+    struct local_cache
+    {
+      void * first;
+      std::size_t count;
+      unsigned generation;
+      thread_cache * owner;
+    };
+
+    BOOST_STATIC_CONSTANT(std::size_t, batch_size = BOOST_POOL_THREAD_CACHE_SIZE);
+
+    shared_chunk_list shared;
+    // Incremented by purge(), to tell the caches that their chunks are gone.
+    boost::atomic<unsigned> generation;
+    pthread_key_t key;
+    bool has_key;
+
+    thread_cache(const thread_cache &);
+    void operator=(const thread_cache &);
+
+    static void destroy(void * const ptr)
+    { //! Called on thread exit: hands the thread's chunks to the other threads.
+      local_cache * const c = static_cast<local_cache *>(ptr);
+      if (c->count != 0
+          && c->generation == c->owner->generation.load(boost::memory_order_relaxed))
+        c->owner->flush(*c, c->count);
+      delete c;
+    }
+
+    local_cache * local()
+    { //! \returns the calling thread's cache, or 0 if caching is disabled.
+      if (!has_key)
+        return 0;
+
+      local_cache * c = static_cast<local_cache *>(pthread_getspecific(key));
+      const unsigned current = generation.load(boost::memory_order_relaxed);
+      if (c == 0)
+      {
+        c = new (std::nothrow) local_cache;
+        if (c == 0)
+          return 0;
+        c->owner = this;
+        if (pthread_setspecific(key, c) != 0)
+        {
+          delete c;
+          return 0;
+        }
+      }
+      else if (c->generation == current)
+        return c;
+
+      c->first = 0;
+      c->count = 0;
+      c->generation = current;
+      return c;
+    }
+
+    void flush(local_cache & c, const std::size_t n)
+    { //! Moves n cached chunks to the shared list.
+      void * const first = c.first;
+      void * last = first;
+      for (std::size_t i = 1; i != n; ++i)
+        last = cached_nextof(last);
+      c.first = cached_nextof(last);
+      c.count -= n;
+      shared.push(first, last);
+    }
+
+    bool refill(local_cache & c)
+    { //! Takes up to a batch of chunks from the shared list into an empty cache.
+      void * const first = shared.take();
+      if (first == 0)
+        return false;
+
+      void * last = first;
+      std::size_t n = 1;
+      while (n != batch_size && cached_nextof(last) != 0)
+      {
+        last = cached_nextof(last);
+        ++n;
+      }
+      void * const rest = cached_nextof(last);
+      cached_nextof(last) = 0;
+      c.first = first;
+      c.count = n;
+      if (rest != 0)
+        shared.give_back(rest);
+      return true;
+    }
+
+  public:
+    thread_cache()
+    :shared(), generation(0), has_key(false)
+    {
+      if (!boost::is_same<Mutex, null_mutex>::value)
+        has_key = (pthread_key_create(&key, &destroy) == 0);
+    }
+
+    template <typename Pool>
+    void * malloc BOOST_PREVENT_MACRO_SUBSTITUTION(Pool & p, Mutex & m)
+    { //! Equivalent to p.malloc(), taking m only when neither this thread's
+      //! cache nor the shared list has a free chunk.
+      local_cache * const c = local();
+      if (c == 0)
+      {
+        guard<Mutex> g(m);
+        return (p.malloc)();
+      }
+
+      if (c->first == 0 && !refill(*c))
+      {
+        // Carve a whole batch out of the pool while we hold the lock.
+        //  Chunks only come back to the pool through release(), in
+        //  order, so it can stay ordered and release_memory() works.
+        guard<Mutex> g(m);
+        for (std::size_t i = 0; i != batch_size; ++i)
+        {
+          void * const chunk = p.ordered_malloc();
+          if (chunk == 0)
+            break;
+          cached_nextof(chunk) = c->first;
+          c->first = chunk;
+          ++c->count;
+        }
+        if (c->first == 0)
+          return 0;
+      }
+
+      void * const ret = c->first;
+      c->first = cached_nextof(ret);
+      --c->count;
+      return ret;
+    }
+
+    template <typename Pool>
+    void free BOOST_PREVENT_MACRO_SUBSTITUTION(Pool & p, Mutex & m, void * const chunk)
+    { //! Equivalent to p.free(chunk); a batch of chunks is passed on to the
+      //! other threads once this thread has cached twice the batch size.
+      local_cache * const c = local();
+      if (c == 0)
+      {
+        guard<Mutex> g(m);
+        (p.free)(chunk);
+        return;
+      }
+
+      cached_nextof(chunk) = c->first;
+      c->first = chunk;
+      if (++c->count > 2 * batch_size)
+        flush(*c, batch_size);
+    }
+
+    template <typename Pool>
+    void release(Pool & p)
+    { //! Returns the calling thread's chunks and the shared list to p, in
+      //! address order so that p stays ordered. Must be called with the mutex held.
+      local_cache * const c = local();
+      if (c != 0 && c->count != 0)
+        flush(*c, c->count);
+
+      void * chunk = sort_chunks(shared.take());
+      while (chunk != 0)
+      {
+        void * const next = cached_nextof(chunk);
+        p.ordered_free(chunk);
+        chunk = next;
+      }
+    }
+
+    void purge()
+    { //! Forgets every cached chunk, before the pool frees its memory.
+      //! Must be called with the mutex held.
+      generation.fetch_add(1, boost::memory_order_relaxed);
+      shared.take();
+    }
+}; // class thread_cache
+
+} // namespace pool
+} // namespace details
+
+} // namespace boost
+
+#endif // BOOST_POOL_HAS_THREAD_CACHE
+
+#endif
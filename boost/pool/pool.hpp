@@ -645,6 +645,8 @@ bool pool<UserAllocator>::release_memory()
     ptr = next;
   }
 
+  // The ordered_free() hint may have been in a block we released
+  this->hint = 0;
   next_size = start_size;
   return ret;
 }
@@ -677,6 +679,7 @@ bool pool<UserAllocator>::purge_memory()
 
   list.invalidate();
   this->first = 0;
+  this->hint = 0;
   next_size = start_size;
 
   return true;
@@ -76,6 +76,11 @@ class simple_segregated_storage
       It points to the first chunk in the free list,
       or is equal to 0 if the free list is empty.
     */
+    void * hint; /*!< The chunk most recently placed by ordered_free(),
+      or 0. When it is non-zero it is in the free list, and find_prev()
+      starts from it instead of first for chunks at higher addresses,
+      so that releasing chunks in increasing address order is O(1).
+    */
 
     void * find_prev(void * ptr);
 
@@ -94,7 +99,7 @@ class simple_segregated_storage
   public:
     // Post: empty()
     simple_segregated_storage()
-    :first(0)
+    :first(0), hint(0)
     { //! Construct empty storage area.
       //! \post empty()
     }
@@ -134,6 +139,7 @@ class simple_segregated_storage
         add_block(block, nsz, npartition_sz);
       else
         nextof(loc) = segregate(block, nsz, npartition_sz, nextof(loc));
+      hint = block;
       BOOST_POOL_VALIDATE_INTERNALS
     }
 
@@ -153,6 +159,8 @@ class simple_segregated_storage
 
       // Increment the "first" pointer to point to the next chunk.
       first = nextof(first);
+      if (ret == hint)
+        hint = 0;
       BOOST_POOL_VALIDATE_INTERNALS
       return ret;
     }
@@ -185,6 +193,7 @@ class simple_segregated_storage
         nextof(chunk) = nextof(loc);
         nextof(loc) = chunk;
       }
+      hint = chunk;
       BOOST_POOL_VALIDATE_INTERNALS
     }
 
@@ -256,7 +265,11 @@ void * simple_segregated_storage<SizeType>::find_prev(void * const ptr)
   if (first == 0 || std::greater<void *>()(first, ptr))
     return 0;
 
+  // Chunks released in increasing address order go right after the
+  //  previous one, so start from there rather than walking the whole list.
   void * iter = first;
+  if (hint != 0 && std::less<void *>()(hint, ptr))
+    iter = hint;
   while (true)
   {
     // if we're about to hit the end, or if we've found where "ptr" goes.
@@ -364,6 +377,10 @@ void * simple_segregated_storage<SizeType>::malloc_n(const size_type n,
   } while (iter == 0);
   void * const ret = nextof(start);
   nextof(start) = nextof(iter);
+  // The chunks [ret, iter] are contiguous; forget the hint if it was one of them.
+  if (hint != 0 && !std::less<void *>()(hint, ret)
+      && !std::greater<void *>()(hint, iter))
+    hint = 0;
   BOOST_POOL_VALIDATE_INTERNALS
   return ret;
 }
@@ -25,6 +25,8 @@
 #include <boost/pool/pool.hpp>
 // boost::details::pool::guard
 #include <boost/pool/detail/guard.hpp>
+// boost::details::pool::thread_cache
+#include <boost/pool/detail/thread_cache.hpp>
 
 #include <boost/type_traits/aligned_storage.hpp>
 
@@ -78,6 +80,14 @@ namespace boost {
 
   pool<UserAllocator> p(RequestedSize, NextSize, MaxSize);
 
+  5 When threads are enabled, POSIX threads are available and Mutex is not
+  <tt>boost::details::pool::null_mutex</tt>, each thread keeps a cache of
+  free chunks for <tt>malloc()</tt> and <tt>free()</tt>, refilled from and
+  flushed to a lock-free list shared by all the threads in batches of
+  BOOST_POOL_THREAD_CACHE_SIZE (default 32) chunks. The mutex is only taken
+  when that list is empty. A thread's chunks are handed to the other threads
+  when it exits. Define BOOST_POOL_NO_THREAD_CACHE to turn this off.
+
   \attention
   The underlying pool constructed by the singleton 
   <b>is never freed</b>.  This means that memory allocated
@@ -118,6 +128,9 @@ private:
     struct pool_type: public Mutex, public pool<UserAllocator>
     {
       pool_type() : pool<UserAllocator>(RequestedSize, NextSize, MaxSize) {}
+#ifdef BOOST_POOL_HAS_THREAD_CACHE
+      details::pool::thread_cache<Mutex> cache;
+#endif
     }; //  struct pool_type: Mutex
 
 #else
@@ -132,9 +145,14 @@ public:
   public:
     static void * malloc BOOST_PREVENT_MACRO_SUBSTITUTION()
     { //! Equivalent to SingletonPool::p.malloc(); synchronized.
+      //! Served from the calling thread's cache when there is one, see below.
       pool_type & p = get_pool();
+#ifdef BOOST_POOL_HAS_THREAD_CACHE
+      return (p.cache.malloc)(p, p);
+#else
       details::pool::guard<Mutex> g(p);
       return (p.malloc)();
+#endif
     }
     static void * ordered_malloc()
     {  //! Equivalent to SingletonPool::p.ordered_malloc(); synchronized.
@@ -157,9 +175,14 @@ public:
     }
     static void free BOOST_PREVENT_MACRO_SUBSTITUTION(void * const ptr)
     { //! Equivalent to SingletonPool::p.free(chunk); synchronized.
+      //! The chunk goes to the calling thread's cache when there is one.
       pool_type & p = get_pool();
+#ifdef BOOST_POOL_HAS_THREAD_CACHE
+      (p.cache.free)(p, p, ptr);
+#else
       details::pool::guard<Mutex> g(p);
       (p.free)(ptr);
+#endif
     }
     static void ordered_free(void * const ptr)
     { //! Equivalent to SingletonPool::p.ordered_free(chunk); synchronized.
@@ -181,14 +204,21 @@ public:
     }
     static bool release_memory()
     { //! Equivalent to SingletonPool::p.release_memory(); synchronized.
+      //! Chunks cached by other running threads are not released.
       pool_type & p = get_pool();
       details::pool::guard<Mutex> g(p);
+#ifdef BOOST_POOL_HAS_THREAD_CACHE
+      p.cache.release(p);
+#endif
       return p.release_memory();
     }
     static bool purge_memory()
     { //! Equivalent to SingletonPool::p.purge_memory(); synchronized.
       pool_type & p = get_pool();
       details::pool::guard<Mutex> g(p);
+#ifdef BOOST_POOL_HAS_THREAD_CACHE
+      p.cache.purge();
+#endif
       return p.purge_memory();
     }
 
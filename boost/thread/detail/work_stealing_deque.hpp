@@ -0,0 +1,194 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//    Chase-Lev work stealing deque, with the memory orders given in
+//    "Correct and Efficient Work-Stealing for Weak Memory Models", Le et al. 2013.
+
+#ifndef BOOST_THREAD_DETAIL_WORK_STEALING_DEQUE_HPP
+#define BOOST_THREAD_DETAIL_WORK_STEALING_DEQUE_HPP
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/atomic.hpp>
+#include <cstddef>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace thread_detail
+  {
+    /**
+     * A deque of pointers to which only its owner thread pushes and from which only its owner pops, at the bottom,
+     * while any thread may steal from the top.
+     * The deque doesn't own the pointed objects.
+     */
+    template <typename T>
+    class work_stealing_deque
+    {
+      typedef std::ptrdiff_t index_type;
+
+      /// A circular array of atomic slots. Arrays replaced when the deque grows are kept until the deque is destroyed,
+      /// as a thief could still be reading from them.
+      struct circular_array
+      {
+        explicit circular_array(std::size_t size) :
+          mask(size - 1), elems(new atomic<T*>[size]), previous(0)
+        {
+        }
+        ~circular_array()
+        {
+          delete[] elems;
+        }
+        std::size_t size() const
+        {
+          return mask + 1;
+        }
+        T* get(index_type i) const
+        {
+          return elems[static_cast<std::size_t>(i) & mask].load(memory_order_relaxed);
+        }
+        void put(index_type i, T* x)
+        {
+          elems[static_cast<std::size_t>(i) & mask].store(x, memory_order_relaxed);
+        }
+
+        std::size_t mask;
+        atomic<T*>* elems;
+        circular_array* previous;
+      };
+
+    public:
+      BOOST_THREAD_NO_COPYABLE(work_stealing_deque)
+
+      /**
+       * \b Effects: creates an empty deque whose initial capacity is \c initial_size, which must be a power of two.
+       */
+      explicit work_stealing_deque(std::size_t initial_size = 64) :
+        top_(0), bottom_(0), array_(new circular_array(initial_size))
+      {
+      }
+
+      ~work_stealing_deque()
+      {
+        circular_array* a = array_.load(memory_order_relaxed);
+        while (a)
+        {
+          circular_array* previous = a->previous;
+          delete a;
+          a = previous;
+        }
+      }
+
+      /**
+       * \b Requires: Must be called only by the owner thread.
+       *
+       * \b Effects: pushes \c x at the bottom of the deque, growing it if full.
+       */
+      void push(T* x)
+      {
+        index_type b = bottom_.load(memory_order_relaxed);
+        index_type t = top_.load(memory_order_acquire);
+        circular_array* a = array_.load(memory_order_relaxed);
+        if (b - t > static_cast<index_type>(a->size()) - 1)
+        {
+          a = grow(a, t, b);
+        }
+        a->put(b, x);
+        atomic_thread_fence(memory_order_release);
+        bottom_.store(b + 1, memory_order_relaxed);
+      }
+
+      /**
+       * \b Requires: Must be called only by the owner thread.
+       *
+       * \b Returns: the element at the bottom of the deque, which is removed, or 0 if the deque is empty.
+       */
+      T* pop()
+      {
+        index_type b = bottom_.load(memory_order_relaxed) - 1;
+        circular_array* a = array_.load(memory_order_relaxed);
+        bottom_.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        index_type t = top_.load(memory_order_relaxed);
+        if (t > b)
+        {
+          bottom_.store(b + 1, memory_order_relaxed);
+          return 0;
+        }
+        T* x = a->get(b);
+        if (t == b)
+        {
+          // last element: race with the thieves
+          if (!top_.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+          {
+            x = 0;
+          }
+          bottom_.store(b + 1, memory_order_relaxed);
+        }
+        return x;
+      }
+
+      /**
+       * \b Effects: tries to remove the element at the top of the deque.
+       *
+       * \b Returns: the removed element, or 0 if the deque was empty or if another thread removed the top element
+       * first. In the latter case \c lost_race is set to true.
+       */
+      T* steal(bool& lost_race)
+      {
+        index_type t = top_.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        index_type b = bottom_.load(memory_order_acquire);
+        if (t >= b)
+        {
+          return 0;
+        }
+        circular_array* a = array_.load(memory_order_consume);
+        T* x = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+        {
+          lost_race = true;
+          return 0;
+        }
+        return x;
+      }
+
+      /**
+       * \b Returns: whether the deque seems empty. The result may be out of date as soon as it is returned.
+       */
+      bool empty() const
+      {
+        index_type b = bottom_.load(memory_order_seq_cst);
+        index_type t = top_.load(memory_order_seq_cst);
+        return b <= t;
+      }
+
+    private:
+      circular_array* grow(circular_array* a, index_type t, index_type b)
+      {
+        circular_array* bigger = new circular_array(a->size() * 2);
+        for (index_type i = t; i < b; ++i)
+        {
+          bigger->put(i, a->get(i));
+        }
+        bigger->previous = a;
+        array_.store(bigger, memory_order_release);
+        return bigger;
+      }
+
+      /// top_ is written by the thieves and bottom_ by the owner, so they are kept on different cache lines.
+      atomic<index_type> top_;
+      char pad1_[64];
+      atomic<index_type> bottom_;
+      atomic<circular_array*> array_;
+      char pad2_[64];
+    };
+  }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
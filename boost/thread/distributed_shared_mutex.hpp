@@ -0,0 +1,308 @@
+#ifndef BOOST_THREAD_DISTRIBUTED_SHARED_MUTEX_HPP
+#define BOOST_THREAD_DISTRIBUTED_SHARED_MUTEX_HPP
+
+//  (C) Copyright 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//    A shared mutex for read-mostly data. Each reader increments a counter chosen by its thread among a set of
+//    counters, each on its own cache line, so that readers running on different cores don't write to the same
+//    cache line. A writer blocks the new readers and waits until all the counters are zero.
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/thread/lockable_traits.hpp>
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+#include <boost/thread/detail/thread_interruption.hpp>
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+#include <boost/chrono/system_clocks.hpp>
+#endif
+#include <boost/atomic.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <new>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  class distributed_shared_mutex
+  {
+    /// The size of the padding between the reader counters.
+    BOOST_STATIC_CONSTANT(std::size_t, cache_line_size = 64);
+    /// The maximum number of reader counters.
+    BOOST_STATIC_CONSTANT(unsigned, max_slots = 256);
+
+    typedef atomic<unsigned> counter;
+
+    /// the reader counters, cache_line_size bytes apart, in storage_.
+    char* storage_;
+    char* slots_;
+    unsigned slot_mask_;
+    /// whether a writer owns the mutex or is waiting for the readers to leave.
+    atomic<bool> writer_;
+    /// protects the waits of the blocked readers and writers.
+    mutex state_change;
+    condition_variable cond;
+
+    counter& slot(unsigned i)
+    {
+      return *reinterpret_cast<counter*>(slots_ + i * cache_line_size);
+    }
+
+    /**
+     * Returns: the counter of the current thread.
+     */
+    counter& current_slot()
+    {
+      std::size_t h = hash_value(this_thread::get_id());
+      // the thread ids are often addresses, whose low bits don't differ.
+      h ^= h >> 4;
+      h ^= h >> 12;
+      return slot(static_cast<unsigned>(h) & slot_mask_);
+    }
+
+    /**
+     * Effects: decrements the counter c, waking the waiting writer if it was the last reader of this counter.
+     */
+    void release_slot(counter& c)
+    {
+      if (c.fetch_sub(1, memory_order_seq_cst) == 1 && writer_.load(memory_order_seq_cst))
+      {
+        lock_guard<mutex> lk(state_change);
+        cond.notify_all();
+      }
+    }
+
+    /**
+     * Effects: increments the counter c.
+     * Returns: whether the shared ownership has been acquired, which is not the case when there is a writer.
+     */
+    bool try_acquire_slot(counter& c)
+    {
+      // the increment followed by the check of writer_ pairs with the store to writer_ followed by the check of the
+      // counters in lock(), so that either the reader sees the writer or the writer sees the reader.
+      c.fetch_add(1, memory_order_seq_cst);
+      if (!writer_.load(memory_order_seq_cst))
+      {
+        return true;
+      }
+      release_slot(c);
+      return false;
+    }
+
+    bool has_readers()
+    {
+      for (unsigned i = 0; i <= slot_mask_; ++i)
+      {
+        if (slot(i).load(memory_order_seq_cst) != 0)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+     * Effects: gives up a write lock that couldn't be completed, waking the blocked readers.
+     */
+    void cancel_writer()
+    {
+      writer_.store(false, memory_order_seq_cst);
+      cond.notify_all();
+    }
+
+    static unsigned slot_count(unsigned concurrency)
+    {
+      unsigned n = 1;
+      while (n < concurrency && n < max_slots)
+      {
+        n *= 2;
+      }
+      return n;
+    }
+
+  public:
+    BOOST_THREAD_NO_COPYABLE(distributed_shared_mutex)
+
+    /**
+     * \b Effects: creates an unlocked mutex with a reader counter for each of the \c concurrency threads that can
+     * run at the same time, rounded up to a power of two.
+     */
+    explicit distributed_shared_mutex(unsigned concurrency = thread::hardware_concurrency()) :
+      storage_(0), slots_(0), slot_mask_(slot_count(concurrency) - 1), writer_(false)
+    {
+      storage_ = new char[(slot_mask_ + 2) * cache_line_size];
+      std::size_t misalignment = reinterpret_cast<std::size_t>(storage_) % cache_line_size;
+      slots_ = storage_ + (misalignment ? cache_line_size - misalignment : 0);
+      for (unsigned i = 0; i <= slot_mask_; ++i)
+      {
+        new (slots_ + i * cache_line_size) counter(0);
+      }
+    }
+
+    ~distributed_shared_mutex()
+    {
+      for (unsigned i = 0; i <= slot_mask_; ++i)
+      {
+        BOOST_ASSERT(slot(i).load(memory_order_relaxed) == 0);
+        slot(i).~counter();
+      }
+      delete[] storage_;
+    }
+
+    void lock_shared()
+    {
+      counter& c = current_slot();
+      while (!try_acquire_slot(c))
+      {
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+        boost::this_thread::disable_interruption do_not_disturb;
+#endif
+        unique_lock<mutex> lk(state_change);
+        while (writer_.load(memory_order_seq_cst))
+        {
+          cond.wait(lk);
+        }
+      }
+    }
+
+    bool try_lock_shared()
+    {
+      return try_acquire_slot(current_slot());
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_shared_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_shared_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_shared_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      counter& c = current_slot();
+      while (!try_acquire_slot(c))
+      {
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+        boost::this_thread::disable_interruption do_not_disturb;
+#endif
+        unique_lock<mutex> lk(state_change);
+        while (writer_.load(memory_order_seq_cst))
+        {
+          if (cv_status::timeout == cond.wait_until(lk, abs_time) && writer_.load(memory_order_seq_cst))
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+#endif
+
+    void unlock_shared()
+    {
+      release_slot(current_slot());
+    }
+
+    void lock()
+    {
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+      boost::this_thread::disable_interruption do_not_disturb;
+#endif
+      unique_lock<mutex> lk(state_change);
+      while (writer_.load(memory_order_relaxed))
+      {
+        cond.wait(lk);
+      }
+      writer_.store(true, memory_order_seq_cst);
+      while (has_readers())
+      {
+        cond.wait(lk);
+      }
+    }
+
+    bool try_lock()
+    {
+      lock_guard<mutex> lk(state_change);
+      if (writer_.load(memory_order_relaxed))
+      {
+        return false;
+      }
+      writer_.store(true, memory_order_seq_cst);
+      if (has_readers())
+      {
+        cancel_writer();
+        return false;
+      }
+      return true;
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+      boost::this_thread::disable_interruption do_not_disturb;
+#endif
+      unique_lock<mutex> lk(state_change);
+      while (writer_.load(memory_order_relaxed))
+      {
+        if (cv_status::timeout == cond.wait_until(lk, abs_time) && writer_.load(memory_order_relaxed))
+        {
+          return false;
+        }
+      }
+      writer_.store(true, memory_order_seq_cst);
+      while (has_readers())
+      {
+        if (cv_status::timeout == cond.wait_until(lk, abs_time) && has_readers())
+        {
+          cancel_writer();
+          return false;
+        }
+      }
+      return true;
+    }
+#endif
+
+    void unlock()
+    {
+      lock_guard<mutex> lk(state_change);
+      BOOST_ASSERT(writer_.load(memory_order_relaxed));
+      writer_.store(false, memory_order_seq_cst);
+      cond.notify_all();
+    }
+  };
+
+  namespace sync
+  {
+#ifdef BOOST_THREAD_NO_AUTO_DETECT_MUTEX_TYPES
+    template<>
+    struct is_basic_lockable<distributed_shared_mutex>
+    {
+      BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+    template<>
+    struct is_lockable<distributed_shared_mutex>
+    {
+      BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+#endif
+  }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
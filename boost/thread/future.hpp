@@ -25,7 +25,10 @@
 #include <boost/thread/lock_algorithms.hpp>
 #include <boost/thread/lock_types.hpp>
 #include <boost/exception_ptr.hpp>
+#include <boost/atomic.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/type_traits/is_fundamental.hpp>
 #include <boost/thread/detail/is_convertible.hpp>
@@ -208,6 +211,15 @@ namespace boost
             relocker& operator=(relocker const&);
         };
 
+        // Notified when a shared state becomes ready, without any thread waiting for it.
+        struct ready_notifier
+        {
+            // Called with the mutex of the ready shared state locked.
+            virtual void notify_ready()=0;
+        protected:
+            ~ready_notifier() {}
+        };
+
         struct shared_state_base : enable_shared_from_this<shared_state_base>
         {
             typedef std::list<boost::condition_variable_any*> waiter_list;
@@ -215,14 +227,20 @@ namespace boost
             typedef shared_ptr<shared_state_base> continuation_ptr_type;
 
             boost::exception_ptr exception;
-            bool done;
+            // The ready/satisfied/waiting flags. They are kept in a single atomic word, so that a result that is
+            // set and then got without any thread having to wait needs no locking of the mutex.
+            boost::atomic<unsigned> state_;
             bool is_deferred_;
             launch policy_;
             bool is_constructed;
             mutable boost::mutex mutex;
-            boost::condition_variable waiters;
+            // Created by the first thread that has to block waiting for the result.
+            boost::scoped_ptr<boost::condition_variable> waiters;
             waiter_list external_waiters;
             boost::function<void()> callback;
+            // The first registered ready notifier is stored in place, so that most shared states never allocate.
+            ready_notifier* notifier;
+            std::vector<ready_notifier*> more_notifiers;
             // This declaration should be only included conditionally if interruptions are allowed, but is included to maintain the same layout.
             bool thread_was_interrupted;
             // This declaration should be only included conditionally, but is included to maintain the same layout.
@@ -233,11 +251,22 @@ namespace boost
             {
             }
 
+            enum
+            {
+                // The result has been stored and can be read.
+                ready_bit = 1,
+                // The promise has been satisfied, but the result may not have been stored yet.
+                satisfied_bit = 2,
+                // A thread has registered to be notified under the mutex (waiter, external waiter or continuation).
+                waiting_bit = 4
+            };
+
             shared_state_base():
-                done(false),
+                state_(0),
                 is_deferred_(false),
                 policy_(launch::none),
                 is_constructed(false),
+                notifier(0),
                 thread_was_interrupted(false),
                 continuation_ptr()
             {}
@@ -261,10 +290,79 @@ namespace boost
               policy_ = launch::executor;
             }
 #endif
+            bool is_done() const
+            {
+                return (state_.load(boost::memory_order_acquire) & ready_bit) != 0;
+            }
+
+            // Claims the right to satisfy the shared state.
+            // Returns false if the shared state has already been satisfied.
+            bool try_satisfy()
+            {
+                unsigned state = state_.load(boost::memory_order_relaxed);
+                do
+                {
+                    if (state & satisfied_bit)
+                    {
+                        return false;
+                    }
+                } while (!state_.compare_exchange_weak(state, state | satisfied_bit,
+                    boost::memory_order_acquire, boost::memory_order_relaxed));
+                return true;
+            }
+
+            // Gives up a claim made with try_satisfy() when the result could not be stored.
+            void cancel_satisfy()
+            {
+                state_.fetch_and(~static_cast<unsigned>(satisfied_bit), boost::memory_order_relaxed);
+            }
+
+            // Makes ready a result that has been stored without locking the mutex. The mutex is only locked when
+            // a thread has registered to be notified.
+            void mark_finished_unlocked()
+            {
+                if (state_.fetch_or(ready_bit, boost::memory_order_acq_rel) & waiting_bit)
+                {
+                    boost::unique_lock<boost::mutex> lock(mutex);
+                    mark_finished_internal(lock);
+                }
+            }
+
+            // Must be called with the mutex locked before waiting for, or registering to be notified of, the
+            // result.
+            void mark_waiting(boost::unique_lock<boost::mutex>&)
+            {
+                state_.fetch_or(waiting_bit, boost::memory_order_acq_rel);
+            }
+
+            boost::condition_variable& get_waiters(boost::unique_lock<boost::mutex>&)
+            {
+                if(!waiters)
+                {
+                    waiters.reset(new boost::condition_variable);
+                }
+                return *waiters;
+            }
+
+            void rethrow_if_exceptional() const
+            {
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+                if(thread_was_interrupted)
+                {
+                    throw boost::thread_interrupted();
+                }
+#endif
+                if(exception)
+                {
+                    boost::rethrow_exception(exception);
+                }
+            }
+
             waiter_list::iterator register_external_waiter(boost::condition_variable_any& cv)
             {
                 boost::unique_lock<boost::mutex> lock(mutex);
                 do_callback(lock);
+                mark_waiting(lock);
                 return external_waiters.insert(external_waiters.end(),&cv);
             }
 
@@ -274,14 +372,84 @@ namespace boost
                 external_waiters.erase(it);
             }
 
+            enum add_notifier_result
+            {
+                notifier_added,
+                already_ready,
+                // The result is only computed when a thread waits for it, by a deferred function or a wait callback.
+                computed_on_wait
+            };
+
+            // Registers n to be notified once when the shared state becomes ready, unless it is already ready or
+            // it would never become ready without being waited for.
+            add_notifier_result add_ready_notifier(ready_notifier& n)
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                if (!is_done() && (is_deferred_ || callback))
+                {
+                    return computed_on_wait;
+                }
+                mark_waiting(lock);
+                if (is_done())
+                {
+                    return already_ready;
+                }
+                if (!notifier)
+                {
+                    notifier = &n;
+                }
+                else
+                {
+                    more_notifiers.push_back(&n);
+                }
+                return notifier_added;
+            }
+
+            // Unregisters n, unless it has already been notified.
+            void remove_ready_notifier(ready_notifier& n)
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                if (notifier == &n)
+                {
+                    notifier = 0;
+                }
+                else
+                {
+                    more_notifiers.erase(std::remove(more_notifiers.begin(), more_notifiers.end(), &n),
+                        more_notifiers.end());
+                }
+            }
+
+            void do_ready_notifiers(boost::unique_lock<boost::mutex>&)
+            {
+                ready_notifier* first = notifier;
+                notifier = 0;
+                if (first)
+                {
+                    first->notify_ready();
+                }
+                if (!more_notifiers.empty())
+                {
+                    std::vector<ready_notifier*> others;
+                    others.swap(more_notifiers);
+                    for (std::size_t i = 0; i < others.size(); ++i)
+                    {
+                        others[i]->notify_ready();
+                    }
+                }
+            }
+
 #if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
             void do_continuation(boost::unique_lock<boost::mutex>& lock)
             {
                 if (continuation_ptr) {
-                  continuation_ptr->launch_continuation(lock);
+                  // The ready bit may be set without the mutex, so both the thread attaching the continuation and
+                  // the one making the result ready can get here. Whichever takes the pointer launches it.
+                  continuation_ptr_type this_continuation;
+                  this_continuation.swap(continuation_ptr);
+                  this_continuation->launch_continuation(lock);
                   if (! lock.owns_lock())
                     lock.lock();
-                  continuation_ptr.reset();
                 }
             }
 #else
@@ -293,20 +461,25 @@ namespace boost
             void set_continuation_ptr(continuation_ptr_type continuation, boost::unique_lock<boost::mutex>& lock)
             {
               continuation_ptr= continuation;
-              if (done) {
+              mark_waiting(lock);
+              if (is_done()) {
                 do_continuation(lock);
               }
             }
 #endif
             void mark_finished_internal(boost::unique_lock<boost::mutex>& lock)
             {
-                done=true;
-                waiters.notify_all();
+                state_.fetch_or(ready_bit | satisfied_bit, boost::memory_order_release);
+                if(waiters)
+                {
+                    waiters->notify_all();
+                }
                 for(waiter_list::const_iterator it=external_waiters.begin(),
                         end=external_waiters.end();it!=end;++it)
                 {
                     (*it)->notify_all();
                 }
+                do_ready_notifiers(lock);
                 do_continuation(lock);
             }
             void make_ready()
@@ -317,7 +490,7 @@ namespace boost
 
             void do_callback(boost::unique_lock<boost::mutex>& lock)
             {
-                if(callback && !done)
+                if(callback && !is_done())
                 {
                     boost::function<void()> local_callback=callback;
                     relocker relock(lock);
@@ -338,19 +511,17 @@ namespace boost
                 }
                 else
                 {
-                  while(!done)
-                  {
-                      waiters.wait(lk);
-                  }
-#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
-                  if(rethrow && thread_was_interrupted)
+                  if(!is_done())
                   {
-                      throw boost::thread_interrupted();
+                      mark_waiting(lk);
+                      while(!is_done())
+                      {
+                          get_waiters(lk).wait(lk);
+                      }
                   }
-#endif
-                  if(rethrow && exception)
+                  if(rethrow)
                   {
-                      boost::rethrow_exception(exception);
+                      rethrow_if_exceptional();
                   }
                 }
               }
@@ -358,6 +529,15 @@ namespace boost
 
             virtual void wait(bool rethrow=true)
             {
+                if(is_done())
+                {
+                    // Once ready there is neither a wait callback to call nor a deferred function to run.
+                    if(rethrow)
+                    {
+                        rethrow_if_exceptional();
+                    }
+                    return;
+                }
                 boost::unique_lock<boost::mutex> lock(mutex);
                 wait_internal(lock, rethrow);
             }
@@ -370,10 +550,14 @@ namespace boost
                     return false;
 
                 do_callback(lock);
-                while(!done)
+                if(!is_done())
+                {
+                    mark_waiting(lock);
+                }
+                while(!is_done())
                 {
-                    bool const success=waiters.timed_wait(lock,target_time);
-                    if(!success && !done)
+                    bool const success=get_waiters(lock).timed_wait(lock,target_time);
+                    if(!success && !is_done())
                     {
                         return false;
                     }
@@ -391,10 +575,14 @@ namespace boost
               if (is_deferred_)
                   return future_status::deferred;
               do_callback(lock);
-              while(!done)
+              if(!is_done())
               {
-                  cv_status const st=waiters.wait_until(lock,abs_time);
-                  if(st==cv_status::timeout && !done)
+                  mark_waiting(lock);
+              }
+              while(!is_done())
+              {
+                  cv_status const st=get_waiters(lock).wait_until(lock,abs_time);
+                  if(st==cv_status::timeout && !is_done())
                   {
                     return future_status::timeout;
                   }
@@ -414,6 +602,13 @@ namespace boost
                 mark_exceptional_finish_internal(boost::current_exception(), lock);
             }
 
+            // Requires: try_satisfy() has returned true.
+            void mark_exceptional_finish_unlocked(boost::exception_ptr const& e)
+            {
+                exception=e;
+                mark_finished_unlocked();
+            }
+
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
             void mark_interrupted_finish()
             {
@@ -425,11 +620,11 @@ namespace boost
             void set_interrupted_at_thread_exit()
             {
               unique_lock<boost::mutex> lk(mutex);
-              thread_was_interrupted=true;
-              if (has_value(lk))
+              if (!try_satisfy())
               {
                   throw_exception(promise_already_satisfied());
               }
+              thread_was_interrupted=true;
               detail::make_ready_at_thread_exit(shared_from_this());
             }
 #endif
@@ -437,7 +632,7 @@ namespace boost
             void set_exception_at_thread_exit(exception_ptr e)
             {
               unique_lock<boost::mutex> lk(mutex);
-              if (has_value(lk))
+              if (!try_satisfy())
               {
                   throw_exception(promise_already_satisfied());
               }
@@ -450,7 +645,7 @@ namespace boost
             bool has_value() const
             {
                 boost::lock_guard<boost::mutex> lock(mutex);
-                return done && !(exception
+                return is_done() && !(exception
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
                     || thread_was_interrupted
 #endif
@@ -459,7 +654,7 @@ namespace boost
 
             bool has_value(unique_lock<boost::mutex>& )  const
             {
-                return done && !(exception
+                return is_done() && !(exception
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
                     || thread_was_interrupted
 #endif
@@ -469,7 +664,7 @@ namespace boost
             bool has_exception()  const
             {
                 boost::lock_guard<boost::mutex> lock(mutex);
-                return done && (exception
+                return is_done() && (exception
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
                     || thread_was_interrupted
 #endif
@@ -478,7 +673,7 @@ namespace boost
 
             bool has_exception(unique_lock<boost::mutex>&) const
             {
-                return done && (exception
+                return is_done() && (exception
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
                     || thread_was_interrupted
 #endif
@@ -496,8 +691,7 @@ namespace boost
 
             future_state::state get_state() const
             {
-                boost::lock_guard<boost::mutex> guard(mutex);
-                if(!done)
+                if(!is_done())
                 {
                     return future_state::waiting;
                 }
@@ -677,6 +871,40 @@ namespace boost
 #endif
             }
 
+            // Requires: try_satisfy() has returned true.
+            void mark_finished_with_result_unlocked(source_reference_type result_)
+            {
+                try
+                {
+                    future_traits<T>::init(result,result_);
+                }
+                catch (...)
+                {
+                    this->cancel_satisfy();
+                    throw;
+                }
+                this->mark_finished_unlocked();
+            }
+
+            // Requires: try_satisfy() has returned true.
+            void mark_finished_with_result_unlocked(rvalue_source_type result_)
+            {
+                try
+                {
+#if ! defined  BOOST_NO_CXX11_RVALUE_REFERENCES
+                    future_traits<T>::init(result,boost::forward<T>(result_));
+#else
+                    future_traits<T>::init(result,static_cast<rvalue_source_type>(result_));
+#endif
+                }
+                catch (...)
+                {
+                    this->cancel_satisfy();
+                    throw;
+                }
+                this->mark_finished_unlocked();
+            }
+
             virtual move_dest_type get()
             {
                 wait();
@@ -693,12 +921,20 @@ namespace boost
             void set_value_at_thread_exit(source_reference_type result_)
             {
               unique_lock<boost::mutex> lk(this->mutex);
-              if (this->has_value(lk))
+              if (!this->try_satisfy())
               {
                   throw_exception(promise_already_satisfied());
               }
               //future_traits<T>::init(result,result_);
-              result.reset(new T(result_));
+              try
+              {
+                  result.reset(new T(result_));
+              }
+              catch (...)
+              {
+                  this->cancel_satisfy();
+                  throw;
+              }
 
               this->is_constructed = true;
               detail::make_ready_at_thread_exit(shared_from_this());
@@ -707,9 +943,17 @@ namespace boost
             void set_value_at_thread_exit(rvalue_source_type result_)
             {
               unique_lock<boost::mutex> lk(this->mutex);
-              if (this->has_value(lk))
+              if (!this->try_satisfy())
                   throw_exception(promise_already_satisfied());
-              result.reset(new T(boost::move(result_)));
+              try
+              {
+                  result.reset(new T(boost::move(result_)));
+              }
+              catch (...)
+              {
+                  this->cancel_satisfy();
+                  throw;
+              }
               //future_traits<T>::init(result,static_cast<rvalue_source_type>(result_));
               this->is_constructed = true;
               detail::make_ready_at_thread_exit(shared_from_this());
@@ -753,6 +997,13 @@ namespace boost
                 mark_finished_with_result_internal(result_, lock);
             }
 
+            // Requires: try_satisfy() has returned true.
+            void mark_finished_with_result_unlocked(source_reference_type result_)
+            {
+                result= &result_;
+                mark_finished_unlocked();
+            }
+
             virtual T& get()
             {
                 wait();
@@ -768,7 +1019,7 @@ namespace boost
             void set_value_at_thread_exit(T& result_)
             {
               unique_lock<boost::mutex> lk(this->mutex);
-              if (this->has_value(lk))
+              if (!this->try_satisfy())
                   throw_exception(promise_already_satisfied());
               //future_traits<T>::init(result,result_);
               result= &result_;
@@ -801,6 +1052,12 @@ namespace boost
                 mark_finished_with_result_internal(lock);
             }
 
+            // Requires: try_satisfy() has returned true.
+            void mark_finished_with_result_unlocked()
+            {
+                mark_finished_unlocked();
+            }
+
             virtual void get()
             {
                 this->wait();
@@ -814,7 +1071,7 @@ namespace boost
             void set_value_at_thread_exit()
             {
               unique_lock<boost::mutex> lk(this->mutex);
-              if (this->has_value(lk))
+              if (!this->try_satisfy())
               {
                   throw_exception(promise_already_satisfied());
               }
@@ -1133,7 +1390,7 @@ namespace boost
                 {
                     for(count_type i=0;i<futures.size();++i)
                     {
-                        if(futures[i].future_->done)
+                        if(futures[i].future_->is_done())
                         {
                             return futures[i].index;
                         }
@@ -2010,21 +2267,16 @@ namespace boost
 #if defined BOOST_THREAD_PROVIDES_PROMISE_LAZY
             future_(),
 #else
-            future_(new detail::shared_state<R>()),
+            future_(boost::make_shared<detail::shared_state<R> >()),
 #endif
             future_obtained(false)
         {}
 
         ~promise()
         {
-            if(future_)
+            if(future_ && future_->try_satisfy())
             {
-                boost::unique_lock<boost::mutex> lock(future_->mutex);
-
-                if(!future_->done && !future_->is_constructed)
-                {
-                    future_->mark_exceptional_finish_internal(boost::copy_exception(broken_promise()), lock);
-                }
+                future_->mark_exceptional_finish_unlocked(boost::copy_exception(broken_promise()));
             }
         }
 
@@ -2069,39 +2321,36 @@ namespace boost
         void set_value(typename detail::future_traits<R>::source_reference_type r)
         {
             lazy_init();
-            boost::unique_lock<boost::mutex> lock(future_->mutex);
-            if(future_->done)
+            if(!future_->try_satisfy())
             {
                 boost::throw_exception(promise_already_satisfied());
             }
-            future_->mark_finished_with_result_internal(r, lock);
+            future_->mark_finished_with_result_unlocked(r);
         }
 
 //         void set_value(R && r);
         void set_value(typename detail::future_traits<R>::rvalue_source_type r)
         {
             lazy_init();
-            boost::unique_lock<boost::mutex> lock(future_->mutex);
-            if(future_->done)
+            if(!future_->try_satisfy())
             {
                 boost::throw_exception(promise_already_satisfied());
             }
 #if ! defined  BOOST_NO_CXX11_RVALUE_REFERENCES
-            future_->mark_finished_with_result_internal(boost::forward<R>(r), lock);
+            future_->mark_finished_with_result_unlocked(boost::forward<R>(r));
 #else
-            future_->mark_finished_with_result_internal(static_cast<typename detail::future_traits<R>::rvalue_source_type>(r), lock);
+            future_->mark_finished_with_result_unlocked(static_cast<typename detail::future_traits<R>::rvalue_source_type>(r));
 #endif
         }
 
         void set_exception(boost::exception_ptr p)
         {
             lazy_init();
-            boost::unique_lock<boost::mutex> lock(future_->mutex);
-            if(future_->done)
+            if(!future_->try_satisfy())
             {
                 boost::throw_exception(promise_already_satisfied());
             }
-            future_->mark_exceptional_finish_internal(p, lock);
+            future_->mark_exceptional_finish_unlocked(p);
         }
         template <typename E>
         void set_exception(E ex)
@@ -2188,21 +2437,16 @@ namespace boost
 #if defined BOOST_THREAD_PROVIDES_PROMISE_LAZY
             future_(),
 #else
-            future_(new detail::shared_state<R&>()),
+            future_(boost::make_shared<detail::shared_state<R&> >()),
 #endif
             future_obtained(false)
         {}
 
         ~promise()
         {
-            if(future_)
+            if(future_ && future_->try_satisfy())
             {
-                boost::unique_lock<boost::mutex> lock(future_->mutex);
-
-                if(!future_->done && !future_->is_constructed)
-                {
-                    future_->mark_exceptional_finish_internal(boost::copy_exception(broken_promise()), lock);
-                }
+                future_->mark_exceptional_finish_unlocked(boost::copy_exception(broken_promise()));
             }
         }
 
@@ -2247,23 +2491,21 @@ namespace boost
         void set_value(R& r)
         {
             lazy_init();
-            boost::unique_lock<boost::mutex> lock(future_->mutex);
-            if(future_->done)
+            if(!future_->try_satisfy())
             {
                 boost::throw_exception(promise_already_satisfied());
             }
-            future_->mark_finished_with_result_internal(r, lock);
+            future_->mark_finished_with_result_unlocked(r);
         }
 
         void set_exception(boost::exception_ptr p)
         {
             lazy_init();
-            boost::unique_lock<boost::mutex> lock(future_->mutex);
-            if(future_->done)
+            if(!future_->try_satisfy())
             {
                 boost::throw_exception(promise_already_satisfied());
             }
-            future_->mark_exceptional_finish_internal(p, lock);
+            future_->mark_exceptional_finish_unlocked(p);
         }
         template <typename E>
         void set_exception(E ex)
@@ -2340,21 +2582,16 @@ namespace boost
 #if defined BOOST_THREAD_PROVIDES_PROMISE_LAZY
             future_(),
 #else
-            future_(new detail::shared_state<void>),
+            future_(boost::make_shared<detail::shared_state<void> >()),
 #endif
             future_obtained(false)
         {}
 
         ~promise()
         {
-            if(future_)
+            if(future_ && future_->try_satisfy())
             {
-                boost::unique_lock<boost::mutex> lock(future_->mutex);
-
-                if(!future_->done && !future_->is_constructed)
-                {
-                    future_->mark_exceptional_finish_internal(boost::copy_exception(broken_promise()), lock);
-                }
+                future_->mark_exceptional_finish_unlocked(boost::copy_exception(broken_promise()));
             }
         }
 
@@ -2402,23 +2639,21 @@ namespace boost
         void set_value()
         {
             lazy_init();
-            boost::unique_lock<boost::mutex> lock(future_->mutex);
-            if(future_->done)
+            if(!future_->try_satisfy())
             {
                 boost::throw_exception(promise_already_satisfied());
             }
-            future_->mark_finished_with_result_internal(lock);
+            future_->mark_finished_with_result_unlocked();
         }
 
         void set_exception(boost::exception_ptr p)
         {
             lazy_init();
-            boost::unique_lock<boost::mutex> lock(future_->mutex);
-            if(future_->done)
+            if(!future_->try_satisfy())
             {
                 boost::throw_exception(promise_already_satisfied());
             }
-            future_->mark_exceptional_finish_internal(p,lock);
+            future_->mark_exceptional_finish_unlocked(p);
         }
         template <typename E>
         void set_exception(E ex)
@@ -4550,54 +4785,137 @@ namespace boost
     BOOST_CONSTEXPR_OR_CONST vector_tag vector_tag_value = {};
     BOOST_CONSTEXPR_OR_CONST values_tag values_tag_value = {};
     ////////////////////////////////
-    // detail::future_async_when_all_shared_state
+    // detail::future_when_vector_shared_state_base
     ////////////////////////////////
+    // The futures notify the shared state when they become ready, so that no thread has to wait for them.
+    // When one of the futures is computed on wait (deferred or with a wait callback) the shared state is deferred
+    // instead, and the futures are waited for by the thread that waits for the result.
+    // The notifications don't keep the shared state alive: a notification runs on the thread that makes a future
+    // ready, with its mutex locked, and destroying the futures there could destroy an async shared state on its own
+    // thread. Instead the notifiers still registered are removed when the shared state is destroyed.
     template<typename F>
-    struct future_when_all_vector_shared_state: future_async_shared_state_base<csbl::vector<F> >
+    struct future_when_vector_shared_state_base: shared_state<csbl::vector<F> >, ready_notifier
     {
       typedef csbl::vector<F> vector_type;
       typedef typename F::value_type value_type;
-      csbl::vector<F> vec_;
+      vector_type vec_;
+      // The number of notifications still to come, plus one until all the notifiers are registered.
+      atomic<std::size_t> pending_;
+      // Whether the result is stored by the last notification.
+      bool finish_when_all_notified_;
+      // The shared states the notifier has been registered on. They are not owned, as the futures may have been
+      // moved to the result and destroyed.
+      csbl::vector<weak_ptr<shared_state_base> > notifying_;
+
+      future_when_vector_shared_state_base()
+      : pending_(1), finish_when_all_notified_(false)
+      {
+      }
 
-      static void run(future_when_all_vector_shared_state* that)
+      template< typename InputIterator>
+      future_when_vector_shared_state_base(InputIterator first, InputIterator last)
+      : vec_(std::make_move_iterator(first), std::make_move_iterator(last)),
+        pending_(1), finish_when_all_notified_(false)
       {
-        try
+      }
+
+      explicit future_when_vector_shared_state_base(BOOST_THREAD_RV_REF(vector_type) v)
+      : vec_(boost::move(v)), pending_(1), finish_when_all_notified_(false)
+      {
+      }
+
+      // Registers the notifier on the i-th future, which is considered ready if it is not valid.
+      shared_state_base::add_notifier_result add_notifier(std::size_t i)
+      {
+        if (!vec_[i].future_)
         {
-          boost::wait_for_all(that->vec_.begin(), that->vec_.end());
-          that->mark_finished_with_result(boost::move(that->vec_));
+          return shared_state_base::already_ready;
         }
-#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
-        catch(thread_interrupted& )
+        notifying_.push_back(vec_[i].future_);
+        pending_.fetch_add(1, memory_order_relaxed);
+        shared_state_base::add_notifier_result r = vec_[i].future_->add_ready_notifier(*this);
+        if (r != shared_state_base::notifier_added)
         {
-          that->mark_interrupted_finish();
+          pending_.fetch_sub(1, memory_order_relaxed);
+          notifying_.pop_back();
         }
-#endif
-        catch(...)
+        return r;
+      }
+
+      // Removes the notifiers that have not been called yet. Must be called by the most derived destructor, as a
+      // notification may be running concurrently until the notifier is removed.
+      void remove_notifiers()
+      {
+        for (std::size_t i = 0; i < notifying_.size(); ++i)
         {
-          that->mark_exceptional_finish();
+          shared_ptr<shared_state_base> state = notifying_[i].lock();
+          if (state)
+          {
+            state->remove_ready_notifier(*this);
+          }
         }
       }
-      void init()
+
+      // Stores the futures as the result, unless it has already been stored.
+      void finish()
+      {
+        if (this->try_satisfy())
+        {
+          try
+          {
+            this->mark_finished_with_result_unlocked(boost::move(vec_));
+          }
+          catch (...)
+          {
+            if (this->try_satisfy())
+            {
+              this->mark_exceptional_finish_unlocked(current_exception());
+            }
+          }
+        }
+      }
+
+      // Accounts for a notification, or for the end of the registration of the notifiers.
+      void release()
       {
-        this->thr_ = thread(&future_when_all_vector_shared_state::run, this);
+        if (pending_.fetch_sub(1, memory_order_acq_rel) == 1)
+        {
+          if (finish_when_all_notified_)
+          {
+            finish();
+          }
+        }
       }
+    };
+
+    ////////////////////////////////
+    // detail::future_when_all_vector_shared_state
+    ////////////////////////////////
+    template<typename F>
+    struct future_when_all_vector_shared_state: future_when_vector_shared_state_base<F>
+    {
+      typedef future_when_vector_shared_state_base<F> base_type;
+      typedef csbl::vector<F> vector_type;
 
     public:
       template< typename InputIterator>
       future_when_all_vector_shared_state(input_iterator_tag,
           InputIterator first, InputIterator last
       )
-      : vec_(std::make_move_iterator(first), std::make_move_iterator(last))
+      : base_type(first, last)
       {
-        init();
       }
 
       future_when_all_vector_shared_state(vector_tag,
           BOOST_THREAD_RV_REF(csbl::vector<F>) v
       )
-      : vec_(boost::move(v))
+      : base_type(boost::move(v))
+      {
+      }
+
+      ~future_when_all_vector_shared_state()
       {
-        init();
+        this->remove_notifiers();
       }
 
 #if ! defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
@@ -4606,75 +4924,106 @@ namespace boost
           BOOST_THREAD_RV_REF(T0) f, BOOST_THREAD_RV_REF(T) ... futures
       )
       {
-        vec_.push_back(boost::forward<T0>(f));
+        this->vec_.reserve(1 + sizeof...(T));
+        this->vec_.push_back(boost::forward<T0>(f));
         typename alias_t<char[]>::type{
             ( //first part of magic unpacker
-            vec_.push_back(boost::forward<T>(futures))
+            this->vec_.push_back(boost::forward<T>(futures))
             ,'0'
             )...,
             '0'
         }; //second part of magic unpacker
-
-        init();
       }
-#else
 #endif
-      ~future_when_all_vector_shared_state()
+
+      void init()
       {
-        this->join();
+        bool computed_on_wait = false;
+        for (std::size_t i = 0; i < this->vec_.size(); ++i)
+        {
+          if (this->add_notifier(i) == shared_state_base::computed_on_wait)
+          {
+            computed_on_wait = true;
+          }
+        }
+        if (computed_on_wait)
+        {
+          this->set_deferred();
+        }
+        else
+        {
+          this->finish_when_all_notified_ = true;
+        }
+        this->release();
       }
 
-    };
-
-    ////////////////////////////////
-    // detail::future_async_when_any_shared_state
-    ////////////////////////////////
-    template<typename F>
-    struct future_when_any_vector_shared_state: future_async_shared_state_base<csbl::vector<F> >
-    {
-      typedef csbl::vector<F> vector_type;
-      typedef typename F::value_type value_type;
-      csbl::vector<F> vec_;
+      virtual void notify_ready()
+      {
+        this->release();
+      }
 
-      static void run(future_when_any_vector_shared_state* that)
+      virtual void execute(boost::unique_lock<boost::mutex>& lck)
       {
         try
         {
-          boost::wait_for_any(that->vec_.begin(), that->vec_.end());
-          that->mark_finished_with_result(boost::move(that->vec_));
-        }
-#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
-        catch(thread_interrupted& )
-        {
-          that->mark_interrupted_finish();
+          relocker relock(lck);
+          for (std::size_t i = 0; i < this->vec_.size(); ++i)
+          {
+            if (this->vec_[i].valid())
+            {
+              this->vec_[i].wait();
+            }
+          }
+          relock.lock();
+          this->mark_finished_with_result_internal(boost::move(this->vec_), lck);
         }
-#endif
-        catch(...)
+        catch (...)
         {
-          that->mark_exceptional_finish();
+          this->mark_exceptional_finish_internal(current_exception(), lck);
         }
       }
-      void init()
+    };
+
+    ////////////////////////////////
+    // detail::future_when_any_vector_shared_state
+    ////////////////////////////////
+    template<typename F>
+    struct future_when_any_vector_shared_state: future_when_vector_shared_state_base<F>
+    {
+      typedef future_when_vector_shared_state_base<F> base_type;
+      typedef csbl::vector<F> vector_type;
+
+      enum
       {
-        this->thr_ = thread(&future_when_any_vector_shared_state::run, this);
-      }
+        notified_bit = 1,
+        registered_bit = 2
+      };
+      // A future that becomes ready while the notifiers are being registered can't store the result, as the
+      // futures are still being read. Whichever of the notification and the end of the registration comes last
+      // stores it.
+      atomic<unsigned> flags_;
+      // The index of the future waited for when the shared state is deferred.
+      std::size_t computed_on_wait_;
 
     public:
       template< typename InputIterator>
       future_when_any_vector_shared_state(input_iterator_tag,
           InputIterator first, InputIterator last
       )
-      : vec_(std::make_move_iterator(first), std::make_move_iterator(last))
+      : base_type(first, last), flags_(0), computed_on_wait_(0)
       {
-        init();
       }
 
       future_when_any_vector_shared_state(vector_tag,
           BOOST_THREAD_RV_REF(csbl::vector<F>) v
       )
-      : vec_(boost::move(v))
+      : base_type(boost::move(v)), flags_(0), computed_on_wait_(0)
+      {
+      }
+
+      ~future_when_any_vector_shared_state()
       {
-        init();
+        this->remove_notifiers();
       }
 
 #if ! defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
@@ -4682,24 +5031,65 @@ namespace boost
       future_when_any_vector_shared_state(values_tag,
           BOOST_THREAD_RV_REF(T0) f, BOOST_THREAD_RV_REF(T) ... futures
       )
+      : flags_(0), computed_on_wait_(0)
       {
-        vec_.push_back(boost::forward<T0>(f));
+        this->vec_.reserve(1 + sizeof...(T));
+        this->vec_.push_back(boost::forward<T0>(f));
         typename alias_t<char[]>::type{
             ( //first part of magic unpacker
-            vec_.push_back(boost::forward<T>(futures))
+            this->vec_.push_back(boost::forward<T>(futures))
             ,'0'
             )...,
             '0'
         }; //second part of magic unpacker
-        init();
       }
 #endif
 
-      ~future_when_any_vector_shared_state()
+      void init()
       {
-        this->join();
+        shared_state_base::add_notifier_result r = shared_state_base::notifier_added;
+        std::size_t i = 0;
+        for (; r == shared_state_base::notifier_added && i < this->vec_.size(); ++i)
+        {
+          r = this->add_notifier(i);
+        }
+        if (r == shared_state_base::computed_on_wait)
+        {
+          // the notifications to come will not store the result, as the registered bit is never set.
+          computed_on_wait_ = i - 1;
+          this->set_deferred();
+        }
+        else if (r == shared_state_base::already_ready
+            || (flags_.fetch_or(registered_bit, memory_order_acq_rel) & notified_bit))
+        {
+          this->finish();
+        }
+        this->release();
       }
 
+      virtual void notify_ready()
+      {
+        if (flags_.fetch_or(notified_bit, memory_order_acq_rel) & registered_bit)
+        {
+          this->finish();
+        }
+        this->release();
+      }
+
+      virtual void execute(boost::unique_lock<boost::mutex>& lck)
+      {
+        try
+        {
+          relocker relock(lck);
+          this->vec_[computed_on_wait_].wait();
+          relock.lock();
+          this->mark_finished_with_result_internal(boost::move(this->vec_), lck);
+        }
+        catch (...)
+        {
+          this->mark_exceptional_finish_internal(current_exception(), lck);
+        }
+      }
     };
 
 #if ! defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
@@ -4768,7 +5158,8 @@ namespace boost
     if (first==last) return make_ready_future(container_type());
 
     shared_ptr<factory_type >
-        h(new factory_type>(detail::input_iterator_tag_value, first,last));
+        h(boost::make_shared<factory_type>(detail::input_iterator_tag_value, first,last));
+    h->init();
     return BOOST_THREAD_FUTURE<container_type>(h);
   }
 
@@ -4788,7 +5179,8 @@ namespace boost
     typedef  typename detail::when_type<T0, T...>::factory_all_type factory_type;
 
     shared_ptr<factory_type>
-        h(new factory_type(detail::values_tag_value, boost::forward<T0>(f), boost::forward<T>(futures)...));
+        h(boost::make_shared<factory_type>(detail::values_tag_value, boost::forward<T0>(f), boost::forward<T>(futures)...));
+    h->init();
     return BOOST_THREAD_FUTURE<container_type>(h);
   }
 #endif
@@ -4806,7 +5198,8 @@ namespace boost
     if (first==last) return make_ready_future(container_type());
 
     shared_ptr<factory_type >
-        h(new factory_type>(detail::input_iterator_tag_value, first,last));
+        h(boost::make_shared<factory_type>(detail::input_iterator_tag_value, first,last));
+    h->init();
     return BOOST_THREAD_FUTURE<container_type>(h);
   }
 
@@ -4825,7 +5218,8 @@ namespace boost
     typedef  typename detail::when_type<T0, T...>::factory_any_type factory_type;
 
     shared_ptr<factory_type>
-        h(new factory_type(detail::values_tag_value, boost::forward<T0>(f), boost::forward<T>(futures)...));
+        h(boost::make_shared<factory_type>(detail::values_tag_value, boost::forward<T0>(f), boost::forward<T>(futures)...));
+    h->init();
     return BOOST_THREAD_FUTURE<container_type>(h);
   }
 #endif
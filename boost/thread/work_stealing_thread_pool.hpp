@@ -0,0 +1,416 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//    A pool of threads where each worker thread has its own work stealing deque.
+//    Closures submitted by a worker thread go to its own deque, closures submitted by other threads go to a shared
+//    queue, and idle workers steal from the deque of another worker chosen at random before parking.
+
+#ifndef BOOST_THREAD_WORK_STEALING_THREAD_POOL_HPP
+#define BOOST_THREAD_WORK_STEALING_THREAD_POOL_HPP
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/detail/move.hpp>
+#include <boost/thread/detail/work.hpp>
+#include <boost/thread/detail/work_stealing_deque.hpp>
+#include <boost/thread/scoped_thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/thread/sync_bounded_queue.hpp>
+#include <boost/thread/csbl/vector.hpp>
+#include <boost/thread/csbl/deque.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/atomic.hpp>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+
+  class work_stealing_thread_pool
+  {
+    /// type-erasure to store the works to do
+    typedef  thread_detail::work work;
+    /// the kind of stored threads are scoped threads to ensure that the threads are joined.
+    /// A move aware vector type
+    typedef scoped_thread<> thread_t;
+    typedef csbl::vector<thread_t> thread_vector;
+
+    /// the data owned by each worker thread
+    struct worker_data
+    {
+      worker_data() : seed(0) {}
+
+      /// the closures submitted by this worker, that other workers can steal
+      thread_detail::work_stealing_deque<work> deque;
+      /// the state of the random generator used to choose the workers to steal from
+      unsigned seed;
+    };
+
+    /// The number of times an idle worker tries to steal before parking.
+    BOOST_STATIC_CONSTANT(unsigned, steal_attempts = 64);
+
+    /// the worker data, one per worker thread
+    worker_data* workers;
+    unsigned worker_count;
+    /// the worker data of the current thread when it is one of the worker threads
+    thread_specific_ptr<worker_data> current_worker;
+
+    /// protects the queue of closures submitted from outside the pool, and is used to park idle workers.
+    mutex mtx;
+    condition_variable not_empty;
+    /// the closures submitted from outside the pool
+    csbl::deque<work*> injected;
+    atomic<std::size_t> injected_size;
+    /// the number of parked workers
+    atomic<unsigned> sleeping;
+    atomic<bool> closed_;
+
+    /// A move aware vector
+    thread_vector threads;
+
+    static void no_cleanup(worker_data*)
+    {
+    }
+
+    static unsigned next_random(unsigned& seed)
+    {
+      // xorshift
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      return seed;
+    }
+
+    /**
+     * Effects: runs and deletes a task.
+     * Returns: whether the task has been executed without throwing.
+     */
+    static bool execute(work* task)
+    {
+      try
+      {
+        (*task)();
+        delete task;
+        return true;
+      }
+      catch (...)
+      {
+        delete task;
+        return false;
+      }
+    }
+
+    /**
+     * Effects: removes a closure from the queue of closures submitted from outside the pool.
+     */
+    work* pull_injected()
+    {
+      if (injected_size.load(memory_order_acquire) == 0)
+      {
+        return 0;
+      }
+      lock_guard<mutex> lk(mtx);
+      if (injected.empty())
+      {
+        return 0;
+      }
+      work* task = injected.front();
+      injected.pop_front();
+      injected_size.fetch_sub(1, memory_order_release);
+      return task;
+    }
+
+    /**
+     * Effects: tries to steal a closure from each other worker once, starting from one chosen at random, and
+     * then from the closures submitted from outside the pool.
+     */
+    work* steal(worker_data* self)
+    {
+      work* task = pull_injected();
+      if (task)
+      {
+        return task;
+      }
+      bool lost_race;
+      do
+      {
+        lost_race = false;
+        unsigned start = self ? next_random(self->seed) % worker_count : 0;
+        for (unsigned i = 0; i < worker_count; ++i)
+        {
+          worker_data& victim = workers[(start + i) % worker_count];
+          if (&victim != self)
+          {
+            task = victim.deque.steal(lost_race);
+            if (task)
+            {
+              return task;
+            }
+          }
+        }
+      } while (lost_race);
+      return 0;
+    }
+
+    /**
+     * Returns: whether there is a closure in any of the queues.
+     */
+    bool has_work() const
+    {
+      if (injected_size.load(memory_order_seq_cst) != 0)
+      {
+        return true;
+      }
+      for (unsigned i = 0; i < worker_count; ++i)
+      {
+        if (!workers[i].deque.empty())
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+     * Effects: wakes up a parked worker if any.
+     */
+    void notify_one_sleeping()
+    {
+      atomic_thread_fence(memory_order_seq_cst);
+      if (sleeping.load(memory_order_relaxed) != 0)
+      {
+        lock_guard<mutex> lk(mtx);
+        not_empty.notify_one();
+      }
+    }
+
+    /**
+     * Effects: parks the worker until a closure is submitted or the pool is closed.
+     * Returns: false when the pool is closed and there is no more closures to run.
+     */
+    bool park()
+    {
+      unique_lock<mutex> lk(mtx);
+      // the seq_cst increment followed by the check of all the queues pairs with the fence in
+      // notify_one_sleeping(), so that either the worker sees the new closure or the submitter sees the worker.
+      sleeping.fetch_add(1, memory_order_seq_cst);
+      bool work_left = has_work();
+      if (!work_left && !closed_.load(memory_order_relaxed))
+      {
+        not_empty.wait(lk);
+        work_left = true;
+      }
+      sleeping.fetch_sub(1, memory_order_relaxed);
+      return work_left;
+    }
+
+    /**
+     * The main loop of the worker threads
+     */
+    void worker_thread(unsigned index)
+    {
+      worker_data& self = workers[index];
+      current_worker.reset(&self);
+      for (;;)
+      {
+        work* task = self.deque.pop();
+        for (unsigned i = 0; !task && i < steal_attempts; ++i)
+        {
+          task = steal(&self);
+          if (!task && i + 1 < steal_attempts)
+          {
+            this_thread::yield();
+          }
+        }
+        if (task)
+        {
+          execute(task);
+        }
+        else if (!park())
+        {
+          break;
+        }
+      }
+      current_worker.release();
+    }
+
+    void submit_work(work* task)
+    {
+      worker_data* self = current_worker.get();
+      if (self)
+      {
+        self->deque.push(task);
+        notify_one_sleeping();
+      }
+      else
+      {
+        lock_guard<mutex> lk(mtx);
+        injected.push_back(task);
+        injected_size.fetch_add(1, memory_order_seq_cst);
+        if (sleeping.load(memory_order_relaxed) != 0)
+        {
+          not_empty.notify_one();
+        }
+      }
+    }
+
+    void throw_if_closed()
+    {
+      if (closed())
+      {
+        BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+      }
+    }
+
+  public:
+    /// work_stealing_thread_pool is not copyable.
+    BOOST_THREAD_NO_COPYABLE(work_stealing_thread_pool)
+
+    /**
+     * \b Effects: creates a thread pool that runs closures on \c thread_count threads.
+     *
+     * \b Throws: Whatever exception is thrown while initializing the needed resources.
+     */
+    work_stealing_thread_pool(unsigned const thread_count = thread::hardware_concurrency()) :
+      workers(new worker_data[thread_count ? thread_count : 1]),
+      worker_count(thread_count ? thread_count : 1),
+      current_worker(&work_stealing_thread_pool::no_cleanup),
+      injected_size(0),
+      sleeping(0),
+      closed_(false)
+    {
+      try
+      {
+        threads.reserve(worker_count);
+        for (unsigned i = 0; i < worker_count; ++i)
+        {
+          workers[i].seed = 2654435761u * (i + 1);
+          thread th (&work_stealing_thread_pool::worker_thread, this, i);
+          threads.push_back(thread_t(boost::move(th)));
+        }
+      }
+      catch (...)
+      {
+        close();
+        threads.clear();
+        delete[] workers;
+        throw;
+      }
+    }
+    /**
+     * \b Effects: Destroys the thread pool.
+     *
+     * \b Synchronization: The completion of all the closures happen before the completion of the
+     * \c work_stealing_thread_pool destructor.
+     */
+    ~work_stealing_thread_pool()
+    {
+      // signal to all the worker threads that there will be no more submissions.
+      close();
+      // joins all the threads as the threads were scoped_threads
+      threads.clear();
+      delete[] workers;
+    }
+
+    /**
+     * \b Effects: close the \c work_stealing_thread_pool for submissions.
+     * The worker threads will work until there is no more closures to run.
+     */
+    void close()
+    {
+      lock_guard<mutex> lk(mtx);
+      closed_.store(true, memory_order_relaxed);
+      not_empty.notify_all();
+    }
+
+    /**
+     * \b Returns: whether the pool is closed for submissions.
+     */
+    bool closed()
+    {
+      return closed_.load(memory_order_relaxed);
+    }
+
+    /**
+     * Effects: try to execute one task.
+     * Returns: whether a task has been executed.
+     * Throws: whatever the current task constructor throws or the task() throws.
+     */
+    bool try_executing_one()
+    {
+      worker_data* self = current_worker.get();
+      work* task = self ? self->deque.pop() : 0;
+      if (!task)
+      {
+        task = steal(self);
+      }
+      return task ? execute(task) : false;
+    }
+
+    /**
+     * \b Requires: \c Closure is a model of \c Callable(void()) and a model of \c CopyConstructible/MoveConstructible.
+     *
+     * \b Effects: The specified \c closure will be scheduled for execution at some point in the future.
+     * If invoked closure throws an exception the \c work_stealing_thread_pool will call \c std::terminate, as is the
+     * case with threads.
+     * A closure submitted from one of the worker threads is pushed to the deque of that thread, from which other
+     * workers can steal it.
+     *
+     * \b Synchronization: completion of \c closure on a particular thread happens before destruction of thread's
+     * thread local variables.
+     *
+     * \b Throws: \c sync_queue_is_closed if the thread pool is closed.
+     * Whatever exception that can be throw while storing the closure.
+     */
+
+#if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    template <typename Closure>
+    void submit(Closure & closure)
+    {
+      throw_if_closed();
+      submit_work(new work(closure));
+    }
+#endif
+    void submit(void (*closure)())
+    {
+      throw_if_closed();
+      submit_work(new work(closure));
+    }
+
+    template <typename Closure>
+    void submit(BOOST_THREAD_RV_REF(Closure) closure)
+    {
+      throw_if_closed();
+      work w = boost::move(closure);
+      submit_work(new work(boost::move(w)));
+    }
+
+    /**
+     * \b Requires: This must be called from an scheduled task.
+     *
+     * \b Effects: reschedule functions until pred()
+     */
+    template <typename Pred>
+    bool reschedule_until(Pred const& pred)
+    {
+      do {
+        if ( ! try_executing_one())
+        {
+          return false;
+        }
+      } while (! pred());
+      return true;
+    }
+
+  };
+
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
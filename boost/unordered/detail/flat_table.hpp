@@ -0,0 +1,1147 @@
+
+// Copyright (C) 2013 Daniel James
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNORDERED_DETAIL_FLAT_TABLE_HPP_INCLUDED
+#define BOOST_UNORDERED_DETAIL_FLAT_TABLE_HPP_INCLUDED
+
+#include <boost/config.hpp>
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#pragma once
+#endif
+
+#include <boost/unordered/detail/allocate.hpp>
+#include <boost/unordered/detail/extract_key.hpp>
+#include <boost/unordered/detail/util.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/is_nothrow_move_constructible.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/iterator.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+#include <stdexcept>
+
+// The control bytes of a group are probed with SSE2 instructions, when
+// they are available. Define BOOST_UNORDERED_FLAT_NO_SIMD to use the
+// portable implementation.
+
+#if !defined(BOOST_UNORDERED_FLAT_NO_SIMD) && \
+    (defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BOOST_UNORDERED_FLAT_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace boost { namespace unordered { namespace detail {
+
+    template <typename Types> struct flat_table;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // flat_group
+    //
+    // The control bytes of 16 consecutive slots, which are probed together.
+    // A full slot stores the low 7 bits of the hash value of its element,
+    // the other states have the sign bit set. The control bytes are followed
+    // by a sentinel, which stops iteration at the end of the table.
+
+    struct flat_group
+    {
+        enum {
+            width = 16,
+            empty = -128,
+            deleted = -2,
+            sentinel = -1
+        };
+
+        explicit flat_group(signed char const* ctrl) :
+#if defined(BOOST_UNORDERED_FLAT_SSE2)
+            ctrl_(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl)))
+#else
+            ctrl_(ctrl)
+#endif
+        {}
+
+        // Returns a bit mask of the slots whose control byte is h.
+        unsigned int match(signed char h) const
+        {
+#if defined(BOOST_UNORDERED_FLAT_SSE2)
+            return static_cast<unsigned int>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(h))));
+#else
+            unsigned int mask = 0;
+            for (unsigned int i = 0; i != width; ++i)
+                if (ctrl_[i] == h) mask |= 1u << i;
+            return mask;
+#endif
+        }
+
+        unsigned int match_empty() const
+        {
+            return match(static_cast<signed char>(empty));
+        }
+
+        // Empty and deleted are the only states less than the sentinel.
+        unsigned int match_empty_or_deleted() const
+        {
+#if defined(BOOST_UNORDERED_FLAT_SSE2)
+            return static_cast<unsigned int>(_mm_movemask_epi8(
+                _mm_cmpgt_epi8(
+                    _mm_set1_epi8(static_cast<char>(sentinel)), ctrl_)));
+#else
+            unsigned int mask = 0;
+            for (unsigned int i = 0; i != width; ++i)
+                if (ctrl_[i] < sentinel) mask |= 1u << i;
+            return mask;
+#endif
+        }
+
+    private:
+#if defined(BOOST_UNORDERED_FLAT_SSE2)
+        __m128i ctrl_;
+#else
+        signed char const* ctrl_;
+#endif
+    };
+
+    inline unsigned int flat_first_bit(unsigned int mask)
+    {
+        BOOST_ASSERT(mask);
+#if defined(__GNUC__)
+        return static_cast<unsigned int>(__builtin_ctz(mask));
+#else
+        unsigned int n = 0;
+        while (!(mask & 1u)) { mask >>= 1; ++n; }
+        return n;
+#endif
+    }
+
+    // The low 7 bits of the hash value are stored in the control byte and
+    // the rest selects the first group to probe. Hash functions such as
+    // boost::hash for integers don't distribute their bits, so they are
+    // mixed first (fibonacci hashing).
+
+    inline std::size_t flat_mix(std::size_t h)
+    {
+        h *= static_cast<std::size_t>(0x9E3779B97F4A7C15ull);
+        return h ^ (h >> (sizeof(std::size_t) * 4));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // flat_value_holder
+    //
+    // Temporary storage for a value that has to be constructed before its
+    // position in the table is known.
+
+    template <typename Alloc>
+    struct flat_value_holder
+    {
+        typedef typename boost::unordered::detail::allocator_traits<Alloc>::
+            value_type value_type;
+
+        explicit flat_value_holder(Alloc& a) : alloc_(a), constructed_(false)
+        {}
+
+        ~flat_value_holder()
+        {
+            if (constructed_)
+                boost::unordered::detail::func::destroy_value_impl(alloc_,
+                    value_ptr());
+        }
+
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        void construct(BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+            BOOST_ASSERT(!constructed_);
+            boost::unordered::detail::func::construct_value_impl(alloc_,
+                value_ptr(), BOOST_UNORDERED_EMPLACE_FORWARD);
+            constructed_ = true;
+        }
+
+        value_type& value()
+        {
+            BOOST_ASSERT(constructed_);
+            return *value_ptr();
+        }
+
+    private:
+
+        value_type* value_ptr()
+        {
+            return static_cast<value_type*>(static_cast<void*>(&storage_));
+        }
+
+        Alloc& alloc_;
+        bool constructed_;
+        typename boost::aligned_storage<sizeof(value_type),
+            boost::alignment_of<value_type>::value>::type storage_;
+
+        flat_value_holder(flat_value_holder const&);
+        flat_value_holder& operator=(flat_value_holder const&);
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Types
+    //
+    // The allocator, value and key types of the flat containers.
+
+    template <typename A, typename T, typename H, typename P>
+    struct flat_set
+    {
+        typedef boost::unordered::detail::flat_set<A, T, H, P> types;
+
+        typedef T value_type;
+        typedef H hasher;
+        typedef P key_equal;
+        typedef T key_type;
+
+        typedef typename boost::unordered::detail::rebind_wrap<
+            A, value_type>::type allocator;
+        typedef boost::unordered::detail::allocator_traits<allocator> traits;
+
+        typedef boost::unordered::detail::flat_table<types> table;
+        typedef boost::unordered::detail::set_extractor<value_type> extractor;
+    };
+
+    template <typename A, typename K, typename M, typename H, typename P>
+    struct flat_map
+    {
+        typedef boost::unordered::detail::flat_map<A, K, M, H, P> types;
+
+        typedef std::pair<K const, M> value_type;
+        typedef H hasher;
+        typedef P key_equal;
+        typedef K key_type;
+
+        typedef typename boost::unordered::detail::rebind_wrap<
+            A, value_type>::type allocator;
+        typedef boost::unordered::detail::allocator_traits<allocator> traits;
+
+        typedef boost::unordered::detail::flat_table<types> table;
+        typedef boost::unordered::detail::map_extractor<key_type, value_type>
+            extractor;
+    };
+}}}
+
+namespace boost { namespace unordered { namespace iterator_detail {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Iterators
+    //
+    // An iterator points to a slot and its control byte. Incrementing it
+    // skips the empty and deleted slots, until it reaches a full slot or
+    // the sentinel.
+
+    template <typename Value> struct flat_c_iterator;
+
+    template <typename Value>
+    struct flat_iterator
+        : public boost::iterator<
+            std::forward_iterator_tag,
+            Value,
+            std::ptrdiff_t,
+            Value*,
+            Value&>
+    {
+#if !defined(BOOST_NO_MEMBER_TEMPLATE_FRIENDS)
+        template <typename>
+        friend struct boost::unordered::iterator_detail::flat_c_iterator;
+        template <typename>
+        friend struct boost::unordered::detail::flat_table;
+    private:
+#endif
+        signed char const* ctrl_;
+        Value* slot_;
+
+    public:
+
+        flat_iterator() BOOST_NOEXCEPT : ctrl_(), slot_() {}
+
+        flat_iterator(signed char const* c, Value* s) BOOST_NOEXCEPT :
+            ctrl_(c), slot_(s) {}
+
+        Value& operator*() const {
+            return *slot_;
+        }
+
+        Value* operator->() const {
+            return slot_;
+        }
+
+        flat_iterator& operator++() {
+            do {
+                ++ctrl_;
+                ++slot_;
+            } while (*ctrl_ < boost::unordered::detail::flat_group::sentinel);
+            return *this;
+        }
+
+        flat_iterator operator++(int) {
+            flat_iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(flat_iterator const& x) const BOOST_NOEXCEPT {
+            return slot_ == x.slot_;
+        }
+
+        bool operator!=(flat_iterator const& x) const BOOST_NOEXCEPT {
+            return slot_ != x.slot_;
+        }
+    };
+
+    template <typename Value>
+    struct flat_c_iterator
+        : public boost::iterator<
+            std::forward_iterator_tag,
+            Value,
+            std::ptrdiff_t,
+            Value const*,
+            Value const&>
+    {
+#if !defined(BOOST_NO_MEMBER_TEMPLATE_FRIENDS)
+        template <typename>
+        friend struct boost::unordered::detail::flat_table;
+    private:
+#endif
+        signed char const* ctrl_;
+        Value* slot_;
+
+    public:
+
+        flat_c_iterator() BOOST_NOEXCEPT : ctrl_(), slot_() {}
+
+        flat_c_iterator(signed char const* c, Value* s) BOOST_NOEXCEPT :
+            ctrl_(c), slot_(s) {}
+
+        flat_c_iterator(flat_iterator<Value> const& x) BOOST_NOEXCEPT :
+            ctrl_(x.ctrl_), slot_(x.slot_) {}
+
+        Value const& operator*() const {
+            return *slot_;
+        }
+
+        Value const* operator->() const {
+            return slot_;
+        }
+
+        flat_c_iterator& operator++() {
+            do {
+                ++ctrl_;
+                ++slot_;
+            } while (*ctrl_ < boost::unordered::detail::flat_group::sentinel);
+            return *this;
+        }
+
+        flat_c_iterator operator++(int) {
+            flat_c_iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(flat_c_iterator const& x,
+                flat_c_iterator const& y) BOOST_NOEXCEPT {
+            return x.slot_ == y.slot_;
+        }
+
+        friend bool operator!=(flat_c_iterator const& x,
+                flat_c_iterator const& y) BOOST_NOEXCEPT {
+            return x.slot_ != y.slot_;
+        }
+    };
+}}}
+
+namespace boost { namespace unordered { namespace detail {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // flat_table
+    //
+    // An open addressing hash table, which stores its elements in an array
+    // of slots and a control byte for each slot in a separate array. The
+    // number of slots is a power of two, at least a group. A key is looked
+    // up by probing the groups in a quadratic sequence, comparing the
+    // control bytes of a whole group with the hash value at once, until
+    // a group with an empty slot is found.
+    //
+    // An erased slot is marked as deleted, unless its group has an empty
+    // slot, so that the probe sequences of other elements aren't broken.
+    // The table is rehashed when the full and deleted slots reach 7/8 of
+    // the slots: at the same size if more than half of them are deleted,
+    // otherwise at twice the size.
+
+    template <typename Types>
+    struct flat_table
+    {
+        typedef typename Types::hasher hasher;
+        typedef typename Types::key_equal key_equal;
+        typedef typename Types::key_type key_type;
+        typedef typename Types::extractor extractor;
+        typedef typename Types::value_type value_type;
+        typedef typename Types::table table_impl;
+
+        typedef typename Types::allocator value_allocator;
+        typedef typename Types::traits value_allocator_traits;
+        typedef typename value_allocator_traits::pointer value_pointer;
+
+        typedef typename boost::unordered::detail::rebind_wrap<
+            value_allocator, signed char>::type ctrl_allocator;
+        typedef boost::unordered::detail::allocator_traits<ctrl_allocator>
+            ctrl_allocator_traits;
+        typedef typename ctrl_allocator_traits::pointer ctrl_pointer;
+
+        typedef boost::unordered::detail::compressed<hasher, key_equal>
+            functions;
+        typedef boost::unordered::detail::flat_group group;
+
+        typedef boost::unordered::iterator_detail::
+            flat_iterator<value_type> iterator;
+        typedef boost::unordered::iterator_detail::
+            flat_c_iterator<value_type> c_iterator;
+
+        typedef std::pair<iterator, bool> emplace_return;
+
+        static const std::size_t npos = static_cast<std::size_t>(-1);
+
+        static const bool nothrow_move_constructible =
+                boost::is_nothrow_move_constructible<hasher>::value &&
+                boost::is_nothrow_move_constructible<key_equal>::value;
+
+        ////////////////////////////////////////////////////////////////////////
+        // Members
+
+        functions functions_;
+        value_allocator alloc_;
+        ctrl_allocator ctrl_alloc_;
+        value_pointer values_;
+        ctrl_pointer ctrls_;
+        value_type* slots_;
+        signed char* ctrl_;
+        std::size_t capacity_;
+        std::size_t size_;
+        std::size_t growth_left_;
+
+        ////////////////////////////////////////////////////////////////////////
+        // Data access
+
+        value_allocator const& value_alloc() const
+        {
+            return alloc_;
+        }
+
+        hasher const& hash_function() const
+        {
+            return functions_.first();
+        }
+
+        key_equal const& key_eq() const
+        {
+            return functions_.second();
+        }
+
+        std::size_t hash(key_type const& k) const
+        {
+            return boost::unordered::detail::flat_mix(hash_function()(k));
+        }
+
+        std::size_t max_size() const
+        {
+            std::size_t n = value_allocator_traits::max_size(alloc_);
+            return max_load(n);
+        }
+
+        float load_factor() const
+        {
+            return capacity_ ?
+                static_cast<float>(size_) / static_cast<float>(capacity_) : 0;
+        }
+
+        iterator begin() const
+        {
+            if (!size_) return end();
+            iterator it(ctrl_, slots_);
+            if (*ctrl_ < group::sentinel) ++it;
+            return it;
+        }
+
+        iterator end() const
+        {
+            return ctrl_ ? iterator(ctrl_ + capacity_, slots_ + capacity_) :
+                iterator();
+        }
+
+        iterator iterator_at(std::size_t pos) const
+        {
+            return iterator(ctrl_ + pos, slots_ + pos);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Sizing
+
+        static std::size_t max_load(std::size_t capacity)
+        {
+            return capacity - capacity / 8;
+        }
+
+        // The number of slots for a requested number of buckets.
+        static std::size_t capacity_for_buckets(std::size_t n)
+        {
+            if (!n) return 0;
+            std::size_t capacity = group::width;
+            while (capacity < n) capacity *= 2;
+            return capacity;
+        }
+
+        // The number of slots that is needed for size elements.
+        static std::size_t capacity_for_size(std::size_t size)
+        {
+            std::size_t capacity = group::width;
+            while (max_load(capacity) < size) capacity *= 2;
+            return capacity;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // buffer
+        //
+        // The control bytes and slots of a table. Owns them until it's
+        // released, so that the values it holds are destroyed if an
+        // exception is thrown while it's filled.
+
+        struct buffer
+        {
+            flat_table& table_;
+            value_pointer values_;
+            ctrl_pointer ctrls_;
+            value_type* slots_;
+            signed char* ctrl_;
+            std::size_t capacity_;
+
+            buffer(flat_table& t, std::size_t capacity) :
+                table_(t), values_(), ctrls_(), slots_(), ctrl_(),
+                capacity_(capacity)
+            {
+                ctrls_ = ctrl_allocator_traits::allocate(
+                    t.ctrl_alloc_, capacity + 1);
+                ctrl_ = boost::addressof(*ctrls_);
+                std::memset(ctrl_, group::empty, capacity);
+                ctrl_[capacity] = group::sentinel;
+
+                values_ = value_allocator_traits::allocate(
+                    t.alloc_, capacity);
+                slots_ = boost::addressof(*values_);
+            }
+
+            ~buffer()
+            {
+                if (ctrl_) table_.destroy(*this);
+            }
+
+            void release()
+            {
+                ctrl_ = 0;
+            }
+
+        private:
+            buffer(buffer const&);
+            buffer& operator=(buffer const&);
+        };
+
+        template <typename Buffer>
+        void destroy(Buffer& b)
+        {
+            if (!b.ctrl_) return;
+
+            for (std::size_t pos = 0; pos != b.capacity_; ++pos) {
+                if (b.ctrl_[pos] >= 0)
+                    boost::unordered::detail::func::destroy_value_impl(
+                        alloc_, b.slots_ + pos);
+            }
+
+            // The value allocation fails after the control bytes have been
+            // allocated.
+            if (b.slots_)
+                value_allocator_traits::deallocate(alloc_, b.values_,
+                    b.capacity_);
+            ctrl_allocator_traits::deallocate(ctrl_alloc_, b.ctrls_,
+                b.capacity_ + 1);
+        }
+
+        void take(buffer& b, std::size_t size, std::size_t growth_left)
+        {
+            destroy(*this);
+
+            values_ = b.values_;
+            ctrls_ = b.ctrls_;
+            slots_ = b.slots_;
+            ctrl_ = b.ctrl_;
+            capacity_ = b.capacity_;
+            size_ = size;
+            growth_left_ = growth_left;
+
+            b.release();
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Constructors
+
+        flat_table(std::size_t num_buckets,
+                hasher const& hf,
+                key_equal const& eq,
+                value_allocator const& a) :
+            functions_(hf, eq),
+            alloc_(a),
+            ctrl_alloc_(a),
+            values_(),
+            ctrls_(),
+            slots_(),
+            ctrl_(),
+            capacity_(capacity_for_buckets(num_buckets)),
+            size_(0),
+            growth_left_(0)
+        {}
+
+        flat_table(flat_table const& x, value_allocator const& a) :
+            functions_(x.functions_),
+            alloc_(a),
+            ctrl_alloc_(a),
+            values_(),
+            ctrls_(),
+            slots_(),
+            ctrl_(),
+            capacity_(x.capacity_),
+            size_(0),
+            growth_left_(0)
+        {
+            copy_buffer(x);
+        }
+
+        flat_table(flat_table const& x) :
+            functions_(x.functions_),
+            alloc_(value_allocator_traits::
+                select_on_container_copy_construction(x.alloc_)),
+            ctrl_alloc_(alloc_),
+            values_(),
+            ctrls_(),
+            slots_(),
+            ctrl_(),
+            capacity_(x.capacity_),
+            size_(0),
+            growth_left_(0)
+        {
+            copy_buffer(x);
+        }
+
+        flat_table(flat_table& x, boost::unordered::detail::move_tag) :
+            functions_(x.functions_),
+            alloc_(x.alloc_),
+            ctrl_alloc_(x.ctrl_alloc_),
+            values_(x.values_),
+            ctrls_(x.ctrls_),
+            slots_(x.slots_),
+            ctrl_(x.ctrl_),
+            capacity_(x.capacity_),
+            size_(x.size_),
+            growth_left_(x.growth_left_)
+        {
+            x.reset();
+        }
+
+        flat_table(flat_table& x, value_allocator const& a,
+                boost::unordered::detail::move_tag) :
+            functions_(x.functions_),
+            alloc_(a),
+            ctrl_alloc_(a),
+            values_(),
+            ctrls_(),
+            slots_(),
+            ctrl_(),
+            capacity_(x.capacity_),
+            size_(0),
+            growth_left_(0)
+        {
+            if (alloc_ == x.alloc_) {
+                values_ = x.values_;
+                ctrls_ = x.ctrls_;
+                slots_ = x.slots_;
+                ctrl_ = x.ctrl_;
+                size_ = x.size_;
+                growth_left_ = x.growth_left_;
+                x.reset();
+            }
+            else {
+                move_buffer(x);
+            }
+        }
+
+        ~flat_table()
+        {
+            destroy(*this);
+        }
+
+        // Leaves the table without any slots, after its buffer has been
+        // taken by another table.
+        void reset()
+        {
+            values_ = value_pointer();
+            ctrls_ = ctrl_pointer();
+            slots_ = 0;
+            ctrl_ = 0;
+            capacity_ = 0;
+            size_ = 0;
+            growth_left_ = 0;
+        }
+
+        // Copies the elements of x to the same slots of a new buffer, so
+        // that they don't have to be hashed again.
+        void copy_buffer(flat_table const& x)
+        {
+            if (!x.size_) return;
+
+            buffer b(*this, x.capacity_);
+            for (std::size_t pos = 0; pos != x.capacity_; ++pos) {
+                if (x.ctrl_[pos] >= 0)
+                    boost::unordered::detail::func::construct_value_impl(
+                        alloc_, b.slots_ + pos,
+                        BOOST_UNORDERED_EMPLACE_ARGS1(x.slots_[pos]));
+                b.ctrl_[pos] = x.ctrl_[pos];
+            }
+            take(b, x.size_, x.growth_left_);
+        }
+
+        void move_buffer(flat_table& x)
+        {
+            if (!x.size_) return;
+
+            buffer b(*this, x.capacity_);
+            for (std::size_t pos = 0; pos != x.capacity_; ++pos) {
+                if (x.ctrl_[pos] >= 0)
+                    boost::unordered::detail::func::construct_value_impl(
+                        alloc_, b.slots_ + pos,
+                        BOOST_UNORDERED_EMPLACE_ARGS1(
+                            boost::move(x.slots_[pos])));
+                b.ctrl_[pos] = x.ctrl_[pos];
+            }
+            take(b, x.size_, x.growth_left_);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Assignment and swap
+
+        void assign(flat_table const& x)
+        {
+            if (this == &x) return;
+
+            bool propagate = value_allocator_traits::
+                propagate_on_container_copy_assignment::value;
+            flat_table tmp(x, propagate ? x.alloc_ : alloc_);
+            swap_contents(tmp);
+            if (propagate) {
+                boost::swap(alloc_, tmp.alloc_);
+                boost::swap(ctrl_alloc_, tmp.ctrl_alloc_);
+            }
+        }
+
+        void move_assign(flat_table& x)
+        {
+            if (this == &x) return;
+
+            bool propagate = value_allocator_traits::
+                propagate_on_container_move_assignment::value;
+            if (propagate || alloc_ == x.alloc_) {
+                flat_table tmp(x, boost::unordered::detail::move_tag());
+                swap_contents(tmp);
+                if (propagate) {
+                    boost::swap(alloc_, tmp.alloc_);
+                    boost::swap(ctrl_alloc_, tmp.ctrl_alloc_);
+                }
+            }
+            else {
+                flat_table tmp(x, alloc_, boost::unordered::detail::move_tag());
+                swap_contents(tmp);
+            }
+        }
+
+        // According to 23.2.1.8, if propagate_on_container_swap is false the
+        // behaviour is undefined unless the allocators are equal.
+        void swap(flat_table& x)
+        {
+            BOOST_ASSERT(value_allocator_traits::
+                propagate_on_container_swap::value || alloc_ == x.alloc_);
+
+            swap_contents(x);
+            if (value_allocator_traits::propagate_on_container_swap::value) {
+                boost::swap(alloc_, x.alloc_);
+                boost::swap(ctrl_alloc_, x.ctrl_alloc_);
+            }
+        }
+
+        void swap_contents(flat_table& x)
+        {
+            functions_.swap(x.functions_);
+            boost::swap(values_, x.values_);
+            boost::swap(ctrls_, x.ctrls_);
+            boost::swap(slots_, x.slots_);
+            boost::swap(ctrl_, x.ctrl_);
+            boost::swap(capacity_, x.capacity_);
+            boost::swap(size_, x.size_);
+            boost::swap(growth_left_, x.growth_left_);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Lookup
+
+        template <typename Key, typename Pred>
+        std::size_t find_position(std::size_t key_hash, Key const& k,
+                Pred const& eq) const
+        {
+            if (!size_) return npos;
+
+            std::size_t mask = capacity_ / group::width - 1;
+            std::size_t g = (key_hash >> 7) & mask;
+            signed char h = static_cast<signed char>(key_hash & 0x7f);
+
+            for (std::size_t i = 1;; ++i) {
+                std::size_t first = g * group::width;
+                group grp(ctrl_ + first);
+                for (unsigned int m = grp.match(h); m; m &= m - 1) {
+                    std::size_t pos = first + flat_first_bit(m);
+                    if (eq(k, extractor::extract(slots_[pos])))
+                        return pos;
+                }
+                if (grp.match_empty()) return npos;
+                g = (g + i) & mask;
+            }
+        }
+
+        std::size_t find_position(key_type const& k) const
+        {
+            return find_position(hash(k), k, key_eq());
+        }
+
+        iterator find_node(key_type const& k) const
+        {
+            std::size_t pos = find_position(k);
+            return pos == npos ? end() : iterator_at(pos);
+        }
+
+        template <class Key, class Hash, class Pred>
+        iterator generic_find_node(Key const& k, Hash const& hf,
+                Pred const& eq) const
+        {
+            std::size_t pos = find_position(
+                boost::unordered::detail::flat_mix(hf(k)), k, eq);
+            return pos == npos ? end() : iterator_at(pos);
+        }
+
+        std::size_t count(key_type const& k) const
+        {
+            return find_position(k) == npos ? 0 : 1;
+        }
+
+        std::pair<iterator, iterator> equal_range(key_type const& k) const
+        {
+            std::size_t pos = find_position(k);
+            if (pos == npos) return std::make_pair(end(), end());
+            iterator it = iterator_at(pos), next = it;
+            return std::make_pair(it, ++next);
+        }
+
+        value_type& at(key_type const& k) const
+        {
+            std::size_t pos = find_position(k);
+            if (pos == npos)
+                boost::throw_exception(std::out_of_range(
+                    "Unable to find key in unordered_flat_map."));
+            return slots_[pos];
+        }
+
+        bool equals(flat_table const& other) const
+        {
+            if (size_ != other.size_) return false;
+
+            for (iterator it = begin(), last = end(); it != last; ++it) {
+                std::size_t pos =
+                    other.find_position(extractor::extract(*it));
+                if (pos == npos || !(*it == other.slots_[pos]))
+                    return false;
+            }
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Insert
+
+        // The first empty or deleted slot in the probe sequence of a hash
+        // value, there must be one.
+        std::size_t insert_position(std::size_t key_hash) const
+        {
+            std::size_t mask = capacity_ / group::width - 1;
+            std::size_t g = (key_hash >> 7) & mask;
+
+            for (std::size_t i = 1;; ++i) {
+                unsigned int m =
+                    group(ctrl_ + g * group::width).match_empty_or_deleted();
+                if (m) return g * group::width + flat_first_bit(m);
+                g = (g + i) & mask;
+            }
+        }
+
+        void set_full(std::size_t pos, std::size_t key_hash)
+        {
+            if (ctrl_[pos] == group::empty) --growth_left_;
+            ctrl_[pos] = static_cast<signed char>(key_hash & 0x7f);
+            ++size_;
+        }
+
+        // Makes sure that an element can be inserted into an empty or
+        // deleted slot. Has strong exception safety if the hash function
+        // doesn't throw and the elements are copied, not moved.
+        void reserve_for_insert()
+        {
+            if (!ctrl_) {
+                if (!capacity_) capacity_ = capacity_for_size(1);
+                buffer b(*this, capacity_);
+                take(b, 0, max_load(capacity_));
+            }
+            else if (!growth_left_) {
+                rehash_impl(size_ < max_load(capacity_) / 2 ?
+                    capacity_ : capacity_ * 2);
+            }
+        }
+
+        void rehash_impl(std::size_t capacity)
+        {
+            BOOST_ASSERT(capacity >= capacity_for_size(size_));
+
+            buffer b(*this, capacity);
+            std::size_t mask = capacity / group::width - 1;
+
+            for (std::size_t pos = 0; pos != capacity_; ++pos) {
+                if (ctrl_[pos] < 0) continue;
+
+                std::size_t key_hash =
+                    hash(extractor::extract(slots_[pos]));
+                std::size_t g = (key_hash >> 7) & mask;
+                for (std::size_t i = 1;; ++i) {
+                    unsigned int m =
+                        group(b.ctrl_ + g * group::width).match_empty();
+                    if (m) {
+                        std::size_t new_pos =
+                            g * group::width + flat_first_bit(m);
+                        boost::unordered::detail::func::construct_value_impl(
+                            alloc_, b.slots_ + new_pos,
+                            BOOST_UNORDERED_EMPLACE_ARGS1(
+                                boost::move(slots_[pos])));
+                        b.ctrl_[new_pos] =
+                            static_cast<signed char>(key_hash & 0x7f);
+                        break;
+                    }
+                    g = (g + i) & mask;
+                }
+            }
+
+            take(b, size_, max_load(capacity) - size_);
+        }
+
+#if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#   if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+        emplace_return emplace(boost::unordered::detail::emplace_args1<
+                boost::unordered::detail::please_ignore_this_overload> const&)
+        {
+            BOOST_ASSERT(false);
+            return emplace_return(this->begin(), false);
+        }
+#   else
+        emplace_return emplace(
+                boost::unordered::detail::please_ignore_this_overload const&)
+        {
+            BOOST_ASSERT(false);
+            return emplace_return(this->begin(), false);
+        }
+#   endif
+#endif
+
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        emplace_return emplace(BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+            return emplace_impl(
+                extractor::extract(BOOST_UNORDERED_EMPLACE_FORWARD),
+                BOOST_UNORDERED_EMPLACE_FORWARD);
+#else
+            return emplace_impl(
+                extractor::extract(args.a0, args.a1),
+                BOOST_UNORDERED_EMPLACE_FORWARD);
+#endif
+        }
+
+#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+        template <typename A0>
+        emplace_return emplace(
+                boost::unordered::detail::emplace_args1<A0> const& args)
+        {
+            return emplace_impl(extractor::extract(args.a0), args);
+        }
+#endif
+
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        emplace_return emplace_impl(key_type const& k,
+            BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+            std::size_t key_hash = this->hash(k);
+            std::size_t pos = find_position(key_hash, k, key_eq());
+            if (pos != npos) return emplace_return(iterator_at(pos), false);
+
+            // The slot is only marked as full once the value has been
+            // constructed, so nothing needs to be undone if it throws.
+            reserve_for_insert();
+            pos = insert_position(key_hash);
+            boost::unordered::detail::func::construct_value_impl(
+                alloc_, slots_ + pos, BOOST_UNORDERED_EMPLACE_FORWARD);
+            set_full(pos, key_hash);
+            return emplace_return(iterator_at(pos), true);
+        }
+
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        emplace_return emplace_impl(no_key, BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+            // Don't have a key, so construct the value first in order
+            // to be able to lookup the position.
+            flat_value_holder<value_allocator> holder(alloc_);
+            holder.construct(BOOST_UNORDERED_EMPLACE_FORWARD);
+
+            key_type const& k = extractor::extract(holder.value());
+            std::size_t key_hash = this->hash(k);
+            std::size_t pos = find_position(key_hash, k, key_eq());
+            if (pos != npos) return emplace_return(iterator_at(pos), false);
+
+            reserve_for_insert();
+            pos = insert_position(key_hash);
+            boost::unordered::detail::func::construct_value_impl(
+                alloc_, slots_ + pos,
+                BOOST_UNORDERED_EMPLACE_ARGS1(boost::move(holder.value())));
+            set_full(pos, key_hash);
+            return emplace_return(iterator_at(pos), true);
+        }
+
+        value_type& operator[](key_type const& k)
+        {
+            std::size_t key_hash = this->hash(k);
+            std::size_t pos = find_position(key_hash, k, key_eq());
+            if (pos != npos) return slots_[pos];
+
+            reserve_for_insert();
+            pos = insert_position(key_hash);
+            boost::unordered::detail::func::construct_value_impl(
+                alloc_, slots_ + pos,
+                BOOST_UNORDERED_EMPLACE_ARGS3(
+                    boost::unordered::piecewise_construct,
+                    boost::make_tuple(k),
+                    boost::make_tuple()));
+            set_full(pos, key_hash);
+            return slots_[pos];
+        }
+
+        template <class InputIt>
+        void insert_range(InputIt i, InputIt j)
+        {
+            if (i == j) return;
+
+            std::size_t n = size_ + boost::unordered::detail::insert_size(i, j);
+            if (capacity_for_size(n) > capacity_) reserve(n);
+
+            for (; i != j; ++i) emplace(*i);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Erase
+
+        void erase_position(std::size_t pos)
+        {
+            BOOST_ASSERT(ctrl_[pos] >= 0);
+
+            boost::unordered::detail::func::destroy_value_impl(alloc_,
+                slots_ + pos);
+
+            // A probe sequence only continues past a group without empty
+            // slots, so the slot can only be emptied if its group already
+            // has an empty slot.
+            std::size_t first = pos & ~static_cast<std::size_t>(
+                group::width - 1);
+            if (group(ctrl_ + first).match_empty()) {
+                ctrl_[pos] = group::empty;
+                ++growth_left_;
+            }
+            else {
+                ctrl_[pos] = group::deleted;
+            }
+            --size_;
+        }
+
+        iterator erase(c_iterator r)
+        {
+            BOOST_ASSERT(r != c_iterator(end()));
+            std::size_t pos = static_cast<std::size_t>(r.slot_ - slots_);
+            erase_position(pos);
+
+            iterator next = iterator_at(pos);
+            return ++next;
+        }
+
+        iterator erase_range(c_iterator r1, c_iterator r2)
+        {
+            while (r1 != r2) r1 = erase(r1);
+            return iterator(r2.ctrl_, r2.slot_);
+        }
+
+        std::size_t erase_key(key_type const& k)
+        {
+            std::size_t pos = find_position(k);
+            if (pos == npos) return 0;
+            erase_position(pos);
+            return 1;
+        }
+
+        void clear()
+        {
+            if (!ctrl_) return;
+
+            for (std::size_t pos = 0; pos != capacity_; ++pos) {
+                if (ctrl_[pos] >= 0)
+                    boost::unordered::detail::func::destroy_value_impl(
+                        alloc_, slots_ + pos);
+            }
+            std::memset(ctrl_, group::empty, capacity_);
+            size_ = 0;
+            growth_left_ = max_load(capacity_);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Rehash
+
+        void rehash(std::size_t num_buckets)
+        {
+            std::size_t capacity = capacity_for_buckets(num_buckets);
+            if (size_) capacity = (std::max)(capacity, capacity_for_size(size_));
+
+            if (!ctrl_) {
+                capacity_ = capacity;
+            }
+            else if (!capacity) {
+                destroy(*this);
+                reset();
+            }
+            else if (capacity != capacity_) {
+                rehash_impl(capacity);
+            }
+        }
+
+        void reserve(std::size_t size)
+        {
+            rehash(size ? capacity_for_size(size) : 0);
+        }
+    };
+}}}
+
+#endif
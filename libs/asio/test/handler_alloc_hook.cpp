@@ -0,0 +1,207 @@
+//
+// handler_alloc_hook.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/handler_alloc_hook.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/thread.hpp>
+#include <boost/asio/detail/thread_info_base.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+using namespace boost::asio;
+using boost::asio::detail::thread_info_base;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif
+
+#if defined(BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE) \
+  && (BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE == 0)
+const bool cache_enabled = false;
+#else
+const bool cache_enabled = true;
+#endif
+
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+
+struct allocation_counts
+{
+  allocation_counts()
+    : hits(thread_info_base::allocation_hits()),
+      misses(thread_info_base::allocation_misses())
+  {
+  }
+
+  long new_hits() const
+  {
+    return thread_info_base::allocation_hits() - hits;
+  }
+
+  long new_misses() const
+  {
+    return thread_info_base::allocation_misses() - misses;
+  }
+
+  long hits;
+  long misses;
+};
+
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+
+void size_class_test()
+{
+  thread_info_base this_thread;
+
+  // Blocks are reused for any size that rounds up to the same size class.
+  // Without the cache, operator new may or may not return the same block.
+  void* p1 = thread_info_base::allocate(&this_thread, 100);
+  thread_info_base::deallocate(&this_thread, p1, 100);
+  void* p2 = thread_info_base::allocate(&this_thread, 128);
+  if (cache_enabled)
+    BOOST_ASIO_CHECK(p2 == p1);
+
+  // A cached block is not handed out for a different size class.
+  thread_info_base::deallocate(&this_thread, p2, 128);
+  void* p3 = thread_info_base::allocate(&this_thread, 64);
+  BOOST_ASIO_CHECK(p3 != p2);
+  void* p4 = thread_info_base::allocate(&this_thread, 1024);
+  BOOST_ASIO_CHECK(p4 != p2);
+  void* p5 = thread_info_base::allocate(&this_thread, 65);
+  if (cache_enabled)
+    BOOST_ASIO_CHECK(p5 == p2);
+
+  thread_info_base::deallocate(&this_thread, p3, 64);
+  thread_info_base::deallocate(&this_thread, p4, 1024);
+  thread_info_base::deallocate(&this_thread, p5, 65);
+
+  // Blocks freed by another thread go to that thread's cache.
+  thread_info_base other_thread;
+  void* p6 = thread_info_base::allocate(&this_thread, 200);
+  thread_info_base::deallocate(&other_thread, p6, 200);
+  void* p7 = thread_info_base::allocate(&other_thread, 200);
+  if (cache_enabled)
+    BOOST_ASIO_CHECK(p7 == p6);
+  thread_info_base::deallocate(&this_thread, p7, 200);
+}
+
+void statistics_test()
+{
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+  thread_info_base this_thread;
+
+  {
+    allocation_counts counts;
+    void* p = thread_info_base::allocate(&this_thread, 500);
+    thread_info_base::deallocate(&this_thread, p, 500);
+    p = thread_info_base::allocate(&this_thread, 500);
+    thread_info_base::deallocate(&this_thread, p, 500);
+    BOOST_ASIO_CHECK(counts.new_hits() == (cache_enabled ? 1 : 0));
+    BOOST_ASIO_CHECK(counts.new_misses() == (cache_enabled ? 1 : 2));
+  }
+
+  // Blocks larger than 1024 bytes are never cached.
+  {
+    allocation_counts counts;
+    for (int i = 0; i < 3; ++i)
+    {
+      void* p = thread_info_base::allocate(&this_thread, 1025);
+      thread_info_base::deallocate(&this_thread, p, 1025);
+    }
+    BOOST_ASIO_CHECK(counts.new_hits() == 0);
+    BOOST_ASIO_CHECK(counts.new_misses() == 3);
+  }
+
+  // Allocations made without a thread cache are counted as misses.
+  {
+    allocation_counts counts;
+    void* p = thread_info_base::allocate(0, 100);
+    thread_info_base::deallocate(0, p, 100);
+    BOOST_ASIO_CHECK(counts.new_hits() == 0);
+    BOOST_ASIO_CHECK(counts.new_misses() == 1);
+  }
+
+  // The totals include threads that have exited.
+  {
+    allocation_counts counts;
+    {
+      thread_info_base exiting_thread;
+      void* p = thread_info_base::allocate(&exiting_thread, 100);
+      thread_info_base::deallocate(&exiting_thread, p, 100);
+      p = thread_info_base::allocate(&exiting_thread, 100);
+      thread_info_base::deallocate(&exiting_thread, p, 100);
+    }
+    BOOST_ASIO_CHECK(counts.new_hits() == (cache_enabled ? 1 : 0));
+    BOOST_ASIO_CHECK(counts.new_misses() == (cache_enabled ? 1 : 2));
+  }
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+}
+
+void repost(io_service* ios, int* count)
+{
+  if (++(*count) < 1000)
+    ios->post(bindns::bind(repost, ios, count));
+}
+
+void io_service_test()
+{
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+  allocation_counts counts;
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+
+  io_service ios;
+  int count1 = 0;
+  int count2 = 0;
+  ios.post(bindns::bind(repost, &ios, &count1));
+  ios.post(bindns::bind(repost, &ios, &count2));
+
+#if defined(BOOST_ASIO_HAS_THREADS)
+  boost::asio::detail::thread th(bindns::bind(
+        static_cast<std::size_t (io_service::*)()>(&io_service::run), &ios));
+  ios.run();
+  th.join();
+#else // defined(BOOST_ASIO_HAS_THREADS)
+  ios.run();
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
+  BOOST_ASIO_CHECK(count1 == 1000);
+  BOOST_ASIO_CHECK(count2 == 1000);
+
+#if defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+  // Every handler posted from a running handler is allocated by a thread with
+  // a cache, and all but the first few reuse the memory of an earlier handler.
+  BOOST_ASIO_CHECK(counts.new_hits() + counts.new_misses() == 2000);
+  if (cache_enabled)
+    BOOST_ASIO_CHECK(counts.new_hits() > 1900);
+  else
+    BOOST_ASIO_CHECK(counts.new_hits() == 0);
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_ALLOCATION_STATS)
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "handler_alloc_hook",
+  BOOST_ASIO_TEST_CASE(size_class_test)
+  BOOST_ASIO_TEST_CASE(statistics_test)
+  BOOST_ASIO_TEST_CASE(io_service_test)
+)
@@ -17,6 +17,7 @@
 #include <boost/asio/io_service.hpp>
 
 #include <sstream>
+#include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/thread.hpp>
 #include "unit_test.hpp"
 
@@ -38,6 +39,7 @@ using namespace boost::asio;
 namespace bindns = boost;
 #else // defined(BOOST_ASIO_HAS_BOOST_BIND)
 namespace bindns = std;
+using std::placeholders::_1;
 #endif
 
 #if defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
@@ -281,6 +283,142 @@ void io_service_test()
   BOOST_ASIO_CHECK(exception_count == 2);
 }
 
+void post_chain(io_service* ios, int remaining,
+    boost::asio::detail::atomic_count* count)
+{
+  ++(*count);
+  if (remaining > 0)
+  {
+    // Fan out so that some threads build up a backlog of handlers.
+    ios->post(bindns::bind(post_chain, ios, remaining - 1, count));
+    if (remaining % 8 == 0)
+      ios->post(bindns::bind(post_chain, ios, 0, count));
+  }
+}
+
+void io_service_multithread_test()
+{
+  const int num_threads = 8;
+  const int num_chains = 16;
+  const int chain_length = 1000;
+
+  io_service ios(num_threads);
+  boost::asio::detail::atomic_count count(0);
+
+  for (int i = 0; i < num_chains; ++i)
+    ios.post(bindns::bind(post_chain, &ios, chain_length, &count));
+
+  boost::asio::detail::thread* threads[num_threads];
+  for (int i = 0; i < num_threads; ++i)
+    threads[i] = new boost::asio::detail::thread(
+        bindns::bind(io_service_run, &ios));
+  for (int i = 0; i < num_threads; ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+
+  // Every handler must run exactly once, whichever thread runs it.
+  const long expected = num_chains * (chain_length + 1 + chain_length / 8);
+  BOOST_ASIO_CHECK(ios.stopped());
+  BOOST_ASIO_CHECK(count == expected);
+
+  // Handlers posted from a handler running in run_one() must not be lost
+  // when run_one() returns.
+  ios.reset();
+  boost::asio::detail::atomic_count count2(0);
+  ios.post(bindns::bind(post_chain, &ios, 10, &count2));
+  while (ios.run_one())
+    ;
+  BOOST_ASIO_CHECK(count2 == 12);
+}
+
+void handle_timer(const boost::system::error_code& err, int* count)
+{
+  BOOST_ASIO_CHECK(!err);
+  ++(*count);
+}
+
+void io_service_multiple_reactor_test()
+{
+  const int num_reactors = 4;
+  const int num_chains = 16;
+  const int chain_length = 1000;
+  const long expected = num_chains * (chain_length + 1 + chain_length / 8);
+
+  // A single thread runs all of the reactors, and surplus threads wait for a
+  // reactor to become free.
+  const int thread_counts[] = { 1, num_reactors, num_reactors + 2 };
+  for (int t = 0; t < 3; ++t)
+  {
+    const int num_threads = thread_counts[t];
+
+    io_service ios(num_reactors, io_service::round_robin_assignment);
+    boost::asio::detail::atomic_count count(0);
+
+    for (int i = 0; i < num_chains; ++i)
+      ios.post(bindns::bind(post_chain, &ios, chain_length, &count));
+
+    int timer_count = 0;
+    timer t1(ios, chronons::milliseconds(50));
+    t1.async_wait(bindns::bind(handle_timer, _1, &timer_count));
+
+    boost::asio::detail::thread* threads[num_reactors + 2];
+    for (int i = 0; i < num_threads; ++i)
+      threads[i] = new boost::asio::detail::thread(
+          bindns::bind(io_service_run, &ios));
+    for (int i = 0; i < num_threads; ++i)
+    {
+      threads[i]->join();
+      delete threads[i];
+    }
+
+    BOOST_ASIO_CHECK(ios.stopped());
+    BOOST_ASIO_CHECK(count == expected);
+    BOOST_ASIO_CHECK(timer_count == 1);
+  }
+
+  // Handlers posted from a handler running in run_one() must not be lost
+  // when run_one() returns, and nested calls must share the reactor.
+  {
+    io_service ios(num_reactors, io_service::thread_affinity_assignment);
+    boost::asio::detail::atomic_count count(0);
+    ios.post(bindns::bind(post_chain, &ios, 10, &count));
+    while (ios.run_one())
+      ;
+    BOOST_ASIO_CHECK(count == 12);
+
+    ios.reset();
+    int count2 = 5;
+    ios.post(bindns::bind(nested_decrement_to_zero, &ios, &count2));
+    ios.run();
+    BOOST_ASIO_CHECK(count2 == 0);
+  }
+
+  // Threads blocked in their reactors are woken by stop().
+  {
+    io_service ios(num_reactors, io_service::round_robin_assignment);
+    io_service::work w(ios);
+
+    boost::asio::detail::thread* threads[num_reactors];
+    for (int i = 0; i < num_reactors; ++i)
+      threads[i] = new boost::asio::detail::thread(
+          bindns::bind(io_service_run, &ios));
+
+    io_service ios2;
+    timer t2(ios2, chronons::milliseconds(100));
+    t2.wait();
+
+    ios.stop();
+    for (int i = 0; i < num_reactors; ++i)
+    {
+      threads[i]->join();
+      delete threads[i];
+    }
+    BOOST_ASIO_CHECK(ios.stopped());
+  }
+}
+
 class test_service : public boost::asio::io_service::service
 {
 public:
@@ -355,5 +493,7 @@ BOOST_ASIO_TEST_SUITE
 (
   "io_service",
   BOOST_ASIO_TEST_CASE(io_service_test)
+  BOOST_ASIO_TEST_CASE(io_service_multithread_test)
+  BOOST_ASIO_TEST_CASE(io_service_multiple_reactor_test)
   BOOST_ASIO_TEST_CASE(io_service_service_test)
 )
@@ -0,0 +1,246 @@
+//
+// io_service_statistics.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/io_service_statistics.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/detail/thread.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+# include <boost/asio/deadline_timer.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+# include <boost/asio/steady_timer.hpp>
+#endif // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+using namespace boost::asio;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+#endif
+
+#if defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+typedef deadline_timer timer;
+namespace chronons = boost::posix_time;
+#elif defined(BOOST_ASIO_HAS_STD_CHRONO)
+typedef steady_timer timer;
+namespace chronons = std::chrono;
+#elif defined(BOOST_ASIO_HAS_BOOST_CHRONO)
+typedef steady_timer timer;
+namespace chronons = boost::chrono;
+#endif // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void sleep_increment(io_service* ios, int* count)
+{
+  timer t(*ios, chronons::milliseconds(2));
+  t.wait();
+
+  ++(*count);
+}
+
+void timer_handler(const boost::system::error_code&, int* count)
+{
+  ++(*count);
+}
+
+void read_statistics(io_service* ios, int* count)
+{
+  for (int i = 0; i < 1000; ++i)
+  {
+    io_service_statistics stats(*ios);
+    if (stats.handlers_executed() <= stats.handlers_queued())
+      ++(*count);
+  }
+}
+
+uint64_t histogram_total(const io_service_statistics& stats)
+{
+  uint64_t total = 0;
+  for (std::size_t i = 0; i < stats.histogram_buckets; ++i)
+    total += stats.handler_histogram(i);
+  return total;
+}
+
+uint64_t histogram_total(const io_service_statistics& stats,
+    io_service_statistics::operation_type type)
+{
+  uint64_t total = 0;
+  for (std::size_t i = 0; i < stats.histogram_buckets; ++i)
+    total += stats.operation_histogram(type, i);
+  return total;
+}
+
+void io_service_statistics_test()
+{
+  io_service ios;
+  int count = 0;
+
+  io_service_statistics stats(ios);
+  BOOST_ASIO_CHECK(stats.handlers_queued() == 0);
+  BOOST_ASIO_CHECK(stats.handlers_executed() == 0);
+  BOOST_ASIO_CHECK(stats.queue_depth() == 0);
+  BOOST_ASIO_CHECK(histogram_total(stats) == 0);
+
+  for (int i = 0; i < 10; ++i)
+    ios.post(bindns::bind(increment, &count));
+  ios.post(bindns::bind(sleep_increment, &ios, &count));
+
+  stats = io_service_statistics(ios);
+#if defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+  BOOST_ASIO_CHECK(stats.handlers_queued() == 11);
+  BOOST_ASIO_CHECK(stats.queue_depth() == 11);
+#else // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+  BOOST_ASIO_CHECK(stats.handlers_queued() == 0);
+  BOOST_ASIO_CHECK(stats.queue_depth() == 0);
+#endif // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+  BOOST_ASIO_CHECK(stats.handlers_executed() == 0);
+
+  ios.run();
+  BOOST_ASIO_CHECK(count == 11);
+
+  stats = io_service_statistics(ios);
+  BOOST_ASIO_CHECK(stats.queue_depth() == 0);
+  BOOST_ASIO_CHECK(histogram_total(stats) == stats.handlers_executed());
+#if defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+  BOOST_ASIO_CHECK(stats.handlers_queued() == 11);
+  BOOST_ASIO_CHECK(stats.handlers_executed() == 11);
+  BOOST_ASIO_CHECK(stats.max_handler_usec() >= 1000);
+  BOOST_ASIO_CHECK(stats.handler_usec() >= stats.max_handler_usec());
+
+  uint64_t slow_handlers = 0;
+  for (std::size_t i = 0; i < stats.histogram_buckets; ++i)
+    if (stats.histogram_bucket_limit_usec(i) > 1000)
+      slow_handlers += stats.handler_histogram(i);
+  BOOST_ASIO_CHECK(slow_handlers == 1);
+#else // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+  BOOST_ASIO_CHECK(stats.handlers_executed() == 0);
+  BOOST_ASIO_CHECK(stats.max_handler_usec() == 0);
+#endif // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+}
+
+void io_service_statistics_reactor_test()
+{
+  io_service ios;
+  int count = 0;
+
+  timer t(ios, chronons::milliseconds(10));
+  t.async_wait(bindns::bind(timer_handler, _1, &count));
+
+  ios.run();
+  BOOST_ASIO_CHECK(count == 1);
+
+  io_service_statistics stats(ios);
+  BOOST_ASIO_CHECK(stats.queue_depth() == 0);
+#if defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+  BOOST_ASIO_CHECK(stats.handlers_queued() == 1);
+  BOOST_ASIO_CHECK(stats.handlers_executed() == 1);
+  BOOST_ASIO_CHECK(stats.reactor_waits() > 0);
+  BOOST_ASIO_CHECK(stats.reactor_wait_usec() >= 5000);
+#else // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+  BOOST_ASIO_CHECK(stats.reactor_waits() == 0);
+  BOOST_ASIO_CHECK(stats.reactor_wait_usec() == 0);
+#endif // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+}
+
+void io_service_statistics_operation_type_test()
+{
+  io_service ios;
+  io_service::strand s(ios);
+  int count = 0;
+
+  for (int i = 0; i < 3; ++i)
+    ios.post(bindns::bind(increment, &count));
+  for (int i = 0; i < 2; ++i)
+    s.post(bindns::bind(increment, &count));
+
+  timer t(ios, chronons::milliseconds(1));
+  t.async_wait(bindns::bind(timer_handler, _1, &count));
+
+  ios.run();
+  BOOST_ASIO_CHECK(count == 6);
+
+  typedef io_service_statistics stats_type;
+  stats_type stats(ios);
+#if defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+  BOOST_ASIO_CHECK(stats.operations_completed(stats_type::posted_handlers) == 3);
+  BOOST_ASIO_CHECK(stats.operations_completed(stats_type::strand_handlers) == 2);
+  BOOST_ASIO_CHECK(stats.operations_completed(stats_type::timer_operations) == 1);
+  BOOST_ASIO_CHECK(
+      stats.operations_completed(stats_type::socket_receive_operations) == 0);
+#else // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+  BOOST_ASIO_CHECK(stats.operations_completed(stats_type::posted_handlers) == 0);
+  BOOST_ASIO_CHECK(stats.operations_completed(stats_type::strand_handlers) == 0);
+  BOOST_ASIO_CHECK(stats.operations_completed(stats_type::timer_operations) == 0);
+#endif // defined(BOOST_ASIO_HAS_HANDLER_TYPE_STATISTICS)
+
+  for (int i = 0; i < stats_type::operation_types; ++i)
+  {
+    stats_type::operation_type type = static_cast<stats_type::operation_type>(i);
+    BOOST_ASIO_CHECK(histogram_total(stats, type)
+        == stats.operations_completed(type));
+  }
+}
+
+void io_service_statistics_multithread_test()
+{
+#if defined(BOOST_ASIO_HAS_THREADS)
+  io_service ios;
+  int count = 0;
+  int reads = 0;
+
+  for (int i = 0; i < 10000; ++i)
+    ios.post(bindns::bind(increment, &count));
+
+  boost::asio::detail::thread reader(
+      bindns::bind(read_statistics, &ios, &reads));
+  ios.run();
+  reader.join();
+
+  BOOST_ASIO_CHECK(count == 10000);
+  BOOST_ASIO_CHECK(reads == 1000);
+
+  io_service_statistics stats(ios);
+  BOOST_ASIO_CHECK(stats.queue_depth() == 0);
+  BOOST_ASIO_CHECK(histogram_total(stats) == stats.handlers_executed());
+#if defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+  BOOST_ASIO_CHECK(stats.handlers_executed() == 10000);
+#endif // defined(BOOST_ASIO_HAS_HANDLER_STATISTICS)
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "io_service_statistics",
+  BOOST_ASIO_TEST_CASE(io_service_statistics_test)
+  BOOST_ASIO_TEST_CASE(io_service_statistics_reactor_test)
+  BOOST_ASIO_TEST_CASE(io_service_statistics_operation_type_test)
+  BOOST_ASIO_TEST_CASE(io_service_statistics_multithread_test)
+)
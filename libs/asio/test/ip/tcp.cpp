@@ -19,10 +19,14 @@
 // Test that header file is self-contained.
 #include <boost/asio/ip/tcp.hpp>
 
+#include <cstdio>
 #include <cstring>
+#include <vector>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
+#include <boost/asio/detail/thread.hpp>
 #include "../unit_test.hpp"
 #include "../archetypes/gettable_socket_option.hpp"
 #include "../archetypes/async_result.hpp"
@@ -370,6 +374,12 @@ void test()
     int i12 = socket1.async_send(null_buffers(), in_flags, lazy);
     (void)i12;
 
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    socket1.async_send_file(-1, 0, 0, &send_handler);
+    int i12a = socket1.async_send_file(-1, 0, 0, lazy);
+    (void)i12a;
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
     socket1.receive(buffer(mutable_char_buffer));
     socket1.receive(mutable_buffers);
     socket1.receive(null_buffers());
@@ -614,6 +624,358 @@ void test()
   BOOST_ASIO_CHECK(read_eof_completed);
 }
 
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void handle_send_file(const boost::system::error_code& err,
+    size_t bytes_transferred, boost::system::error_code* out_err,
+    size_t* out_bytes_transferred)
+{
+  *out_err = err;
+  *out_bytes_transferred = bytes_transferred;
+}
+
+#if defined(BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+struct delayed_pipe_writer
+{
+  int fd;
+  const char* data;
+  size_t length;
+
+  void operator()()
+  {
+    // Write the data in two halves, so that the pipe becomes empty again
+    // while the send is in progress.
+    for (size_t half = 0; half < 2; ++half)
+    {
+      ::usleep(100000);
+      size_t written = 0;
+      while (written < length / 2)
+      {
+        ssize_t n = ::write(fd, data + half * (length / 2) + written,
+            length / 2 - written);
+        if (n <= 0)
+          return;
+        written += n;
+      }
+    }
+  }
+};
+
+#endif // defined(BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+void send_file_test()
+{
+  using namespace std; // For memcmp, tmpfile and fwrite.
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+  io_service ios;
+
+  ip::tcp::acceptor acceptor(ios, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ios);
+  ip::tcp::socket server_side_socket(ios);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  // Create a file that is larger than the socket buffers, so that the send
+  // completes in several parts.
+  const size_t file_size = 4 * 1024 * 1024;
+  std::vector<char> file_data(file_size);
+  for (size_t i = 0; i < file_size; ++i)
+    file_data[i] = static_cast<char>(i * 7 + i / 4096);
+  FILE* file = tmpfile();
+  BOOST_ASIO_CHECK(file != 0);
+  if (!file)
+    return;
+  BOOST_ASIO_CHECK(fwrite(&file_data[0], 1, file_size, file) == file_size);
+  fflush(file);
+  int fd = fileno(file);
+
+  // Send a range from the middle of the file.
+
+  const size_t offset = 1000;
+  const size_t length = file_size - 2000;
+  std::vector<char> read_buffer(file_size);
+  boost::system::error_code send_err = error::would_block;
+  size_t bytes_sent = 0;
+  server_side_socket.async_send_file(fd, offset, length,
+      bindns::bind(handle_send_file, _1, _2, &send_err, &bytes_sent));
+
+  boost::system::error_code read_err = error::would_block;
+  size_t bytes_read = 0;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(&read_buffer[0], length),
+      bindns::bind(handle_send_file, _1, _2, &read_err, &bytes_read));
+
+  ios.run();
+  BOOST_ASIO_CHECK(!send_err);
+  BOOST_ASIO_CHECK(bytes_sent == length);
+  BOOST_ASIO_CHECK(!read_err);
+  BOOST_ASIO_CHECK(bytes_read == length);
+  BOOST_ASIO_CHECK(memcmp(&read_buffer[0], &file_data[offset], length) == 0);
+
+  // A send that runs past the end of the file should fail with eof after
+  // sending the remainder of the file.
+
+  send_err = error::would_block;
+  bytes_sent = 0;
+  server_side_socket.async_send_file(fd, file_size - 100, 200,
+      bindns::bind(handle_send_file, _1, _2, &send_err, &bytes_sent));
+
+  read_err = error::would_block;
+  bytes_read = 0;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(&read_buffer[0], 100),
+      bindns::bind(handle_send_file, _1, _2, &read_err, &bytes_read));
+
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(send_err == error::eof);
+  BOOST_ASIO_CHECK(bytes_sent == 100);
+  BOOST_ASIO_CHECK(!read_err);
+  BOOST_ASIO_CHECK(bytes_read == 100);
+  BOOST_ASIO_CHECK(memcmp(&read_buffer[0],
+        &file_data[file_size - 100], 100) == 0);
+
+  fclose(file);
+
+#if defined(BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+  // Send the contents of a pipe.
+
+  int pipe_fds[2];
+  BOOST_ASIO_CHECK(::pipe(pipe_fds) == 0);
+  posix::stream_descriptor pipe_read_end(ios, pipe_fds[0]);
+  posix::stream_descriptor pipe_write_end(ios, pipe_fds[1]);
+  const size_t pipe_length = 4096;
+  boost::asio::write(pipe_write_end,
+      boost::asio::buffer(&file_data[0], pipe_length));
+
+  send_err = error::would_block;
+  bytes_sent = 0;
+  server_side_socket.async_send_file(pipe_read_end, 0, pipe_length,
+      bindns::bind(handle_send_file, _1, _2, &send_err, &bytes_sent));
+
+  read_err = error::would_block;
+  bytes_read = 0;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(&read_buffer[0], pipe_length),
+      bindns::bind(handle_send_file, _1, _2, &read_err, &bytes_read));
+
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(!send_err);
+  BOOST_ASIO_CHECK(bytes_sent == pipe_length);
+  BOOST_ASIO_CHECK(!read_err);
+  BOOST_ASIO_CHECK(bytes_read == pipe_length);
+  BOOST_ASIO_CHECK(memcmp(&read_buffer[0], &file_data[0], pipe_length) == 0);
+
+  // Send from a pipe that starts empty. The send has to wait for the pipe
+  // rather than the socket, which is writable throughout.
+
+  send_err = error::would_block;
+  bytes_sent = 0;
+  server_side_socket.async_send_file(pipe_read_end, 0, pipe_length,
+      bindns::bind(handle_send_file, _1, _2, &send_err, &bytes_sent));
+
+  read_err = error::would_block;
+  bytes_read = 0;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(&read_buffer[0], pipe_length),
+      bindns::bind(handle_send_file, _1, _2, &read_err, &bytes_read));
+
+  delayed_pipe_writer writer = { pipe_fds[1], &file_data[4096], pipe_length };
+  boost::asio::detail::thread writer_thread(writer);
+
+  ios.reset();
+  ios.run();
+  writer_thread.join();
+  BOOST_ASIO_CHECK(!send_err);
+  BOOST_ASIO_CHECK(bytes_sent == pipe_length);
+  BOOST_ASIO_CHECK(!read_err);
+  BOOST_ASIO_CHECK(bytes_read == pipe_length);
+  BOOST_ASIO_CHECK(memcmp(&read_buffer[0],
+        &file_data[4096], pipe_length) == 0);
+
+  // Send more from a pipe than the socket buffers can hold, so that the
+  // socket fills up while there is still data in the pipe.
+
+  server_side_socket.set_option(ip::tcp::socket::send_buffer_size(16384));
+  client_side_socket.set_option(
+      ip::tcp::socket::receive_buffer_size(16384));
+
+  send_err = error::would_block;
+  bytes_sent = 0;
+  server_side_socket.async_send_file(pipe_read_end, 0, file_size,
+      bindns::bind(handle_send_file, _1, _2, &send_err, &bytes_sent));
+
+  read_err = error::would_block;
+  bytes_read = 0;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(&read_buffer[0], file_size),
+      bindns::bind(handle_send_file, _1, _2, &read_err, &bytes_read));
+
+  delayed_pipe_writer large_writer = { pipe_fds[1], &file_data[0], file_size };
+  boost::asio::detail::thread large_writer_thread(large_writer);
+
+  ios.reset();
+  ios.run();
+  large_writer_thread.join();
+  BOOST_ASIO_CHECK(!send_err);
+  BOOST_ASIO_CHECK(bytes_sent == file_size);
+  BOOST_ASIO_CHECK(!read_err);
+  BOOST_ASIO_CHECK(bytes_read == file_size);
+  BOOST_ASIO_CHECK(memcmp(&read_buffer[0], &file_data[0], file_size) == 0);
+
+  // Closing the write end of an empty pipe ends the send with eof.
+
+  send_err = error::would_block;
+  bytes_sent = 0;
+  server_side_socket.async_send_file(pipe_read_end, 0, pipe_length,
+      bindns::bind(handle_send_file, _1, _2, &send_err, &bytes_sent));
+  ios.reset();
+  ios.poll();
+  BOOST_ASIO_CHECK(send_err == error::would_block);
+  pipe_write_end.close();
+
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(send_err == error::eof);
+  BOOST_ASIO_CHECK(bytes_sent == 0);
+#endif // defined(BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+}
+
+void send_file_cancel_test()
+{
+#if defined(BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+  io_service ios;
+
+  ip::tcp::acceptor acceptor(ios, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ios);
+  ip::tcp::socket server_side_socket(ios);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  int pipe_fds[2];
+  BOOST_ASIO_CHECK(::pipe(pipe_fds) == 0);
+  posix::stream_descriptor pipe_read_end(ios, pipe_fds[0]);
+  posix::stream_descriptor pipe_write_end(ios, pipe_fds[1]);
+
+  // Cancelling the socket ends a wait for an empty pipe.
+
+  boost::system::error_code send_err = error::would_block;
+  size_t bytes_sent = 0;
+  server_side_socket.async_send_file(pipe_read_end, 0, 100,
+      bindns::bind(handle_send_file, _1, _2, &send_err, &bytes_sent));
+  ios.poll();
+  BOOST_ASIO_CHECK(send_err == error::would_block);
+
+  // A second send_file on the same socket is rejected.
+
+  boost::system::error_code second_err = error::would_block;
+  size_t second_bytes_sent = 0;
+  server_side_socket.async_send_file(pipe_read_end, 0, 100,
+      bindns::bind(handle_send_file, _1, _2,
+        &second_err, &second_bytes_sent));
+  ios.reset();
+  ios.poll();
+  BOOST_ASIO_CHECK(second_err == error::already_started);
+  BOOST_ASIO_CHECK(send_err == error::would_block);
+
+  server_side_socket.cancel();
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(send_err == error::operation_aborted);
+  BOOST_ASIO_CHECK(bytes_sent == 0);
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+  // The wait follows the socket when it is moved.
+
+  send_err = error::would_block;
+  server_side_socket.async_send_file(pipe_read_end, 0, 100,
+      bindns::bind(handle_send_file, _1, _2, &send_err, &bytes_sent));
+  ios.reset();
+  ios.poll();
+  BOOST_ASIO_CHECK(send_err == error::would_block);
+
+  ip::tcp::socket moved_socket(std::move(server_side_socket));
+  moved_socket.cancel();
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(send_err == error::operation_aborted);
+  server_side_socket = std::move(moved_socket);
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
+  // Closing the socket ends the wait.
+
+  send_err = error::would_block;
+  server_side_socket.async_send_file(pipe_read_end, 0, 100,
+      bindns::bind(handle_send_file, _1, _2, &send_err, &bytes_sent));
+  ios.reset();
+  ios.poll();
+  BOOST_ASIO_CHECK(send_err == error::would_block);
+
+  server_side_socket.close();
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(send_err == error::operation_aborted);
+
+  // So does destroying the socket, after which data written to the pipe is
+  // left in it.
+
+  send_err = error::would_block;
+  {
+    client_side_socket.close();
+    client_side_socket.connect(server_endpoint);
+    ip::tcp::socket socket(ios);
+    acceptor.accept(socket);
+
+    socket.async_send_file(pipe_read_end, 0, 100,
+        bindns::bind(handle_send_file, _1, _2, &send_err, &bytes_sent));
+    ios.reset();
+    ios.poll();
+    BOOST_ASIO_CHECK(send_err == error::would_block);
+  }
+
+  boost::asio::write(pipe_write_end, boost::asio::buffer("x", 1));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(send_err == error::operation_aborted);
+  posix::stream_descriptor::bytes_readable command;
+  pipe_read_end.io_control(command);
+  BOOST_ASIO_CHECK(command.get() == 1);
+#endif // defined(BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+}
+
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
 } // namespace ip_tcp_socket_runtime
 
 //------------------------------------------------------------------------------
@@ -841,6 +1203,102 @@ void test()
       == client_endpoint.port());
 }
 
+void handle_echo_write(const boost::system::error_code& err,
+    std::size_t bytes_transferred)
+{
+  BOOST_ASIO_CHECK(!err);
+  BOOST_ASIO_CHECK(bytes_transferred == 4);
+}
+
+void handle_echo_read(const boost::system::error_code& err,
+    std::size_t bytes_transferred,
+    boost::asio::ip::tcp::socket* socket, char* data)
+{
+  BOOST_ASIO_CHECK(!err);
+  boost::asio::async_write(*socket,
+      boost::asio::buffer(data, bytes_transferred), &handle_echo_write);
+}
+
+void handle_echo_accept(const boost::system::error_code& err,
+    boost::asio::ip::tcp::socket* socket, char* data)
+{
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+  BOOST_ASIO_CHECK(!err);
+  boost::asio::async_read(*socket, boost::asio::buffer(data, 4),
+      bindns::bind(handle_echo_read, _1, _2, socket, data));
+}
+
+void run_io_service(boost::asio::io_service* ios)
+{
+  ios->run();
+}
+
+void multiple_reactor_test()
+{
+  using namespace std; // For memcmp.
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+  const int num_threads = 2;
+  const int num_connections = 8;
+
+  // Accepted sockets are registered with the reactor of the thread that runs
+  // the acceptor.
+  io_service ios(num_threads, io_service::thread_affinity_assignment);
+
+  ip::tcp::acceptor acceptor(ios, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  std::vector<ip::tcp::socket*> server_side_sockets;
+  char data[num_connections][4];
+  for (int i = 0; i < num_connections; ++i)
+  {
+    server_side_sockets.push_back(new ip::tcp::socket(ios));
+    acceptor.async_accept(*server_side_sockets[i],
+        bindns::bind(handle_echo_accept, _1, server_side_sockets[i], data[i]));
+  }
+
+  boost::asio::detail::thread* threads[num_threads];
+  for (int i = 0; i < num_threads; ++i)
+    threads[i] = new boost::asio::detail::thread(
+        bindns::bind(run_io_service, &ios));
+
+  for (int i = 0; i < num_connections; ++i)
+  {
+    ip::tcp::socket client_side_socket(ios);
+    client_side_socket.connect(server_endpoint);
+    const char message[4] = { 'e', 'c', 'h', static_cast<char>('0' + i) };
+    boost::asio::write(client_side_socket, boost::asio::buffer(message));
+    char reply[4] = { 0, 0, 0, 0 };
+    boost::asio::read(client_side_socket, boost::asio::buffer(reply));
+    BOOST_ASIO_CHECK(memcmp(message, reply, 4) == 0);
+  }
+
+  for (int i = 0; i < num_threads; ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+
+  for (int i = 0; i < num_connections; ++i)
+    delete server_side_sockets[i];
+}
+
 } // namespace ip_tcp_acceptor_runtime
 
 //------------------------------------------------------------------------------
@@ -919,7 +1377,12 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(ip_tcp_runtime::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_socket_compile::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_socket_runtime::test)
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  BOOST_ASIO_TEST_CASE(ip_tcp_socket_runtime::send_file_test)
+  BOOST_ASIO_TEST_CASE(ip_tcp_socket_runtime::send_file_cancel_test)
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
   BOOST_ASIO_TEST_CASE(ip_tcp_acceptor_compile::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test)
+  BOOST_ASIO_TEST_CASE(ip_tcp_acceptor_runtime::multiple_reactor_test)
   BOOST_ASIO_TEST_CASE(ip_tcp_resolver_compile::test)
 )
@@ -17,6 +17,7 @@
 #include <boost/asio/ip/udp.hpp>
 
 #include <cstring>
+#include <vector>
 #include <boost/asio/io_service.hpp>
 #include "../unit_test.hpp"
 #include "../archetypes/gettable_socket_option.hpp"
@@ -382,6 +383,31 @@ void test()
     int i28 = socket1.async_receive_from(null_buffers(),
         endpoint, in_flags, lazy);
     (void)i28;
+
+#if !defined(BOOST_ASIO_WINDOWS_RUNTIME) && !defined(BOOST_ASIO_HAS_IOCP)
+    std::size_t sizes[1] = { 0 };
+    socket1.async_send_batch(buffer(mutable_char_buffer),
+        &endpoint, &send_handler);
+    socket1.async_send_batch(buffer(const_char_buffer),
+        &endpoint, in_flags, &send_handler);
+    int i29 = socket1.async_send_batch(buffer(const_char_buffer),
+        &endpoint, lazy);
+    (void)i29;
+    int i30 = socket1.async_send_batch(buffer(const_char_buffer),
+        &endpoint, in_flags, lazy);
+    (void)i30;
+
+    socket1.async_receive_batch(buffer(mutable_char_buffer),
+        &endpoint, sizes, &receive_handler);
+    socket1.async_receive_batch(buffer(mutable_char_buffer),
+        0, sizes, in_flags, &receive_handler);
+    int i31 = socket1.async_receive_batch(buffer(mutable_char_buffer),
+        &endpoint, sizes, lazy);
+    (void)i31;
+    int i32 = socket1.async_receive_batch(buffer(mutable_char_buffer),
+        &endpoint, sizes, in_flags, lazy);
+    (void)i32;
+#endif // !defined(BOOST_ASIO_WINDOWS_RUNTIME) && !defined(BOOST_ASIO_HAS_IOCP)
   }
   catch (std::exception&)
   {
@@ -459,6 +485,201 @@ void test()
   BOOST_ASIO_CHECK(memcmp(send_msg, recv_msg, sizeof(send_msg)) == 0);
 }
 
+#if !defined(BOOST_ASIO_WINDOWS_RUNTIME) && !defined(BOOST_ASIO_HAS_IOCP)
+
+void handle_batch(size_t* total, const boost::system::error_code& err,
+    size_t datagrams)
+{
+  BOOST_ASIO_CHECK(!err);
+  BOOST_ASIO_CHECK(datagrams > 0);
+  *total += datagrams;
+}
+
+void batch_test()
+{
+  using namespace std; // For memcmp, memset and size_t.
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+  const size_t num_msgs = 8;
+
+  io_service ios;
+
+  ip::udp::socket s1(ios, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ios, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  char send_msgs[num_msgs][16];
+  std::vector<const_buffer> send_bufs;
+  ip::udp::endpoint destinations[num_msgs];
+  for (size_t i = 0; i < num_msgs; ++i)
+  {
+    memset(send_msgs[i], 'a' + static_cast<int>(i), sizeof(send_msgs[i]));
+    send_bufs.push_back(buffer(send_msgs[i], i + 1));
+    destinations[i] = s1.local_endpoint();
+  }
+
+  size_t sent = 0;
+  s2.async_send_batch(send_bufs, destinations,
+      bindns::bind(handle_batch, &sent, _1, _2));
+  ios.run();
+
+  BOOST_ASIO_CHECK(sent == num_msgs);
+
+  // All of the datagrams are now queued on the receiving socket, and so should
+  // be received by a single operation.
+  char recv_msgs[num_msgs][16];
+  memset(recv_msgs, 0, sizeof(recv_msgs));
+  std::vector<mutable_buffer> recv_bufs;
+  for (size_t i = 0; i < num_msgs; ++i)
+    recv_bufs.push_back(buffer(recv_msgs[i]));
+  ip::udp::endpoint senders[num_msgs];
+  size_t sizes[num_msgs] = { 0 };
+
+  size_t received = 0;
+  s1.async_receive_batch(recv_bufs, senders, sizes,
+      bindns::bind(handle_batch, &received, _1, _2));
+  ios.reset();
+  ios.run();
+
+  BOOST_ASIO_CHECK(received == num_msgs);
+  for (size_t i = 0; i < received; ++i)
+  {
+    BOOST_ASIO_CHECK(sizes[i] == i + 1);
+    BOOST_ASIO_CHECK(memcmp(send_msgs[i], recv_msgs[i], i + 1) == 0);
+    BOOST_ASIO_CHECK(senders[i] == s2.local_endpoint());
+  }
+
+  // Send on a connected socket without destinations and receive without
+  // sender endpoints.
+  s2.connect(s1.local_endpoint());
+  sent = 0;
+  s2.async_send_batch(send_bufs, 0,
+      bindns::bind(handle_batch, &sent, _1, _2));
+  ios.reset();
+  ios.run();
+
+  BOOST_ASIO_CHECK(sent == num_msgs);
+
+  memset(recv_msgs, 0, sizeof(recv_msgs));
+  received = 0;
+  while (received < num_msgs)
+  {
+    std::vector<mutable_buffer> rest(recv_bufs.begin() + received,
+        recv_bufs.end());
+    size_t n = 0;
+    s1.async_receive_batch(rest, 0, sizes + received,
+        bindns::bind(handle_batch, &n, _1, _2));
+    ios.reset();
+    ios.run();
+    if (n == 0)
+      break;
+    received += n;
+  }
+
+  BOOST_ASIO_CHECK(received == num_msgs);
+  for (size_t i = 0; i < received; ++i)
+  {
+    BOOST_ASIO_CHECK(sizes[i] == i + 1);
+    BOOST_ASIO_CHECK(memcmp(send_msgs[i], recv_msgs[i], i + 1) == 0);
+  }
+
+  // An empty buffer is sent as a zero-length datagram, and the datagrams
+  // that follow it still go to their own destinations.
+  ip::udp::socket r1(ios, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket r2(ios, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket r3(ios, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s3(ios, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  std::vector<const_buffer> mixed_bufs;
+  mixed_bufs.push_back(buffer("A", 1));
+  mixed_bufs.push_back(buffer("", 0));
+  mixed_bufs.push_back(buffer("C", 1));
+  ip::udp::endpoint mixed_destinations[3] = {
+    r1.local_endpoint(), r2.local_endpoint(), r3.local_endpoint() };
+
+  sent = 0;
+  s3.async_send_batch(mixed_bufs, mixed_destinations,
+      bindns::bind(handle_batch, &sent, _1, _2));
+  ios.reset();
+  ios.run();
+
+  BOOST_ASIO_CHECK(sent == 3);
+
+  // The datagrams are already queued, so there is no need to block.
+  r1.non_blocking(true);
+  r2.non_blocking(true);
+  r3.non_blocking(true);
+  char recv_msg[16] = { 0 };
+  ip::udp::endpoint sender;
+  boost::system::error_code ec;
+  BOOST_ASIO_CHECK(r1.receive_from(buffer(recv_msg), sender, 0, ec) == 1);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(recv_msg[0] == 'A');
+  BOOST_ASIO_CHECK(r2.receive_from(buffer(recv_msg), sender, 0, ec) == 0);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(sender == s3.local_endpoint());
+  BOOST_ASIO_CHECK(r3.receive_from(buffer(recv_msg), sender, 0, ec) == 1);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(recv_msg[0] == 'C');
+  r1.non_blocking(false);
+
+  // Likewise an empty receive buffer takes one datagram.
+  std::vector<const_buffer> three_bufs;
+  three_bufs.push_back(buffer("A", 1));
+  three_bufs.push_back(buffer("BB", 2));
+  three_bufs.push_back(buffer("C", 1));
+  ip::udp::endpoint r1_destinations[3] = {
+    r1.local_endpoint(), r1.local_endpoint(), r1.local_endpoint() };
+
+  sent = 0;
+  s3.async_send_batch(three_bufs, r1_destinations,
+      bindns::bind(handle_batch, &sent, _1, _2));
+  ios.reset();
+  ios.run();
+
+  BOOST_ASIO_CHECK(sent == 3);
+
+  char recv_a[16] = { 0 };
+  char recv_c[16] = { 0 };
+  std::vector<mutable_buffer> mixed_recv_bufs;
+  mixed_recv_bufs.push_back(buffer(recv_a));
+  mixed_recv_bufs.push_back(mutable_buffer());
+  mixed_recv_bufs.push_back(buffer(recv_c));
+  size_t mixed_sizes[3] = { 99, 99, 99 };
+
+  received = 0;
+  while (received < 3)
+  {
+    std::vector<mutable_buffer> rest(mixed_recv_bufs.begin() + received,
+        mixed_recv_bufs.end());
+    size_t n = 0;
+    r1.async_receive_batch(rest, 0, mixed_sizes + received,
+        bindns::bind(handle_batch, &n, _1, _2));
+    ios.reset();
+    ios.run();
+    if (n == 0)
+      break;
+    received += n;
+  }
+
+  BOOST_ASIO_CHECK(received == 3);
+  BOOST_ASIO_CHECK(mixed_sizes[0] == 1);
+  BOOST_ASIO_CHECK(recv_a[0] == 'A');
+  BOOST_ASIO_CHECK(mixed_sizes[1] == 0);
+  BOOST_ASIO_CHECK(mixed_sizes[2] == 1);
+  BOOST_ASIO_CHECK(recv_c[0] == 'C');
+}
+
+#endif // !defined(BOOST_ASIO_WINDOWS_RUNTIME) && !defined(BOOST_ASIO_HAS_IOCP)
+
 } // namespace ip_udp_socket_runtime
 
 //------------------------------------------------------------------------------
@@ -535,5 +756,8 @@ BOOST_ASIO_TEST_SUITE
   "ip/udp",
   BOOST_ASIO_TEST_CASE(ip_udp_socket_compile::test)
   BOOST_ASIO_TEST_CASE(ip_udp_socket_runtime::test)
+#if !defined(BOOST_ASIO_WINDOWS_RUNTIME) && !defined(BOOST_ASIO_HAS_IOCP)
+  BOOST_ASIO_TEST_CASE(ip_udp_socket_runtime::batch_test)
+#endif // !defined(BOOST_ASIO_WINDOWS_RUNTIME) && !defined(BOOST_ASIO_HAS_IOCP)
   BOOST_ASIO_TEST_CASE(ip_udp_resolver_compile::test)
 )
@@ -0,0 +1,191 @@
+//
+// send_file.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/thread.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "high_res_clock.hpp"
+
+using boost::asio::ip::tcp;
+
+// Measures the cost of serving a file over a loopback connection, first by
+// reading the file into a buffer and writing the buffer to the socket, and then
+// by using async_send_file so that the data is not copied into user space. A
+// separate thread reads and discards the data at the other end. The CPU time
+// used by the sending thread is reported separately from the elapsed time,
+// since on loopback the receiver's copy is included in the latter.
+
+enum { chunk_size = 64 * 1024 };
+
+// Returns the CPU time used by the calling thread, in microseconds, where the
+// platform is able to report it.
+double thread_cpu_usec()
+{
+#if defined(RUSAGE_THREAD)
+  rusage usage;
+  ::getrusage(RUSAGE_THREAD, &usage);
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000.0
+    + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#else // defined(RUSAGE_THREAD)
+  return 0;
+#endif // defined(RUSAGE_THREAD)
+}
+
+int file_fd;
+std::size_t file_size;
+std::vector<char> chunk(chunk_size);
+
+void drain(tcp::socket* s)
+{
+  std::vector<char> data(chunk_size);
+  boost::system::error_code ec;
+  while (!ec)
+    s->read_some(boost::asio::buffer(data), ec);
+}
+
+class read_write_sender
+{
+public:
+  read_write_sender(tcp::socket& s, int repeats)
+    : socket_(s), offset_(0), repeats_(repeats)
+  {
+  }
+
+  void start()
+  {
+    if (offset_ == file_size)
+    {
+      if (--repeats_ == 0)
+        return;
+      offset_ = 0;
+    }
+
+    std::size_t length = file_size - offset_;
+    if (length > chunk_size)
+      length = chunk_size;
+    ssize_t n = ::pread(file_fd, &chunk[0], length, offset_);
+    if (n <= 0)
+      return;
+    offset_ += n;
+
+    boost::asio::async_write(socket_,
+        boost::asio::buffer(&chunk[0], n), *this);
+  }
+
+  void operator()(const boost::system::error_code& ec, std::size_t)
+  {
+    if (!ec)
+      start();
+  }
+
+private:
+  tcp::socket& socket_;
+  std::size_t offset_;
+  int repeats_;
+};
+
+class send_file_sender
+{
+public:
+  send_file_sender(tcp::socket& s, int repeats)
+    : socket_(s), repeats_(repeats)
+  {
+  }
+
+  void start()
+  {
+    socket_.async_send_file(file_fd, 0, file_size, *this);
+  }
+
+  void operator()(const boost::system::error_code& ec, std::size_t)
+  {
+    if (!ec && --repeats_ > 0)
+      start();
+  }
+
+private:
+  tcp::socket& socket_;
+  int repeats_;
+};
+
+template <typename Sender>
+void run_test(const char* name, int repeats)
+{
+  boost::asio::io_service ios;
+  tcp::acceptor acceptor(ios, tcp::endpoint(tcp::v4(), 0));
+  tcp::endpoint endpoint = acceptor.local_endpoint();
+  endpoint.address(boost::asio::ip::address_v4::loopback());
+
+  tcp::socket client(ios);
+  tcp::socket server(ios);
+  client.connect(endpoint);
+  acceptor.accept(server);
+
+  boost::asio::detail::thread t(
+      boost::asio::detail::bind_handler(drain, &client));
+
+  boost::uint64_t t1 = high_res_clock();
+  double cpu1 = thread_cpu_usec();
+  Sender sender(server, repeats);
+  sender.start();
+  ios.run();
+  double cpu2 = thread_cpu_usec();
+  boost::uint64_t t2 = high_res_clock();
+
+  server.close();
+  t.join();
+
+  double kib = 1.0 * file_size * repeats / 1024;
+  std::printf("%-10s %12.2f %12.3f\n", name,
+      static_cast<double>(t2 - t1) / kib, (cpu2 - cpu1) / kib);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::fprintf(stderr, "Usage: send_file <file> [<repeats>]\n");
+    return 1;
+  }
+
+  int repeats = (argc > 2) ? std::atoi(argv[2]) : 10;
+
+  std::FILE* file = std::fopen(argv[1], "rb");
+  if (!file)
+  {
+    std::fprintf(stderr, "Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::fseek(file, 0, SEEK_END);
+  file_size = std::ftell(file);
+  file_fd = fileno(file);
+  if (file_size == 0 || repeats < 1)
+  {
+    std::fprintf(stderr, "Nothing to send\n");
+    return 1;
+  }
+
+  std::printf("%d transfers of %d bytes, cost per KiB\n",
+      repeats, static_cast<int>(file_size));
+  std::printf("%-10s %12s %12s\n", "method", "elapsed", "sender usec");
+
+  run_test<read_write_sender>("read+write", repeats);
+  run_test<send_file_sender>("send_file", repeats);
+
+  std::fclose(file);
+  return 0;
+}
@@ -0,0 +1,171 @@
+//
+// strand.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "high_res_clock.hpp"
+
+using boost::asio::io_service;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// Measures how long handlers wait to start when many strands are in use and a
+// few of them run slow handlers. A number of fast tokens hop between strands,
+// recording the time between each post and the start of its handler. The slow
+// strands repeatedly run long handlers. Strands that share an implementation
+// with a slow strand are delayed by it, even though they are unrelated.
+
+static const int num_slow_strands = 8;
+static const boost::uint64_t slow_handler_cycles = 1000000;
+static const int num_tokens = 64;
+
+std::vector<io_service::strand*> strands;
+boost::asio::detail::atomic_count tokens_remaining(num_tokens);
+
+void spin(boost::uint64_t cycles)
+{
+  boost::uint64_t start = high_res_clock();
+  while (high_res_clock() - start < cycles)
+    ;
+}
+
+struct fast_handler
+{
+  std::vector<boost::uint64_t>* samples_;
+  std::size_t strand_index_;
+  boost::uint64_t posted_;
+
+  void operator()()
+  {
+    samples_->push_back(high_res_clock() - posted_);
+
+    if (samples_->size() == samples_->capacity())
+    {
+      --tokens_remaining;
+      return;
+    }
+
+    // Move to another fast strand.
+    strand_index_ += 7919;
+    while (strand_index_ >= strands.size())
+      strand_index_ -= strands.size() - num_slow_strands;
+
+    fast_handler h = { samples_, strand_index_, high_res_clock() };
+    strands[strand_index_]->post(h);
+  }
+};
+
+struct slow_handler
+{
+  std::size_t strand_index_;
+
+  void operator()()
+  {
+    if (tokens_remaining == 0)
+      return;
+
+    spin(slow_handler_cycles);
+    strands[strand_index_]->post(*this);
+  }
+};
+
+void run(io_service* ios)
+{
+  ios->run();
+}
+
+int main(int argc, char* argv[])
+{
+  int num_threads = (argc > 1) ? std::atoi(argv[1]) : 16;
+  int num_strands = (argc > 2) ? std::atoi(argv[2]) : 10000;
+  int num_hops = (argc > 3) ? std::atoi(argv[3]) : 20000;
+
+  if (num_threads < 1 || num_strands <= num_slow_strands || num_hops < 1)
+  {
+    std::fprintf(stderr,
+        "Usage: strand [<threads> [<strands> [<hops per token>]]]\n");
+    return 1;
+  }
+
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+  std::printf("Lock-free strands, ");
+#else // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+  std::printf("Hashed strands, ");
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRANDS)
+  std::printf("%d threads, %d strands, %d tokens, %d hops per token\n",
+      num_threads, num_strands, num_tokens, num_hops);
+
+  io_service ios;
+  for (int i = 0; i < num_strands; ++i)
+    strands.push_back(new io_service::strand(ios));
+
+  std::vector<std::vector<boost::uint64_t> > samples(num_tokens);
+  for (int i = 0; i < num_tokens; ++i)
+  {
+    samples[i].reserve(num_hops);
+    fast_handler h = { &samples[i],
+      num_slow_strands + i * (num_strands - num_slow_strands) / num_tokens,
+      high_res_clock() };
+    strands[h.strand_index_]->post(h);
+  }
+
+  for (int i = 0; i < num_slow_strands; ++i)
+  {
+    slow_handler h = { static_cast<std::size_t>(i) };
+    strands[i]->post(h);
+  }
+
+  ptime start = microsec_clock::universal_time();
+  boost::uint64_t start_hr = high_res_clock();
+
+  std::vector<boost::asio::detail::thread*> threads;
+  for (int i = 0; i < num_threads; ++i)
+    threads.push_back(new boost::asio::detail::thread(
+          boost::asio::detail::bind_handler(run, &ios)));
+
+  for (int i = 0; i < num_threads; ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+
+  ptime stop = microsec_clock::universal_time();
+  boost::uint64_t stop_hr = high_res_clock();
+  boost::uint64_t elapsed_usec = (stop - start).total_microseconds();
+  boost::uint64_t elapsed_hr = stop_hr - start_hr;
+  double scale = 1.0 * elapsed_usec / elapsed_hr;
+
+  std::vector<boost::uint64_t> all;
+  for (int i = 0; i < num_tokens; ++i)
+    all.insert(all.end(), samples[i].begin(), samples[i].end());
+  std::sort(all.begin(), all.end());
+  std::size_t n = all.size();
+
+  std::printf("Elapsed %f ms, post to start latency in usec:\n",
+      elapsed_usec / 1000.0);
+  std::printf(" 50.0%%\t%f\n", all[n * 5 / 10 - 1] * scale);
+  std::printf(" 90.0%%\t%f\n", all[n * 9 / 10 - 1] * scale);
+  std::printf(" 99.0%%\t%f\n", all[n * 99 / 100 - 1] * scale);
+  std::printf(" 99.9%%\t%f\n", all[n * 999 / 1000 - 1] * scale);
+  std::printf("100.0%%\t%f\n", all[n - 1] * scale);
+
+  for (int i = 0; i < num_strands; ++i)
+    delete strands[i];
+
+  return 0;
+}
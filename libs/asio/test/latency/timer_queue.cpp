@@ -0,0 +1,136 @@
+//
+// timer_queue.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/deadline_timer_service.hpp>
+#include <boost/asio/time_traits.hpp>
+#include <boost/asio/timer_wheel_traits.hpp>
+#include <boost/asio/detail/timer_wheel.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "high_res_clock.hpp"
+
+using boost::posix_time::ptime;
+using boost::posix_time::milliseconds;
+
+// Time traits that use a manually advanced clock, so that the queues can be
+// measured without waiting for timers to expire.
+struct manual_time_traits : boost::asio::time_traits<ptime>
+{
+  static ptime now()
+  {
+    return current;
+  }
+
+  static ptime current;
+};
+
+ptime manual_time_traits::current(
+    boost::gregorian::date(2013, 1, 1), boost::posix_time::seconds(0));
+
+// An operation that does nothing when it is completed or destroyed.
+class null_op : public boost::asio::detail::wait_op
+{
+public:
+  null_op()
+    : boost::asio::detail::wait_op(&null_op::do_complete)
+  {
+  }
+
+  static void do_complete(boost::asio::detail::io_service_impl*,
+      boost::asio::detail::operation*,
+      const boost::system::error_code&, std::size_t)
+  {
+  }
+};
+
+template <typename Queue>
+void run_test(const char* name, std::size_t num_timers,
+    std::size_t num_rearms, long max_timeout_ms)
+{
+  typedef typename Queue::per_timer_data per_timer_data;
+
+  Queue queue;
+  std::vector<per_timer_data> timers(num_timers);
+  std::vector<null_op> ops(num_timers);
+  boost::asio::detail::op_queue<boost::asio::detail::operation> ready;
+
+  std::srand(0);
+  ptime start = manual_time_traits::current;
+
+  // Arm every timer once.
+  boost::uint64_t t1 = high_res_clock();
+  for (std::size_t i = 0; i < num_timers; ++i)
+  {
+    ptime expiry = start + milliseconds(1 + std::rand() % max_timeout_ms);
+    queue.enqueue_timer(expiry, timers[i], &ops[i]);
+  }
+  boost::uint64_t t2 = high_res_clock();
+
+  // Rearm random timers, as happens to an inactivity timeout whenever a
+  // packet arrives on its connection.
+  for (std::size_t n = 0; n < num_rearms; ++n)
+  {
+    std::size_t i = std::rand() % num_timers;
+    queue.cancel_timer(timers[i], ready);
+    while (boost::asio::detail::operation* op = ready.front())
+      ready.pop(), (void)op;
+    ptime expiry = start + milliseconds(1 + std::rand() % max_timeout_ms);
+    queue.enqueue_timer(expiry, timers[i], &ops[i]);
+  }
+  boost::uint64_t t3 = high_res_clock();
+
+  // Let every timer expire, checking the queue once per millisecond as a
+  // reactor would.
+  std::size_t expired = 0;
+  for (long ms = 0; ms <= max_timeout_ms; ++ms)
+  {
+    manual_time_traits::current = start + milliseconds(ms);
+    queue.wait_duration_usec(5 * 60 * 1000 * 1000);
+    queue.get_ready_timers(ready);
+    while (boost::asio::detail::operation* op = ready.front())
+      ready.pop(), (void)op, ++expired;
+  }
+  boost::uint64_t t4 = high_res_clock();
+
+  manual_time_traits::current = start;
+
+  std::printf("%-6s %8d %12.1f %12.1f %12.1f %s\n", name,
+      static_cast<int>(num_timers),
+      static_cast<double>(t2 - t1) / num_timers,
+      static_cast<double>(t3 - t2) / num_rearms,
+      static_cast<double>(t4 - t3) / num_timers,
+      expired == num_timers ? "" : "(missed timers)");
+}
+
+int main(int argc, char* argv[])
+{
+  long max_timeout_ms = (argc > 1) ? std::atol(argv[1]) : 30000;
+  std::size_t num_rearms = (argc > 2) ? std::atol(argv[2]) : 1000000;
+
+  std::printf("Timeouts up to %ld ms, %d rearms, "
+      "high_res_clock units per operation\n",
+      max_timeout_ms, static_cast<int>(num_rearms));
+  std::printf("%-6s %8s %12s %12s %12s\n",
+      "queue", "timers", "arm", "rearm", "expire");
+
+  typedef boost::asio::detail::timer_queue<manual_time_traits> heap_queue;
+  typedef boost::asio::detail::timer_queue<
+    boost::asio::timer_wheel_traits<manual_time_traits> > wheel_queue;
+
+  static const std::size_t sizes[] = { 10000, 100000, 1000000 };
+  for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    run_test<heap_queue>("heap", sizes[i], num_rearms, max_timeout_ms);
+    run_test<wheel_queue>("wheel", sizes[i], num_rearms, max_timeout_ms);
+  }
+
+  return 0;
+}
@@ -210,8 +210,72 @@ void strand_test()
   BOOST_ASIO_CHECK(count == 0);
 }
 
+void strand_copy_test()
+{
+  io_service ios;
+  int count = 0;
+
+  // Handlers posted through copies of a strand are run through the same
+  // strand, even when the original strand object no longer exists.
+  strand* s1 = new strand(ios);
+  strand s2(*s1);
+  s1->post(bindns::bind(increment_with_lock, &s2, &count));
+  s2.post(bindns::bind(increment_with_lock, &s2, &count));
+  delete s1;
+  s2.post(bindns::bind(increment_with_lock, &s2, &count));
+
+  {
+    strand s3(s2);
+    s3.post(bindns::bind(increment_with_lock, &s2, &count));
+  }
+
+  // No handlers can be called until run() is called.
+  BOOST_ASIO_CHECK(count == 0);
+
+  ios.run();
+
+  // The run() call will not return until all work has finished.
+  BOOST_ASIO_CHECK(count == 4);
+
+  count = 0;
+  ios.reset();
+
+  // Handlers posted through an orphaned strand are still run.
+  {
+    strand s4(ios);
+    s4.post(bindns::bind(increment, &count));
+    s4.post(bindns::bind(increment, &count));
+  }
+
+  ios.run();
+
+  BOOST_ASIO_CHECK(count == 2);
+}
+
+void strand_outlives_io_service_test()
+{
+  int count = 0;
+
+  // A strand may be destroyed after its io_service, whether or not it has
+  // handlers pending.
+  io_service* ios = new io_service;
+  strand* s1 = new strand(*ios);
+  strand* s2 = new strand(*s1);
+  strand* s3 = new strand(*ios);
+  s1->post(bindns::bind(increment, &count));
+  delete ios;
+  delete s1;
+  delete s3;
+  delete s2;
+
+  // The handler is destroyed without being called.
+  BOOST_ASIO_CHECK(count == 0);
+}
+
 BOOST_ASIO_TEST_SUITE
 (
   "strand",
   BOOST_ASIO_TEST_CASE(strand_test)
+  BOOST_ASIO_TEST_CASE(strand_copy_test)
+  BOOST_ASIO_TEST_CASE(strand_outlives_io_service_test)
 )
@@ -0,0 +1,182 @@
+//
+// timer_wheel_traits.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/timer_wheel_traits.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+
+#include <cstdlib>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/asio/basic_deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/time_traits.hpp>
+
+using namespace boost::posix_time;
+
+typedef boost::asio::basic_deadline_timer<ptime,
+    boost::asio::timer_wheel_traits<boost::asio::time_traits<ptime> > >
+  wheel_timer;
+
+ptime now()
+{
+  return boost::asio::time_traits<ptime>::now();
+}
+
+void record_order(std::vector<int>* order, int id,
+    const boost::system::error_code& ec)
+{
+  if (!ec)
+    order->push_back(id);
+}
+
+void check_not_early(wheel_timer* t, int* count, int* aborted,
+    const boost::system::error_code& ec)
+{
+  if (ec == boost::asio::error::operation_aborted)
+  {
+    ++(*aborted);
+  }
+  else
+  {
+    BOOST_ASIO_CHECK(!ec);
+    BOOST_ASIO_CHECK(!(now() < t->expires_at()));
+    ++(*count);
+  }
+}
+
+void count_aborted(int* count, const boost::system::error_code& ec)
+{
+  if (ec == boost::asio::error::operation_aborted)
+    ++(*count);
+}
+
+void timer_wheel_order_test()
+{
+  boost::asio::io_service ios;
+  std::vector<int> order;
+
+  ptime start = now();
+
+  wheel_timer t1(ios, start + milliseconds(30));
+  t1.async_wait(boost::bind(record_order, &order, 3, _1));
+  wheel_timer t2(ios, start + milliseconds(10));
+  t2.async_wait(boost::bind(record_order, &order, 1, _1));
+  wheel_timer t3(ios, start + milliseconds(20));
+  t3.async_wait(boost::bind(record_order, &order, 2, _1));
+  wheel_timer t4(ios, start - milliseconds(10));
+  t4.async_wait(boost::bind(record_order, &order, 0, _1));
+
+  ios.run();
+
+  BOOST_ASIO_CHECK(order.size() == 4);
+  for (std::size_t i = 0; i < order.size(); ++i)
+    BOOST_ASIO_CHECK(order[i] == static_cast<int>(i));
+
+  // The timers must not complete before their expiry time.
+  BOOST_ASIO_CHECK(!(now() < start + milliseconds(30)));
+
+  // A timer that expires after the first rotation of the wheel's lowest level
+  // must be moved down a level before it completes.
+  start = now();
+  t1.expires_at(start + milliseconds(150));
+  t1.wait();
+  BOOST_ASIO_CHECK(!(now() < start + milliseconds(150)));
+}
+
+void timer_wheel_cancel_test()
+{
+  boost::asio::io_service ios;
+  int aborted = 0;
+  std::vector<int> order;
+
+  wheel_timer t1(ios, seconds(60));
+  t1.async_wait(boost::bind(count_aborted, &aborted, _1));
+  t1.async_wait(boost::bind(count_aborted, &aborted, _1));
+  wheel_timer t2(ios, hours(24 * 365 * 5));
+  t2.async_wait(boost::bind(count_aborted, &aborted, _1));
+  wheel_timer t3(ios, ptime(pos_infin));
+  t3.async_wait(boost::bind(count_aborted, &aborted, _1));
+  wheel_timer t4(ios, milliseconds(20));
+  t4.async_wait(boost::bind(record_order, &order, 0, _1));
+
+  BOOST_ASIO_CHECK(t1.cancel_one() == 1);
+  BOOST_ASIO_CHECK(t1.cancel() == 1);
+  BOOST_ASIO_CHECK(t1.cancel() == 0);
+  BOOST_ASIO_CHECK(t2.cancel() == 1);
+  BOOST_ASIO_CHECK(t3.cancel() == 1);
+
+  ios.run();
+
+  BOOST_ASIO_CHECK(aborted == 4);
+  BOOST_ASIO_CHECK(order.size() == 1);
+}
+
+void timer_wheel_rearm_test()
+{
+  boost::asio::io_service ios;
+
+  const int num_timers = 2000;
+  std::vector<wheel_timer*> timers;
+  int count = 0;
+  int aborted = 0;
+
+  // Start many timers and then move each of them a number of times, as would
+  // be done for per-connection inactivity timeouts.
+  for (int i = 0; i < num_timers; ++i)
+  {
+    timers.push_back(new wheel_timer(ios));
+    timers.back()->expires_from_now(seconds(30 + i % 30));
+    timers.back()->async_wait(boost::bind(count_aborted, &aborted, _1));
+  }
+
+  for (int n = 0; n < 3; ++n)
+  {
+    for (int i = 0; i < num_timers; ++i)
+    {
+      wheel_timer* t = timers[i];
+      t->expires_from_now(milliseconds(std::rand() % 250));
+      t->async_wait(boost::bind(check_not_early, t, &count, &aborted, _1));
+      if (n < 2)
+        t->cancel();
+    }
+  }
+
+  ios.run();
+
+  BOOST_ASIO_CHECK(count == num_timers);
+  BOOST_ASIO_CHECK(aborted == 3 * num_timers);
+
+  for (int i = 0; i < num_timers; ++i)
+    delete timers[i];
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "timer_wheel_traits",
+  BOOST_ASIO_TEST_CASE(timer_wheel_order_test)
+  BOOST_ASIO_TEST_CASE(timer_wheel_cancel_test)
+  BOOST_ASIO_TEST_CASE(timer_wheel_rearm_test)
+)
+#else // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+BOOST_ASIO_TEST_SUITE
+(
+  "timer_wheel_traits",
+  BOOST_ASIO_TEST_CASE(null_test)
+)
+#endif // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
@@ -1882,6 +1882,70 @@ void test_3_arg_vector_buffers_async_write()
   BOOST_ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
 }
 
+void test_3_arg_long_vector_buffers_async_write()
+{
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+  boost::asio::io_service ios;
+  test_stream s(ios);
+  std::vector<boost::asio::const_buffer> buffers;
+  for (size_t i = 0; i < 100; ++i)
+    buffers.push_back(boost::asio::const_buffer());
+  for (size_t i = 0; i < 3 * sizeof(write_data); ++i)
+  {
+    buffers.push_back(boost::asio::buffer(write_data + i % sizeof(write_data), 1));
+    buffers.push_back(boost::asio::const_buffer());
+  }
+
+  s.reset();
+  bool called = false;
+  boost::asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, 3 * sizeof(write_data), &called));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(s.check_buffers(buffers, 3 * sizeof(write_data)));
+
+  s.reset();
+  s.next_write_length(1);
+  called = false;
+  boost::asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, 3 * sizeof(write_data), &called));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(s.check_buffers(buffers, 3 * sizeof(write_data)));
+
+  s.reset();
+  s.next_write_length(10);
+  called = false;
+  boost::asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, 3 * sizeof(write_data), &called));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(s.check_buffers(buffers, 3 * sizeof(write_data)));
+
+  s.reset();
+  called = false;
+  boost::asio::async_write(s, buffers, boost::asio::transfer_at_least(1),
+      bindns::bind(async_write_handler,
+        _1, _2, 64, &called));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(s.check_buffers(buffers, 64));
+}
+
 void test_3_arg_streambuf_async_write()
 {
 #if defined(BOOST_ASIO_HAS_BOOST_BIND)
@@ -3904,6 +3968,7 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(test_3_arg_boost_array_buffers_async_write)
   BOOST_ASIO_TEST_CASE(test_3_arg_std_array_buffers_async_write)
   BOOST_ASIO_TEST_CASE(test_3_arg_vector_buffers_async_write)
+  BOOST_ASIO_TEST_CASE(test_3_arg_long_vector_buffers_async_write)
   BOOST_ASIO_TEST_CASE(test_3_arg_streambuf_async_write)
   BOOST_ASIO_TEST_CASE(test_4_arg_const_buffers_1_async_write)
   BOOST_ASIO_TEST_CASE(test_4_arg_mutable_buffers_1_async_write)
@@ -0,0 +1,198 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2013-2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "boost/container/map.hpp"
+#include "boost/container/flat_map.hpp"
+#include "boost/container/btree_map.hpp"
+#include <vector>
+#include <iostream>
+#include <boost/timer/timer.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+using boost::timer::cpu_timer;
+using boost::timer::cpu_times;
+using boost::timer::nanosecond_type;
+
+//Insertions in random order are quadratic for flat_map, so the number of
+//values is kept moderate and the searches and scans are repeated instead
+#ifdef NDEBUG
+static const std::size_t N = 100000;
+static const std::size_t Repetitions = 20;
+#else
+static const std::size_t N = 10000;
+static const std::size_t Repetitions = 2;
+#endif
+
+std::vector<int> random_unique_range;
+std::vector<int> random_search_range;
+
+void fill_ranges()
+{
+   random_unique_range.resize(N);
+   for(std::size_t i = 0; i != N; ++i){
+      random_unique_range[i] = static_cast<int>(i*2);
+   }
+   std::srand(0);
+   std::random_shuffle(random_unique_range.begin(), random_unique_range.end());
+   //Half of the searched keys are not in the container
+   random_search_range.resize(N);
+   for(std::size_t i = 0; i != N; ++i){
+      random_search_range[i] = std::rand() % static_cast<int>(N*2);
+   }
+}
+
+void compare_times(cpu_times time_numerator, cpu_times time_denominator){
+   std::cout << "----------------------------------------------" << '\n';
+   std::cout << " wall        = " << ((double)time_numerator.wall/(double)time_denominator.wall) << std::endl;
+   std::cout << "----------------------------------------------" << '\n' << std::endl;
+}
+
+template<typename T>
+cpu_times insert_time()
+{
+   cpu_timer insert_timer, hint_timer;
+   insert_timer.stop(); hint_timer.stop();
+
+   {
+      insert_timer.resume();
+      T t;
+      for(std::size_t i = 0; i != N; ++i){
+         t.insert(typename T::value_type(random_unique_range[i], 0));
+      }
+      insert_timer.stop();
+   }
+   {
+      //Sorted insertions at the end, as when building from ordered data
+      hint_timer.resume();
+      T t;
+      for(std::size_t i = 0; i != N; ++i){
+         t.insert(t.end(), typename T::value_type(static_cast<int>(i), 0));
+      }
+      hint_timer.stop();
+   }
+
+   std::cout << " Insert random_unique_range " << boost::timer::format(insert_timer.elapsed(), boost::timer::default_places, "%ws wall\n");
+   std::cout << " Insert with end() hint     " << boost::timer::format(hint_timer.elapsed(), boost::timer::default_places, "%ws wall\n");
+   cpu_times total(insert_timer.elapsed());
+   total.wall += hint_timer.elapsed().wall;
+   return total;
+}
+
+template<typename T>
+cpu_times lower_bound_time()
+{
+   T t;
+   for(std::size_t i = 0; i != N; ++i){
+      t.insert(typename T::value_type(random_unique_range[i], 0));
+   }
+
+   cpu_timer lower_timer;
+   std::size_t found = 0;
+   for(std::size_t r = 0; r != Repetitions; ++r){
+      for(std::size_t i = 0; i != N; ++i){
+         found += static_cast<std::size_t>(t.end() != t.lower_bound(random_search_range[i]));
+      }
+   }
+   lower_timer.stop();
+   if(!found){
+      std::cout << "ERROR! no element found" << std::endl;
+   }
+
+   std::cout << " Lower Bound  " << boost::timer::format(lower_timer.elapsed(), boost::timer::default_places, "%ws wall\n");
+   return lower_timer.elapsed();
+}
+
+template<typename T>
+cpu_times range_scan_time()
+{
+   T t;
+   for(std::size_t i = 0; i != N; ++i){
+      t.insert(typename T::value_type(random_unique_range[i], static_cast<int>(i)));
+   }
+
+   cpu_timer full_timer, range_timer;
+   full_timer.stop(); range_timer.stop();
+   long long sum = 0;
+   for(std::size_t r = 0; r != Repetitions; ++r){
+      full_timer.resume();
+      for(typename T::const_iterator it = t.begin(), itend = t.end(); it != itend; ++it){
+         sum += it->second;
+      }
+      full_timer.stop();
+   }
+   //Short scans of 100 values after a search, as in paginated queries
+   range_timer.resume();
+   for(std::size_t r = 0; r != Repetitions; ++r){
+      for(std::size_t i = 0; i != N/100; ++i){
+         typename T::const_iterator it = t.lower_bound(random_search_range[i]), itend = t.end();
+         for(std::size_t j = 0; j != 100 && it != itend; ++j, ++it){
+            sum += it->second;
+         }
+      }
+   }
+   range_timer.stop();
+   if(!sum){
+      std::cout << "ERROR! empty scan" << std::endl;
+   }
+
+   std::cout << " Full scan          " << boost::timer::format(full_timer.elapsed(), boost::timer::default_places, "%ws wall\n");
+   std::cout << " lower_bound + 100  " << boost::timer::format(range_timer.elapsed(), boost::timer::default_places, "%ws wall\n");
+   cpu_times total(full_timer.elapsed());
+   total.wall += range_timer.elapsed().wall;
+   return total;
+}
+
+template<class BtreeClass, class BoostClass>
+void launch_tests(const char *BtreeContName, const char *BoostContName)
+{
+   {
+      std::cout << "Insert benchmark:" << BtreeContName << std::endl;
+      cpu_times btree_time = insert_time< BtreeClass >();
+
+      std::cout << "Insert benchmark:" << BoostContName << std::endl;
+      cpu_times boost_time = insert_time< BoostClass >();
+
+      std::cout << "Total time (" << BtreeContName << "/" << BoostContName << "):\n";
+      compare_times(btree_time, boost_time);
+   }
+   {
+      std::cout << "Search benchmark:" << BtreeContName << std::endl;
+      cpu_times btree_time = lower_bound_time< BtreeClass >();
+
+      std::cout << "Search benchmark:" << BoostContName << std::endl;
+      cpu_times boost_time = lower_bound_time< BoostClass >();
+
+      std::cout << "Total time (" << BtreeContName << "/" << BoostContName << "):\n";
+      compare_times(btree_time, boost_time);
+   }
+   {
+      std::cout << "Range scan benchmark:" << BtreeContName << std::endl;
+      cpu_times btree_time = range_scan_time< BtreeClass >();
+
+      std::cout << "Range scan benchmark:" << BoostContName << std::endl;
+      cpu_times boost_time = range_scan_time< BoostClass >();
+
+      std::cout << "Total time (" << BtreeContName << "/" << BoostContName << "):\n";
+      compare_times(btree_time, boost_time);
+   }
+}
+
+int main()
+{
+   fill_ranges();
+   //btree_map vs map
+   launch_tests< boost::container::btree_map<int, int> , boost::container::map<int, int> >
+      ("boost::container::btree_map<int, int>", "boost::container::map<int, int>");
+   //btree_map vs flat_map
+   launch_tests< boost::container::btree_map<int, int> , boost::container::flat_map<int, int> >
+      ("boost::container::btree_map<int, int>", "boost::container::flat_map<int, int>");
+   return 0;
+}
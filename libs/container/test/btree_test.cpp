@@ -0,0 +1,461 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2004-2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/container/detail/config_begin.hpp>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <boost/container/btree_set.hpp>
+#include <boost/container/btree_map.hpp>
+//Must coexist with the red-black tree based containers
+#include <boost/container/set.hpp>
+#include <boost/container/map.hpp>
+#include "print_container.hpp"
+#include "movable_int.hpp"
+#include "dummy_test_allocator.hpp"
+#include "set_test.hpp"
+#include "map_test.hpp"
+#include "propagate_allocator_test.hpp"
+#include "emplace_test.hpp"
+
+using namespace boost::container;
+
+//Alias standard types
+typedef std::set<int>                                          MyStdSet;
+typedef std::multiset<int>                                     MyStdMultiSet;
+typedef std::map<int, int>                                     MyStdMap;
+typedef std::multimap<int, int>                                MyStdMultiMap;
+
+//Alias non-movable types
+typedef btree_set<int>           MyBoostSet;
+typedef btree_multiset<int>      MyBoostMultiSet;
+typedef btree_map<int, int>      MyBoostMap;
+typedef btree_multimap<int, int> MyBoostMultiMap;
+
+//Alias movable types
+typedef btree_set<test::movable_int>                           MyMovableBoostSet;
+typedef btree_multiset<test::movable_int>                      MyMovableBoostMultiSet;
+typedef btree_map<test::movable_int, test::movable_int>        MyMovableBoostMap;
+typedef btree_multimap<test::movable_int, test::movable_int>   MyMovableBoostMultiMap;
+typedef btree_set<test::movable_and_copyable_int>              MyMoveCopyBoostSet;
+typedef btree_set<test::copyable_int>                          MyCopyBoostSet;
+typedef btree_multiset<test::movable_and_copyable_int>         MyMoveCopyBoostMultiSet;
+typedef btree_multiset<test::copyable_int>                     MyCopyBoostMultiSet;
+typedef btree_map<test::movable_and_copyable_int
+                 ,test::movable_and_copyable_int>              MyMoveCopyBoostMap;
+typedef btree_multimap<test::movable_and_copyable_int
+                      ,test::movable_and_copyable_int>         MyMoveCopyBoostMultiMap;
+typedef btree_map<test::copyable_int
+                 ,test::copyable_int>                          MyCopyBoostMap;
+typedef btree_multimap<test::copyable_int
+                      ,test::copyable_int>                     MyCopyBoostMultiMap;
+
+namespace boost {
+namespace container {
+
+//Explicit instantiation to detect compilation errors
+
+//btree_map
+template class btree_map
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::dummy_test_allocator
+      < std::pair<const test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+template class btree_map
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::simple_allocator
+      < std::pair<const test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+template class btree_map
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , std::allocator
+      < std::pair<const test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+//btree_multimap
+template class btree_multimap
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::dummy_test_allocator
+      < std::pair<const test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+template class btree_multimap
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::simple_allocator
+      < std::pair<const test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+template class btree_multimap
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , std::allocator
+      < std::pair<const test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+//btree_set
+template class btree_set
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::dummy_test_allocator<test::movable_and_copyable_int>
+   >;
+
+template class btree_set
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::simple_allocator<test::movable_and_copyable_int>
+   >;
+
+template class btree_set
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , std::allocator<test::movable_and_copyable_int>
+   >;
+
+//btree_multiset
+template class btree_multiset
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::dummy_test_allocator<test::movable_and_copyable_int>
+   >;
+
+template class btree_multiset
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::simple_allocator<test::movable_and_copyable_int>
+   >;
+
+template class btree_multiset
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , std::allocator<test::movable_and_copyable_int>
+   >;
+
+}} //boost::container
+
+//Test recursive structures
+class recursive_set
+{
+public:
+   recursive_set & operator=(const recursive_set &x)
+   {  id_ = x.id_;  set_ = x.set_; return *this; }
+
+   int id_;
+   btree_set<recursive_set> set_;
+   friend bool operator< (const recursive_set &a, const recursive_set &b)
+   {  return a.id_ < b.id_;   }
+};
+
+class recursive_map
+{
+   public:
+   recursive_map & operator=(const recursive_map &x)
+   {  id_ = x.id_;  map_ = x.map_; return *this;  }
+
+   int id_;
+   btree_map<recursive_map, recursive_map> map_;
+   friend bool operator< (const recursive_map &a, const recursive_map &b)
+   {  return a.id_ < b.id_;   }
+};
+
+//Test recursive structures
+class recursive_multiset
+{
+   public:
+   recursive_multiset & operator=(const recursive_multiset &x)
+   {  id_ = x.id_;  multiset_ = x.multiset_; return *this;  }
+
+   int id_;
+   btree_multiset<recursive_multiset> multiset_;
+   friend bool operator< (const recursive_multiset &a, const recursive_multiset &b)
+   {  return a.id_ < b.id_;   }
+};
+
+class recursive_multimap
+{
+   public:
+   recursive_multimap & operator=(const recursive_multimap &x)
+   {  id_ = x.id_;  multimap_ = x.multimap_; return *this;  }
+
+   int id_;
+   btree_multimap<recursive_multimap, recursive_multimap> multimap_;
+   friend bool operator< (const recursive_multimap &a, const recursive_multimap &b)
+   {  return a.id_ < b.id_;   }
+};
+
+template<class C>
+void test_move()
+{
+   //Now test move semantics
+   C original;
+   original.emplace();
+   C move_ctor(boost::move(original));
+   C move_assign;
+   move_assign.emplace();
+   move_assign = boost::move(move_ctor);
+   move_assign.swap(original);
+}
+
+//Inserts and erases enough values to split, merge and rebalance nodes at every
+//level of the tree, comparing the contents with std::multimap along the way
+bool test_node_rebalancing()
+{
+   typedef btree_multimap<int, int>          MyBtree;
+   typedef std::multimap<int, int>           MyStd;
+   typedef std::pair<const int, int>         value_t;
+
+   MyBtree btree;
+   MyStd   stdmap;
+   std::srand(0);
+   for(int i = 0; i != 40000; ++i){
+      const int k = std::rand() % 2000;
+      switch(std::rand() % 5){
+         case 0:
+            btree.insert(value_t(k, i));
+            stdmap.insert(value_t(k, i));
+         break;
+         case 1:
+            btree.insert(btree.lower_bound(k), value_t(k, i));
+            stdmap.insert(stdmap.lower_bound(k), value_t(k, i));
+         break;
+         case 2:
+            btree.insert(btree.upper_bound(k), value_t(k, i));
+            stdmap.insert(stdmap.upper_bound(k), value_t(k, i));
+         break;
+         case 3:{
+            MyBtree::iterator bit = btree.lower_bound(k);
+            MyStd::iterator   sit = stdmap.lower_bound(k);
+            if(sit == stdmap.end()){
+               if(bit != btree.end())
+                  return false;
+               break;
+            }
+            bit = btree.erase(bit);
+            stdmap.erase(sit++);
+            if((bit == btree.end()) != (sit == stdmap.end()) ||
+               (sit != stdmap.end() && *bit != *sit))
+               return false;
+         }
+         break;
+         default:
+            if(btree.erase(k) != stdmap.erase(k))
+               return false;
+         break;
+      }
+      if(i % 1000 == 0 && !test::CheckEqualPairContainers(&btree, &stdmap))
+         return false;
+   }
+   if(!test::CheckEqualPairContainers(&btree, &stdmap) ||
+      !std::equal(btree.rbegin(), btree.rend(), stdmap.rbegin()))
+      return false;
+
+   //Copies append the values in order, so they get a different node layout
+   MyBtree copy(btree);
+   if(copy != btree)
+      return false;
+
+   //Erase the values by ranges
+   while(!stdmap.empty()){
+      const int k = std::rand() % 2000;
+      MyBtree::iterator bit = btree.erase(btree.lower_bound(k), btree.upper_bound(k + 100));
+      MyStd::iterator   sit = stdmap.lower_bound(k);
+      stdmap.erase(sit, stdmap.upper_bound(k + 100));
+      sit = stdmap.upper_bound(k + 100);
+      if((bit == btree.end()) != (sit == stdmap.end()) ||
+         (sit != stdmap.end() && *bit != *sit) ||
+         !test::CheckEqualPairContainers(&btree, &stdmap))
+         return false;
+   }
+   return btree.empty() && btree.begin() == btree.end();
+}
+
+template<class T, class A>
+class tree_propagate_test_wrapper
+   : public container_detail::btree<T, T, container_detail::identity<T>, std::less<T>, A>
+{
+   BOOST_COPYABLE_AND_MOVABLE(tree_propagate_test_wrapper)
+   typedef container_detail::btree<T, T, container_detail::identity<T>, std::less<T>, A> Base;
+   public:
+   tree_propagate_test_wrapper()
+      : Base()
+   {}
+
+   tree_propagate_test_wrapper(const tree_propagate_test_wrapper &x)
+      : Base(x)
+   {}
+
+   tree_propagate_test_wrapper(BOOST_RV_REF(tree_propagate_test_wrapper) x)
+      : Base(boost::move(static_cast<Base&>(x)))
+   {}
+
+   tree_propagate_test_wrapper &operator=(BOOST_COPY_ASSIGN_REF(tree_propagate_test_wrapper) x)
+   {  this->Base::operator=(x);  return *this; }
+
+   tree_propagate_test_wrapper &operator=(BOOST_RV_REF(tree_propagate_test_wrapper) x)
+   {  this->Base::operator=(boost::move(static_cast<Base&>(x)));  return *this; }
+
+   void swap(tree_propagate_test_wrapper &x)
+   {  this->Base::swap(x);  }
+};
+
+int main ()
+{
+   //Recursive container instantiation
+   {
+      btree_set<recursive_set> set_;
+      btree_multiset<recursive_multiset> multiset_;
+      btree_map<recursive_map, recursive_map> map_;
+      btree_multimap<recursive_multimap, recursive_multimap> multimap_;
+   }
+   //Allocator argument container
+   {
+      btree_set<int> set_((std::allocator<int>()));
+      btree_multiset<int> multiset_((std::allocator<int>()));
+      btree_map<int, int> map_((std::allocator<std::pair<const int, int> >()));
+      btree_multimap<int, int> multimap_((std::allocator<std::pair<const int, int> >()));
+   }
+   //Now test move semantics
+   {
+      test_move<btree_set<recursive_set> >();
+      test_move<btree_multiset<recursive_multiset> >();
+      test_move<btree_map<recursive_map, recursive_map> >();
+      test_move<btree_multimap<recursive_multimap, recursive_multimap> >();
+   }
+
+
+   if(0 != test::set_test<MyBoostSet
+                        ,MyStdSet
+                        ,MyBoostMultiSet
+                        ,MyStdMultiSet>()){
+      return 1;
+   }
+
+   if(0 != test::set_test_copyable<MyBoostSet
+                        ,MyStdSet
+                        ,MyBoostMultiSet
+                        ,MyStdMultiSet>()){
+      return 1;
+   }
+
+   if(0 != test::set_test<MyMovableBoostSet
+                        ,MyStdSet
+                        ,MyMovableBoostMultiSet
+                        ,MyStdMultiSet>()){
+      return 1;
+   }
+
+   if(0 != test::set_test<MyMoveCopyBoostSet
+                        ,MyStdSet
+                        ,MyMoveCopyBoostMultiSet
+                        ,MyStdMultiSet>()){
+      return 1;
+   }
+
+   if(0 != test::set_test_copyable<MyMoveCopyBoostSet
+                        ,MyStdSet
+                        ,MyMoveCopyBoostMultiSet
+                        ,MyStdMultiSet>()){
+      return 1;
+   }
+
+   if(0 != test::set_test<MyCopyBoostSet
+                        ,MyStdSet
+                        ,MyCopyBoostMultiSet
+                        ,MyStdMultiSet>()){
+      return 1;
+   }
+
+   if(0 != test::set_test_copyable<MyCopyBoostSet
+                        ,MyStdSet
+                        ,MyCopyBoostMultiSet
+                        ,MyStdMultiSet>()){
+      return 1;
+   }
+
+   if (0 != test::map_test<MyBoostMap
+                  ,MyStdMap
+                  ,MyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      return 1;
+   }
+
+   if(0 != test::map_test_copyable<MyBoostMap
+                        ,MyStdMap
+                        ,MyBoostMultiMap
+                        ,MyStdMultiMap>()){
+      return 1;
+   }
+
+   if (0 != test::map_test<MyMovableBoostMap
+                  ,MyStdMap
+                  ,MyMovableBoostMultiMap
+                  ,MyStdMultiMap>()){
+      return 1;
+   }
+
+   if (0 != test::map_test<MyMoveCopyBoostMap
+                  ,MyStdMap
+                  ,MyMoveCopyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      return 1;
+   }
+
+   if (0 != test::map_test_copyable<MyMoveCopyBoostMap
+                  ,MyStdMap
+                  ,MyMoveCopyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      return 1;
+   }
+
+   if (0 != test::map_test<MyCopyBoostMap
+                  ,MyStdMap
+                  ,MyCopyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      return 1;
+   }
+
+   if (0 != test::map_test_copyable<MyCopyBoostMap
+                  ,MyStdMap
+                  ,MyCopyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      return 1;
+   }
+
+   const test::EmplaceOptions SetOptions = (test::EmplaceOptions)(test::EMPLACE_HINT | test::EMPLACE_ASSOC);
+   if(!boost::container::test::test_emplace<btree_set<test::EmplaceInt>, SetOptions>())
+      return 1;
+   if(!boost::container::test::test_emplace<btree_multiset<test::EmplaceInt>, SetOptions>())
+      return 1;
+   const test::EmplaceOptions MapOptions = (test::EmplaceOptions)(test::EMPLACE_HINT_PAIR | test::EMPLACE_ASSOC_PAIR);
+   if(!boost::container::test::test_emplace<btree_map<test::EmplaceInt, test::EmplaceInt>, MapOptions>())
+      return 1;
+   if(!boost::container::test::test_emplace<btree_multimap<test::EmplaceInt, test::EmplaceInt>, MapOptions>())
+      return 1;
+   if(!boost::container::test::test_propagate_allocator<tree_propagate_test_wrapper>())
+      return 1;
+   if(!test_node_rebalancing())
+      return 1;
+
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
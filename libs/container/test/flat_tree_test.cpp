@@ -10,6 +10,9 @@
 
 #include <boost/container/detail/config_begin.hpp>
 #include <set>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
 #include <boost/container/flat_set.hpp>
 #include <boost/container/flat_map.hpp>
 #include "print_container.hpp"
@@ -311,6 +314,13 @@ namespace boost{
 namespace container {
 namespace test{
 
+struct flat_tree_first_less
+{
+   template<class Pair>
+   bool operator()(const Pair &a, const Pair &b) const
+   {  return a.first < b.first;  }
+};
+
 bool flat_tree_ordered_insertion_test()
 {
    using namespace boost::container;
@@ -469,6 +479,84 @@ bool flat_tree_ordered_insertion_test()
    return true;
 }
 
+template<class FlatMap, class StdMap>
+bool flat_tree_check_equal_pairs(const FlatMap &fmap, const StdMap &smap)
+{
+   if(fmap.size() != smap.size())
+      return false;
+   typename FlatMap::const_iterator fit = fmap.begin();
+   typename StdMap::const_iterator sit = smap.begin();
+   for(; sit != smap.end(); ++fit, ++sit){
+      if(fit->first != sit->first || fit->second != sit->second)
+         return false;
+   }
+   return true;
+}
+
+bool flat_tree_unordered_insertion_test()
+{
+   using namespace boost::container;
+   const int NumBatches = 20;
+   const int BatchSize = 500;
+
+   //Batches of unordered values with repeated keys, the mapped value
+   //records the insertion order of equivalent keys
+   std::map<int, int> int_map;
+   std::multimap<int, int> int_mmap;
+   flat_map<int, int> fmap;
+   flat_multimap<int, int> fmmap;
+   std::srand(1);
+   for(int b = 0; b != NumBatches; ++b){
+      std::vector<std::pair<int, int> > batch;
+      for(int i = 0; i != BatchSize; ++i){
+         batch.push_back(std::pair<int, int>(std::rand() % 5000, b*BatchSize + i));
+      }
+      //Every other batch is ordered
+      if(b % 2){
+         std::stable_sort(batch.begin(), batch.end(), flat_tree_first_less());
+      }
+      int_map.insert(batch.begin(), batch.end());
+      int_mmap.insert(batch.begin(), batch.end());
+      fmap.insert(batch.begin(), batch.end());
+      fmmap.insert(batch.begin(), batch.end());
+      if(!flat_tree_check_equal_pairs(fmap, int_map))
+         return false;
+      if(!flat_tree_check_equal_pairs(fmmap, int_mmap))
+         return false;
+
+      //Construction from an unordered range
+      flat_map<int, int> fmap2(batch.begin(), batch.end());
+      flat_multimap<int, int> fmmap2(batch.begin(), batch.end());
+      std::map<int, int> int_map2(batch.begin(), batch.end());
+      std::multimap<int, int> int_mmap2(batch.begin(), batch.end());
+      if(!flat_tree_check_equal_pairs(fmap2, int_map2))
+         return false;
+      if(!flat_tree_check_equal_pairs(fmmap2, int_mmap2))
+         return false;
+   }
+
+   //Unordered insertion of move-only values
+   {
+      const int NumElements = 1000;
+      std::set<int> int_set;
+      flat_set<test::movable_int> fset;
+      for(int b = 0; b != 2; ++b){
+         test::movable_int aux_vect[NumElements];
+         for(int i = 0; i != NumElements; ++i){
+            int v = std::rand() % (2*NumElements);
+            aux_vect[i] = test::movable_int(v);
+            int_set.insert(v);
+         }
+         fset.insert( boost::make_move_iterator(&aux_vect[0])
+                    , boost::make_move_iterator(aux_vect + NumElements));
+      }
+      if(!CheckEqualContainers(&int_set, &fset))
+         return false;
+   }
+
+   return true;
+}
+
 }}}
 
 int main()
@@ -494,6 +582,10 @@ int main()
       return 1;
    }
 
+   if(!flat_tree_unordered_insertion_test()){
+      return 1;
+   }
+
    if (0 != set_test<
                   MyBoostSet
                   ,MyStdSet
@@ -441,6 +441,49 @@ void run_reserve_heap_tests(void)
     check_q(q, data);
 }
 
+template <typename pri_queue>
+void pri_queue_test_range_constructor(void)
+{
+    for (int i = 0; i != test_size; ++i)
+    {
+        test_data data = make_test_data(i);
+
+        test_data shuffled (data);
+        std::random_shuffle(shuffled.begin(), shuffled.end());
+
+        pri_queue q(shuffled.begin(), shuffled.end());
+        check_q(q, data);
+    }
+}
+
+template <typename pri_queue>
+void pri_queue_test_range_push(void)
+{
+    // pushing few elements into a large heap sifts them up, pushing many rebuilds the heap
+    for (int i = 0; i != test_size; ++i)
+    {
+        for (int j = 0; j != test_size; ++j)
+        {
+            test_data data = make_test_data(i + j * 3);
+
+            test_data shuffled (data);
+            std::random_shuffle(shuffled.begin(), shuffled.end());
+
+            pri_queue q;
+            fill_q(q, test_data(shuffled.begin(), shuffled.begin() + i));
+            q.push(shuffled.begin() + i, shuffled.end());
+            check_q(q, data);
+        }
+    }
+}
+
+template <typename pri_queue>
+void run_bulk_heap_tests(void)
+{
+    pri_queue_test_range_constructor<pri_queue>();
+    pri_queue_test_range_push<pri_queue>();
+}
+
 template <typename pri_queue>
 void run_leak_check_test(void)
 {
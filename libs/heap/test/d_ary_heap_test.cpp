@@ -40,6 +40,7 @@ void run_d_ary_heap_test(void)
     run_moveable_heap_tests<pri_queue>();
     run_reserve_heap_tests<pri_queue>();
     run_merge_tests<pri_queue>();
+    run_bulk_heap_tests<pri_queue>();
 
     run_ordered_iterator_tests<pri_queue>();
 
@@ -49,6 +50,7 @@ void run_d_ary_heap_test(void)
                                        > stable_pri_queue;
 
         run_stable_heap_tests<stable_pri_queue>();
+        run_stable_bulk_heap_tests<stable_pri_queue>();
     }
 
 #if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
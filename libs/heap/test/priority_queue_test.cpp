@@ -29,10 +29,12 @@ void run_common_priority_queue_tests(void)
     run_copyable_heap_tests<pri_queue>();
     run_moveable_heap_tests<pri_queue>();
     run_merge_tests<pri_queue>();
+    run_bulk_heap_tests<pri_queue>();
 
     if (stable) {
         typedef boost::heap::priority_queue<q_tester, boost::heap::stable<stable> > stable_pri_queue;
         run_stable_heap_tests<stable_pri_queue>();
+        run_stable_bulk_heap_tests<stable_pri_queue>();
     }
 }
 
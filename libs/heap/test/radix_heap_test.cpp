@@ -0,0 +1,113 @@
+/*=============================================================================
+    Copyright (c) 2013 Tim Blechmann
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_HEAP_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/heap/radix_heap.hpp>
+
+/* pushes keys that are never smaller than the last popped key, as dijkstra's algorithm does, and compares the keys
+ * with the ones popped from a std::priority_queue */
+template <typename Key>
+void run_radix_heap_monotone_test(Key max_step)
+{
+    typedef boost::heap::radix_heap<Key, int> pri_queue;
+    typedef std::pair<Key, int> element;
+    std::priority_queue<element, std::vector<element>, std::greater<element> > reference;
+
+    pri_queue q;
+    Key last = 0;
+    std::srand(42);
+
+    for (int i = 0; i != 10000; ++i) {
+        int pushes = std::rand() % 4;
+        for (int j = 0; j != pushes; ++j) {
+            Key k = last + static_cast<Key>(std::rand() % (max_step + 1));
+            q.push(k, i);
+            reference.push(element(k, i));
+        }
+
+        BOOST_REQUIRE_EQUAL(q.size(), reference.size());
+        if (!reference.empty() && std::rand() % 3) {
+            BOOST_REQUIRE_EQUAL(q.top().first, reference.top().first);
+            last = q.top().first;
+            q.pop();
+            reference.pop();
+            BOOST_REQUIRE_EQUAL(q.min_key(), last);
+        }
+    }
+
+    while (!reference.empty()) {
+        BOOST_REQUIRE(!q.empty());
+        BOOST_REQUIRE_EQUAL(q.top().first, reference.top().first);
+        q.pop();
+        reference.pop();
+    }
+    BOOST_REQUIRE(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE( radix_heap_monotone_test )
+{
+    run_radix_heap_monotone_test<unsigned char>(3);
+    run_radix_heap_monotone_test<unsigned int>(100);
+    run_radix_heap_monotone_test<boost::uint64_t>(1000000);
+}
+
+BOOST_AUTO_TEST_CASE( radix_heap_extreme_keys_test )
+{
+    typedef boost::uint64_t key;
+    boost::heap::radix_heap<key, int> q;
+
+    key const max = ~key(0);
+    q.push(max, 3);
+    q.push(0, 0);
+    q.push(max - 1, 2);
+    q.push(key(1) << 63, 1);
+
+    for (int i = 0; i != 4; ++i) {
+        BOOST_REQUIRE_EQUAL(q.top().second, i);
+        q.pop();
+    }
+    BOOST_REQUIRE(q.empty());
+    BOOST_REQUIRE_EQUAL(q.min_key(), max);
+}
+
+BOOST_AUTO_TEST_CASE( radix_heap_clear_swap_test )
+{
+    typedef boost::heap::radix_heap<unsigned int, int> pri_queue;
+    pri_queue q, r;
+
+    for (int i = 0; i != 100; ++i)
+        q.push(100 + i, i);
+    BOOST_REQUIRE_EQUAL(q.top().first, 100u);
+    q.pop();
+
+    q.swap(r);
+    BOOST_REQUIRE(q.empty());
+    BOOST_REQUIRE_EQUAL(r.size(), 99u);
+    BOOST_REQUIRE_EQUAL(r.top().first, 101u);
+    BOOST_REQUIRE_EQUAL(q.min_key(), 0u);
+
+    /* after clear(), smaller keys can be pushed again */
+    r.clear();
+    BOOST_REQUIRE(r.empty());
+    r.push(5, 5);
+    r.push(1, 1);
+    BOOST_REQUIRE_EQUAL(r.top().second, 1);
+}
@@ -91,9 +91,28 @@ void pri_queue_stable_test_sequential_reverse_push(void)
 }
 
 
+template <typename pri_queue>
+void pri_queue_stable_test_range_push(void)
+{
+    stable_test_data data = make_stable_test_data(test_size);
+
+    pri_queue q;
+    q.push(data.begin(), data.end());
+    std::stable_sort(data.begin(), data.end(), compare_by_id());
+    std::stable_sort(data.begin(), data.end(), std::less<q_tester>());
+    check_q(q, data);
+}
+
+
 template <typename pri_queue>
 void run_stable_heap_tests(void)
 {
     pri_queue_stable_test_sequential_push<pri_queue>();
     pri_queue_stable_test_sequential_reverse_push<pri_queue>();
 }
+
+template <typename pri_queue>
+void run_stable_bulk_heap_tests(void)
+{
+    pri_queue_stable_test_range_push<pri_queue>();
+}
@@ -0,0 +1,164 @@
+/*=============================================================================
+    Copyright (c) 2013 Tim Blechmann
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+
+// compares bulk construction and merging of array-based heaps with pushing the elements one by one, and the radix
+// heap with a 4-ary heap on a monotone workload like the one of dijkstra's algorithm.
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/heap/d_ary_heap.hpp>
+#include <boost/heap/heap_merge.hpp>
+#include <boost/heap/priority_queue.hpp>
+#include <boost/heap/radix_heap.hpp>
+
+#include "high_resolution_timer.hpp"
+
+using namespace std;
+using boost::high_resolution_timer;
+
+typedef vector<int> test_data;
+
+test_data make_test_data(int size)
+{
+    test_data v(size);
+    for (int i = 0; i != size; ++i)
+        v[i] = i;
+    random_shuffle(v.begin(), v.end());
+    return v;
+}
+
+template <typename pri_queue>
+double run_push_loop(test_data const & data)
+{
+    high_resolution_timer timer;
+    pri_queue q;
+    for (size_t i = 0; i != data.size(); ++i)
+        q.push(data[i]);
+    double ret = timer.elapsed();
+    if (q.top() != int(data.size()) - 1)
+        abort();
+    return ret;
+}
+
+template <typename pri_queue>
+double run_range_construction(test_data const & data)
+{
+    high_resolution_timer timer;
+    pri_queue q(data.begin(), data.end());
+    double ret = timer.elapsed();
+    if (q.top() != int(data.size()) - 1)
+        abort();
+    return ret;
+}
+
+template <typename pri_queue>
+double run_emulated_merge(test_data const & data)
+{
+    pri_queue lhs(data.begin(), data.begin() + data.size() / 2);
+    pri_queue rhs(data.begin() + data.size() / 2, data.end());
+
+    high_resolution_timer timer;
+    boost::heap::detail::heap_merge_emulate<pri_queue, pri_queue>::merge(lhs, rhs);
+    return timer.elapsed();
+}
+
+template <typename pri_queue>
+double run_heap_merge(test_data const & data)
+{
+    pri_queue lhs(data.begin(), data.begin() + data.size() / 2);
+    pri_queue rhs(data.begin() + data.size() / 2, data.end());
+
+    high_resolution_timer timer;
+    boost::heap::heap_merge(lhs, rhs);
+    return timer.elapsed();
+}
+
+template <typename pri_queue>
+void run_bulk_benchmarks(const char * name, test_data const & data)
+{
+    cout << name << "\t"
+         << run_push_loop<pri_queue>(data) << "\t"
+         << run_range_construction<pri_queue>(data) << "\t"
+         << run_emulated_merge<pri_queue>(data) << "\t"
+         << run_heap_merge<pri_queue>(data) << endl;
+}
+
+
+typedef boost::uint32_t key_type;
+typedef pair<key_type, int> element;
+
+/* pops n elements, each one followed by up to 3 pushes of keys that are at most max_step larger than the popped key */
+struct monotone_workload
+{
+    vector<int> pushes;
+    vector<key_type> steps;
+
+    monotone_workload(int n, key_type max_step)
+    {
+        for (int i = 0; i != n; ++i) {
+            pushes.push_back(rand() % 4 + (i < 16 ? 1 : 0));
+            for (int j = 0; j != pushes.back(); ++j)
+                steps.push_back(static_cast<key_type>(rand()) % max_step);
+        }
+    }
+};
+
+template <typename pri_queue>
+double run_monotone(monotone_workload const & w, key_type & checksum)
+{
+    high_resolution_timer timer;
+    pri_queue q;
+    q.push(element(0, 0));
+    size_t step = 0;
+    for (size_t i = 0; i != w.pushes.size() && !q.empty(); ++i) {
+        key_type key = q.top().first;
+        checksum += key;
+        q.pop();
+        for (int j = 0; j != w.pushes[i]; ++j)
+            q.push(element(key + w.steps[step++], j));
+    }
+    return timer.elapsed();
+}
+
+void run_monotone_benchmarks(int n, key_type max_step)
+{
+    typedef boost::heap::d_ary_heap<element, boost::heap::arity<4>,
+                                    boost::heap::compare<greater<element> > > d_ary_heap;
+    typedef boost::heap::radix_heap<key_type, int> radix_heap;
+
+    monotone_workload w(n, max_step);
+    key_type d_ary_checksum = 0, radix_checksum = 0;
+
+    double d_ary_time = run_monotone<d_ary_heap>(w, d_ary_checksum);
+    double radix_time = run_monotone<radix_heap>(w, radix_checksum);
+    if (d_ary_checksum != radix_checksum)
+        abort();
+
+    cout << n << "\t" << max_step << "\t" << d_ary_time << "\t" << radix_time << endl;
+}
+
+int main(int argc, char ** argv)
+{
+    int size = argc > 1 ? atoi(argv[1]) : 1000000;
+    test_data data = make_test_data(size);
+
+    cout << "heap\tpush loop\trange construction\tmerge (push/pop)\theap_merge" << endl;
+    run_bulk_benchmarks<boost::heap::priority_queue<int> >("priority_queue", data);
+    run_bulk_benchmarks<boost::heap::d_ary_heap<int, boost::heap::arity<2> > >("d_ary_heap<2>", data);
+    run_bulk_benchmarks<boost::heap::d_ary_heap<int, boost::heap::arity<4> > >("d_ary_heap<4>", data);
+
+    cout << endl << "pops\tmax step\td_ary_heap<4>\tradix_heap" << endl;
+    run_monotone_benchmarks(size, 100);
+    run_monotone_benchmarks(size, 1000000);
+    run_monotone_benchmarks(size * 10, 1000);
+}
@@ -0,0 +1,122 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Throughput of boost::lockfree::mpmc_ring compared with boost::lockfree::queue, with 1, 4 and 16 producer and
+//  consumer threads each, pushing and popping single elements and batches of 32 elements. Both hold up to 1024
+//  elements, the threads yield when the queue is full or empty.
+
+#include <boost/thread/thread.hpp>
+#include <boost/lockfree/mpmc_ring.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <boost/chrono.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <iostream>
+
+const long element_count = 4000000;
+const int batch_size = 32;
+const int capacity = 1024;
+
+typedef boost::chrono::high_resolution_clock clock_type;
+
+template <typename Queue>
+struct benchmark
+{
+    Queue & queue;
+    int producer_count;
+    boost::atomic<int> producers_done;
+    boost::atomic<long> consumed;
+
+    benchmark(Queue & queue, int producer_count):
+        queue(queue), producer_count(producer_count), producers_done(0), consumed(0)
+    {}
+
+    void producer(bool batched)
+    {
+        const long count = element_count / producer_count;
+        long data[batch_size];
+        for (long i = 0; i < count;) {
+            if (batched) {
+                int n = count - i < batch_size ? int(count - i) : batch_size;
+                for (int j = 0; j != n; ++j)
+                    data[j] = i + j;
+                long * it = data;
+                for (;;) {
+                    it = queue.push(it, data + n);
+                    if (it == data + n)
+                        break;
+                    boost::this_thread::yield();
+                }
+                i += n;
+            } else {
+                while (!queue.push(i))
+                    boost::this_thread::yield();
+                ++i;
+            }
+        }
+        ++producers_done;
+    }
+
+    void consumer(bool batched)
+    {
+        long data[batch_size];
+        long count = 0;
+        for (;;) {
+            bool done = producers_done.load() == producer_count;
+            long popped;
+            if (batched)
+                popped = queue.pop(data, batch_size);
+            else
+                popped = queue.pop(data[0]) ? 1 : 0;
+
+            count += popped;
+            if (popped == 0) {
+                if (done)
+                    break;
+                boost::this_thread::yield();
+            }
+        }
+        consumed += count;
+    }
+
+    double run(int thread_count, bool batched)
+    {
+        boost::thread_group threads;
+        clock_type::time_point start = clock_type::now();
+        for (int i = 0; i != thread_count; ++i) {
+            threads.create_thread(boost::bind(&benchmark::consumer, this, batched));
+            threads.create_thread(boost::bind(&benchmark::producer, this, batched));
+        }
+        threads.join_all();
+        clock_type::duration elapsed = clock_type::now() - start;
+        if (consumed.load() != (element_count / producer_count) * producer_count)
+            std::cout << "lost elements" << std::endl;
+        return double(boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed).count()) / element_count;
+    }
+};
+
+template <typename Queue>
+void run(const char * name, Queue & queue, int thread_count, bool batched)
+{
+    benchmark<Queue> b(queue, thread_count);
+    double ns = b.run(thread_count, batched);
+    std::cout << name << (batched ? " batched" : "") << " " << thread_count << "P" << thread_count << "C: "
+              << ns << " ns per element" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const int thread_counts[] = {1, 4, 16};
+    for (int i = 0; i != 3; ++i) {
+        for (int batched = 0; batched != 2; ++batched) {
+            boost::lockfree::queue<long, boost::lockfree::fixed_sized<true> > queue(capacity);
+            run("queue", queue, thread_counts[i], batched != 0);
+
+            boost::lockfree::mpmc_ring<long> ring(capacity);
+            run("mpmc_ring", ring, thread_counts[i], batched != 0);
+        }
+    }
+}
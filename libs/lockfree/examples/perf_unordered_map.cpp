@@ -0,0 +1,111 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Throughput of boost::lockfree::unordered_map compared with a boost::unordered_map that is protected by a
+//  boost::shared_mutex, with 1, 2, 4 and 8 threads. 90% of the operations are lookups, the others insert or erase an
+//  element, on a table that holds about half of the 100000 keys.
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/lockfree/unordered_map.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/chrono.hpp>
+#include <boost/bind.hpp>
+#include <iostream>
+
+const long operation_count = 4000000;
+const long key_count = 100000;
+
+typedef boost::chrono::high_resolution_clock clock_type;
+
+class locked_unordered_map
+{
+public:
+    bool insert(long key, long value)
+    {
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        return map_.insert(std::make_pair(key, value)).second;
+    }
+
+    bool erase(long key)
+    {
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        return map_.erase(key) != 0;
+    }
+
+    bool find(long key, long & value) const
+    {
+        boost::shared_lock<boost::shared_mutex> lock(mutex_);
+        boost::unordered_map<long, long>::const_iterator it = map_.find(key);
+        if (it == map_.end())
+            return false;
+        value = it->second;
+        return true;
+    }
+
+private:
+    boost::unordered_map<long, long> map_;
+    mutable boost::shared_mutex mutex_;
+};
+
+/* linear congruential generator, so that the threads don't share the state of a random number generator */
+inline unsigned long next_random(unsigned long & state)
+{
+    state = state * 6364136223846793005UL + 1442695040888963407UL;
+    return state >> 33;
+}
+
+template <typename Map>
+void worker(Map & map, long count, unsigned long seed)
+{
+    unsigned long state = seed;
+    long found = 0;
+    for (long i = 0; i != count; ++i) {
+        unsigned long r = next_random(state);
+        long key = long(r % key_count);
+        unsigned long operation = (r / key_count) % 20;
+
+        if (operation == 0)
+            map.insert(key, key);
+        else if (operation == 1)
+            map.erase(key);
+        else {
+            long value;
+            if (map.find(key, value))
+                found += 1;
+        }
+    }
+    volatile long sink = found;
+    (void)sink;
+}
+
+template <typename Map>
+void run(const char * name, int thread_count)
+{
+    Map map;
+    for (long key = 0; key < key_count; key += 2)
+        map.insert(key, key);
+
+    boost::thread_group threads;
+    clock_type::time_point start = clock_type::now();
+    for (int i = 0; i != thread_count; ++i)
+        threads.create_thread(boost::bind(&worker<Map>, boost::ref(map), operation_count / thread_count, i + 1));
+    threads.join_all();
+    clock_type::duration elapsed = clock_type::now() - start;
+
+    double ns = double(boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed).count()) / operation_count;
+    std::cout << name << " " << thread_count << " threads: " << ns << " ns per operation" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const int thread_counts[] = {1, 2, 4, 8};
+    for (int i = 0; i != 4; ++i) {
+        run<locked_unordered_map>("unordered_map + shared_mutex", thread_counts[i]);
+        run<boost::lockfree::unordered_map<long, long> >("lockfree::unordered_map", thread_counts[i]);
+    }
+}
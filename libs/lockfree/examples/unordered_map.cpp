@@ -0,0 +1,61 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//[unordered_map_example
+#include <boost/thread/thread.hpp>
+#include <boost/lockfree/unordered_map.hpp>
+#include <iostream>
+
+#include <boost/atomic.hpp>
+
+boost::atomic_int found_count(0);
+
+boost::lockfree::unordered_map<int, int> table(128);
+
+const int iterations = 1000000;
+const int key_count = 1000;
+const int writer_thread_count = 2;
+const int reader_thread_count = 4;
+
+void writer(int id)
+{
+    for (int i = 0; i != iterations; ++i) {
+        int key = (i * writer_thread_count + id) % key_count;
+        if (!table.insert(key, key * 2))
+            table.erase(key);
+    }
+}
+
+void reader(void)
+{
+    for (int i = 0; i != iterations; ++i) {
+        int value;
+        if (table.find(i % key_count, value) && value == (i % key_count) * 2)
+            ++found_count;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace std;
+    cout << "boost::lockfree::unordered_map is ";
+    if (!table.is_lock_free())
+        cout << "not ";
+    cout << "lockfree" << endl;
+
+    boost::thread_group threads;
+
+    for (int i = 0; i != writer_thread_count; ++i)
+        threads.create_thread(boost::bind(writer, i));
+
+    for (int i = 0; i != reader_thread_count; ++i)
+        threads.create_thread(reader);
+
+    threads.join_all();
+
+    cout << "found " << found_count << " elements, the table holds " << table.size() << " elements." << endl;
+}
+//]
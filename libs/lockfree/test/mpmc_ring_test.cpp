@@ -0,0 +1,204 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/mpmc_ring.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <string>
+#include <vector>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( simple_mpmc_ring_test )
+{
+    mpmc_ring<int, capacity<64> > f;
+
+    BOOST_WARN(f.is_lock_free());
+
+    BOOST_REQUIRE(f.empty());
+    f.push(1);
+    f.push(2);
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.pop(i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.pop(i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(!f.pop(i2));
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_runtime_sized_test )
+{
+    mpmc_ring<long> f(3);
+
+    /* the capacity is rounded up to 4 */
+    for (long i = 0; i != 4; ++i)
+        BOOST_REQUIRE(f.push(i));
+    BOOST_REQUIRE(!f.push(4));
+
+    /* wrap around several times */
+    for (long i = 4; i != 100; ++i) {
+        long out;
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, i - 4);
+        BOOST_REQUIRE(f.push(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_capacity_test )
+{
+    mpmc_ring<int, capacity<2> > f;
+
+    BOOST_REQUIRE(f.push(1));
+    BOOST_REQUIRE(f.push(2));
+    BOOST_REQUIRE(!f.push(3));
+
+    mpmc_ring<int> g(2);
+
+    BOOST_REQUIRE(g.push(1));
+    BOOST_REQUIRE(g.push(2));
+    BOOST_REQUIRE(!g.push(3));
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_capacity_one_test )
+{
+    /* capacities below 2 are rounded up to 2 */
+    mpmc_ring<int, capacity<1> > f;
+    mpmc_ring<int> g(1);
+    mpmc_ring<int> h(0);
+
+    for (int round = 0; round != 3; ++round) {
+        BOOST_REQUIRE(f.push(1));
+        BOOST_REQUIRE(f.push(2));
+        BOOST_REQUIRE(!f.push(3));
+        BOOST_REQUIRE(g.push(1));
+        BOOST_REQUIRE(g.push(2));
+        BOOST_REQUIRE(!g.push(3));
+        BOOST_REQUIRE(h.push(1));
+        BOOST_REQUIRE(h.push(2));
+        BOOST_REQUIRE(!h.push(3));
+
+        int out;
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, 1);
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, 2);
+        BOOST_REQUIRE(!f.pop(out));
+        BOOST_REQUIRE(g.pop(out));
+        BOOST_REQUIRE_EQUAL(out, 1);
+        BOOST_REQUIRE(g.pop(out));
+        BOOST_REQUIRE_EQUAL(out, 2);
+        BOOST_REQUIRE(!g.pop(out));
+        BOOST_REQUIRE(h.pop(out));
+        BOOST_REQUIRE_EQUAL(out, 1);
+        BOOST_REQUIRE(h.pop(out));
+        BOOST_REQUIRE_EQUAL(out, 2);
+        BOOST_REQUIRE(!h.pop(out));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_ranged_push_test )
+{
+    mpmc_ring<int, capacity<8> > f;
+
+    int data[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    BOOST_REQUIRE_EQUAL(f.push(data, 3), 3u);
+    BOOST_REQUIRE_EQUAL(f.push(data + 3, data + 10), data + 8);
+    BOOST_REQUIRE_EQUAL(f.push(data, 1), 0u);
+
+    vector<int> v(data, data + 2);
+    mpmc_ring<int> g(4);
+    BOOST_REQUIRE(g.push(v.begin(), v.end()) == v.end());
+
+    int out[10];
+    BOOST_REQUIRE_EQUAL(f.pop(out, 10), 8u);
+    for (int i = 0; i != 8; ++i)
+        BOOST_REQUIRE_EQUAL(out[i], i);
+    BOOST_REQUIRE_EQUAL(f.pop(out), 0u);
+
+    BOOST_REQUIRE_EQUAL(g.pop(out), 2u);
+    BOOST_REQUIRE_EQUAL(out[1], 1);
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_consume_one_test )
+{
+    mpmc_ring<int> f(64);
+
+    f.push(1);
+    f.push(2);
+
+#ifdef BOOST_NO_CXX11_LAMBDAS
+    bool success1 = f.consume_one(test_equal(1));
+    bool success2 = f.consume_one(test_equal(2));
+#else
+    bool success1 = f.consume_one([] (int i) {
+        BOOST_REQUIRE_EQUAL(i, 1);
+    });
+
+    bool success2 = f.consume_one([] (int i) {
+        BOOST_REQUIRE_EQUAL(i, 2);
+    });
+#endif
+
+    BOOST_REQUIRE(success1);
+    BOOST_REQUIRE(success2);
+
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_consume_all_test )
+{
+    mpmc_ring<int> f(128);
+
+    for (int i = 0; i != 100; ++i)
+        f.push(i);
+
+    int expected = 0;
+    size_t consumed = f.consume_all(test_sequence(expected));
+
+    BOOST_REQUIRE_EQUAL(consumed, 100u);
+    BOOST_REQUIRE_EQUAL(expected, 100);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_non_trivial_type_test )
+{
+    {
+        mpmc_ring<string> f(4);
+
+        BOOST_REQUIRE(f.push("one"));
+        BOOST_REQUIRE(f.push(string("two")));
+        BOOST_REQUIRE(f.push("three"));
+
+        string out;
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, "one");
+        /* the remaining elements are destroyed with the ringbuffer */
+    }
+
+    {
+        mpmc_ring<int*> f(4);
+        f.push(new int(1));
+
+        boost::shared_ptr<int> out;
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(*out, 1);
+    }
+}
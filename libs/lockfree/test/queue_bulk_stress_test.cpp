@@ -0,0 +1,167 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/mpmc_ring.hpp>
+#include <boost/lockfree/queue.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <vector>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+
+/* writers push bursts of ids with push(range), readers pop them with pop(T*, size) and consume_all. each id is
+ * writer * id_stride + sequence number, so that each reader can check that it sees the ids of one writer in order. */
+template <typename queue_type>
+struct queue_bulk_stress_tester
+{
+    static const unsigned int buckets = 1<<13;
+#ifndef BOOST_LOCKFREE_STRESS_TEST
+    static const long node_count = 20000;
+#else
+    static const long node_count = 2000000;
+#endif
+    static const long id_stride = 1 << 24;
+    static const int writer_threads = 4;
+    static const int reader_threads = 4;
+
+    queue_type q;
+    static_hashed_set<long, buckets> dequeued;
+    boost::lockfree::detail::atomic<int> writers_finished;
+    boost::lockfree::detail::atomic<long> pop_count;
+
+    queue_bulk_stress_tester(void):
+        q(128), writers_finished(0), pop_count(0)
+    {}
+
+    void add_items(int writer)
+    {
+        std::vector<long> burst;
+        long sequence = 0;
+        for (int burst_size = 1; sequence != node_count; burst_size = burst_size % 512 + 63) {
+            burst.clear();
+            for (int i = 0; i != burst_size && sequence != node_count; ++i)
+                burst.push_back(writer * id_stride + sequence++);
+
+            std::vector<long>::const_iterator it = burst.begin();
+            while (it != burst.end())
+                it = q.push(it, std::vector<long>::const_iterator(burst.end()));
+        }
+        writers_finished += 1;
+    }
+
+    struct check_element
+    {
+        queue_bulk_stress_tester * tester;
+        long * last_seen;
+
+        void operator()(long id) const
+        {
+            tester->check(id, last_seen);
+        }
+    };
+
+    void check(long id, long * last_seen)
+    {
+        long writer = id / id_stride;
+        BOOST_REQUIRE(writer < writer_threads);
+        BOOST_REQUIRE(last_seen[writer] < id);
+        last_seen[writer] = id;
+
+        bool inserted = dequeued.insert(id);
+        BOOST_REQUIRE(inserted);
+        ++pop_count;
+    }
+
+    void get_items(int reader)
+    {
+        long last_seen[writer_threads];
+        for (int i = 0; i != writer_threads; ++i)
+            last_seen[i] = i * id_stride - 1;
+
+        long out[64];
+        check_element checker = { this, last_seen };
+        for (int round = 0;; ++round) {
+            bool finished = writers_finished.load() == writer_threads;
+            size_t count;
+            if ((reader + round) % 4 == 0)
+                count = q.consume_all(checker);
+            else {
+                count = q.pop(out, (reader + round) % 64 + 1);
+                for (size_t i = 0; i != count; ++i)
+                    check(out[i], last_seen);
+            }
+
+            if (count == 0 && finished)
+                break;
+        }
+    }
+
+    void run(void)
+    {
+        BOOST_REQUIRE(q.empty());
+
+        thread_group writers;
+        thread_group readers;
+
+        for (int i = 0; i != reader_threads; ++i)
+            readers.create_thread(boost::bind(&queue_bulk_stress_tester::get_items, this, i));
+
+        for (int i = 0; i != writer_threads; ++i)
+            writers.create_thread(boost::bind(&queue_bulk_stress_tester::add_items, this, i));
+
+        writers.join_all();
+        readers.join_all();
+
+        BOOST_REQUIRE(q.empty());
+        BOOST_REQUIRE_EQUAL(pop_count.load(), writer_threads * node_count);
+        BOOST_REQUIRE_EQUAL(dequeued.count_nodes(), (size_t)(writer_threads * node_count));
+    }
+};
+
+BOOST_AUTO_TEST_CASE( queue_bulk_test )
+{
+    typedef queue_bulk_stress_tester<boost::lockfree::queue<long> > tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type());
+    tester->run();
+}
+
+BOOST_AUTO_TEST_CASE( queue_bulk_test_fixed_size )
+{
+    typedef queue_bulk_stress_tester<boost::lockfree::queue<long, boost::lockfree::fixed_sized<true> > > tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type());
+    tester->run();
+}
+
+BOOST_AUTO_TEST_CASE( queue_bulk_test_hazard_pointers )
+{
+    typedef boost::lockfree::queue<long, boost::lockfree::reclamation<boost::lockfree::hazard_pointer_reclamation> > queue_type;
+    typedef queue_bulk_stress_tester<queue_type> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type());
+    tester->run();
+}
+
+BOOST_AUTO_TEST_CASE( queue_bulk_test_epoch_based )
+{
+    typedef boost::lockfree::queue<long, boost::lockfree::reclamation<boost::lockfree::epoch_based_reclamation> > queue_type;
+    typedef queue_bulk_stress_tester<queue_type> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type());
+    tester->run();
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_bulk_test )
+{
+    typedef queue_bulk_stress_tester<boost::lockfree::mpmc_ring<long> > tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type());
+    tester->run();
+}
@@ -136,6 +136,101 @@ BOOST_AUTO_TEST_CASE( queue_consume_all_test )
 }
 
 
+BOOST_AUTO_TEST_CASE( ranged_push_test )
+{
+    queue<long> f(128);
+
+    long data[3] = {1, 2, 3};
+
+    BOOST_REQUIRE_EQUAL(f.push(data, data + 3), data + 3);
+
+    long out;
+    BOOST_REQUIRE(f.pop(out)); BOOST_REQUIRE_EQUAL(out, 1);
+    BOOST_REQUIRE(f.pop(out)); BOOST_REQUIRE_EQUAL(out, 2);
+    BOOST_REQUIRE(f.pop(out)); BOOST_REQUIRE_EQUAL(out, 3);
+    BOOST_REQUIRE(!f.pop(out));
+
+    BOOST_REQUIRE_EQUAL(f.push(data, data), data);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( ranged_unsynchronized_push_test )
+{
+    queue<long> f(128);
+
+    long data[2] = {1, 2};
+
+    BOOST_REQUIRE(f.unsynchronized_push(0));
+    BOOST_REQUIRE_EQUAL(f.unsynchronized_push(data, data + 2), data + 2);
+
+    long out;
+    BOOST_REQUIRE(f.unsynchronized_pop(out)); BOOST_REQUIRE_EQUAL(out, 0);
+    BOOST_REQUIRE(f.unsynchronized_pop(out)); BOOST_REQUIRE_EQUAL(out, 1);
+    BOOST_REQUIRE(f.unsynchronized_pop(out)); BOOST_REQUIRE_EQUAL(out, 2);
+    BOOST_REQUIRE(!f.unsynchronized_pop(out));
+}
+
+BOOST_AUTO_TEST_CASE( bounded_ranged_push_test_exhausted )
+{
+    queue<long, capacity<4> > f;
+
+    long data[6] = {1, 2, 3, 4, 5, 6};
+
+    BOOST_REQUIRE_EQUAL(f.bounded_push(data, data + 6), data + 4);
+    BOOST_REQUIRE_EQUAL(f.bounded_push(data + 4, data + 6), data + 4);
+
+    long out[6];
+    BOOST_REQUIRE_EQUAL(f.pop(out, 6), 4u);
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE_EQUAL(out[i], data[i]);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( bulk_pop_test )
+{
+    queue<long> f(128);
+
+    long data[10];
+    for (int i = 0; i != 10; ++i)
+        data[i] = i;
+
+    f.push(data, data + 4);
+    for (int i = 4; i != 10; ++i)
+        f.push(data[i]);
+
+    long out[10];
+    BOOST_REQUIRE_EQUAL(f.pop(out, 0), 0u);
+    BOOST_REQUIRE_EQUAL(f.pop(out, 3), 3u);
+    BOOST_REQUIRE_EQUAL(f.pop(out + 3, 5), 5u);
+    BOOST_REQUIRE_EQUAL(f.pop(out + 8, 5), 2u);
+    BOOST_REQUIRE_EQUAL(f.pop(out, 5), 0u);
+    BOOST_REQUIRE(f.empty());
+
+    for (int i = 0; i != 10; ++i)
+        BOOST_REQUIRE_EQUAL(out[i], data[i]);
+
+    f.push(data, data + 10);
+    long value;
+    BOOST_REQUIRE(f.pop(value)); BOOST_REQUIRE_EQUAL(value, 0);
+    BOOST_REQUIRE_EQUAL(f.pop(out, 10), 9u);
+    BOOST_REQUIRE_EQUAL(out[8], 9);
+}
+
+BOOST_AUTO_TEST_CASE( queue_consume_all_batches_test )
+{
+    queue<int> f(256);
+
+    for (int i = 0; i != 100; ++i)
+        f.push(i);
+
+    int expected = 0;
+    size_t consumed = f.consume_all(test_sequence(expected));
+
+    BOOST_REQUIRE_EQUAL(consumed, 100u);
+    BOOST_REQUIRE_EQUAL(expected, 100);
+    BOOST_REQUIRE(f.empty());
+}
+
 BOOST_AUTO_TEST_CASE( queue_convert_pop_test )
 {
     queue<int*> f(128);
@@ -0,0 +1,66 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/stack.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include "test_common.hpp"
+
+using boost::lockfree::reclamation;
+using boost::lockfree::hazard_pointer_reclamation;
+using boost::lockfree::epoch_based_reclamation;
+
+BOOST_AUTO_TEST_CASE( queue_test_hazard_pointers )
+{
+    typedef queue_stress_tester<false> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type(4, 4) );
+
+    boost::lockfree::queue<long, reclamation<hazard_pointer_reclamation> > q(128);
+    tester->run(q);
+}
+
+BOOST_AUTO_TEST_CASE( queue_test_epoch_based )
+{
+    typedef queue_stress_tester<false> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type(4, 4) );
+
+    boost::lockfree::queue<long, reclamation<epoch_based_reclamation> > q(128);
+    tester->run(q);
+}
+
+BOOST_AUTO_TEST_CASE( queue_test_bounded_hazard_pointers )
+{
+    typedef queue_stress_tester<true> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type(4, 4) );
+
+    boost::lockfree::queue<long, reclamation<hazard_pointer_reclamation> > q(128);
+    tester->run(q);
+}
+
+BOOST_AUTO_TEST_CASE( stack_test_hazard_pointers )
+{
+    typedef queue_stress_tester<false> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type(4, 4) );
+
+    boost::lockfree::stack<long, reclamation<hazard_pointer_reclamation> > q(128);
+    tester->run(q);
+}
+
+BOOST_AUTO_TEST_CASE( stack_test_epoch_based )
+{
+    typedef queue_stress_tester<false> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type(4, 4) );
+
+    boost::lockfree::stack<long, reclamation<epoch_based_reclamation> > q(128);
+    tester->run(q);
+}
@@ -0,0 +1,210 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <new>
+
+#include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/stack.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+/* counts the nodes that have been allocated and not yet deallocated */
+long allocated_nodes = 0;
+
+template <typename T>
+struct counting_allocator
+{
+    typedef T value_type;
+    typedef T * pointer;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator(void)
+    {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const &)
+    {}
+
+    T * allocate(std::size_t n)
+    {
+        allocated_nodes += n;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T * p, std::size_t n)
+    {
+        allocated_nodes -= n;
+        ::operator delete(p);
+    }
+};
+
+template <typename Queue>
+void test_queue_reclamation(void)
+{
+    {
+        Queue f(64);
+        BOOST_WARN(f.is_lock_free());
+        BOOST_REQUIRE(f.empty());
+
+        for (int i = 0; i != 10000; ++i)
+            BOOST_REQUIRE(f.push(i));
+
+        for (int i = 0; i != 10000; ++i) {
+            int out;
+            BOOST_REQUIRE(f.pop(out));
+            BOOST_REQUIRE_EQUAL(out, i);
+        }
+        BOOST_REQUIRE(f.empty());
+
+        /* the popped nodes are returned to the allocator, except for the ones that have not been reclaimed yet */
+        BOOST_REQUIRE_LT(allocated_nodes, 1000);
+    }
+    BOOST_REQUIRE_EQUAL(allocated_nodes, 0);
+}
+
+template <typename Queue>
+void test_queue_reclamation_bounded(void)
+{
+    Queue f(2);
+
+    for (int round = 0; round != 100; ++round) {
+        BOOST_REQUIRE(f.bounded_push(1));
+        BOOST_REQUIRE(f.bounded_push(2));
+        BOOST_REQUIRE(!f.bounded_push(3));
+
+        int out;
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, 1);
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, 2);
+        BOOST_REQUIRE(!f.pop(out));
+    }
+
+    f.reserve(1);
+    BOOST_REQUIRE(f.bounded_push(1));
+    BOOST_REQUIRE(f.bounded_push(2));
+    BOOST_REQUIRE(f.bounded_push(3));
+    BOOST_REQUIRE(!f.bounded_push(4));
+}
+
+template <typename Queue>
+void test_queue_reclamation_bulk_pop(void)
+{
+    Queue f(0);
+
+    int data[100];
+    for (int i = 0; i != 100; ++i)
+        data[i] = i;
+    BOOST_REQUIRE(f.push(data, data + 100) == data + 100);
+
+    int out[64];
+    BOOST_REQUIRE_EQUAL(f.pop(out, 64), 64u);
+    for (int i = 0; i != 64; ++i)
+        BOOST_REQUIRE_EQUAL(out[i], i);
+
+    int next = 64;
+    BOOST_REQUIRE_EQUAL(f.consume_all(test_sequence(next)), 36u);
+    BOOST_REQUIRE_EQUAL(next, 100);
+    BOOST_REQUIRE(f.empty());
+}
+
+template <typename Stack>
+void test_stack_reclamation(void)
+{
+    {
+        Stack s(64);
+        BOOST_WARN(s.is_lock_free());
+        BOOST_REQUIRE(s.empty());
+
+        for (long i = 0; i != 10000; ++i)
+            BOOST_REQUIRE(s.push(i));
+
+        for (long i = 9999; i >= 0; --i) {
+            long out;
+            BOOST_REQUIRE(s.pop(out));
+            BOOST_REQUIRE_EQUAL(out, i);
+        }
+        BOOST_REQUIRE(s.empty());
+        BOOST_REQUIRE_LT(allocated_nodes, 1000);
+
+        s.push(1);
+        s.push(2);
+        BOOST_REQUIRE_EQUAL(s.consume_all(dummy_functor()), 2u);
+    }
+    BOOST_REQUIRE_EQUAL(allocated_nodes, 0);
+}
+
+BOOST_AUTO_TEST_CASE( freelist_reclamation_keeps_nodes_test )
+{
+    {
+        queue<int, boost::lockfree::allocator<counting_allocator<void> > > f(0);
+        for (int i = 0; i != 1000; ++i)
+            f.push(i);
+
+        f.consume_all(dummy_functor());
+        BOOST_REQUIRE_EQUAL(allocated_nodes, 1001);
+    }
+    BOOST_REQUIRE_EQUAL(allocated_nodes, 0);
+}
+
+BOOST_AUTO_TEST_CASE( queue_hazard_pointer_test )
+{
+    typedef queue<int,
+                  boost::lockfree::allocator<counting_allocator<void> >,
+                  boost::lockfree::reclamation<hazard_pointer_reclamation>
+                 > queue_type;
+
+    test_queue_reclamation<queue_type>();
+    test_queue_reclamation_bounded<queue_type>();
+    test_queue_reclamation_bulk_pop<queue_type>();
+}
+
+BOOST_AUTO_TEST_CASE( queue_epoch_based_test )
+{
+    typedef queue<int,
+                  boost::lockfree::allocator<counting_allocator<void> >,
+                  boost::lockfree::reclamation<epoch_based_reclamation>
+                 > queue_type;
+
+    test_queue_reclamation<queue_type>();
+    test_queue_reclamation_bounded<queue_type>();
+    test_queue_reclamation_bulk_pop<queue_type>();
+}
+
+BOOST_AUTO_TEST_CASE( stack_hazard_pointer_test )
+{
+    test_stack_reclamation<stack<long,
+                                 boost::lockfree::allocator<counting_allocator<void> >,
+                                 boost::lockfree::reclamation<hazard_pointer_reclamation>
+                                > >();
+}
+
+BOOST_AUTO_TEST_CASE( stack_epoch_based_test )
+{
+    test_stack_reclamation<stack<long,
+                                 boost::lockfree::allocator<counting_allocator<void> >,
+                                 boost::lockfree::reclamation<epoch_based_reclamation>
+                                > >();
+}
@@ -209,3 +209,74 @@ BOOST_AUTO_TEST_CASE( spsc_queue_test_buffering )
     test1->run();
 }
 
+
+/* the writer writes sequence numbers in place through acquire_write/commit_write, the reader checks them in place
+ * through acquire_read/release_read */
+struct spsc_queue_tester_spans
+{
+    typedef spsc_queue<boost::uint32_t, capacity<127> > queue_type;
+    queue_type sf;
+
+    boost::lockfree::detail::atomic<bool> out_of_order;
+
+    spsc_queue_tester_spans(void):
+        out_of_order(false)
+    {}
+
+    static void fill(queue_type::span const & span, boost::uint32_t & next)
+    {
+        for (boost::uint32_t * it = span.begin(); it != span.end(); ++it)
+            *it = next++;
+    }
+
+    void add(void)
+    {
+        boost::uint32_t next = 0;
+        for (size_t burst = 1; next != nodes_per_thread; burst = burst % 200 + 7) {
+            queue_type::span_pair spans = sf.acquire_write((std::min)(burst, size_t(nodes_per_thread - next)));
+            fill(spans.first, next);
+            fill(spans.second, next);
+            sf.commit_write(spans.size());
+        }
+    }
+
+    bool check(queue_type::span const & span, boost::uint32_t & expected)
+    {
+        for (boost::uint32_t * it = span.begin(); it != span.end(); ++it)
+            if (*it != expected++)
+                return false;
+        return true;
+    }
+
+    void get(void)
+    {
+        boost::uint32_t expected = 0;
+        while (expected != nodes_per_thread) {
+            queue_type::span_pair spans = sf.acquire_read();
+            if (!check(spans.first, expected) || !check(spans.second, expected))
+                out_of_order = true;
+            /* release a part of the elements, the others are seen again by the next acquire_read */
+            size_t released = spans.size() > 3 ? spans.size() - 3 : spans.size();
+            expected -= spans.size() - released;
+            sf.release_read(released);
+        }
+    }
+
+    void run(void)
+    {
+        boost::thread reader(boost::bind(&spsc_queue_tester_spans::get, this));
+        boost::thread writer(boost::bind(&spsc_queue_tester_spans::add, this));
+
+        writer.join();
+        reader.join();
+
+        BOOST_REQUIRE(!out_of_order);
+        BOOST_REQUIRE(sf.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( spsc_queue_test_spans )
+{
+    boost::shared_ptr<spsc_queue_tester_spans> test1(new spsc_queue_tester_spans);
+    test1->run();
+}
@@ -15,6 +15,7 @@
 
 #include <iostream>
 #include <memory>
+#include <string>
 
 #include "test_helpers.hpp"
 #include "test_common.hpp"
@@ -341,3 +342,76 @@ BOOST_AUTO_TEST_CASE( spsc_queue_buffer_pop_test )
     spsc_queue_buffer_pop<reference_to_array, 7, 16, 64>();
     spsc_queue_buffer_pop<output_iterator_, 7, 16, 64>();
 }
+
+BOOST_AUTO_TEST_CASE( spsc_queue_span_test )
+{
+    typedef spsc_queue<int, capacity<8> > queue_type;
+    queue_type f;
+
+    /* move the indices, so that the spans wrap around */
+    int data[5] = {0, 1, 2, 3, 4};
+    BOOST_REQUIRE_EQUAL(f.push(data, 5), 5u);
+    BOOST_REQUIRE_EQUAL(f.pop(data, 5), 5u);
+
+    queue_type::span_pair w = f.acquire_write(6);
+    BOOST_REQUIRE_EQUAL(w.size(), 6u);
+    BOOST_REQUIRE_EQUAL(w.first.size(), 4u);
+    BOOST_REQUIRE_EQUAL(w.second.size(), 2u);
+
+    int value = 10;
+    for (int * it = w.first.begin(); it != w.first.end(); ++it)
+        *it = value++;
+    for (int * it = w.second.begin(); it != w.second.end(); ++it)
+        *it = value++;
+
+    BOOST_REQUIRE(f.acquire_read().empty());
+    f.commit_write(5);
+    BOOST_REQUIRE_EQUAL(f.read_available(), 5u);
+    BOOST_REQUIRE_EQUAL(f.acquire_write(8).size(), 3u);
+
+    queue_type::span_pair r = f.acquire_read();
+    BOOST_REQUIRE_EQUAL(r.size(), 5u);
+    BOOST_REQUIRE_EQUAL(r.first.size(), 4u);
+    BOOST_REQUIRE_EQUAL(r.first.begin(), w.first.begin());
+    BOOST_REQUIRE_EQUAL(r.second.size(), 1u);
+    BOOST_REQUIRE_EQUAL(r.first.begin()[0], 10);
+    BOOST_REQUIRE_EQUAL(r.second.begin()[0], 14);
+
+    f.release_read(3);
+    r = f.acquire_read();
+    BOOST_REQUIRE_EQUAL(r.size(), 2u);
+    BOOST_REQUIRE_EQUAL(r.first.begin()[0], 13);
+
+    f.release_read(2);
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(f.acquire_read().empty());
+}
+
+BOOST_AUTO_TEST_CASE( spsc_queue_span_non_trivial_test )
+{
+    typedef spsc_queue<std::string> queue_type;
+    queue_type f(4);
+
+    for (int round = 0; round != 3; ++round) {
+        queue_type::span_pair w = f.acquire_write(3);
+        BOOST_REQUIRE_EQUAL(w.size(), 3u);
+        for (std::string * it = w.first.begin(); it != w.first.end(); ++it)
+            new (it) std::string("element");
+        for (std::string * it = w.second.begin(); it != w.second.end(); ++it)
+            new (it) std::string("element");
+        f.commit_write(3);
+
+        queue_type::span_pair r = f.acquire_read();
+        BOOST_REQUIRE_EQUAL(r.size(), 3u);
+        BOOST_REQUIRE_EQUAL(*r.first.begin(), "element");
+        f.release_read(2);
+        std::string out;
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, "element");
+    }
+
+    /* the remaining elements are destroyed with the queue */
+    queue_type::span_pair w = f.acquire_write(1);
+    new (w.first.begin()) std::string("left over");
+    f.commit_write(1);
+}
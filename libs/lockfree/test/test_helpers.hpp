@@ -99,6 +99,21 @@ struct test_equal
     int i;
 };
 
+struct test_sequence
+{
+    test_sequence(int & next):
+        next(next)
+    {}
+
+    void operator()(int arg) const
+    {
+        BOOST_REQUIRE_EQUAL(arg, next);
+        ++next;
+    }
+
+    int & next;
+};
+
 struct dummy_functor
 {
     void operator()(int /* arg */) const
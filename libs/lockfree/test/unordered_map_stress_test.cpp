@@ -0,0 +1,107 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/unordered_map.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace std;
+
+#ifndef BOOST_LOCKFREE_STRESS_TEST
+static const long rounds = 20;
+#else
+static const long rounds = 2000;
+#endif
+
+static const long keys_per_thread = 1000;
+static const int thread_count = 4;
+
+typedef lockfree::unordered_map<long, long> map_type;
+
+struct unordered_map_stress_tester
+{
+    map_type map;
+    lockfree::detail::atomic<long> shared_inserted, shared_erased;
+    lockfree::detail::atomic<bool> failed;
+
+    unordered_map_stress_tester(void):
+        shared_inserted(0), shared_erased(0), failed(false)
+    {}
+
+    void check(bool condition)
+    {
+        if (!condition)
+            failed.store(true);
+    }
+
+    /* each thread owns a range of keys, in which the results of all operations are known, and it inserts and erases
+     * keys of a range that is shared by all threads */
+    void run_thread(int id)
+    {
+        const long own_begin = (id + 1) * keys_per_thread;
+        const long own_end = own_begin + keys_per_thread;
+
+        for (long round = 0; round != rounds; ++round) {
+            for (long key = own_begin; key != own_end; ++key)
+                check(map.insert(key, key * 3));
+
+            for (long key = 0; key != keys_per_thread; ++key) {
+                if (map.insert(key, key * 3))
+                    ++shared_inserted;
+
+                long value;
+                if (map.find(key, value))
+                    check(value == key * 3);
+            }
+
+            for (long key = own_begin; key != own_end; ++key) {
+                long value = 0;
+                check(map.find(key, value));
+                check(value == key * 3);
+                check(map.erase(key));
+                check(!map.contains(key));
+            }
+
+            for (long key = id; key < keys_per_thread; key += thread_count)
+                if (map.erase(key))
+                    ++shared_erased;
+        }
+    }
+
+    void run(void)
+    {
+        thread_group threads;
+        for (int i = 0; i != thread_count; ++i)
+            threads.create_thread(boost::bind(&unordered_map_stress_tester::run_thread, this, i));
+        threads.join_all();
+
+        BOOST_REQUIRE(!failed.load());
+
+        long remaining = 0;
+        for (long key = 0; key != keys_per_thread; ++key)
+            remaining += map.contains(key) ? 1 : 0;
+
+        BOOST_REQUIRE_EQUAL(remaining, shared_inserted.load() - shared_erased.load());
+        BOOST_REQUIRE_EQUAL((long)map.size(), remaining);
+    }
+};
+
+BOOST_AUTO_TEST_CASE( unordered_map_stress_test )
+{
+    boost::scoped_ptr<unordered_map_stress_tester> tester(new unordered_map_stress_tester);
+    tester->run();
+}
@@ -0,0 +1,125 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/unordered_map.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( simple_unordered_map_test )
+{
+    lockfree::unordered_map<int, long> m;
+
+    BOOST_WARN(m.is_lock_free());
+    BOOST_REQUIRE(m.empty());
+
+    BOOST_REQUIRE(m.insert(1, 10));
+    BOOST_REQUIRE(m.insert(2, 20));
+    BOOST_REQUIRE(!m.insert(1, 11));
+    BOOST_REQUIRE_EQUAL(m.size(), 2u);
+
+    long out = 0;
+    BOOST_REQUIRE(m.find(1, out));
+    BOOST_REQUIRE_EQUAL(out, 10);
+    BOOST_REQUIRE(m.find(2, out));
+    BOOST_REQUIRE_EQUAL(out, 20);
+    BOOST_REQUIRE(!m.find(3, out));
+    BOOST_REQUIRE_EQUAL(out, 20);
+
+    BOOST_REQUIRE(m.contains(1));
+    BOOST_REQUIRE_EQUAL(m.count(3), 0u);
+
+    BOOST_REQUIRE(m.erase(1));
+    BOOST_REQUIRE(!m.erase(1));
+    BOOST_REQUIRE(!m.contains(1));
+    BOOST_REQUIRE(m.contains(2));
+
+    BOOST_REQUIRE(m.erase(2));
+    BOOST_REQUIRE(m.empty());
+}
+
+BOOST_AUTO_TEST_CASE( unordered_map_resize_test )
+{
+    lockfree::unordered_map<long, long> m;
+    const size_t initial_buckets = m.bucket_count();
+
+    for (long i = 0; i != 10000; ++i)
+        BOOST_REQUIRE(m.insert(i, -i));
+
+    BOOST_REQUIRE_EQUAL(m.size(), 10000u);
+    BOOST_REQUIRE_GT(m.bucket_count(), initial_buckets);
+    BOOST_REQUIRE_GE(m.bucket_count() * 2, 10000u / 2);
+
+    for (long i = 0; i != 10000; ++i) {
+        long out;
+        BOOST_REQUIRE(m.find(i, out));
+        BOOST_REQUIRE_EQUAL(out, -i);
+    }
+
+    for (long i = 0; i != 10000; i += 2)
+        BOOST_REQUIRE(m.erase(i));
+
+    BOOST_REQUIRE_EQUAL(m.size(), 5000u);
+    for (long i = 0; i != 10000; ++i)
+        BOOST_REQUIRE_EQUAL(m.contains(i), i % 2 == 1);
+
+    /* erased nodes are reused */
+    for (long i = 0; i != 10000; i += 2)
+        BOOST_REQUIRE(m.insert(i, i));
+    for (long i = 0; i != 10000; ++i) {
+        long out;
+        BOOST_REQUIRE(m.find(i, out));
+        BOOST_REQUIRE_EQUAL(out, i % 2 ? -i : i);
+    }
+}
+
+/* all keys collide, so the elements are only told apart by the key comparison */
+struct constant_hash
+{
+    size_t operator()(int) const
+    {
+        return 42;
+    }
+};
+
+BOOST_AUTO_TEST_CASE( unordered_map_collision_test )
+{
+    lockfree::unordered_map<int, int, constant_hash> m(64);
+
+    for (int i = 0; i != 100; ++i)
+        BOOST_REQUIRE(m.insert(i, i * 2));
+    BOOST_REQUIRE(!m.insert(50, 0));
+
+    for (int i = 0; i < 100; i += 3)
+        BOOST_REQUIRE(m.erase(i));
+
+    for (int i = 0; i != 100; ++i) {
+        int out;
+        BOOST_REQUIRE_EQUAL(m.find(i, out), i % 3 != 0);
+        if (i % 3)
+            BOOST_REQUIRE_EQUAL(out, i * 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( unordered_map_reserve_test )
+{
+    lockfree::unordered_map<int, int> m(1000);
+    BOOST_REQUIRE_GE(m.bucket_count() * 2, 1000u);
+
+    m.reserve(100);
+    BOOST_REQUIRE(m.insert(1, 1));
+    BOOST_REQUIRE(m.contains(1));
+}
@@ -0,0 +1,144 @@
+/* Copyright (C) 2013 John Maddock
+*
+* Use, modification and distribution is subject to the
+* Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+// Tests singleton_pool's per-thread caches, with chunks freed by other
+// threads than the ones that allocated them, and pool's ordered_free().
+
+#include <boost/pool/pool.hpp>
+#include <boost/pool/singleton_pool.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+#include "track_allocator.hpp"
+
+#include <cstddef>
+#include <vector>
+
+struct cache_test_tag { };
+typedef boost::singleton_pool<cache_test_tag, sizeof(std::size_t),
+    track_allocator> cache_pool;
+
+const std::size_t chunks_per_thread = 20000;
+const int num_threads = 4;
+
+// Chunks allocated by one thread and waiting to be freed by the next one.
+boost::mutex handoff_mutex;
+std::vector<std::size_t*> handoff[num_threads];
+
+void run_thread(int n)
+{
+    std::vector<std::size_t*> mine;
+    for(std::size_t i = 0; i < chunks_per_thread; ++i)
+    {
+        std::size_t* p = static_cast<std::size_t*>(cache_pool::malloc());
+        BOOST_TEST(p != 0);
+        *p = n * chunks_per_thread + i;
+        mine.push_back(p);
+
+        // Free some of them straight away, so that the same chunks
+        //  keep moving through this thread's cache.
+        if(i % 3 == 0)
+        {
+            BOOST_TEST(*mine.back() == n * chunks_per_thread + i);
+            cache_pool::free(mine.back());
+            mine.pop_back();
+        }
+    }
+
+    // Check that no chunk was handed out twice, then give the rest to
+    //  the next thread.
+    for(std::size_t i = 0; i < mine.size(); ++i)
+    {
+        BOOST_TEST(*mine[i] / chunks_per_thread == static_cast<std::size_t>(n));
+    }
+    {
+        boost::mutex::scoped_lock lock(handoff_mutex);
+        handoff[(n + 1) % num_threads].swap(mine);
+    }
+}
+
+void free_handoff(int n)
+{
+    boost::mutex::scoped_lock lock(handoff_mutex);
+    for(std::size_t i = 0; i < handoff[n].size(); ++i)
+    {
+        BOOST_TEST(*handoff[n][i] / chunks_per_thread
+            == static_cast<std::size_t>((n + num_threads - 1) % num_threads));
+        cache_pool::free(handoff[n][i]);
+    }
+    handoff[n].clear();
+}
+
+void test_threads()
+{
+    {
+        boost::thread_group threads;
+        for(int i = 0; i < num_threads; ++i)
+            threads.create_thread(boost::bind(&run_thread, i));
+        threads.join_all();
+    }
+    {
+        boost::thread_group threads;
+        for(int i = 0; i < num_threads; ++i)
+            threads.create_thread(boost::bind(&free_handoff, i));
+        threads.join_all();
+    }
+
+    // Every chunk has been freed and the threads have exited, so all the
+    //  memory can be given back.
+    BOOST_TEST(cache_pool::release_memory());
+    BOOST_TEST(track_allocator::ok());
+
+    // Chunks in this thread's cache are forgotten by purge_memory().
+    void* p = cache_pool::malloc();
+    cache_pool::free(p);
+    BOOST_TEST(cache_pool::purge_memory());
+    BOOST_TEST(track_allocator::ok());
+    p = cache_pool::malloc();
+    BOOST_TEST(p != 0);
+    BOOST_TEST(cache_pool::is_from(p));
+    cache_pool::free(p);
+    BOOST_TEST(cache_pool::release_memory());
+    BOOST_TEST(track_allocator::ok());
+}
+
+void test_ordered_free()
+{
+    boost::pool<track_allocator> p(sizeof(int), 64);
+    std::vector<void*> chunks;
+    for(int i = 0; i < 1000; ++i)
+        chunks.push_back(p.ordered_malloc());
+
+    // Free alternate chunks in increasing order, then the rest in
+    //  decreasing order, and allocate runs in between.
+    for(std::size_t i = 0; i < chunks.size(); i += 2)
+        p.ordered_free(chunks[i]);
+    void* pair = p.ordered_malloc(2);
+    BOOST_TEST(pair != 0);
+    for(std::size_t i = chunks.size() - 1; i < chunks.size(); i -= 2)
+        p.ordered_free(chunks[i]);
+
+    // The free list must still be in order: a run of 100 chunks fits in
+    //  the memory we freed, and once everything is freed every block
+    //  can be released.
+    void* run = p.ordered_malloc(100);
+    BOOST_TEST(run != 0);
+    BOOST_TEST(p.is_from(run));
+    p.ordered_free(run, 100);
+    p.ordered_free(pair, 2);
+    BOOST_TEST(p.release_memory());
+    BOOST_TEST(track_allocator::ok());
+}
+
+int main()
+{
+    test_threads();
+    test_ordered_free();
+    return boost::report_errors();
+}
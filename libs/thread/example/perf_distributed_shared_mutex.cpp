@@ -0,0 +1,97 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Scaling test of shared_mutex and distributed_shared_mutex with 1 to 64 reader threads taking the shared lock in
+// a loop, while a writer thread takes the exclusive lock once per millisecond.
+
+#define BOOST_THREAD_USES_CHRONO
+
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/distributed_shared_mutex.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <boost/atomic.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+const int cycles = 100000;
+
+typedef boost::chrono::high_resolution_clock clock_type;
+
+template <typename Mutex>
+struct test
+{
+  static Mutex* mtx;
+  static int value;
+  static boost::atomic<bool> done;
+
+  static void reader()
+  {
+    int sum = 0;
+    for (int i = 0; i < cycles; ++i)
+    {
+      boost::shared_lock<Mutex> lock(*mtx);
+      sum += value;
+    }
+    if (sum < 0)
+    {
+      std::cout << sum << std::endl;
+    }
+  }
+
+  static void writer()
+  {
+    while (!done.load(boost::memory_order_relaxed))
+    {
+      {
+        boost::unique_lock<Mutex> lock(*mtx);
+        ++value;
+      }
+      boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+    }
+  }
+
+  static void run(const char* name, int readers)
+  {
+    Mutex m;
+    mtx = &m;
+    done = false;
+    boost::thread w(&writer);
+    clock_type::time_point start = clock_type::now();
+    std::vector<boost::thread*> threads;
+    for (int i = 0; i < readers; ++i)
+    {
+      threads.push_back(new boost::thread(&reader));
+    }
+    for (int i = 0; i < readers; ++i)
+    {
+      threads[i]->join();
+      delete threads[i];
+    }
+    clock_type::duration elapsed = clock_type::now() - start;
+    done = true;
+    w.join();
+    std::cout << name << " readers=" << readers << ": "
+        << boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed) / (static_cast<long>(cycles) * readers)
+        << " per shared lock" << std::endl;
+  }
+};
+
+template <typename Mutex> Mutex* test<Mutex>::mtx;
+template <typename Mutex> int test<Mutex>::value;
+template <typename Mutex> boost::atomic<bool> test<Mutex>::done;
+
+int main(int argc, char* argv[])
+{
+  int max_readers = argc > 1 ? std::atoi(argv[1]) : 64;
+  for (int readers = 1; readers <= max_readers; readers *= 2)
+  {
+    test<boost::shared_mutex>::run("shared_mutex", readers);
+    test<boost::distributed_shared_mutex>::run("distributed_shared_mutex", readers);
+  }
+  return 0;
+}
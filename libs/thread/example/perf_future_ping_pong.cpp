@@ -0,0 +1,83 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Performance test of the promise/future fast path: a value set on a promise and got from its future on the same
+// thread, and a ping-pong between two threads where each round trip goes through two promise/future pairs.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <iostream>
+#include <vector>
+
+const int rounds = 200000;
+
+typedef boost::chrono::high_resolution_clock clock_type;
+
+std::vector<boost::promise<int> >* pings;
+std::vector<boost::promise<int> >* pongs;
+
+void ponger()
+{
+  for (int i = 0; i < rounds; ++i)
+  {
+    int v = (*pings)[i].get_future().get();
+    (*pongs)[i].set_value(v + 1);
+  }
+}
+
+int main()
+{
+  {
+    clock_type::time_point start = clock_type::now();
+    long sum = 0;
+    for (int i = 0; i < rounds; ++i)
+    {
+      boost::promise<int> p;
+      boost::future<int> f = p.get_future();
+      p.set_value(i);
+      sum += f.get();
+    }
+    clock_type::duration elapsed = clock_type::now() - start;
+    std::cout << "set then get, same thread: "
+        << boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed) / rounds << " per round" << std::endl;
+    if (sum != static_cast<long>(rounds) * (rounds - 1) / 2)
+    {
+      std::cout << "wrong result" << std::endl;
+    }
+  }
+
+  {
+    std::vector<boost::promise<int> > ping(rounds);
+    std::vector<boost::promise<int> > pong(rounds);
+    std::vector<boost::future<int> > pong_futures;
+    pong_futures.reserve(rounds);
+    for (int i = 0; i < rounds; ++i)
+    {
+      pong_futures.push_back(pong[i].get_future());
+    }
+    pings = &ping;
+    pongs = &pong;
+
+    clock_type::time_point start = clock_type::now();
+    boost::thread t(&ponger);
+    for (int i = 0; i < rounds; ++i)
+    {
+      ping[i].set_value(i);
+      if (pong_futures[i].get() != i + 1)
+      {
+        std::cout << "wrong result" << std::endl;
+      }
+    }
+    t.join();
+    clock_type::duration elapsed = clock_type::now() - start;
+    std::cout << "ping-pong between two threads: "
+        << boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed) / rounds << " per round trip"
+        << std::endl;
+  }
+  return 0;
+}
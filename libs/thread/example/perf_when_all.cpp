@@ -0,0 +1,85 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Performance test of when_all and when_any fanning in 200 futures, compared with waiting for them with
+// wait_for_all. The futures are made ready by another thread.
+
+#define BOOST_THREAD_VERSION 4
+#include <boost/config.hpp>
+
+#if ! defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY \
+ && ! defined BOOST_THREAD_DONT_PROVIDE_FUTURE_WHEN_ALL_WHEN_ANY \
+ && ! defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) \
+ && ! defined(BOOST_NO_CXX11_HDR_TUPLE)
+#define BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+#endif
+
+#include <boost/thread/future.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <iostream>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+
+const int fan_out = 200;
+const int rounds = 2000;
+
+typedef boost::chrono::high_resolution_clock clock_type;
+typedef boost::csbl::vector<boost::future<int> > futures;
+
+void set_values(boost::csbl::vector<boost::promise<int> >* promises)
+{
+  for (int i = 0; i < fan_out; ++i)
+  {
+    (*promises)[i].set_value(i);
+  }
+}
+
+enum kind { all, any, wait_all };
+
+void run(const char* name, kind k)
+{
+  clock_type::duration elapsed(0);
+  for (int r = 0; r < rounds; ++r)
+  {
+    boost::csbl::vector<boost::promise<int> > promises(fan_out);
+    futures v;
+    v.reserve(fan_out);
+    for (int i = 0; i < fan_out; ++i)
+    {
+      v.push_back(promises[i].get_future());
+    }
+    clock_type::time_point start = clock_type::now();
+    boost::thread t(&set_values, &promises);
+    if (k == wait_all)
+    {
+      boost::wait_for_all(v.begin(), v.end());
+    }
+    else
+    {
+      boost::future<futures> f = k == all ? boost::when_all(v.begin(), v.end()) : boost::when_any(v.begin(), v.end());
+      f.wait();
+    }
+    t.join();
+    elapsed += clock_type::now() - start;
+  }
+  std::cout << name << " of " << fan_out << " futures: "
+      << boost::chrono::duration_cast<boost::chrono::microseconds>(elapsed) / rounds << " per round" << std::endl;
+}
+
+int main()
+{
+  run("wait_for_all", wait_all);
+  run("when_all", all);
+  run("when_any", any);
+  return 0;
+}
+
+#else
+int main()
+{
+  return 0;
+}
+#endif
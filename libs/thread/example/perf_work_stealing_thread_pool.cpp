@@ -0,0 +1,181 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Fork-join performance test comparing thread_pool and work_stealing_thread_pool on a recursive fibonacci and a
+// parallel quicksort. Each task submits one half of its work and runs the other half, then runs other tasks while
+// waiting for the submitted half to complete.
+
+#define BOOST_THREAD_VERSION 4
+#define BOOST_THREAD_QUEUE_DEPRECATE_OLD
+
+#include <boost/thread/thread_pool.hpp>
+#include <boost/thread/work_stealing_thread_pool.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <boost/atomic.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+const int fib_n = 34;
+const int fib_cutoff = 16;
+const std::size_t sort_size = 1 << 21;
+const std::size_t sort_cutoff = 1 << 12;
+
+template <typename Pool>
+void wait_for(Pool& pool, boost::atomic<bool> const& done)
+{
+  while (!done.load(boost::memory_order_acquire))
+  {
+    if (!pool.try_executing_one())
+    {
+      boost::this_thread::yield();
+    }
+  }
+}
+
+long serial_fib(int n)
+{
+  return n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2);
+}
+
+template <typename Pool>
+struct fib_task
+{
+  Pool* pool;
+  int n;
+  long* result;
+  boost::atomic<bool>* done;
+
+  void operator()() const
+  {
+    *result = fib(*pool, n);
+    done->store(true, boost::memory_order_release);
+  }
+
+  static long fib(Pool& pool, int n)
+  {
+    if (n < fib_cutoff)
+    {
+      return serial_fib(n);
+    }
+    long r1 = 0;
+    boost::atomic<bool> done(false);
+    fib_task child = { &pool, n - 1, &r1, &done };
+    pool.submit(child);
+    long r2 = fib(pool, n - 2);
+    wait_for(pool, done);
+    return r1 + r2;
+  }
+};
+
+template <typename Pool>
+struct sort_task
+{
+  Pool* pool;
+  int* first;
+  int* last;
+  boost::atomic<bool>* done;
+
+  void operator()() const
+  {
+    sort(*pool, first, last);
+    done->store(true, boost::memory_order_release);
+  }
+
+  static void sort(Pool& pool, int* first, int* last)
+  {
+    if (static_cast<std::size_t>(last - first) < sort_cutoff)
+    {
+      std::sort(first, last);
+      return;
+    }
+    int pivot = first[(last - first) / 2];
+    int* middle1 = std::partition(first, last, less_than(pivot));
+    int* middle2 = std::partition(middle1, last, not_greater_than(pivot));
+    boost::atomic<bool> done(false);
+    sort_task child = { &pool, first, middle1, &done };
+    pool.submit(child);
+    sort(pool, middle2, last);
+    wait_for(pool, done);
+  }
+
+  struct less_than
+  {
+    int pivot;
+    explicit less_than(int p) : pivot(p) {}
+    bool operator()(int x) const { return x < pivot; }
+  };
+  struct not_greater_than
+  {
+    int pivot;
+    explicit not_greater_than(int p) : pivot(p) {}
+    bool operator()(int x) const { return !(pivot < x); }
+  };
+};
+
+/// Runs a task on the pool from outside of it and waits for its completion.
+template <typename Pool, typename Task>
+void run_root(Pool& pool, Task task, boost::atomic<bool>& done)
+{
+  pool.submit(task);
+  while (!done.load(boost::memory_order_acquire))
+  {
+    boost::this_thread::yield();
+  }
+}
+
+template <typename Pool>
+void run(const char* name, unsigned threads)
+{
+  typedef boost::chrono::high_resolution_clock clock;
+  Pool pool(threads);
+
+  {
+    long result = 0;
+    boost::atomic<bool> done(false);
+    fib_task<Pool> task = { &pool, fib_n, &result, &done };
+    clock::time_point start = clock::now();
+    run_root(pool, task, done);
+    clock::duration elapsed = clock::now() - start;
+    if (result != serial_fib(fib_n))
+    {
+      std::cout << "wrong result" << std::endl;
+    }
+    std::cout << name << " threads=" << threads << " fib(" << fib_n << "): "
+        << boost::chrono::duration_cast<boost::chrono::milliseconds>(elapsed) << std::endl;
+  }
+
+  {
+    std::vector<int> v(sort_size);
+    std::srand(1);
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+      v[i] = std::rand();
+    }
+    boost::atomic<bool> done(false);
+    sort_task<Pool> task = { &pool, &v[0], &v[0] + v.size(), &done };
+    clock::time_point start = clock::now();
+    run_root(pool, task, done);
+    clock::duration elapsed = clock::now() - start;
+    if (!std::is_sorted(v.begin(), v.end()))
+    {
+      std::cout << "not sorted" << std::endl;
+    }
+    std::cout << name << " threads=" << threads << " quicksort(" << sort_size << "): "
+        << boost::chrono::duration_cast<boost::chrono::milliseconds>(elapsed) << std::endl;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned max_threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2)
+  {
+    run<boost::thread_pool>("thread_pool", threads);
+    run<boost::work_stealing_thread_pool>("work_stealing_thread_pool", threads);
+  }
+  return 0;
+}
@@ -0,0 +1,127 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_THREAD_VERSION 4
+#define BOOST_THREAD_PROVIDES_EXECUTORS
+#define BOOST_THREAD_QUEUE_DEPRECATE_OLD
+
+#include <boost/thread/work_stealing_thread_pool.hpp>
+#include <boost/thread/executor.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+boost::atomic<int> count(0);
+
+void p1()
+{
+  ++count;
+}
+
+/// Computes fib(n) by submitting fib(n-1) to the pool and computing fib(n-2) on the current thread.
+struct fib_task
+{
+  boost::work_stealing_thread_pool* pool;
+  int n;
+  long* result;
+  boost::atomic<bool>* done;
+
+  void operator()() const
+  {
+    *result = fib(*pool, n);
+    done->store(true, boost::memory_order_release);
+  }
+
+  static long fib(boost::work_stealing_thread_pool& pool, int n)
+  {
+    if (n < 2)
+    {
+      return n;
+    }
+    long r1 = 0;
+    boost::atomic<bool> done(false);
+    fib_task child = { &pool, n - 1, &r1, &done };
+    pool.submit(child);
+    long r2 = fib(pool, n - 2);
+    while (!done.load(boost::memory_order_acquire))
+    {
+      if (!pool.try_executing_one())
+      {
+        boost::this_thread::yield();
+      }
+    }
+    return r1 + r2;
+  }
+};
+
+struct fib_root
+{
+  boost::work_stealing_thread_pool* pool;
+  int n;
+  long* result;
+  boost::atomic<bool>* done;
+
+  void operator()() const
+  {
+    *result = fib_task::fib(*pool, n);
+    done->store(true, boost::memory_order_release);
+  }
+};
+
+int the_answer()
+{
+  return 42;
+}
+
+int main()
+{
+  {
+    boost::work_stealing_thread_pool tp(4);
+    for (int i = 0; i < 1000; ++i)
+    {
+      tp.submit(&p1);
+    }
+  }
+  BOOST_TEST_EQ(count.load(), 1000);
+
+  {
+    boost::work_stealing_thread_pool tp(3);
+    long result = 0;
+    boost::atomic<bool> done(false);
+    fib_root root = { &tp, 20, &result, &done };
+    tp.submit(root);
+    while (!done.load(boost::memory_order_acquire))
+    {
+      boost::this_thread::yield();
+    }
+    BOOST_TEST_EQ(result, 6765);
+  }
+
+  {
+    boost::work_stealing_thread_pool tp(2);
+    tp.close();
+    BOOST_TEST(tp.closed());
+    bool thrown = false;
+    try
+    {
+      tp.submit(&p1);
+    }
+    catch (boost::sync_queue_is_closed&)
+    {
+      thrown = true;
+    }
+    BOOST_TEST(thrown);
+  }
+
+  {
+    boost::executor_adaptor<boost::work_stealing_thread_pool> ea(2);
+    boost::executor& ex = ea;
+    boost::future<int> f = boost::async(ex, &the_answer);
+    BOOST_TEST_EQ(f.get(), 42);
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,73 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// class future<R>
+
+// template<typename F>
+// auto then(launch policy, F&& func) -> future<decltype(func(*this))>;
+
+// A continuation attached while the promise is being satisfied is launched once.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+
+boost::atomic<int> calls(0);
+boost::atomic<int> arrived(0);
+
+int twice(boost::future<int> f)
+{
+  ++calls;
+  return 2 * f.get();
+}
+
+// Waits until both threads have arrived, so that they race.
+void rendezvous()
+{
+  ++arrived;
+  while (arrived.load() < 2)
+  {
+    boost::this_thread::yield();
+  }
+}
+
+void set_value(boost::promise<int>* p)
+{
+  rendezvous();
+  p->set_value(1);
+}
+
+int main()
+{
+  for (int i = 0; i < 10000; ++i)
+  {
+    calls = 0;
+    arrived = 0;
+    boost::promise<int> p;
+    boost::future<int> f1 = p.get_future();
+    boost::thread t(&set_value, &p);
+    rendezvous();
+    boost::future<int> f2 = f1.then(boost::launch::async, &twice);
+    BOOST_TEST(f2.get() == 2);
+    t.join();
+    BOOST_TEST(calls == 1);
+  }
+  return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,124 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// template< typename InputIterator>
+// future<vector<typename InputIterator::value_type>  >
+//   when_all(InputIterator first, InputIterator last)
+
+#define BOOST_THREAD_VERSION 4
+#include <boost/config.hpp>
+
+#if ! defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY \
+ && ! defined BOOST_THREAD_DONT_PROVIDE_FUTURE_WHEN_ALL_WHEN_ANY \
+ && ! defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) \
+ && ! defined(BOOST_NO_CXX11_HDR_TUPLE)
+#define BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+#endif
+
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+
+int p1()
+{
+  return 123;
+}
+
+void set_3(boost::promise<int>* p)
+{
+  p->set_value(3);
+}
+
+int main()
+{
+  { // invalid future
+    boost::csbl::vector<boost::future<int> > v;
+    v.push_back(boost::future<int>());
+    boost::future<boost::csbl::vector<boost::future<int> > > all = boost::when_all(v.begin(), v.end());
+    BOOST_TEST(all.is_ready());
+  }
+  { // ready futures
+    boost::csbl::vector<boost::future<int> > v;
+    v.push_back(boost::make_ready_future(1));
+    v.push_back(boost::make_ready_future(2));
+    boost::future<boost::csbl::vector<boost::future<int> > > all = boost::when_all(v.begin(), v.end());
+    BOOST_TEST(all.is_ready());
+    boost::csbl::vector<boost::future<int> > res = all.get();
+    BOOST_TEST(res.size() == 2);
+    BOOST_TEST(res[0].get() == 1);
+    BOOST_TEST(res[1].get() == 2);
+  }
+  { // futures made ready by the current thread, without any thread waiting for them
+    const int n = 200;
+    boost::csbl::vector<boost::promise<int> > p(n);
+    boost::csbl::vector<boost::future<int> > v;
+    for (int i = 0; i < n; ++i)
+    {
+      v.push_back(p[i].get_future());
+    }
+    boost::future<boost::csbl::vector<boost::future<int> > > all = boost::when_all(v.begin(), v.end());
+    for (int i = 0; i < n; ++i)
+    {
+      BOOST_TEST(! all.is_ready());
+      p[i].set_value(i);
+    }
+    BOOST_TEST(all.is_ready());
+    boost::csbl::vector<boost::future<int> > res = all.get();
+    BOOST_TEST(res.size() == static_cast<std::size_t>(n));
+    for (int i = 0; i < n; ++i)
+    {
+      BOOST_TEST(res[i].get() == i);
+    }
+  }
+  { // exceptional and broken futures
+    boost::promise<int> p1;
+    boost::csbl::vector<boost::future<int> > v;
+    v.push_back(p1.get_future());
+    {
+      boost::promise<int> p2;
+      v.push_back(p2.get_future());
+    }
+    boost::future<boost::csbl::vector<boost::future<int> > > all = boost::when_all(v.begin(), v.end());
+    BOOST_TEST(! all.is_ready());
+    p1.set_exception(boost::copy_exception(std::runtime_error("")));
+    BOOST_TEST(all.is_ready());
+    boost::csbl::vector<boost::future<int> > res = all.get();
+    BOOST_TEST(res[0].has_exception());
+    BOOST_TEST(res[1].has_exception());
+  }
+  { // shared futures, ready by another thread
+    boost::promise<int> p;
+    boost::shared_future<int> sf = p.get_future().share();
+    boost::csbl::vector<boost::shared_future<int> > v;
+    v.push_back(sf);
+    v.push_back(sf);
+    boost::future<boost::csbl::vector<boost::shared_future<int> > > all = boost::when_all(v.begin(), v.end());
+    boost::thread t(&set_3, &p);
+    boost::csbl::vector<boost::shared_future<int> > res = all.get();
+    t.join();
+    BOOST_TEST(res[0].get() == 3);
+    BOOST_TEST(res[1].get() == 3);
+  }
+  { // deferred future
+    boost::csbl::vector<boost::future<int> > v;
+    v.push_back(boost::async(boost::launch::deferred, &p1));
+    v.push_back(boost::make_ready_future(1));
+    boost::future<boost::csbl::vector<boost::future<int> > > all = boost::when_all(v.begin(), v.end());
+    boost::csbl::vector<boost::future<int> > res = all.get();
+    BOOST_TEST(res[0].get() == 123);
+    BOOST_TEST(res[1].get() == 1);
+  }
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return 0;
+}
+#endif
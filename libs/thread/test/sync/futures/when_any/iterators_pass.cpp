@@ -0,0 +1,134 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// template< typename InputIterator>
+// future<vector<typename InputIterator::value_type>  >
+//   when_any(InputIterator first, InputIterator last)
+
+
+#define BOOST_THREAD_VERSION 4
+#include <boost/config.hpp>
+
+#if ! defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY \
+ && ! defined BOOST_THREAD_DONT_PROVIDE_FUTURE_WHEN_ALL_WHEN_ANY \
+ && ! defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) \
+ && ! defined(BOOST_NO_CXX11_HDR_TUPLE)
+#define BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+#endif
+
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+
+int p1()
+{
+  return 123;
+}
+
+void set_3(boost::promise<int>* p)
+{
+  p->set_value(3);
+}
+
+int main()
+{
+  { // one ready future
+    boost::promise<int> p;
+    boost::csbl::vector<boost::future<int> > v;
+    v.push_back(p.get_future());
+    v.push_back(boost::make_ready_future(1));
+    boost::future<boost::csbl::vector<boost::future<int> > > any = boost::when_any(v.begin(), v.end());
+    BOOST_TEST(any.is_ready());
+    boost::csbl::vector<boost::future<int> > res = any.get();
+    BOOST_TEST(res.size() == 2);
+    BOOST_TEST(! res[0].is_ready());
+    BOOST_TEST(res[1].get() == 1);
+    p.set_value(0);
+    BOOST_TEST(res[0].get() == 0);
+  }
+  { // futures made ready by the current thread, without any thread waiting for them
+    const int n = 200;
+    boost::csbl::vector<boost::promise<int> > p(n);
+    boost::csbl::vector<boost::future<int> > v;
+    for (int i = 0; i < n; ++i)
+    {
+      v.push_back(p[i].get_future());
+    }
+    boost::future<boost::csbl::vector<boost::future<int> > > any = boost::when_any(v.begin(), v.end());
+    BOOST_TEST(! any.is_ready());
+    p[n / 2].set_value(n / 2);
+    BOOST_TEST(any.is_ready());
+    boost::csbl::vector<boost::future<int> > res = any.get();
+    BOOST_TEST(res.size() == static_cast<std::size_t>(n));
+    BOOST_TEST(res[n / 2].get() == n / 2);
+    // the other futures can still be made ready after the result has been got.
+    for (int i = 0; i < n; ++i)
+    {
+      if (i != n / 2)
+      {
+        p[i].set_value(i);
+        BOOST_TEST(res[i].get() == i);
+      }
+    }
+  }
+  { // the result outlived by the futures
+    boost::promise<int> p1;
+    boost::promise<int> p2;
+    boost::csbl::vector<boost::future<int> > v;
+    v.push_back(p1.get_future());
+    v.push_back(p2.get_future());
+    {
+      boost::future<boost::csbl::vector<boost::future<int> > > any = boost::when_any(v.begin(), v.end());
+    }
+    p2.set_value(2);
+    p1.set_value(1);
+  }
+  { // broken future
+    boost::promise<int> p1;
+    boost::csbl::vector<boost::future<int> > v;
+    v.push_back(p1.get_future());
+    boost::future<boost::csbl::vector<boost::future<int> > > any = boost::when_any(v.begin(), v.end());
+    BOOST_TEST(! any.is_ready());
+    {
+      boost::promise<int> p2(boost::move(p1));
+    }
+    BOOST_TEST(any.is_ready());
+    boost::csbl::vector<boost::future<int> > res = any.get();
+    BOOST_TEST(res[0].has_exception());
+  }
+  { // shared future, ready by another thread
+    boost::promise<int> p;
+    boost::promise<int> p2;
+    boost::csbl::vector<boost::shared_future<int> > v;
+    v.push_back(p.get_future().share());
+    v.push_back(p2.get_future().share());
+    boost::future<boost::csbl::vector<boost::shared_future<int> > > any = boost::when_any(v.begin(), v.end());
+    boost::thread t(&set_3, &p);
+    boost::csbl::vector<boost::shared_future<int> > res = any.get();
+    t.join();
+    BOOST_TEST(res[0].get() == 3);
+  }
+  { // deferred future
+    boost::promise<int> p;
+    boost::csbl::vector<boost::future<int> > v;
+    v.push_back(p.get_future());
+    v.push_back(boost::async(boost::launch::deferred, &p1));
+    boost::future<boost::csbl::vector<boost::future<int> > > any = boost::when_any(v.begin(), v.end());
+    boost::csbl::vector<boost::future<int> > res = any.get();
+    BOOST_TEST(res[1].get() == 123);
+  }
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,105 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// template <typename T0, typename ...T>
+// future<vector<future<R>>>
+//   when_any(T0&& f, T&&... futures);
+
+
+#define BOOST_THREAD_VERSION 4
+#include <boost/config.hpp>
+
+#if ! defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY \
+ && ! defined BOOST_THREAD_DONT_PROVIDE_FUTURE_WHEN_ALL_WHEN_ANY \
+ && ! defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) \
+ && ! defined(BOOST_NO_CXX11_HDR_TUPLE)
+#define BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+#endif
+
+#include <boost/thread/future.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+
+void set_123(boost::promise<int>* p)
+{
+  p->set_value(123);
+}
+
+int p1_sleep()
+{
+  boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+  return 1;
+}
+
+int main()
+{
+  {
+    boost::future<boost::csbl::tuple<> > any0 = boost::when_any();
+    BOOST_TEST(any0.is_ready());
+  }
+  {
+    boost::promise<int> p1;
+    boost::promise<int> p2;
+    boost::future<int> f1 = p1.get_future();
+    boost::future<int> f2 = p2.get_future();
+    boost::future<boost::csbl::vector<boost::future<int> > > any = boost::when_any(boost::move(f1), boost::move(f2));
+    BOOST_TEST(! f1.valid());
+    BOOST_TEST(! f2.valid());
+    BOOST_TEST(! any.is_ready());
+    p2.set_value(2);
+    BOOST_TEST(any.is_ready());
+    boost::csbl::vector<boost::future<int> > res = any.get();
+    BOOST_TEST(res.size() == 2);
+    BOOST_TEST(! res[0].is_ready());
+    BOOST_TEST(res[1].get() == 2);
+    p1.set_value(1);
+    BOOST_TEST(res[0].get() == 1);
+  }
+  {
+    boost::promise<int> p;
+    boost::future<int> f1 = p.get_future();
+    boost::future<int> f2 = boost::make_ready_future(1);
+    boost::future<boost::csbl::vector<boost::future<int> > > any = boost::when_any(boost::move(f1), boost::move(f2));
+    boost::csbl::vector<boost::future<int> > res = any.get();
+    BOOST_TEST(res[1].get() == 1);
+    boost::thread t(&set_123, &p);
+    BOOST_TEST(res[0].get() == 123);
+    t.join();
+  }
+  {
+    // The last notification comes from the async thread. Dropping the result must not make that thread destroy
+    // its own shared state.
+    boost::future<int> f = boost::async(boost::launch::async, &p1_sleep);
+    boost::future<boost::csbl::vector<boost::future<int> > > any = boost::when_any(boost::move(f));
+  }
+  boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
+  {
+    // The futures still to notify are not owned once the result has been taken.
+    boost::promise<int> p1;
+    boost::promise<int> p2;
+    boost::future<int> f1 = p1.get_future();
+    boost::future<int> f2 = p2.get_future();
+    {
+      boost::future<boost::csbl::vector<boost::future<int> > > any = boost::when_any(boost::move(f1), boost::move(f2));
+      p1.set_value(1);
+      boost::csbl::vector<boost::future<int> > res = any.get();
+      BOOST_TEST(res[0].get() == 1);
+    }
+    p2.set_value(2);
+  }
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,21 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/distributed_shared_mutex.hpp>
+
+// class distributed_shared_mutex;
+
+// distributed_shared_mutex(const distributed_shared_mutex&) = delete;
+
+#include <boost/thread/distributed_shared_mutex.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+int main()
+{
+  boost::distributed_shared_mutex m0;
+  boost::distributed_shared_mutex m1(m0);
+}
+
+#include "../../../remove_error_code_unused_warning.hpp"
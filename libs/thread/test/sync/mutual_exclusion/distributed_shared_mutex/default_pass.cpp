@@ -0,0 +1,40 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/distributed_shared_mutex.hpp>
+
+// class distributed_shared_mutex;
+
+// distributed_shared_mutex(unsigned concurrency = thread::hardware_concurrency());
+
+#include <boost/thread/distributed_shared_mutex.hpp>
+#include <boost/thread/lockable_concepts.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+BOOST_CONCEPT_ASSERT(( boost::SharedLockable<boost::distributed_shared_mutex> ));
+
+int main()
+{
+  {
+    boost::distributed_shared_mutex m0;
+  }
+  {
+    boost::distributed_shared_mutex m0(1);
+    m0.lock_shared();
+    m0.lock_shared();
+    BOOST_TEST(!m0.try_lock());
+    m0.unlock_shared();
+    m0.unlock_shared();
+    BOOST_TEST(m0.try_lock());
+    BOOST_TEST(!m0.try_lock_shared());
+    m0.unlock();
+  }
+  {
+    boost::distributed_shared_mutex m0(1000);
+    m0.lock();
+    m0.unlock();
+  }
+  return boost::report_errors();
+}
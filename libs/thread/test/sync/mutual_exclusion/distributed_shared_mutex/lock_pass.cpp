@@ -0,0 +1,72 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/distributed_shared_mutex.hpp>
+
+// class distributed_shared_mutex;
+
+// void lock();
+
+#include <boost/thread/distributed_shared_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+boost::distributed_shared_mutex m;
+
+typedef boost::chrono::steady_clock Clock;
+typedef Clock::time_point time_point;
+typedef boost::chrono::milliseconds ms;
+typedef boost::chrono::nanoseconds ns;
+
+void f()
+{
+  time_point t0 = Clock::now();
+  m.lock();
+  time_point t1 = Clock::now();
+  m.unlock();
+  ns d = t1 - t0 - ms(250);
+  // This test is spurious as it depends on the time the thread system switches the threads
+  BOOST_TEST(d < ns(2500000)+ms(1000)); // within 2.5ms
+}
+
+void shared()
+{
+  time_point t0 = Clock::now();
+  m.lock_shared();
+  time_point t1 = Clock::now();
+  m.unlock_shared();
+  ns d = t1 - t0 - ms(250);
+  // This test is spurious as it depends on the time the thread system switches the threads
+  BOOST_TEST(d < ns(2500000)+ms(1000)); // within 2.5ms
+}
+
+int main()
+{
+  {
+    m.lock();
+    boost::thread t(f);
+    boost::this_thread::sleep_for(ms(250));
+    m.unlock();
+    t.join();
+  }
+  {
+    m.lock_shared();
+    boost::thread t(f);
+    boost::this_thread::sleep_for(ms(250));
+    m.unlock_shared();
+    t.join();
+  }
+  {
+    m.lock();
+    boost::thread t0(shared);
+    boost::thread t1(shared);
+    boost::this_thread::sleep_for(ms(250));
+    m.unlock();
+    t0.join();
+    t1.join();
+  }
+
+  return boost::report_errors();
+}
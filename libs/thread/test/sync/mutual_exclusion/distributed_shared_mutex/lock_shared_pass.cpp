@@ -0,0 +1,66 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/distributed_shared_mutex.hpp>
+
+// class distributed_shared_mutex;
+
+// void lock_shared();
+// void unlock_shared();
+
+#include <boost/thread/distributed_shared_mutex.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+boost::distributed_shared_mutex m;
+// written under the exclusive lock and read under the shared lock, they must always be equal.
+int value1 = 0;
+int value2 = 0;
+boost::atomic<int> inconsistencies(0);
+
+const int cycles = 20000;
+
+void reader()
+{
+  for (int i = 0; i < cycles; ++i)
+  {
+    boost::shared_lock<boost::distributed_shared_mutex> lk(m);
+    if (value1 != value2)
+    {
+      ++inconsistencies;
+    }
+  }
+}
+
+void writer()
+{
+  for (int i = 0; i < cycles / 10; ++i)
+  {
+    boost::unique_lock<boost::distributed_shared_mutex> lk(m);
+    ++value1;
+    boost::this_thread::yield();
+    ++value2;
+  }
+}
+
+int main()
+{
+  boost::thread r0(reader);
+  boost::thread r1(reader);
+  boost::thread r2(reader);
+  boost::thread w0(writer);
+  boost::thread w1(writer);
+  r0.join();
+  r1.join();
+  r2.join();
+  w0.join();
+  w1.join();
+  BOOST_TEST(inconsistencies == 0);
+  BOOST_TEST(value1 == 2 * (cycles / 10));
+  BOOST_TEST(value2 == 2 * (cycles / 10));
+
+  return boost::report_errors();
+}
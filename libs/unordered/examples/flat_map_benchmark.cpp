@@ -0,0 +1,90 @@
+
+// Copyright 2013 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares unordered_flat_map with unordered_map: inserts n random keys,
+// looks up each of them, looks up n keys that aren't in the map and then
+// erases all of them. Run with the number of keys as the argument.
+
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_flat_map.hpp>
+#include <boost/cstdint.hpp>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+typedef boost::uint64_t key_type;
+
+std::vector<key_type> random_keys(std::size_t n, key_type seed)
+{
+    // xorshift, with the lowest bit used to tell the hits from the misses.
+    std::vector<key_type> keys(n);
+    key_type x = seed;
+    for (std::size_t i = 0; i != n; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        keys[i] = x;
+    }
+    return keys;
+}
+
+struct timer
+{
+    std::clock_t start;
+
+    timer() : start(std::clock()) {}
+
+    double elapsed() const
+    {
+        return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    }
+};
+
+template <class Map>
+void run(char const* name, std::vector<key_type> const& keys,
+        std::vector<key_type> const& misses)
+{
+    Map map;
+    std::size_t n = keys.size(), found = 0;
+
+    timer t1;
+    for (std::size_t i = 0; i != n; ++i) map[keys[i] | 1] = i;
+    double insert = t1.elapsed();
+
+    timer t2;
+    for (std::size_t i = 0; i != n; ++i) found += map.count(keys[i] | 1);
+    double hit = t2.elapsed();
+
+    timer t3;
+    for (std::size_t i = 0; i != n; ++i) found += map.count(misses[i] & ~1);
+    double miss = t3.elapsed();
+
+    timer t4;
+    for (std::size_t i = 0; i != n; ++i) map.erase(keys[i] | 1);
+    double erase = t4.elapsed();
+
+    std::cout << name << ": "
+        << "insert " << insert << "s, "
+        << "hit " << hit << "s, "
+        << "miss " << miss << "s, "
+        << "erase " << erase << "s "
+        << "(" << found << " found)" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = argc > 1 ?
+        static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+
+    std::vector<key_type> keys = random_keys(n, 88172645463325252ull);
+    std::vector<key_type> misses = random_keys(n, 2463534242ull);
+
+    std::cout << n << " keys" << std::endl;
+    run<boost::unordered_map<key_type, std::size_t> >(
+        "unordered_map", keys, misses);
+    run<boost::unordered_flat_map<key_type, std::size_t> >(
+        "unordered_flat_map", keys, misses);
+}
@@ -0,0 +1,271 @@
+
+// Copyright 2013 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "../helpers/prefix.hpp"
+#include <boost/unordered_flat_map.hpp>
+#include <boost/unordered_flat_set.hpp>
+#include "../helpers/postfix.hpp"
+
+#include "../helpers/test.hpp"
+#include <boost/lexical_cast.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+namespace flat_tests {
+
+// Counts the live instances, to check that every element that is
+// constructed is also destroyed.
+struct counted
+{
+    static int count;
+
+    int value;
+
+    counted(int v = 0) : value(v) { ++count; }
+    counted(counted const& x) : value(x.value) { ++count; }
+    ~counted() { --count; }
+
+    counted& operator=(counted const& x) { value = x.value; return *this; }
+    bool operator==(counted const& x) const { return value == x.value; }
+};
+
+int counted::count = 0;
+
+std::size_t hash_value(counted const& x)
+{
+    return boost::hash<int>()(x.value);
+}
+
+// A poor hash function, so that many keys share a probe sequence.
+struct collide_hash
+{
+    std::size_t operator()(int x) const
+    {
+        return static_cast<std::size_t>(x % 8);
+    }
+};
+
+template <class Map, class Oracle>
+void compare(Map const& x, Oracle const& y)
+{
+    BOOST_TEST(x.size() == y.size());
+    BOOST_TEST(x.empty() == y.empty());
+    BOOST_TEST(static_cast<std::size_t>(
+        std::distance(x.begin(), x.end())) == y.size());
+
+    for (typename Oracle::const_iterator it = y.begin(); it != y.end(); ++it) {
+        typename Map::const_iterator pos = x.find(it->first);
+        BOOST_TEST(pos != x.end() && pos->second == it->second);
+    }
+}
+
+UNORDERED_AUTO_TEST(flat_map_basic) {
+    boost::unordered_flat_map<std::string, int> x;
+    BOOST_TEST(x.empty());
+    BOOST_TEST(x.begin() == x.end());
+    BOOST_TEST(x.find("one") == x.end());
+    BOOST_TEST(!x.count("one"));
+
+    BOOST_TEST(x.insert(std::make_pair(std::string("one"), 1)).second);
+    BOOST_TEST(!x.insert(std::make_pair(std::string("one"), 2)).second);
+    BOOST_TEST(x.emplace("two", 2).second);
+    x["three"] = 3;
+
+    BOOST_TEST(x.size() == 3);
+    BOOST_TEST(x["one"] == 1);
+    BOOST_TEST(x.at("two") == 2);
+    BOOST_TEST(x.find("three")->second == 3);
+    BOOST_TEST(x.count("three") == 1);
+    BOOST_TEST(x.equal_range("two").first->second == 2);
+    BOOST_TEST(x.equal_range("four").first == x.end());
+
+    try {
+        x.at("four");
+        BOOST_ERROR("Should have thrown.");
+    }
+    catch(std::out_of_range&) {
+    }
+
+    BOOST_TEST(x.erase("two") == 1);
+    BOOST_TEST(x.erase("two") == 0);
+    BOOST_TEST(x.size() == 2);
+    BOOST_TEST(x.find("two") == x.end());
+
+    x.clear();
+    BOOST_TEST(x.empty());
+    BOOST_TEST(x.begin() == x.end());
+    BOOST_TEST(x.find("one") == x.end());
+}
+
+UNORDERED_AUTO_TEST(flat_map_random) {
+    boost::unordered_flat_map<int, int> x;
+    std::map<int, int> y;
+
+    std::srand(1);
+    for (int i = 0; i < 20000; ++i) {
+        int k = std::rand() % 2000;
+        switch (std::rand() % 4) {
+        case 0:
+        case 1:
+            BOOST_TEST(x.insert(std::make_pair(k, i)).second ==
+                y.insert(std::make_pair(k, i)).second);
+            break;
+        case 2:
+            BOOST_TEST(x.erase(k) == y.erase(k));
+            break;
+        case 3:
+            BOOST_TEST(x.count(k) == y.count(k));
+            break;
+        }
+    }
+
+    compare(x, y);
+    BOOST_TEST(x.load_factor() <= x.max_load_factor());
+}
+
+// Erasing and inserting different keys fills the table with deleted
+// slots, which have to be reclaimed without growing the table.
+UNORDERED_AUTO_TEST(flat_map_churn) {
+    boost::unordered_flat_map<int, int, collide_hash> x;
+    std::map<int, int> y;
+
+    for (int i = 0; i < 100; ++i) {
+        x[i] = i;
+        y[i] = i;
+    }
+    std::size_t buckets = x.bucket_count();
+
+    for (int i = 100; i < 10000; ++i) {
+        BOOST_TEST(x.erase(i - 100) == 1);
+        y.erase(i - 100);
+        x[i] = i;
+        y[i] = i;
+    }
+
+    compare(x, y);
+    BOOST_TEST(x.bucket_count() == buckets);
+}
+
+UNORDERED_AUTO_TEST(flat_map_erase_iterator) {
+    boost::unordered_flat_map<int, int> x;
+    for (int i = 0; i < 1000; ++i) x[i] = i;
+
+    typedef boost::unordered_flat_map<int, int>::iterator iterator;
+    for (iterator it = x.begin(); it != x.end();) {
+        if (it->first % 2) it = x.erase(it);
+        else ++it;
+    }
+
+    BOOST_TEST(x.size() == 500);
+    for (int i = 0; i < 1000; ++i) BOOST_TEST(x.count(i) == (i % 2 ? 0 : 1));
+
+    BOOST_TEST(x.erase(x.begin(), x.end()) == x.end());
+    BOOST_TEST(x.empty());
+}
+
+UNORDERED_AUTO_TEST(flat_map_copy_move_swap) {
+    boost::unordered_flat_map<int, std::string> x, z;
+    for (int i = 0; i < 100; ++i) x[i] = boost::lexical_cast<std::string>(i);
+    z[-1] = "minus one";
+
+    boost::unordered_flat_map<int, std::string> y(x);
+    BOOST_TEST(y == x);
+    y[100] = "100";
+    BOOST_TEST(y != x);
+
+    y = x;
+    BOOST_TEST(y == x);
+
+    y.swap(z);
+    BOOST_TEST(y.size() == 1 && y[-1] == "minus one");
+    BOOST_TEST(z == x);
+
+    boost::unordered_flat_map<int, std::string> w(boost::move(z));
+    BOOST_TEST(w == x);
+    z.clear();
+    z[1] = "1";
+    BOOST_TEST(z.size() == 1);
+
+    w = boost::move(y);
+    BOOST_TEST(w.size() == 1 && w[-1] == "minus one");
+}
+
+UNORDERED_AUTO_TEST(flat_map_rehash) {
+    boost::unordered_flat_map<int, int> x(0);
+    BOOST_TEST(x.bucket_count() == 0);
+
+    x.reserve(1000);
+    std::size_t buckets = x.bucket_count();
+    BOOST_TEST(static_cast<float>(buckets) * x.max_load_factor() >= 1000);
+
+    for (int i = 0; i < 1000; ++i) x[i] = i;
+    BOOST_TEST(x.bucket_count() == buckets);
+
+    x.rehash(0);
+    BOOST_TEST(x.bucket_count() <= buckets);
+    for (int i = 0; i < 1000; ++i) BOOST_TEST(x[i] == i);
+
+    x.rehash(buckets * 4);
+    BOOST_TEST(x.bucket_count() >= buckets * 4);
+    for (int i = 0; i < 1000; ++i) BOOST_TEST(x[i] == i);
+
+    x.clear();
+    x.rehash(0);
+    BOOST_TEST(x.bucket_count() == 0);
+    x[1] = 1;
+    BOOST_TEST(x.size() == 1);
+}
+
+UNORDERED_AUTO_TEST(flat_map_range) {
+    std::vector<std::pair<int, int> > values;
+    for (int i = 0; i < 500; ++i) values.push_back(std::make_pair(i % 250, i));
+
+    boost::unordered_flat_map<int, int> x(values.begin(), values.end());
+    BOOST_TEST(x.size() == 250);
+    for (int i = 0; i < 250; ++i) BOOST_TEST(x[i] == i);
+
+    x.insert(values.begin(), values.end());
+    BOOST_TEST(x.size() == 250);
+}
+
+UNORDERED_AUTO_TEST(flat_set_tests) {
+    BOOST_TEST(counted::count == 0);
+    {
+        boost::unordered_flat_set<counted> x;
+        std::set<int> y;
+
+        std::srand(2);
+        for (int i = 0; i < 5000; ++i) {
+            int k = std::rand() % 500;
+            if (std::rand() % 3) {
+                BOOST_TEST(x.insert(counted(k)).second ==
+                    y.insert(k).second);
+            }
+            else {
+                BOOST_TEST(x.erase(counted(k)) == y.erase(k));
+            }
+        }
+
+        BOOST_TEST(x.size() == y.size());
+        for (std::set<int>::iterator it = y.begin(); it != y.end(); ++it)
+            BOOST_TEST(x.count(counted(*it)) == 1);
+
+        boost::unordered_flat_set<counted> z(x);
+        BOOST_TEST(z == x);
+        BOOST_TEST(counted::count ==
+            static_cast<int>(x.size() + z.size()));
+
+        z.clear();
+        BOOST_TEST(counted::count == static_cast<int>(x.size()));
+    }
+    BOOST_TEST(counted::count == 0);
+}
+
+}
+
+RUN_TESTS()